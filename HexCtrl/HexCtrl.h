@@ -6,8 +6,10 @@
 ****************************************************************************************/
 #pragma once
 #include <Windows.h>
+#include <array>
 #include <compare>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <span>
@@ -77,7 +79,8 @@ namespace HEXCTRL {
 		CMD_APPEAR_FONTDEC, CMD_APPEAR_CAPACINC, CMD_APPEAR_CAPACDEC, CMD_PRINT_DLG, CMD_ABOUT_DLG,
 		CMD_CARET_LEFT, CMD_CARET_RIGHT, CMD_CARET_UP, CMD_CARET_DOWN,
 		CMD_SCROLL_PAGEUP, CMD_SCROLL_PAGEDOWN,
-		CMD_TEMPL_APPLYCURR, CMD_TEMPL_DISAPPLY, CMD_TEMPL_DISAPPALL, CMD_TEMPL_DLG_MGR
+		CMD_TEMPL_APPLYCURR, CMD_TEMPL_DISAPPLY, CMD_TEMPL_DISAPPALL, CMD_TEMPL_DLG_MGR,
+		CMD_HASH_DLG, CMD_DIFF_NEXT, CMD_DIFF_PREV
 	};
 
 	/********************************************************************************************
@@ -85,7 +88,7 @@ namespace HEXCTRL {
 	********************************************************************************************/
 	enum class EHexWnd : std::uint8_t {
 		WND_MAIN, DLG_BKMMGR, DLG_DATAINTERP, DLG_MODIFY,
-		DLG_SEARCH, DLG_CODEPAGE, DLG_GOTO, DLG_TEMPLMGR
+		DLG_SEARCH, DLG_CODEPAGE, DLG_GOTO, DLG_TEMPLMGR, DLG_HASH
 	};
 
 	/********************************************************************************************
@@ -95,7 +98,7 @@ namespace HEXCTRL {
 		BKMMGR_CHK_HEX, DATAINTERP_CHK_HEX, DATAINTERP_CHK_BE, TEMPLMGR_CHK_MIN,
 		TEMPLMGR_CHK_TT, TEMPLMGR_CHK_HGL, TEMPLMGR_CHK_HEX, TEMPLMGR_CHK_SWAP,
 		SEARCH_COMBO_FIND, SEARCH_COMBO_REPLACE, SEARCH_EDIT_START, SEARCH_EDIT_STEP,
-		SEARCH_EDIT_RNGBEG, SEARCH_EDIT_RNGEND, SEARCH_EDIT_LIMIT, FILLDATA_COMBO_DATA
+		SEARCH_EDIT_RNGBEG, SEARCH_EDIT_RNGEND, SEARCH_EDIT_LIMIT, SEARCH_EDIT_MISMATCH, FILLDATA_COMBO_DATA
 	};
 
 	/********************************************************************************************
@@ -129,10 +132,13 @@ namespace HEXCTRL {
 	/********************************************************************************************
 	* IHexVirtData: Pure abstract data handler class, that can be implemented by a client,      *
 	* to set its own data handler routines.	Pointer to this class is set in the SetData method. *
+	* The OnHexGetData is called not only from the UI thread. Long operations, like the search,  *
+	* hashing and data statistics, read the data ahead from their own worker threads, so the    *
+	* OnHexGetData must be safe to call from any thread.                                        *
 	********************************************************************************************/
 	class IHexVirtData {
 	public:
-		virtual void OnHexGetData(HEXDATAINFO&) = 0; //Data to get.
+		virtual void OnHexGetData(HEXDATAINFO&) = 0; //Data to get, can be called from any thread.
 		virtual void OnHexGetOffset(HEXDATAINFO& hdi, bool fGetVirt) = 0; //Offset<->VirtOffset conversion.
 		virtual void OnHexSetData(const HEXDATAINFO&) = 0; //Data to set, if mutable.
 	};
@@ -284,6 +290,8 @@ namespace HEXCTRL {
 		COLORREF clrBkInfoBar { GetSysColor(COLOR_3DFACE) };         //Background color of the bottom Info bar.
 		COLORREF clrBkCaret { RGB(0, 0, 255) };                      //Caret background color.
 		COLORREF clrBkCaretSel { RGB(0, 0, 200) };                   //Caret background color in selection.
+		COLORREF clrFontDiff { RGB(255, 255, 255) };                 //Font color of the compare differences.
+		COLORREF clrBkDiff { RGB(200, 0, 0) };                       //Background color of the compare differences.
 	};
 	using PCHEXCOLORS = const HEXCOLORS*;
 
@@ -346,7 +354,8 @@ namespace HEXCTRL {
 	* EHexModifyMode: Enum of the data modification mode, used in the HEXMODIFY.                *
 	********************************************************************************************/
 	enum class EHexModifyMode : std::uint8_t {
-		MODIFY_ONCE, MODIFY_REPEAT, MODIFY_OPERATION, MODIFY_RAND_MT19937, MODIFY_RAND_FAST
+		MODIFY_ONCE, MODIFY_REPEAT, MODIFY_OPERATION, MODIFY_RAND_MT19937, MODIFY_RAND_FAST,
+		MODIFY_KEYSTREAM
 	};
 
 	/********************************************************************************************
@@ -366,6 +375,19 @@ namespace HEXCTRL {
 		DATA_UINT32, DATA_INT64, DATA_UINT64, DATA_FLOAT, DATA_DOUBLE
 	};
 
+	/********************************************************************************************
+	* EHexKeyStream: Keystream type, used in the EHexModifyMode::MODIFY_KEYSTREAM mode.         *
+	* The data is XORed with the stream produced from the HEXMODIFY::spnData key:               *
+	* KEYSTREAM_XOR     - key bytes repeated: Key[i % KeySize].                                 *
+	* KEYSTREAM_ROLLXOR - Key[i % KeySize] ^ Data[i - 1], original previous data byte, or zero. *
+	* KEYSTREAM_COUNTER - Key[i % KeySize] + (i / KeySize), key incremented at each key round.  *
+	* KEYSTREAM_RC4     - RC4 keystream initialized with the key.                               *
+	* Index i runs continuously through all HEXMODIFY::vecSpan regions.                         *
+	********************************************************************************************/
+	enum class EHexKeyStream : std::uint8_t {
+		KEYSTREAM_XOR, KEYSTREAM_ROLLXOR, KEYSTREAM_COUNTER, KEYSTREAM_RC4
+	};
+
 	/********************************************************************************************
 	* HEXMODIFY: Main struct to represent data modification parameters.                         *
 	* When eModifyMode is set to MODIFY_ONCE, bytes from spnData.data() just replace            *
@@ -378,16 +400,209 @@ namespace HEXCTRL {
 	* at vecSpan.ullOffset will be `030405030405030405.                                         *
 	* If eModifyMode is equal to MODIFY_OPERATION, then eOperMode comes into play, showing      *
 	* what kind of operation must be performed on the data.                                     *
+	* If eModifyMode is equal to MODIFY_KEYSTREAM, the data is XORed with the eKeyStream        *
+	* stream, spnData is the key of any length.                                                 *
 	********************************************************************************************/
 	struct HEXMODIFY {
 		EHexModifyMode eModifyMode { };      //Modify mode.
 		EHexOperMode   eOperMode { };        //Operation mode, used if eModifyMode == MODIFY_OPERATION.
 		EHexDataType   eDataType { };        //Data type of the underlying data, used if eModifyMode == MODIFY_OPERATION.
+		EHexKeyStream  eKeyStream { };       //Keystream type, used if eModifyMode == MODIFY_KEYSTREAM.
 		SpanCByte      spnData;              //Span of the data to modify with.
 		VecSpan        vecSpan;              //Vector of data offsets and sizes to modify.
 		bool           fBigEndian { false }; //Treat data as the big endian, used if eModifyMode == MODIFY_OPERATION.
 	};
 
+	/********************************************************************************************
+	* EHexHash: Checksum and hash algorithms, used in the HEXHASH.                              *
+	********************************************************************************************/
+	enum class EHexHash : std::uint8_t {
+		HASH_CRC32, HASH_CRC32C, HASH_ADLER32, HASH_XXH64, HASH_MD5, HASH_SHA1, HASH_SHA256
+	};
+
+	/********************************************************************************************
+	* HEXHASH: Struct for the HashData method.                                                  *
+	* All the vecHash algorithms are computed in one pass over the data.                        *
+	* If fPerSpan is false, all the vecSpan spans are hashed as one continuous stream,          *
+	* otherwise every span gets its own digests, and the spans are hashed in parallel.          *
+	********************************************************************************************/
+	struct HEXHASH {
+		VecSpan               vecSpan;            //Vector of data offsets and sizes to hash.
+		std::vector<EHexHash> vecHash;            //Algorithms to compute.
+		bool                  fPerSpan { false }; //Digests for every span separately, or for all spans as a whole.
+	};
+
+	/********************************************************************************************
+	* HEXDIGEST: Digest computed by the HashData method.                                        *
+	* Checksums (CRC-32, CRC-32C, Adler-32, xxHash64) are in the big-endian byte order,         *
+	* as they are usually shown.                                                                *
+	********************************************************************************************/
+	struct HEXDIGEST {
+		std::vector<std::byte> vecDigest;      //Digest bytes.
+		std::size_t            sSpanIndex { }; //Index in the HEXHASH::vecSpan if fPerSpan, zero otherwise.
+		EHexHash               eHash { };      //Algorithm of this digest.
+	};
+
+	/********************************************************************************************
+	* HEXENTROPY: Byte-value histogram and Shannon entropy of the data, used in GetEntropy.     *
+	* Entropy is in bits per byte, from 0.0 (one byte value only) to 8.0 (random data).         *
+	* vecBlockEntropy holds the entropy of every dwBlockSize block, the last one may be shorter.*
+	********************************************************************************************/
+	struct HEXENTROPY {
+		std::array<ULONGLONG, 256> arrHist { };     //Byte-value histogram of the whole data.
+		std::vector<float>         vecBlockEntropy; //Entropy of every block.
+		DWORD                      dwBlockSize { }; //Block size the vecBlockEntropy is computed for.
+		double                     dEntropy { };    //Entropy of the whole data.
+	};
+
+	/********************************************************************************************
+	* HEXPATTERNS: Struct for the SearchPatterns method.                                        *
+	* All the vecPattern patterns are searched for in one pass over the data.                   *
+	* Every span is searched separately, occurrences can't cross the span's boundaries.         *
+	********************************************************************************************/
+	struct HEXPATTERNS {
+		VecSpan                             vecSpan;                  //Vector of data offsets and sizes to search within.
+		std::vector<std::vector<std::byte>> vecPattern;               //Byte patterns to search for.
+		DWORD                               dwLimit { 0xFFFFFFFFUL }; //Maximum count of occurrences to find.
+	};
+
+	/********************************************************************************************
+	* HEXPATTERNHIT: Occurrence found by the SearchPatterns method.                             *
+	********************************************************************************************/
+	struct HEXPATTERNHIT {
+		ULONGLONG   ullOffset { };     //Offset of the occurrence.
+		std::size_t sPatternIndex { }; //Index in the HEXPATTERNS::vecPattern.
+	};
+
+	/********************************************************************************************
+	* EHexSearchType: Type of the data to search for, used in the HEXSEARCH.                    *
+	********************************************************************************************/
+	enum class EHexSearchType : std::uint8_t {
+		SEARCH_BYTES, SEARCH_TEXT_ASCII, SEARCH_TEXT_UTF16
+	};
+
+	/********************************************************************************************
+	* HEXSEARCH: Struct for the SearchAsync method, the search without the Search dialog.       *
+	* The text is searched for in the eType's encoding, numbers are searched for as bytes.      *
+	* FuncHit is called for every occurrence, in the ascending order, from the search thread.   *
+	* It returns false to stop the search. In VirtualData mode there is no search thread, the   *
+	* search is done in the SearchAsync's calling thread before it returns, so the FuncHit is   *
+	* the only way to stop it.                                                                  *
+	********************************************************************************************/
+	struct HEXSEARCH {
+		std::vector<std::byte>           vecData;                  //Data to search for.
+		std::function<bool(ULONGLONG)>   FuncHit;                  //Called with every occurrence's offset.
+		HEXSPAN                          stRange;                  //Range to search within, zero size is up to the data end.
+		ULONGLONG                        ullStep { 1 };            //Search step.
+		DWORD                            dwLimit { 0xFFFFFFFFUL }; //Maximum count of occurrences to find.
+		EHexSearchType                   eType { };                //Type of the vecData.
+		bool                             fMatchCase { true };      //Case sensitive search, for the text only.
+		bool                             fInverted { false };      //Offsets where the vecData doesn't match.
+	};
+
+	/********************************************************************************************
+	* IHexSearch: Running search, returned by the SearchAsync and the ExtractStrings methods.   *
+	* Deleting it cancels the search and waits for the search thread to finish.                 *
+	* The data modification, ClearData and SetData cancel the running SearchAsync searches and   *
+	* wait for them the same way, the search's IsCanceled is true then.                         *
+	********************************************************************************************/
+	class IHexSearch {
+	public:
+		virtual void Cancel() = 0;                                 //Stop the search as soon as possible.
+		virtual void Delete() = 0;                                 //IHexSearch object deleter.
+		[[nodiscard]] virtual auto GetCount()const->ULONGLONG = 0; //Occurrences found so far.
+		[[nodiscard]] virtual bool IsCanceled()const = 0;          //Search was stopped by the Cancel or by the FuncHit.
+		[[nodiscard]] virtual bool IsDone()const = 0;              //Search thread has finished.
+		virtual void Wait() = 0;                                   //Wait for the search thread to finish, not from the FuncHit.
+	};
+	struct IHexSearchDeleter { void operator()(IHexSearch* p)const { p->Delete(); } };
+	using IHexSearchPtr = std::unique_ptr<IHexSearch, IHexSearchDeleter>;
+
+	/********************************************************************************************
+	* EHexStringType: Encoding of the string found by the ExtractStrings method.                *
+	********************************************************************************************/
+	enum class EHexStringType : std::uint8_t {
+		STRING_ASCII, STRING_UTF8, STRING_UTF16LE, STRING_UTF16BE
+	};
+
+	/********************************************************************************************
+	* HEXSTRING: String found by the ExtractStrings method.                                     *
+	********************************************************************************************/
+	struct HEXSTRING {
+		ULONGLONG      ullOffset { }; //Offset of the string's first byte.
+		ULONGLONG      ullSize { };   //Size of the string in bytes.
+		ULONGLONG      ullLength { }; //Length of the string in characters.
+		EHexStringType eType { };     //Encoding of the string.
+	};
+
+	/********************************************************************************************
+	* HEXSTRINGS: Struct for the ExtractStrings method, the runs of printable characters.       *
+	* Printable are the 0x09 and 0x20-0x7E ASCII, all the UTF-8 characters except the controls, *
+	* and the UTF-16 code units 0x09, 0x20-0x7E and 0xA0-0xFF, at both even and odd offsets.    *
+	* UTF-8 strings of the ASCII characters only are the STRING_ASCII ones, if fASCII is set.   *
+	* FuncString is called for every string, in the offsets order, from an extraction thread.   *
+	* It returns false to stop the extraction. The wstrPath file gets a line for every string:  *
+	* the hex offset, the encoding, the length in characters and the string itself in UTF-8.    *
+	********************************************************************************************/
+	struct HEXSTRINGS {
+		std::function<bool(const HEXSTRING&)> FuncString;   //Called with every string, can be empty if the wstrPath is set.
+		std::wstring                          wstrPath;     //File to write the strings to, "" for none.
+		HEXSPAN                               stRange;      //Range to extract from, zero size is up to the data end.
+		DWORD                                 dwMinLength { 4 }; //Minimum string length in characters.
+		bool                                  fASCII { true };    //ASCII strings.
+		bool                                  fUTF8 { false };    //UTF-8 strings, the ASCII ones included.
+		bool                                  fUTF16LE { true };  //UTF-16 little-endian strings.
+		bool                                  fUTF16BE { false }; //UTF-16 big-endian strings.
+	};
+
+	/********************************************************************************************
+	* HEXCOMPARE: Data to compare the HexCtrl's data with, used in the CompareData and DiffData *
+	* methods. The data is either the spnData, or the pHexVirtData that gives it in the         *
+	* dwCacheSize chunks. The HexCtrl's bytes past the compared data end are all a difference.  *
+	********************************************************************************************/
+	struct HEXCOMPARE {
+		SpanCByte     spnData;                    //Data to compare with, if the pHexVirtData is not set.
+		IHexVirtData* pHexVirtData { };           //Data handler to compare with, not the HexCtrl's own one.
+		ULONGLONG     ullDataSize { };            //Data size of the pHexVirtData.
+		DWORD         dwCacheSize { 0x800000UL }; //Size of the chunks to get from the pHexVirtData.
+		DWORD         dwMergeGap { };             //Differences that are at most that many bytes apart are one range.
+		DWORD         dwBlockSize { };            //DiffData block size, zero for the size based one.
+	};
+
+	/********************************************************************************************
+	* EHexDiffOp: Operation of the HEXDIFFOP.                                                   *
+	********************************************************************************************/
+	enum class EHexDiffOp : std::uint8_t {
+		DIFF_COPY, DIFF_INSERT
+	};
+
+	/********************************************************************************************
+	* HEXDIFFOP: Operation found by the DiffData method. The operations cover the HexCtrl's     *
+	* data in order. The DIFF_COPY range is the same as the other data's range at the           *
+	* ullOffsetOther, the DIFF_INSERT range is not found in the other data.                     *
+	********************************************************************************************/
+	struct HEXDIFFOP {
+		ULONGLONG  ullOffset { };      //Offset in the HexCtrl's data.
+		ULONGLONG  ullSize { };        //Size of the range.
+		ULONGLONG  ullOffsetOther { }; //Offset in the other data, for the DIFF_COPY.
+		EHexDiffOp eOp { };            //Operation.
+	};
+
+	/********************************************************************************************
+	* HEXSTATS: Statistics of the data treated as an array of the EHexDataType elements.        *
+	* NaNs are counted in the ullCountNaN, and excluded from all the other values.              *
+	* dStdDev is the population standard deviation.                                             *
+	********************************************************************************************/
+	struct HEXSTATS {
+		ULONGLONG ullCount { };     //Count of all the elements, including NaNs.
+		ULONGLONG ullCountNaN { };  //Count of NaNs, for DATA_FLOAT and DATA_DOUBLE only.
+		ULONGLONG ullCountZero { }; //Count of zero elements.
+		double    dMin { };         //Minimum element.
+		double    dMax { };         //Maximum element.
+		double    dSum { };         //Sum of all the elements.
+		double    dMean { };        //Arithmetic mean.
+		double    dStdDev { };      //Standard deviation.
+	};
 
 	/********************************************************************************************
 	* IHexCtrl: Pure abstract HexCtrl base class.                                               *
@@ -401,11 +616,14 @@ namespace HEXCTRL {
 		IHexCtrl& operator=(IHexCtrl&&) = delete;
 		virtual ~IHexCtrl() = default;
 		virtual void ClearData() = 0; //Clears all data from HexCtrl's view (not touching data itself).
+		virtual auto CompareData(const HEXCOMPARE& hcs)->VecSpan = 0; //Compare with other data, to navigate and highlight differences.
 		virtual bool Create(const HEXCREATE& hcs) = 0;                       //Main initialization method.
 		virtual bool CreateDialogCtrl(UINT uCtrlID, HWND hWndParent) = 0;    //Сreates custom dialog control.
 		virtual void Delete() = 0;                                           //IHexCtrl object deleter.
 		virtual void DestroyWindow() = 0;                                    //Destroy HexCtrl window.
+		virtual auto DiffData(const HEXCOMPARE& hcs)->std::vector<HEXDIFFOP> = 0; //Insertion aware difference with other data.
 		virtual void ExecuteCmd(EHexCmd eCmd) = 0;                           //Execute a command within HexCtrl.
+		[[nodiscard]] virtual auto ExtractStrings(const HEXSTRINGS& hss)const->IHexSearchPtr = 0; //Printable strings, in a separate thread if non-virtual.
 		[[nodiscard]] virtual auto GetActualWidth()const->int = 0;           //Working area actual width.
 		[[nodiscard]] virtual auto GetBookmarks()const->IHexBookmarks* = 0;  //Get Bookmarks interface.
 		[[nodiscard]] virtual auto GetCacheSize()const->DWORD = 0;           //Returns VirtualData mode cache size.
@@ -418,6 +636,7 @@ namespace HEXCTRL {
 		[[nodiscard]] virtual auto GetDataSize()const->ULONGLONG = 0;        //Get currently set data size.
 		[[nodiscard]] virtual auto GetDateInfo()const->std::tuple<DWORD, wchar_t> = 0; //Get date format and separator info.
 		[[nodiscard]] virtual auto GetDlgItemHandle(EHexWnd eWnd, EHexDlgItem eItem)const->HWND = 0; //Dialogs' items.
+		[[nodiscard]] virtual auto GetEntropy(DWORD dwBlockSize = 4096)->HEXENTROPY = 0; //Histogram and entropy map of the data.
 		[[nodiscard]] virtual auto GetFont()const->LOGFONTW = 0;             //Get current font.
 		[[nodiscard]] virtual auto GetGroupSize()const->DWORD = 0;           //Retrieves current data grouping size.
 		[[nodiscard]] virtual auto GetMenuHandle()const->HMENU = 0;          //Context menu handle.
@@ -427,11 +646,13 @@ namespace HEXCTRL {
 		[[nodiscard]] virtual auto GetPageSize()const->DWORD = 0;            //Current page size.
 		[[nodiscard]] virtual auto GetScrollRatio()const->std::tuple<float, bool> = 0; //Get current scroll ratio.
 		[[nodiscard]] virtual auto GetSelection()const->VecSpan = 0;         //Get current selection.
+		[[nodiscard]] virtual auto GetStatistics(const VecSpan& vecSpan, EHexDataType eDataType, bool fBigEndian = false)const->HEXSTATS = 0; //Statistics of the typed data.
 		[[nodiscard]] virtual auto GetTemplates()const->IHexTemplates* = 0;  //Get Templates interface.
 		[[nodiscard]] virtual auto GetUnprintableChar()const->wchar_t = 0;   //Get unprintable replacement character.
 		[[nodiscard]] virtual auto GetWndHandle(EHexWnd eWnd, bool fCreate = true)const->HWND = 0; //Get HWND of internal window/dialogs.
 		virtual void GoToOffset(ULONGLONG ullOffset, int iPosAt = 0) = 0;    //Go to the given offset.
 		[[nodiscard]] virtual bool HasSelection()const = 0;    //Does currently have any selection or not.
+		[[nodiscard]] virtual auto HashData(const HEXHASH& hhs)const->std::vector<HEXDIGEST> = 0; //Checksums/hashes of the data.
 		[[nodiscard]] virtual auto HitTest(POINT pt, bool fScreen = true)const->std::optional<HEXHITTEST> = 0; //HitTest given point.
 		[[nodiscard]] virtual bool IsCmdAvail(EHexCmd eCmd)const = 0; //Is given Cmd currently available (can be executed)?
 		[[nodiscard]] virtual bool IsCreated()const = 0;       //Shows whether HexCtrl is created or not.
@@ -444,6 +665,8 @@ namespace HEXCTRL {
 		virtual void ModifyData(const HEXMODIFY& hms) = 0;     //Main routine to modify data in IsMutable()==true mode.
 		[[nodiscard]] virtual bool PreTranslateMsg(MSG* pMsg) = 0;
 		virtual void Redraw() = 0;                             //Redraw HexCtrl's window.
+		[[nodiscard]] virtual auto SearchAsync(const HEXSEARCH& hss)const->IHexSearchPtr = 0; //Search without the Search dialog, in a separate thread if non-virtual.
+		[[nodiscard]] virtual auto SearchPatterns(const HEXPATTERNS& hps)const->std::vector<HEXPATTERNHIT> = 0; //Search for many patterns at once.
 		virtual void SetCapacity(DWORD dwCapacity) = 0;        //Set current capacity.
 		virtual void SetCaretPos(ULONGLONG ullOffset, bool fHighLow = true, bool fRedraw = true) = 0; //Set the caret position.
 		virtual void SetCharsExtraSpace(DWORD dwSpace) = 0;    //Extra space to add between chars, in pixels.
@@ -460,17 +683,30 @@ namespace HEXCTRL {
 		virtual void SetPageSize(DWORD dwSize, std::wstring_view wsvName = L"Page") = 0; //Set page size and name to draw the lines in-between.
 		virtual void SetRedraw(bool fRedraw) = 0;              //Handle WM_PAINT message or not.
 		virtual void SetScrollRatio(float flRatio, bool fLines) = 0; //Set mouse-wheel scroll ratio in screens or in lines.
+		virtual bool SetSearchIndex(std::wstring_view wsvPath) = 0; //Load or build the search index side file, or "" to remove.
 		virtual void SetSelection(const VecSpan& vecSel, bool fRedraw = true, bool fHighlight = false) = 0; //Set current selection.
 		virtual void SetUnprintableChar(wchar_t wch) = 0;      //Set unprintable replacement character.
 		virtual void SetVirtualBkm(IHexBookmarks* pVirtBkm) = 0; //Set pointer for Bookmarks Virtual Mode.
 		virtual void SetWindowPos(HWND hWndAfter, int iX, int iY, int iWidth, int iHeight, UINT uFlags = SWP_NOACTIVATE | SWP_NOZORDER) = 0;
 		virtual void ShowInfoBar(bool fShow) = 0;              //Show/hide bottom Info bar.
+		virtual void WaitSearchIndex() = 0;                    //Wait until the search index is loaded, or built and saved.
 	};
 
 	struct IHexCtrlDeleter { void operator()(IHexCtrl* p)const { p->Delete(); } };
 	using IHexCtrlPtr = std::unique_ptr<IHexCtrl, IHexCtrlDeleter>;
 	[[nodiscard]] HEXCTRLAPI IHexCtrlPtr CreateHexCtrl();
 
+	/********************************************************************************************
+	* HEXBYTES: Bytes of the hex string, converted by the HexStrToBytes function.               *
+	* The hex string is as in the Search dialog: "48 ? 89" and "48?89" are 48, any byte, 89,    *
+	* the wildcard in the two chars token is a half-byte: "4?" and "?8".                        *
+	********************************************************************************************/
+	struct HEXBYTES {
+		std::vector<std::byte> vecData; //Bytes, the wildcard bits are zeroed.
+		std::vector<std::byte> vecMask; //Bits of the vecData to compare, zero bits are the wildcard ones.
+	};
+	[[nodiscard]] HEXCTRLAPI auto HexStrToBytes(std::wstring_view wsvHex, wchar_t wchWildcard = 0)->std::optional<HEXBYTES>;
+
 	/**************************************************************************
 	* WM_NOTIFY message codes (NMHDR.code values).                            *
 	* These codes are used to notify parent window about HexCtrl's states.    *
@@ -494,6 +730,7 @@ namespace HEXCTRL {
 	constexpr auto HEXCTRL_MSG_SETFONT { 0x010FU };       //Font has changed.
 	constexpr auto HEXCTRL_MSG_SETGROUPSIZE { 0x0110U };  //Data grouping size has changed.
 	constexpr auto HEXCTRL_MSG_SETSELECTION { 0x0111U };  //Selection has been made.
+	constexpr auto HEXCTRL_MSG_DLGHASH { 0x0112U };       //"Hash" dialog is about to be displayed.
 
 
 	/**************************************************************************
@@ -93,6 +93,21 @@
 #define IDC_HEXCTRL_TEMPLMGR_CHK_MIN    9089
 #define IDC_HEXCTRL_TEMPLMGR_STAT_AVAIL 9090
 #define IDC_HEXCTRL_TEMPLMGR_STAT_APPLY 9091
+#define IDD_HEXCTRL_HASH                9092
+#define IDC_HEXCTRL_HASH_CHK_CRC32      9093
+#define IDC_HEXCTRL_HASH_CHK_CRC32C     9094
+#define IDC_HEXCTRL_HASH_CHK_ADLER32    9095
+#define IDC_HEXCTRL_HASH_CHK_XXH64      9096
+#define IDC_HEXCTRL_HASH_CHK_MD5        9097
+#define IDC_HEXCTRL_HASH_CHK_SHA1       9098
+#define IDC_HEXCTRL_HASH_CHK_SHA256     9099
+#define IDC_HEXCTRL_HASH_RAD_ALL        9100
+#define IDC_HEXCTRL_HASH_RAD_SEL        9101
+#define IDC_HEXCTRL_HASH_CHK_PERSPAN    9102
+#define IDC_HEXCTRL_HASH_EDIT_RESULT    9103
+#define IDC_HEXCTRL_HASH_BTN_COPY       9104
+#define IDC_HEXCTRL_SEARCH_EDIT_MISMATCH 9105
+#define IDC_HEXCTRL_SEARCH_BTN_COUNTALL 9106
 #define IDM_HEXCTRL_SEARCH_DLGSEARCH    33001
 #define IDM_HEXCTRL_SEARCH_NEXT         33002
 #define IDM_HEXCTRL_SEARCH_PREV         33003
@@ -150,14 +165,15 @@
 #define IDM_HEXCTRL_APPEAR_CAPACDEC     33055
 #define IDM_HEXCTRL_OTHER_DLGPRINT      33056
 #define IDM_HEXCTRL_OTHER_DLGABOUT      33057
+#define IDM_HEXCTRL_DLGHASH             33058
 
 // Next default values for new objects
 // 
 #ifdef APSTUDIO_INVOKED
 #ifndef APSTUDIO_READONLY_SYMBOLS
-#define _APS_NEXT_RESOURCE_VALUE        9092
-#define _APS_NEXT_COMMAND_VALUE         33058
-#define _APS_NEXT_CONTROL_VALUE         9093
-#define _APS_NEXT_SYMED_VALUE           9092
+#define _APS_NEXT_RESOURCE_VALUE        9107
+#define _APS_NEXT_COMMAND_VALUE         33059
+#define _APS_NEXT_CONTROL_VALUE         9107
+#define _APS_NEXT_SYMED_VALUE           9107
 #endif
 #endif
@@ -0,0 +1,232 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+export module HEXCTRL.CHexAhoCorasick;
+
+namespace HEXCTRL::INTERNAL {
+	//Aho-Corasick automaton to search for many byte patterns in one pass over the data.
+	//The automaton is a complete DFA over the byte classes if it fits m_sDenseMax transitions,
+	//otherwise it is a trie with the failure links, that are followed at the search time.
+	export class CHexAhoCorasick final {
+	public:
+		explicit CHexAhoCorasick(const std::vector<std::vector<std::byte>>& vecPattern); //Empty patterns never match.
+		[[nodiscard]] auto GetMaxPatternSize()const->std::size_t;
+		//Searches the spnData, that starts at the ullOffset, continuing from the refState state.
+		//The state is to be zero at the beginning, and is carried from chunk to chunk of the continuous data.
+		//Only occurrences that start before the ullOffsetStartEnd are added to the vecHit.
+		void Search(SpanCByte spnData, ULONGLONG ullOffset, ULONGLONG ullOffsetStartEnd, std::uint32_t& refState,
+			std::vector<HEXPATTERNHIT>& vecHit)const;
+	private:
+		[[nodiscard]] auto FindEdge(std::uint32_t u32State, std::uint8_t u8Byte)const->std::uint32_t;
+		template<bool fDense>
+		void SearchImpl(SpanCByte spnData, ULONGLONG ullOffset, ULONGLONG ullOffsetStartEnd, std::uint32_t& refState,
+			std::vector<HEXPATTERNHIT>& vecHit)const;
+	private:
+		static constexpr auto m_u32None { 0xFFFFFFFFU };
+		static constexpr auto m_sDenseMax { 1024U * 1024U * 16U }; //Max transitions in the dense DFA table.
+		std::array<std::uint8_t, 256> m_arrClass { };     //Byte to byte class, bytes absent in patterns share the class 0.
+		std::array<std::uint32_t, 256> m_arrRoot { };     //Complete transitions of the root state.
+		std::vector<std::uint32_t> m_vecDense;            //Dense DFA table, m_u32Classes transitions per state.
+		std::vector<std::uint32_t> m_vecEdgeFirst;        //Index of the state's first edge, m_vecEdgeFirst[state + 1] is the end.
+		std::vector<std::uint8_t> m_vecEdgeByte;          //Trie edges' bytes, sorted per state.
+		std::vector<std::uint32_t> m_vecEdgeTarget;       //Trie edges' target states.
+		std::vector<std::uint32_t> m_vecFail;             //Failure link of every state.
+		std::vector<std::uint32_t> m_vecOutFirst;         //The state itself or its nearest failure state, that has patterns.
+		std::vector<std::uint32_t> m_vecStatePattern;     //First pattern that ends at the state.
+		std::vector<std::uint32_t> m_vecPatternNext;      //Next pattern that ends at the same state, for duplicates.
+		std::vector<std::uint32_t> m_vecPatternSize;
+		std::uint32_t m_u32Classes { };
+		std::size_t m_sMaxPatternSize { };
+	};
+
+	CHexAhoCorasick::CHexAhoCorasick(const std::vector<std::vector<std::byte>>& vecPattern)
+	{
+		//Byte classes: every byte present in patterns gets its own class.
+		std::array<bool, 256> arrUsed { };
+		for (const auto& vecPatt : vecPattern) {
+			for (const auto byte : vecPatt) {
+				arrUsed[static_cast<std::uint8_t>(byte)] = true;
+			}
+		}
+		const auto fAllUsed = std::ranges::all_of(arrUsed, [](bool fUsed) { return fUsed; });
+		m_u32Classes = fAllUsed ? 0 : 1; //The class 0 is not needed if all bytes are used.
+		for (auto i { 0U }; i < 256U; ++i) {
+			m_arrClass[i] = arrUsed[i] ? static_cast<std::uint8_t>(m_u32Classes++) : 0;
+		}
+
+		//Trie.
+		std::vector<std::vector<std::pair<std::uint8_t, std::uint32_t>>> vecTrie(1);
+		const auto lmbChild = [&vecTrie](std::uint32_t u32State, std::uint8_t u8Byte) {
+			const auto& vecEdge = vecTrie[u32State];
+			const auto it = std::find_if(vecEdge.begin(), vecEdge.end(), [u8Byte](const auto& ref) { return ref.first == u8Byte; });
+			return it == vecEdge.end() ? m_u32None : it->second;
+			};
+		m_vecStatePattern.emplace_back(m_u32None);
+		m_vecPatternNext.assign(vecPattern.size(), m_u32None);
+		m_vecPatternSize.resize(vecPattern.size());
+		for (auto uPatt { 0U }; uPatt < vecPattern.size(); ++uPatt) {
+			const auto& vecPatt = vecPattern[uPatt];
+			m_vecPatternSize[uPatt] = static_cast<std::uint32_t>(vecPatt.size());
+			if (vecPatt.empty())
+				continue;
+
+			m_sMaxPatternSize = (std::max)(m_sMaxPatternSize, vecPatt.size());
+			std::uint32_t u32State { 0 };
+			for (const auto byte : vecPatt) {
+				const auto u8Byte = static_cast<std::uint8_t>(byte);
+				auto u32Next = lmbChild(u32State, u8Byte);
+				if (u32Next == m_u32None) {
+					u32Next = static_cast<std::uint32_t>(vecTrie.size());
+					vecTrie[u32State].emplace_back(u8Byte, u32Next);
+					vecTrie.emplace_back();
+					m_vecStatePattern.emplace_back(m_u32None);
+				}
+				u32State = u32Next;
+			}
+
+			//Patterns of the same state are chained in the order of their indexes.
+			auto* pLink = &m_vecStatePattern[u32State];
+			while (*pLink != m_u32None) {
+				pLink = &m_vecPatternNext[*pLink];
+			}
+			*pLink = uPatt;
+		}
+
+		//Flat sorted edges.
+		const auto sStates = vecTrie.size();
+		m_vecEdgeFirst.reserve(sStates + 1);
+		for (auto& vecEdge : vecTrie) {
+			std::sort(vecEdge.begin(), vecEdge.end());
+			m_vecEdgeFirst.emplace_back(static_cast<std::uint32_t>(m_vecEdgeByte.size()));
+			for (const auto& [u8Byte, u32Target] : vecEdge) {
+				m_vecEdgeByte.emplace_back(u8Byte);
+				m_vecEdgeTarget.emplace_back(u32Target);
+			}
+		}
+		m_vecEdgeFirst.emplace_back(static_cast<std::uint32_t>(m_vecEdgeByte.size()));
+		vecTrie = { };
+
+		//Failure links in the breadth-first order, every state's failure state is shallower than the state itself.
+		m_vecFail.assign(sStates, 0);
+		m_vecOutFirst.assign(sStates, m_u32None);
+		std::vector<std::uint32_t> vecOrder;
+		vecOrder.reserve(sStates);
+		vecOrder.emplace_back(0);
+		for (std::size_t sIndex { 0 }; sIndex < vecOrder.size(); ++sIndex) {
+			const auto u32State = vecOrder[sIndex];
+			for (auto uEdge = m_vecEdgeFirst[u32State]; uEdge < m_vecEdgeFirst[u32State + 1]; ++uEdge) {
+				const auto u8Byte = m_vecEdgeByte[uEdge];
+				const auto u32Child = m_vecEdgeTarget[uEdge];
+				if (u32State != 0) {
+					auto u32Fail = m_vecFail[u32State];
+					while (u32Fail != 0 && FindEdge(u32Fail, u8Byte) == m_u32None) {
+						u32Fail = m_vecFail[u32Fail];
+					}
+					const auto u32Target = FindEdge(u32Fail, u8Byte);
+					m_vecFail[u32Child] = u32Target == m_u32None ? 0 : u32Target;
+				}
+				m_vecOutFirst[u32Child] = m_vecStatePattern[u32Child] != m_u32None ? u32Child : m_vecOutFirst[m_vecFail[u32Child]];
+				vecOrder.emplace_back(u32Child);
+			}
+		}
+
+		for (auto i { 0U }; i < 256U; ++i) {
+			const auto u32Target = FindEdge(0, static_cast<std::uint8_t>(i));
+			m_arrRoot[i] = u32Target == m_u32None ? 0 : u32Target;
+		}
+
+		if (sStates * m_u32Classes > m_sDenseMax)
+			return;
+
+		//Dense DFA, the missing transitions are taken from the failure state's row, that is already complete.
+		std::array<std::uint8_t, 256> arrClassByte { }; //Representative byte of every class.
+		for (auto i { 0U }; i < 256U; ++i) {
+			arrClassByte[m_arrClass[i]] = static_cast<std::uint8_t>(i);
+		}
+		m_vecDense.resize(sStates * m_u32Classes);
+		for (const auto u32State : vecOrder) {
+			const auto pRow = m_vecDense.data() + (static_cast<std::size_t>(u32State) * m_u32Classes);
+			const auto pRowFail = m_vecDense.data() + (static_cast<std::size_t>(m_vecFail[u32State]) * m_u32Classes);
+			for (auto uClass { 0U }; uClass < m_u32Classes; ++uClass) {
+				const auto u32Target = u32State == 0 ? m_arrRoot[arrClassByte[uClass]] : FindEdge(u32State, arrClassByte[uClass]);
+				pRow[uClass] = u32Target != m_u32None ? u32Target : pRowFail[uClass];
+			}
+		}
+	}
+
+	auto CHexAhoCorasick::GetMaxPatternSize()const->std::size_t
+	{
+		return m_sMaxPatternSize;
+	}
+
+	void CHexAhoCorasick::Search(SpanCByte spnData, ULONGLONG ullOffset, ULONGLONG ullOffsetStartEnd, std::uint32_t& refState,
+		std::vector<HEXPATTERNHIT>& vecHit)const
+	{
+		if (m_vecDense.empty()) {
+			SearchImpl<false>(spnData, ullOffset, ullOffsetStartEnd, refState, vecHit);
+		}
+		else {
+			SearchImpl<true>(spnData, ullOffset, ullOffsetStartEnd, refState, vecHit);
+		}
+	}
+
+
+	//Private methods.
+
+	auto CHexAhoCorasick::FindEdge(std::uint32_t u32State, std::uint8_t u8Byte)const->std::uint32_t
+	{
+		const auto itBegin = m_vecEdgeByte.begin() + m_vecEdgeFirst[u32State];
+		const auto itEnd = m_vecEdgeByte.begin() + m_vecEdgeFirst[u32State + 1];
+		const auto it = std::lower_bound(itBegin, itEnd, u8Byte);
+		return (it == itEnd || *it != u8Byte) ? m_u32None : m_vecEdgeTarget[static_cast<std::size_t>(it - m_vecEdgeByte.begin())];
+	}
+
+	template<bool fDense>
+	void CHexAhoCorasick::SearchImpl(SpanCByte spnData, ULONGLONG ullOffset, ULONGLONG ullOffsetStartEnd, std::uint32_t& refState,
+		std::vector<HEXPATTERNHIT>& vecHit)const
+	{
+		const auto pData = reinterpret_cast<const std::uint8_t*>(spnData.data());
+		const auto pDense = m_vecDense.data();
+		const auto pOutFirst = m_vecOutFirst.data();
+		auto u32State = refState;
+		for (std::size_t i { 0 }; i < spnData.size(); ++i) {
+			const auto u8Byte = pData[i];
+			if constexpr (fDense) {
+				u32State = pDense[(static_cast<std::size_t>(u32State) * m_u32Classes) + m_arrClass[u8Byte]];
+			}
+			else {
+				auto u32Next = m_u32None;
+				while (u32State != 0 && (u32Next = FindEdge(u32State, u8Byte)) == m_u32None) {
+					u32State = m_vecFail[u32State];
+				}
+				u32State = u32State == 0 ? m_arrRoot[u8Byte] : u32Next;
+			}
+
+			if (pOutFirst[u32State] == m_u32None) [[likely]]
+				continue;
+
+			//All the patterns that end at this byte: the state's own and its failure states' ones.
+			const auto ullOffsetEnd = ullOffset + i + 1;
+			for (auto u32Out = pOutFirst[u32State]; u32Out != m_u32None; u32Out = pOutFirst[m_vecFail[u32Out]]) {
+				for (auto u32Patt = m_vecStatePattern[u32Out]; u32Patt != m_u32None; u32Patt = m_vecPatternNext[u32Patt]) {
+					const auto ullOffsetStart = ullOffsetEnd - m_vecPatternSize[u32Patt];
+					if (ullOffsetStart < ullOffsetStartEnd) {
+						vecHit.emplace_back(ullOffsetStart, u32Patt);
+					}
+				}
+			}
+		}
+		refState = u32State;
+	}
+}
\ No newline at end of file
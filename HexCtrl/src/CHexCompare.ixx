@@ -0,0 +1,176 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <intrin.h>
+export module HEXCTRL.CHexCompare;
+
+import HEXCTRL.HexUtility;
+
+namespace HEXCTRL::INTERNAL {
+	//Ranges of the differing bytes of two data, position by position.
+	//Parts are compared independently, in the offsets order within a part, and then merged in the parts order.
+	//Differences that are at most m_dwMergeGap equal bytes apart are merged into one range.
+	export class CHexCompare final {
+	public:
+		explicit CHexCompare(DWORD dwMergeGap = 0) : m_dwMergeGap(dwMergeGap) { }
+		void Add(SpanCByte spnData, SpanCByte spnOther, ULONGLONG ullOffset); //Equal size data at the ullOffset.
+		void AddDiff(HEXSPAN hss); //Range that differs as a whole, like the longer data's tail.
+		[[nodiscard]] auto GetResult()const->const VecSpan&;
+		void Merge(const CHexCompare& rhs); //The rhs part must follow this one.
+		[[nodiscard]] static auto FindMatch(const std::byte* pData, const std::byte* pOther, std::size_t sSize)->std::size_t;
+		[[nodiscard]] static auto FindMismatch(const std::byte* pData, const std::byte* pOther, std::size_t sSize)->std::size_t;
+	private:
+		VecSpan m_vecDiff;
+		DWORD m_dwMergeGap { };
+	};
+
+	void CHexCompare::Add(SpanCByte spnData, SpanCByte spnOther, ULONGLONG ullOffset)
+	{
+		assert(spnData.size() == spnOther.size());
+		const auto sSize = (std::min)(spnData.size(), spnOther.size());
+		const auto pData = spnData.data();
+		const auto pOther = spnOther.data();
+		std::size_t sPos { 0 };
+		while (sPos < sSize) {
+			sPos += FindMismatch(pData + sPos, pOther + sPos, sSize - sPos);
+			if (sPos == sSize)
+				break;
+
+			const auto sEnd = sPos + FindMatch(pData + sPos, pOther + sPos, sSize - sPos);
+			AddDiff({ .ullOffset { ullOffset + sPos }, .ullSize { sEnd - sPos } });
+			sPos = sEnd;
+		}
+	}
+
+	void CHexCompare::AddDiff(HEXSPAN hss)
+	{
+		if (hss.ullSize == 0)
+			return;
+
+		if (!m_vecDiff.empty()) {
+			auto& refBack = m_vecDiff.back();
+			const auto ullBackEnd = refBack.ullOffset + refBack.ullSize;
+			assert(hss.ullOffset >= ullBackEnd);
+			if (hss.ullOffset - ullBackEnd <= m_dwMergeGap) {
+				refBack.ullSize = hss.ullOffset + hss.ullSize - refBack.ullOffset;
+				return;
+			}
+		}
+
+		m_vecDiff.emplace_back(hss);
+	}
+
+	auto CHexCompare::GetResult()const->const VecSpan&
+	{
+		return m_vecDiff;
+	}
+
+	void CHexCompare::Merge(const CHexCompare& rhs)
+	{
+		for (const auto& hss : rhs.m_vecDiff) {
+			AddDiff(hss);
+		}
+	}
+
+	auto CHexCompare::FindMatch(const std::byte* pData, const std::byte* pOther, std::size_t sSize)->std::size_t
+	{
+		//Differences are usually short, so it's a vector at a time.
+		std::size_t i { 0 };
+	#if defined(_M_IX86) || defined(_M_X64)
+		if (ut::HasAVX2()) {
+			for (; i + sizeof(__m256i) <= sSize; i += sizeof(__m256i)) {
+				const auto uMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + i)),
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pOther + i)))));
+				if (uMask != 0)
+					return i + std::countr_zero(uMask);
+			}
+		}
+
+		for (; i + sizeof(__m128i) <= sSize; i += sizeof(__m128i)) {
+			const auto uMask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(pOther + i)))));
+			if (uMask != 0)
+				return i + std::countr_zero(uMask);
+		}
+	#endif //^^^ _M_IX86 || _M_X64
+
+		for (; i < sSize; ++i) { //Remainder.
+			if (pData[i] == pOther[i])
+				return i;
+		}
+
+		return sSize;
+	}
+
+	auto CHexCompare::FindMismatch(const std::byte* pData, const std::byte* pOther, std::size_t sSize)->std::size_t
+	{
+		//Equal data is the hot path, four vectors are compared at once, and the mismatch is then found
+		//within them vector by vector. Without SIMD the data is compared by the eight bytes words.
+		std::size_t i { 0 };
+	#if defined(_M_IX86) || defined(_M_X64)
+		if (ut::HasAVX2()) {
+			for (; i + (sizeof(__m256i) * 4) <= sSize; i += sizeof(__m256i) * 4) {
+				const auto lmbCmp = [=](std::size_t sOffset) {
+					return _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + i + sOffset)),
+						_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pOther + i + sOffset)));
+					};
+				const auto m256iEq = _mm256_and_si256(_mm256_and_si256(lmbCmp(0), lmbCmp(32)),
+					_mm256_and_si256(lmbCmp(64), lmbCmp(96)));
+				if (_mm256_movemask_epi8(m256iEq) != -1)
+					break;
+			}
+
+			for (; i + sizeof(__m256i) <= sSize; i += sizeof(__m256i)) {
+				const auto uMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + i)),
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pOther + i)))));
+				if (uMask != 0xFFFFFFFFU)
+					return i + std::countr_one(uMask);
+			}
+		}
+
+		for (; i + (sizeof(__m128i) * 4) <= sSize; i += sizeof(__m128i) * 4) {
+			const auto lmbCmp = [=](std::size_t sOffset) {
+				return _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i + sOffset)),
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(pOther + i + sOffset)));
+				};
+			const auto m128iEq = _mm_and_si128(_mm_and_si128(lmbCmp(0), lmbCmp(16)), _mm_and_si128(lmbCmp(32), lmbCmp(48)));
+			if (_mm_movemask_epi8(m128iEq) != 0xFFFF)
+				break;
+		}
+
+		for (; i + sizeof(__m128i) <= sSize; i += sizeof(__m128i)) {
+			const auto uMask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(pOther + i)))));
+			if (uMask != 0xFFFFU)
+				return i + std::countr_one(uMask);
+		}
+	#else  //^^^ _M_IX86 || _M_X64 / vvv !_M_IX86 && !_M_X64
+		for (; i + sizeof(std::uint64_t) <= sSize; i += sizeof(std::uint64_t)) {
+			const auto u64Diff = ut::LoadTData<std::uint64_t>(pData + i, false) ^ ut::LoadTData<std::uint64_t>(pOther + i, false);
+			if (u64Diff != 0)
+				return i + (std::countr_zero(u64Diff) / 8);
+		}
+	#endif //^^^ !_M_IX86 && !_M_X64
+
+		for (; i < sSize; ++i) { //Remainder.
+			if (pData[i] != pOther[i])
+				return i;
+		}
+
+		return sSize;
+	}
+}
\ No newline at end of file
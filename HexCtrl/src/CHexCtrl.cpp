@@ -11,12 +11,15 @@
 #include "Dialogs/CHexDlgCodepage.h"
 #include "Dialogs/CHexDlgDataInterp.h"
 #include "Dialogs/CHexDlgGoTo.h"
+#include "Dialogs/CHexDlgHash.h"
 #include "Dialogs/CHexDlgModify.h"
 #include "Dialogs/CHexDlgSearch.h"
 #include "Dialogs/CHexDlgTemplMgr.h"
 #include <algorithm>
+#include <barrier>
 #include <bit>
 #include <cassert>
+#include <cmath>
 #include <cwctype>
 #include <format>
 #include <fstream>
@@ -29,6 +32,17 @@
 import HEXCTRL.CHexScroll;
 import HEXCTRL.CHexSelection;
 import HEXCTRL.CHexDlgProgress;
+import HEXCTRL.CHexAhoCorasick;
+import HEXCTRL.CHexCompare;
+import HEXCTRL.CHexDiff;
+import HEXCTRL.CHexEntropy;
+import HEXCTRL.CHexHash;
+import HEXCTRL.CHexParallel;
+import HEXCTRL.CHexReader;
+import HEXCTRL.CHexSearchCache;
+import HEXCTRL.CHexSearchIndex;
+import HEXCTRL.CHexStats;
+import HEXCTRL.CHexStrings;
 
 using namespace HEXCTRL::INTERNAL;
 
@@ -36,6 +50,10 @@ HEXCTRLAPI HEXCTRL::IHexCtrlPtr HEXCTRL::CreateHexCtrl() {
 	return IHexCtrlPtr { new HEXCTRL::INTERNAL::CHexCtrl() };
 }
 
+HEXCTRLAPI auto HEXCTRL::HexStrToBytes(std::wstring_view wsvHex, wchar_t wchWildcard)->std::optional<HEXBYTES> {
+	return ut::HexStrToBytes(wsvHex, wchWildcard);
+}
+
 namespace HEXCTRL::INTERNAL {
 	class CHexDlgAbout final {
 	public:
@@ -60,6 +78,27 @@ namespace HEXCTRL::INTERNAL {
 		bool m_fLinkUnderline { };
 		bool m_fLBDownLink { }; //Left button was pressed on the link static control.
 	};
+
+	//Keystream transform for the EHexModifyMode::MODIFY_KEYSTREAM mode.
+	//Data is fed chunk by chunk, the stream state is carried over from one chunk to the next.
+	class CKeyStream final {
+	public:
+		CKeyStream(EHexKeyStream eKeyStream, SpanCByte spnKey);
+		void Apply(SpanByte spnData); //XOR the next spnData.size() bytes with the stream.
+	private:
+		void FillKeyRepeat(std::byte* pStream, std::size_t sSize); //Fill with the repeated key from the current position.
+	private:
+		static constexpr auto m_uSizeBlock { 1024U * 64U };  //Size of the one stream block.
+		std::vector<std::byte> m_vecKeyExt;  //Key repeated to a multiple of the key size, for the block copy.
+		std::vector<std::byte> m_vecStream;  //Stream block buffer.
+		std::size_t m_sSizeKey { };          //Key size.
+		ULONGLONG m_ullPos { };              //Current position in the stream.
+		EHexKeyStream m_eKeyStream { };
+		std::byte m_bytePrev { };            //Previous original data byte, for KEYSTREAM_ROLLXOR.
+		std::uint8_t m_arrRC4S[256] { };     //RC4 state.
+		std::uint8_t m_u8RC4I { };           //RC4 "i" index.
+		std::uint8_t m_u8RC4J { };           //RC4 "j" index.
+	};
 }
 
 auto CHexDlgAbout::DoModal(HWND hWndParent)->INT_PTR {
@@ -202,6 +241,111 @@ auto CHexDlgAbout::OnMouseMove(const MSG& msg)->INT_PTR
 	return TRUE;
 }
 
+
+//CKeyStream.
+
+CKeyStream::CKeyStream(EHexKeyStream eKeyStream, SpanCByte spnKey) : m_sSizeKey(spnKey.size()), m_eKeyStream(eKeyStream)
+{
+	assert(!spnKey.empty());
+	if (spnKey.empty())
+		return;
+
+	//Extended key is at least m_uSizeBlock + key size long, and is a multiple of the key size.
+	//So, a whole block can be copied or XORed in one go from any key phase position.
+	const auto sKeyRounds = (m_uSizeBlock / m_sSizeKey) + 2;
+	m_vecKeyExt.reserve(sKeyRounds * m_sSizeKey);
+	for (auto iter = 0U; iter < sKeyRounds; ++iter) {
+		m_vecKeyExt.insert(m_vecKeyExt.end(), spnKey.begin(), spnKey.end());
+	}
+
+	using enum EHexKeyStream;
+	if (m_eKeyStream != KEYSTREAM_XOR) {
+		m_vecStream.resize(m_uSizeBlock);
+	}
+
+	if (m_eKeyStream == KEYSTREAM_RC4) { //RC4 Key-scheduling algorithm.
+		std::iota(std::begin(m_arrRC4S), std::end(m_arrRC4S), static_cast<std::uint8_t>(0));
+		std::uint8_t u8J { 0 };
+		for (auto iter = 0U; iter < 256U; ++iter) {
+			u8J += m_arrRC4S[iter] + static_cast<std::uint8_t>(spnKey[iter % m_sSizeKey]);
+			std::swap(m_arrRC4S[iter], m_arrRC4S[u8J]);
+		}
+	}
+}
+
+void CKeyStream::Apply(SpanByte spnData)
+{
+	if (m_vecKeyExt.empty())
+		return;
+
+	using enum EHexKeyStream;
+	auto pData = spnData.data();
+	auto sSizeRem = spnData.size();
+	while (sSizeRem > 0) {
+		const auto sSizeBlock = (std::min)(sSizeRem, static_cast<std::size_t>(m_uSizeBlock));
+		switch (m_eKeyStream) {
+		case KEYSTREAM_XOR: //Data is XORed straight with the extended key, no intermediate stream.
+			ut::XorBytes(pData, m_vecKeyExt.data() + static_cast<std::size_t>(m_ullPos % m_sSizeKey), sSizeBlock);
+			break;
+		case KEYSTREAM_ROLLXOR:
+		{
+			const auto pStream = m_vecStream.data();
+			FillKeyRepeat(pStream, sSizeBlock);
+			pStream[0] ^= m_bytePrev;
+			ut::XorBytes(pStream + 1, pData, sSizeBlock - 1); //Stream[i] ^= Data[i - 1].
+			m_bytePrev = pData[sSizeBlock - 1]; //Original byte, before it's modified below.
+			ut::XorBytes(pData, pStream, sSizeBlock);
+		}
+		break;
+		case KEYSTREAM_COUNTER:
+		{
+			const auto pStream = m_vecStream.data();
+			FillKeyRepeat(pStream, sSizeBlock);
+			auto ullRound = m_ullPos / m_sSizeKey;
+			auto sKeyPhase = static_cast<std::size_t>(m_ullPos % m_sSizeKey);
+			for (auto iter = 0ULL; iter < sSizeBlock; ++iter) {
+				pStream[iter] = static_cast<std::byte>(static_cast<std::uint8_t>(pStream[iter]) + static_cast<std::uint8_t>(ullRound));
+				if (++sKeyPhase == m_sSizeKey) {
+					sKeyPhase = 0;
+					++ullRound;
+				}
+			}
+			ut::XorBytes(pData, pStream, sSizeBlock);
+		}
+		break;
+		case KEYSTREAM_RC4:
+		{
+			const auto pStream = m_vecStream.data();
+			auto u8I = m_u8RC4I;
+			auto u8J = m_u8RC4J;
+			for (auto iter = 0ULL; iter < sSizeBlock; ++iter) { //RC4 Pseudo-random generation algorithm.
+				++u8I;
+				u8J += m_arrRC4S[u8I];
+				std::swap(m_arrRC4S[u8I], m_arrRC4S[u8J]);
+				pStream[iter] = static_cast<std::byte>(m_arrRC4S[static_cast<std::uint8_t>(m_arrRC4S[u8I] + m_arrRC4S[u8J])]);
+			}
+			m_u8RC4I = u8I;
+			m_u8RC4J = u8J;
+			ut::XorBytes(pData, pStream, sSizeBlock);
+		}
+		break;
+		default:
+			return;
+		}
+
+		m_ullPos += sSizeBlock;
+		pData += sSizeBlock;
+		sSizeRem -= sSizeBlock;
+	}
+}
+
+void CKeyStream::FillKeyRepeat(std::byte* pStream, std::size_t sSize)
+{
+	assert(sSize <= m_uSizeBlock);
+	std::copy_n(m_vecKeyExt.data() + static_cast<std::size_t>(m_ullPos % m_sSizeKey), sSize, pStream);
+}
+
+
 //CHexCtrl.
 
 enum class CHexCtrl::EClipboard : std::uint8_t {
@@ -256,6 +400,7 @@ void CHexCtrl::ClearData()
 	if (!IsCreated())
 		return;
 
+	m_pDlgSearch->CancelSearchAsync();
 	m_spnData = { };
 	m_fDataSet = false;
 	m_fMutable = false;
@@ -267,6 +412,10 @@ void CHexCtrl::ClearData()
 	m_ullCursorNow = 0;
 	m_vecUndo.clear();
 	m_vecRedo.clear();
+	m_pEntropy->ClearAll();
+	m_pSearchIndex->ClearAll();
+	m_pSearchCache->ClearAll();
+	m_vecDiff.clear();
 	m_pScrollV->SetScrollPos(0);
 	m_pScrollH->SetScrollPos(0);
 	m_pScrollV->SetScrollSizes(0, 0, 0);
@@ -276,6 +425,86 @@ void CHexCtrl::ClearData()
 	Redraw();
 }
 
+auto CHexCtrl::CompareData(const HEXCOMPARE& hcs)->VecSpan
+{
+	assert(IsCreated());
+	if (!IsCreated())
+		return { };
+
+	m_vecDiff.clear();
+	const auto fOtherVirt = hcs.pHexVirtData != nullptr;
+	if (!IsDataSet() || (!fOtherVirt && hcs.spnData.empty()) || (fOtherVirt && hcs.dwCacheSize == 0)) {
+		Redraw(); //Differences are cleared.
+		return { };
+	}
+
+	//Parts are compared independently, in parallel if neither data is virtual, and merged in order at the end.
+	//The virtual data parts are of the cache sizes, so the whole part is got in one call.
+	const auto ullDataSize = GetDataSize();
+	const auto ullCmpSize = (std::min)(ullDataSize, fOtherVirt ? hcs.ullDataSize : hcs.spnData.size());
+	auto ullSizePartMax = 1024ULL * 1024ULL * 4ULL;
+	if (IsVirtual()) {
+		ullSizePartMax = GetCacheSize();
+	}
+	if (fOtherVirt) {
+		ullSizePartMax = (std::min)(ullSizePartMax, static_cast<ULONGLONG>(hcs.dwCacheSize));
+	}
+
+	const auto sParts = static_cast<std::size_t>((ullCmpSize + ullSizePartMax - 1) / ullSizePartMax);
+	std::vector<CHexCompare> vecCmp(sParts, CHexCompare(hcs.dwMergeGap));
+	CHexDlgProgress dlgProg(L"Comparing...", L"", 0, ullCmpSize);
+	CHexParallel par(this, &dlgProg);
+	const auto lmbGetOther = [&](HEXSPAN hss)->SpanCByte {
+		if (!fOtherVirt)
+			return hcs.spnData.subspan(static_cast<std::size_t>(hss.ullOffset), static_cast<std::size_t>(hss.ullSize));
+
+		HEXDATAINFO hdi { .hdr { m_Wnd, static_cast<UINT>(m_Wnd.GetDlgCtrlID()) }, .stHexSpan { hss } };
+		hcs.pHexVirtData->OnHexGetData(hdi);
+		return hdi.spnData;
+		};
+	const auto lmbComparePart = [&](std::size_t sIndex, CHexReader& refReader) {
+		const HEXSPAN hss { .ullOffset { sIndex * ullSizePartMax },
+			.ullSize { (std::min)(ullSizePartMax, ullCmpSize - (sIndex * ullSizePartMax)) } };
+		const auto spnOther = lmbGetOther(hss);
+		const auto spnData = refReader.GetData(hss);
+		assert(spnData.size() == hss.ullSize && spnOther.size() >= hss.ullSize);
+		const auto sSize = (std::min)({ spnData.size(), spnOther.size(), static_cast<std::size_t>(hss.ullSize) });
+		auto& refCmp = vecCmp[sIndex];
+		refCmp.Add(spnData.first(sSize), spnOther.first(sSize), hss.ullOffset);
+		refCmp.AddDiff({ .ullOffset { hss.ullOffset + sSize }, .ullSize { hss.ullSize - sSize } }); //Data not given.
+		par.AddProcessed(hss.ullSize);
+		};
+	const auto lmbCompare = [&]() {
+		par.Run(sParts, lmbComparePart, IsVirtual() || fOtherVirt, 0, ullCmpSize - 1);
+		dlgProg.OnCancel();
+		};
+
+	static constexpr auto uSizeToRunThread { 1024U * 1024U * 50U }; //50MB.
+	if (ullCmpSize > uSizeToRunThread) { //Spawning new thread only if data size is big enough.
+		std::thread thrd(lmbCompare);
+		dlgProg.DoModal(m_Wnd, m_hInstRes);
+		thrd.join();
+	}
+	else {
+		lmbCompare();
+	}
+
+	if (par.IsCanceled()) {
+		Redraw();
+		return { };
+	}
+
+	CHexCompare cmpAll(hcs.dwMergeGap);
+	for (const auto& refCmp : vecCmp) {
+		cmpAll.Merge(refCmp);
+	}
+	cmpAll.AddDiff({ .ullOffset { ullCmpSize }, .ullSize { ullDataSize - ullCmpSize } });
+	m_vecDiff = cmpAll.GetResult();
+	Redraw();
+
+	return m_vecDiff;
+}
+
 bool CHexCtrl::Create(const HEXCREATE& hcs)
 {
 	assert(!IsCreated()); //Already created.
@@ -442,9 +671,12 @@ bool CHexCtrl::Create(const HEXCREATE& hcs)
 	m_pDlgDataInterp->Initialize(this, m_hInstRes);
 	m_pDlgCodepage->Initialize(this, m_hInstRes);
 	m_pDlgGoTo->Initialize(this, m_hInstRes);
-	m_pDlgSearch->Initialize(this, m_hInstRes);
+	m_pDlgSearch->Initialize(this, m_hInstRes, m_pSearchIndex.get(), m_pSearchCache.get());
 	m_pDlgTemplMgr->Initialize(this, m_hInstRes);
 	m_pDlgModify->Initialize(this, m_hInstRes);
+	m_pDlgHash->Initialize(this, m_hInstRes);
+	m_pEntropy->Initialize(this);
+	m_pSearchIndex->Initialize(this);
 
 	return true;
 }
@@ -474,6 +706,123 @@ void CHexCtrl::DestroyWindow()
 	}
 }
 
+auto CHexCtrl::DiffData(const HEXCOMPARE& hcs)->std::vector<HEXDIFFOP>
+{
+	assert(IsCreated());
+	if (!IsCreated())
+		return { };
+
+	m_vecDiff.clear();
+	const auto fOtherVirt = hcs.pHexVirtData != nullptr;
+	if (!IsDataSet() || (!fOtherVirt && hcs.spnData.empty()) || (fOtherVirt && hcs.dwCacheSize == 0)) {
+		Redraw(); //Differences are cleared.
+		return { };
+	}
+
+	//The default block size is about the square root of the other data size, as in the rsync.
+	//In VirtualData mode a block must fit in the cache together with the next scan windows.
+	const auto ullDataSize = GetDataSize();
+	const auto ullSizeOther = fOtherVirt ? hcs.ullDataSize : static_cast<ULONGLONG>(hcs.spnData.size());
+	auto ullBlockSize = hcs.dwBlockSize > 0 ? static_cast<ULONGLONG>(hcs.dwBlockSize) :
+		std::clamp(static_cast<ULONGLONG>(std::sqrt(static_cast<double>(ullSizeOther))) & ~15ULL, 64ULL, 1024ULL * 1024ULL);
+	if (IsVirtual()) {
+		ullBlockSize = (std::min)(ullBlockSize, static_cast<ULONGLONG>(GetCacheSize() / 2));
+	}
+	if (fOtherVirt) {
+		ullBlockSize = (std::min)(ullBlockSize, static_cast<ULONGLONG>(hcs.dwCacheSize));
+	}
+
+	CHexDiff diff(static_cast<DWORD>(ullBlockSize), ullSizeOther);
+	const ULONGLONG ullBlock { diff.GetBlockSize() };
+	const auto lmbGetOther = [&](HEXSPAN hss)->SpanCByte {
+		if (!fOtherVirt)
+			return hcs.spnData.subspan(static_cast<std::size_t>(hss.ullOffset), static_cast<std::size_t>(hss.ullSize));
+
+		HEXDATAINFO hdi { .hdr { m_Wnd, static_cast<UINT>(m_Wnd.GetDlgCtrlID()) }, .stHexSpan { hss } };
+		hcs.pHexVirtData->OnHexGetData(hdi);
+		return hdi.spnData;
+		};
+
+	//The other data's whole blocks are indexed by the parts of the whole blocks, then the data's scan windows
+	//are scanned by the parts. Both are done in parallel, if the data is not virtual.
+	static constexpr auto ullSizePartMax { 1024ULL * 1024ULL * 4ULL };
+	const auto ullSizeIndex = (ullSizeOther / ullBlock) * ullBlock;
+	const auto ullSizeIndexPart = fOtherVirt ? (hcs.dwCacheSize / ullBlock) * ullBlock :
+		(std::max)(ullBlock, (ullSizePartMax / ullBlock) * ullBlock);
+	const auto sPartsIndex = static_cast<std::size_t>((ullSizeIndex + ullSizeIndexPart - 1) / ullSizeIndexPart);
+	const auto ullPosEnd = ullDataSize >= ullBlock ? ullDataSize - ullBlock + 1 : 0ULL; //Scan windows' starts end.
+	const auto sPartsScan = static_cast<std::size_t>((ullPosEnd + ullSizePartMax - 1) / ullSizePartMax);
+	const auto ullSizeChunk = IsVirtual() ? static_cast<ULONGLONG>(GetCacheSize()) : ullSizePartMax + ullBlock - 1;
+	std::vector<std::vector<CHexDiff::MATCH>> vecMatchPart(sPartsScan);
+	CHexDlgProgress dlgProg(L"Comparing...", L"", 0, ullSizeIndex + ullPosEnd);
+	CHexParallel par(this, &dlgProg);
+	const auto lmbIndexPart = [&](std::size_t sIndex, CHexReader& /*refReader*/) {
+		const HEXSPAN hss { .ullOffset { sIndex * ullSizeIndexPart },
+			.ullSize { (std::min)(ullSizeIndexPart, ullSizeIndex - (sIndex * ullSizeIndexPart)) } };
+		const auto spnOther = lmbGetOther(hss);
+		assert(spnOther.size() >= hss.ullSize);
+		diff.AddBlocks(spnOther.first((std::min)(spnOther.size(), static_cast<std::size_t>(hss.ullSize))), hss.ullOffset);
+		par.AddProcessed(hss.ullSize);
+		};
+	const auto lmbScanPart = [&](std::size_t sIndex, CHexReader& refReader) {
+		const auto ullPartStart = sIndex * ullSizePartMax;
+		const auto ullPartEnd = (std::min)(ullPartStart + ullSizePartMax, ullPosEnd);
+		auto ullPos = ullPartStart;
+		while (ullPos < ullPartEnd) {
+			const auto ullPosPrev = ullPos;
+			const auto spnData = refReader.GetData({ ullPos, (std::min)(ullSizeChunk, ullDataSize - ullPos) });
+			diff.Scan(spnData, ullPos, ullPos, ullPartEnd, vecMatchPart[sIndex]);
+			if (ullPos == ullPosPrev) //No data.
+				break;
+		}
+		par.AddProcessed(ullPartEnd - ullPartStart);
+		};
+	const auto lmbDiff = [&]() {
+		par.Run(sPartsIndex, lmbIndexPart, fOtherVirt);
+		if (!par.IsCanceled()) {
+			diff.BuildIndex();
+			par.Run(sPartsScan, lmbScanPart, IsVirtual());
+		}
+		dlgProg.OnCancel();
+		};
+
+	static constexpr auto uSizeToRunThread { 1024U * 1024U * 50U }; //50MB.
+	if (ullSizeIndex + ullPosEnd > uSizeToRunThread) { //Spawning new thread only if data size is big enough.
+		std::thread thrd(lmbDiff);
+		dlgProg.DoModal(m_Wnd, m_hInstRes);
+		thrd.join();
+	}
+	else {
+		lmbDiff();
+	}
+
+	if (par.IsCanceled()) {
+		Redraw();
+		return { };
+	}
+
+	std::vector<CHexDiff::MATCH> vecMatch;
+	for (auto& refVec : vecMatchPart) {
+		vecMatch.insert(vecMatch.end(), refVec.begin(), refVec.end());
+		std::vector<CHexDiff::MATCH>().swap(refVec);
+	}
+	vecMatch = CHexDiff::JoinMatches(std::move(vecMatch));
+
+	//The matches are extended by the small chunks, that fit in the caches of both data.
+	const auto ullSizeExtend = fOtherVirt ? (std::min)(1024ULL * 64ULL, static_cast<ULONGLONG>(hcs.dwCacheSize)) : 1024ULL * 64ULL;
+	CHexDiff::ExtendMatches(vecMatch, ullDataSize, ullSizeOther, ullSizeExtend,
+		[this](HEXSPAN hss)->SpanCByte { return GetData(hss); }, lmbGetOther);
+	auto vecOps = CHexDiff::ToOps(vecMatch, ullDataSize);
+	for (const auto& refOp : vecOps) {
+		if (refOp.eOp == EHexDiffOp::DIFF_INSERT) {
+			m_vecDiff.emplace_back(refOp.ullOffset, refOp.ullSize);
+		}
+	}
+	Redraw();
+
+	return vecOps;
+}
+
 void CHexCtrl::ExecuteCmd(EHexCmd eCmd)
 {
 	assert(IsCreated());
@@ -700,9 +1049,45 @@ void CHexCtrl::ExecuteCmd(EHexCmd eCmd)
 		ParentNotify(HEXCTRL_MSG_DLGTEMPLMGR);
 		m_pDlgTemplMgr->ShowWindow(SW_SHOW);
 		break;
+	case CMD_HASH_DLG:
+		ParentNotify(HEXCTRL_MSG_DLGHASH);
+		m_pDlgHash->ShowWindow(SW_SHOW);
+		break;
+	case CMD_DIFF_NEXT:
+		GoToDiff(true);
+		break;
+	case CMD_DIFF_PREV:
+		GoToDiff(false);
+		break;
 	}
 }
 
+auto CHexCtrl::ExtractStrings(const HEXSTRINGS& hss)const->IHexSearchPtr
+{
+	assert(IsCreated());
+	assert(IsDataSet());
+	if (!IsCreated() || !IsDataSet())
+		return { };
+
+	const auto ullDataSize = GetDataSize();
+	const auto ullRngStart = hss.stRange.ullOffset;
+	if (hss.dwMinLength == 0 || (!hss.FuncString && hss.wstrPath.empty()) || ullRngStart >= ullDataSize
+		|| (!hss.fASCII && !hss.fUTF8 && !hss.fUTF16LE && !hss.fUTF16BE)) {
+		ut::DBG_REPORT(L"Wrong HEXSTRINGS data.");
+		return { };
+	}
+
+	const auto ullRngEnd = hss.stRange.ullSize == 0 || hss.stRange.ullSize > ullDataSize - ullRngStart ?
+		ullDataSize - 1 : ullRngStart + hss.stRange.ullSize - 1;
+	const auto pStrings = new CHexStrings(this, hss, ullRngStart, ullRngEnd);
+	if (!pStrings->Run()) {
+		pStrings->Delete();
+		return { };
+	}
+
+	return IHexSearchPtr { pStrings };
+}
+
 int CHexCtrl::GetActualWidth()const
 {
 	assert(IsCreated());
@@ -840,6 +1225,39 @@ auto CHexCtrl::GetDlgItemHandle(EHexWnd eWnd, EHexDlgItem eItem)const->HWND
 	};
 }
 
+auto CHexCtrl::GetEntropy(DWORD dwBlockSize)->HEXENTROPY
+{
+	assert(IsCreated());
+	assert(IsDataSet());
+	assert(dwBlockSize > 0);
+	if (!IsCreated() || !IsDataSet() || dwBlockSize == 0)
+		return { };
+
+	//Only the blocks modified since the previous call are computed.
+	if (const auto ullSizeToUpdate = m_pEntropy->GetSizeToUpdate(dwBlockSize); ullSizeToUpdate > 0) {
+		CHexDlgProgress dlgProg(L"Analyzing...", L"", 0, ullSizeToUpdate);
+		const auto lmbUpdate = [&]() {
+			m_pEntropy->Update(dwBlockSize, dlgProg);
+			dlgProg.OnCancel();
+			};
+
+		static constexpr auto uSizeToRunThread { 1024U * 1024U * 50U }; //50MB.
+		if (ullSizeToUpdate > uSizeToRunThread) { //Spawning new thread only if data size is big enough.
+			std::thread thrd(lmbUpdate);
+			dlgProg.DoModal(m_Wnd, m_hInstRes);
+			thrd.join();
+		}
+		else {
+			lmbUpdate();
+		}
+	}
+
+	if (!m_pEntropy->IsUpdated(dwBlockSize)) //Canceled.
+		return { };
+
+	return m_pEntropy->GetEntropy();
+}
+
 auto CHexCtrl::GetFont()const->LOGFONTW
 {
 	assert(IsCreated());
@@ -936,6 +1354,71 @@ auto CHexCtrl::GetSelection()const->VecSpan
 	return m_pSelection->GetData();
 }
 
+auto CHexCtrl::GetStatistics(const VecSpan& vecSpan, EHexDataType eDataType, bool fBigEndian)const->HEXSTATS
+{
+	assert(IsCreated());
+	assert(IsDataSet());
+	if (!IsCreated() || !IsDataSet() || vecSpan.empty())
+		return { };
+
+	std::size_t sSizeType { 0 };
+	ut::VisitDataType(eDataType, [&]<typename T>(std::type_identity<T>) { sSizeType = sizeof(T); });
+	assert(sSizeType > 0);
+	if (sSizeType == 0)
+		return { };
+
+	//Every span is an array of its own, and is split into the parts of the whole elements.
+	//Parts are computed independently, in parallel in non-virtual mode, and merged in order at the end.
+	const auto ullSizeChunkMax = IsVirtual() ? static_cast<ULONGLONG>(GetCacheSize()) : 1024ULL * 1024ULL;
+	const auto ullSizePartMax = ullSizeChunkMax - (ullSizeChunkMax % sSizeType);
+	VecSpan vecPart;
+	for (const auto& hss : vecSpan) {
+		const auto ullOffsetEnd = (std::min)(hss.ullOffset + hss.ullSize, GetDataSize());
+		if (hss.ullOffset >= ullOffsetEnd)
+			continue;
+
+		const auto ullSizeSpan = (ullOffsetEnd - hss.ullOffset) - ((ullOffsetEnd - hss.ullOffset) % sSizeType);
+		for (auto ullOffsetCurr = hss.ullOffset; ullOffsetCurr < hss.ullOffset + ullSizeSpan; ullOffsetCurr += ullSizePartMax) {
+			vecPart.emplace_back(ullOffsetCurr, (std::min)(hss.ullOffset + ullSizeSpan - ullOffsetCurr, ullSizePartMax));
+		}
+	}
+
+	const auto ullTotalSize = std::reduce(vecPart.begin(), vecPart.end(), 0ULL,
+		[](ULONGLONG ullSumm, const HEXSPAN& ref) { return ullSumm + ref.ullSize; });
+	std::vector<CHexStats> vecStats(vecPart.size());
+	CHexDlgProgress dlgProg(L"Calculating...", L"", 0, ullTotalSize);
+	CHexParallel par(this, &dlgProg);
+	const auto lmbStatsPart = [&](std::size_t sIndex, CHexReader& refReader) {
+		const auto& hss = vecPart[sIndex];
+		vecStats[sIndex].Add(refReader.GetData(hss), eDataType, fBigEndian);
+		par.AddProcessed(hss.ullSize);
+		};
+	const auto lmbStats = [&]() {
+		par.Run(vecPart.size(), lmbStatsPart, IsVirtual());
+		dlgProg.OnCancel();
+		};
+
+	static constexpr auto uSizeToRunThread { 1024U * 1024U * 50U }; //50MB.
+	if (ullTotalSize > uSizeToRunThread) { //Spawning new thread only if data size is big enough.
+		std::thread thrd(lmbStats);
+		dlgProg.DoModal(m_Wnd, m_hInstRes);
+		thrd.join();
+	}
+	else {
+		lmbStats();
+	}
+
+	if (par.IsCanceled())
+		return { };
+
+	CHexStats stStats;
+	for (const auto& refStats : vecStats) {
+		stStats.Merge(refStats);
+	}
+
+	return stStats.GetResult();
+}
+
 auto CHexCtrl::GetTemplates()const->IHexTemplates*
 {
 	assert(IsCreated());
@@ -998,6 +1481,11 @@ auto CHexCtrl::GetWndHandle(EHexWnd eWnd, bool fCreate)const->HWND
 			m_pDlgTemplMgr->CreateDlg();
 		}
 		return m_pDlgTemplMgr->GetHWND();
+	case EHexWnd::DLG_HASH:
+		if (!IsWindow(m_pDlgHash->GetHWND()) && fCreate) {
+			m_pDlgHash->CreateDlg();
+		}
+		return m_pDlgHash->GetHWND();
 	default:
 		return { };
 	}
@@ -1048,6 +1536,147 @@ bool CHexCtrl::HasSelection()const
 	return m_pSelection->HasSelection();
 }
 
+auto CHexCtrl::HashData(const HEXHASH& hhs)const->std::vector<HEXDIGEST>
+{
+	assert(IsCreated());
+	assert(IsDataSet());
+	if (!IsCreated() || !IsDataSet() || hhs.vecSpan.empty() || hhs.vecHash.empty())
+		return { };
+
+	//Every stream holds its own set of hashers, that are independent of each other.
+	struct HASHSTREAM {
+		std::vector<HEXSPAN> vecSpan;
+		std::vector<std::unique_ptr<IHexHasher>> vecHasher;
+	};
+	std::vector<HASHSTREAM> vecStream;
+	const auto lmbAddStream = [&](std::vector<HEXSPAN>&& vecSpan) {
+		auto& refStream = vecStream.emplace_back(std::move(vecSpan));
+		for (const auto eHash : hhs.vecHash) {
+			refStream.vecHasher.emplace_back(CreateHasher(eHash));
+		}
+		};
+
+	if (hhs.fPerSpan) {
+		for (const auto& hss : hhs.vecSpan) {
+			lmbAddStream({ hss });
+		}
+	}
+	else {
+		lmbAddStream({ hhs.vecSpan.begin(), hhs.vecSpan.end() });
+	}
+
+	const auto ullTotalSize = std::reduce(hhs.vecSpan.begin(), hhs.vecSpan.end(), 0ULL,
+		[](ULONGLONG ullSumm, const HEXSPAN& ref) { return ullSumm + ref.ullSize; });
+	const auto ullSizeChunkMax = static_cast<ULONGLONG>(GetCacheSize());
+	const auto sHashers = hhs.vecHash.size();
+	CHexDlgProgress dlgProg(L"Hashing...", L"", 0, ullTotalSize);
+	CHexParallel par(this, &dlgProg);
+
+	//Stream's data is read by chunks, every chunk goes to the lmbUpdate.
+	const auto lmbReadStream = [&](const HASHSTREAM& refStream, CHexReader& refReader, const auto& lmbUpdate) {
+		for (const auto& hss : refStream.vecSpan) {
+			auto ullOffsetCurr = hss.ullOffset;
+			const auto ullOffsetEnd = (std::min)(hss.ullOffset + hss.ullSize, GetDataSize());
+			while (ullOffsetCurr < ullOffsetEnd) {
+				const auto ullSizeCurr = (std::min)(ullOffsetEnd - ullOffsetCurr, ullSizeChunkMax);
+				const auto spnData = refReader.GetData({ ullOffsetCurr, ullSizeCurr });
+				assert(!spnData.empty());
+				lmbUpdate(spnData);
+				ullOffsetCurr += ullSizeCurr;
+				par.AddProcessed(ullSizeCurr);
+				if (par.IsCanceled())
+					return;
+			}
+		}
+		};
+
+	//Every stream's data is read only once, and every chunk is hashed by all the stream's hashers.
+	//Concurrent data access is only allowed in non-virtual mode, the streams are then hashed in parallel.
+	//One stream, or the streams in virtual mode that are read one by one, has every chunk hashed
+	//by all the hashers simultaneously, by the workers created once.
+	const auto lmbHashStreams = [&]() {
+		par.Run(vecStream.size(), [&](std::size_t sIndex, CHexReader& refReader) {
+			const auto& refStream = vecStream[sIndex];
+			lmbReadStream(refStream, refReader, [&](SpanCByte spnData) {
+				for (const auto& pHasher : refStream.vecHasher) {
+					pHasher->Update(spnData);
+				}
+				});
+			}, false);
+		};
+
+	const auto lmbHashFanOut = [&]() {
+		//The barrier's phases: the chunk is set by the main worker, and then is hashed by all the workers.
+		const HASHSTREAM* pStreamCurr { };
+		SpanCByte spnDataCurr;
+		bool fDone { false };
+		std::barrier barrChunk(static_cast<std::ptrdiff_t>(sHashers));
+		const auto lmbHasherWorker = [&](std::size_t sHasher) {
+			while (true) {
+				barrChunk.arrive_and_wait();
+				if (fDone)
+					break;
+
+				pStreamCurr->vecHasher[sHasher]->Update(spnDataCurr);
+				barrChunk.arrive_and_wait();
+			}
+			};
+
+		std::vector<std::thread> vecThrd;
+		for (auto sHasher { 1U }; sHasher < sHashers; ++sHasher) {
+			vecThrd.emplace_back(lmbHasherWorker, sHasher);
+		}
+		par.Run(vecStream.size(), [&](std::size_t sIndex, CHexReader& refReader) {
+			const auto& refStream = vecStream[sIndex];
+			pStreamCurr = &refStream;
+			lmbReadStream(refStream, refReader, [&](SpanCByte spnData) {
+				spnDataCurr = spnData;
+				barrChunk.arrive_and_wait();
+				refStream.vecHasher.front()->Update(spnData);
+				barrChunk.arrive_and_wait();
+				});
+			}, IsVirtual());
+		fDone = true;
+		barrChunk.arrive_and_wait();
+		for (auto& thrd : vecThrd) {
+			thrd.join();
+		}
+		};
+
+	const auto lmbHash = [&]() {
+		if (IsVirtual() || vecStream.size() == 1) {
+			lmbHashFanOut();
+		}
+		else {
+			lmbHashStreams();
+		}
+		dlgProg.OnCancel();
+		};
+
+	static constexpr auto uSizeToRunThread { 1024U * 1024U * 50U }; //50MB.
+	if (ullTotalSize > uSizeToRunThread) { //Spawning new thread only if data size is big enough.
+		std::thread thrd(lmbHash);
+		dlgProg.DoModal(m_Wnd, m_hInstRes);
+		thrd.join();
+	}
+	else {
+		lmbHash();
+	}
+
+	if (par.IsCanceled())
+		return { };
+
+	std::vector<HEXDIGEST> vecDigest;
+	vecDigest.reserve(vecStream.size() * hhs.vecHash.size());
+	for (auto iStream { 0U }; iStream < vecStream.size(); ++iStream) {
+		for (auto iHash { 0U }; iHash < hhs.vecHash.size(); ++iHash) {
+			vecDigest.emplace_back(vecStream[iStream].vecHasher[iHash]->Final(), iStream, hhs.vecHash[iHash]);
+		}
+	}
+
+	return vecDigest;
+}
+
 auto CHexCtrl::HitTest(POINT pt, bool fScreen)const->std::optional<HEXHITTEST>
 {
 	assert(IsCreated());
@@ -1128,12 +1757,17 @@ bool CHexCtrl::IsCmdAvail(EHexCmd eCmd)const
 	case CMD_SEL_ALL:
 	case CMD_DATAINTERP_DLG:
 	case CMD_CLPBRD_COPY_OFFSET:
+	case CMD_HASH_DLG:
 		fAvail = fDataSet;
 		break;
 	case CMD_SEARCH_NEXT:
 	case CMD_SEARCH_PREV:
 		fAvail = m_pDlgSearch->IsSearchAvail();
 		break;
+	case CMD_DIFF_NEXT:
+	case CMD_DIFF_PREV:
+		fAvail = fDataSet && !m_vecDiff.empty();
+		break;
 	case CMD_NAV_PAGEBEG:
 	case CMD_NAV_PAGEEND:
 		fAvail = fDataSet && GetPagesCount() > 0;
@@ -1240,8 +1874,12 @@ void CHexCtrl::ModifyData(const HEXMODIFY& hms)
 	if (!IsMutable() || hms.vecSpan.empty())
 		return;
 
+	m_pDlgSearch->CancelSearchAsync();
 	m_vecRedo.clear(); //No Redo unless we make Undo.
 	SnapshotUndo(hms.vecSpan);
+	m_pEntropy->SetDirty(hms.vecSpan);
+	m_pSearchIndex->SetDirty(hms.vecSpan);
+	m_pSearchCache->SetDirty(hms.vecSpan);
 
 	SetRedraw(false);
 	using enum EHexModifyMode;
@@ -1461,6 +2099,9 @@ void CHexCtrl::ModifyData(const HEXMODIFY& hms)
 	#endif // ^^^ _M_ARM64
 	}
 	break;
+	case MODIFY_KEYSTREAM:
+		ModifyKeyStream(hms);
+		break;
 	default:
 		break;
 	}
@@ -1478,6 +2119,7 @@ bool CHexCtrl::PreTranslateMsg(MSG* pMsg)
 	if (m_pDlgCodepage->PreTranslateMsg(pMsg)) { return true; }
 	if (m_pDlgGoTo->PreTranslateMsg(pMsg)) { return true; }
 	if (m_pDlgTemplMgr->PreTranslateMsg(pMsg)) { return true; }
+	if (m_pDlgHash->PreTranslateMsg(pMsg)) { return true; }
 
 	return false;
 }
@@ -1556,6 +2198,119 @@ void CHexCtrl::Redraw()
 	m_Wnd.RedrawWindow();
 }
 
+auto CHexCtrl::SearchAsync(const HEXSEARCH& hss)const->IHexSearchPtr
+{
+	assert(IsCreated());
+	assert(IsDataSet());
+	if (!IsCreated() || !IsDataSet())
+		return { };
+
+	return m_pDlgSearch->SearchAsync(hss);
+}
+
+auto CHexCtrl::SearchPatterns(const HEXPATTERNS& hps)const->std::vector<HEXPATTERNHIT>
+{
+	assert(IsCreated());
+	assert(IsDataSet());
+	if (!IsCreated() || !IsDataSet() || hps.vecSpan.empty() || hps.dwLimit == 0)
+		return { };
+
+	const CHexAhoCorasick stAC(hps.vecPattern);
+	const auto ullMaxPattSize = static_cast<ULONGLONG>(stAC.GetMaxPatternSize());
+	if (ullMaxPattSize == 0)
+		return { };
+
+	//Every span is split into the partitions of the occurrences' start offsets, that are searched in parallel.
+	//Partition's data is read up to the (max pattern size - 1) bytes past its end, to find occurrences
+	//that cross the partitions' boundaries. The automaton's state is carried through the partition's chunks.
+	struct PATTPART {
+		ULONGLONG ullOffset { };     //First start offset.
+		ULONGLONG ullSize { };       //Start offsets count.
+		ULONGLONG ullOffsetEnd { };  //End of the data to search within.
+	};
+	static constexpr auto ullSizePartMax { 1024ULL * 1024ULL * 16ULL }; //16MB.
+	std::vector<PATTPART> vecPart;
+	ULONGLONG ullTotalSize { 0 };
+	for (const auto& hss : hps.vecSpan) {
+		const auto ullOffsetEnd = (std::min)(hss.ullOffset + hss.ullSize, GetDataSize());
+		if (hss.ullOffset >= ullOffsetEnd)
+			continue;
+
+		for (auto ullOffsetCurr = hss.ullOffset; ullOffsetCurr < ullOffsetEnd; ullOffsetCurr += ullSizePartMax) {
+			const auto ullSize = (std::min)(ullOffsetEnd - ullOffsetCurr, ullSizePartMax);
+			vecPart.emplace_back(ullOffsetCurr, ullSize, (std::min)(ullOffsetCurr + ullSize + ullMaxPattSize - 1, ullOffsetEnd));
+			ullTotalSize += ullSize;
+		}
+	}
+	if (vecPart.empty())
+		return { };
+
+	const auto ullSizeChunkMax = static_cast<ULONGLONG>(GetCacheSize());
+	const auto sParts = vecPart.size();
+	const auto sLimit = static_cast<std::size_t>(hps.dwLimit);
+	std::vector<std::vector<HEXPATTERNHIT>> vecPartHit(sParts);
+	CHexDlgProgress dlgProg(L"Searching...", L"", 0, ullTotalSize);
+	CHexParallel par(this, &dlgProg);
+	par.SetLimit(sLimit); //Partitions are taken in the ascending order, so the limit cuts off the latest ones.
+
+	const auto lmbSearchPart = [&](std::size_t sPart, CHexReader& refReader) {
+		const auto& refPart = vecPart[sPart];
+		const auto ullOffsetStartEnd = refPart.ullOffset + refPart.ullSize;
+		auto& refHit = vecPartHit[sPart];
+		auto ullOffsetEnd = refPart.ullOffsetEnd;
+		std::uint32_t u32State { 0 };
+		for (auto ullOffsetCurr = refPart.ullOffset; ullOffsetCurr < ullOffsetEnd && !par.IsPastLimit(sPart) && !par.IsCanceled();) {
+			const auto ullSize = (std::min)(ullOffsetEnd - ullOffsetCurr, ullSizeChunkMax);
+			stAC.Search(refReader.GetData({ .ullOffset { ullOffsetCurr }, .ullSize { ullSize } }), ullOffsetCurr, ullOffsetStartEnd,
+				u32State, refHit);
+			ullOffsetCurr += ullSize;
+
+			//Occurrences are found in the order of their end offsets. Once the limit is reached, only the ones
+			//that end within the next (max pattern size - 1) bytes can still start before the found ones.
+			if (refHit.size() >= sLimit) {
+				ullOffsetEnd = (std::min)(ullOffsetEnd, ullOffsetCurr + ullMaxPattSize - 1);
+			}
+		}
+
+		std::sort(refHit.begin(), refHit.end(), [](const HEXPATTERNHIT& lhs, const HEXPATTERNHIT& rhs) {
+			return lhs.ullOffset < rhs.ullOffset || (lhs.ullOffset == rhs.ullOffset && lhs.sPatternIndex < rhs.sPatternIndex); });
+		if (refHit.size() > sLimit) {
+			refHit.resize(sLimit);
+		}
+		par.AddProcessed(refPart.ullSize);
+		par.OnPartDone(sPart, refHit.size());
+		};
+
+	const auto lmbSearch = [&]() {
+		par.Run(sParts, lmbSearchPart, IsVirtual());
+		dlgProg.OnCancel();
+		};
+
+	static constexpr auto uSizeToRunThread { 1024U * 1024U * 50U }; //50MB.
+	if (ullTotalSize > uSizeToRunThread) { //Spawning new thread only if data size is big enough.
+		std::thread thrd(lmbSearch);
+		dlgProg.DoModal(m_Wnd, m_hInstRes);
+		thrd.join();
+	}
+	else {
+		lmbSearch();
+	}
+
+	if (par.IsCanceled())
+		return { };
+
+	//Partitions go in the offsets order, their occurrences are merged as is.
+	std::vector<HEXPATTERNHIT> vecHit;
+	for (const auto& refHit : vecPartHit) {
+		const auto sToAdd = (std::min)(refHit.size(), sLimit - vecHit.size());
+		vecHit.insert(vecHit.end(), refHit.begin(), refHit.begin() + sToAdd);
+		if (vecHit.size() >= sLimit)
+			break;
+	}
+
+	return vecHit;
+}
+
 void CHexCtrl::SetCapacity(DWORD dwCapacity)
 {
 	assert(IsCreated());
@@ -1740,7 +2495,10 @@ bool CHexCtrl::SetConfig(std::wstring_view wsvPath)
 		{ "CMD_TEMPL_APPLYCURR", { CMD_TEMPL_APPLYCURR, IDM_HEXCTRL_TEMPL_APPLYCURR } },
 		{ "CMD_TEMPL_DISAPPLY", { CMD_TEMPL_DISAPPLY, IDM_HEXCTRL_TEMPL_DISAPPLY } },
 		{ "CMD_TEMPL_DISAPPALL", { CMD_TEMPL_DISAPPALL, IDM_HEXCTRL_TEMPL_DISAPPALL } },
-		{ "CMD_TEMPL_DLG_MGR", { CMD_TEMPL_DLG_MGR, IDM_HEXCTRL_TEMPL_DLGMGR } }
+		{ "CMD_TEMPL_DLG_MGR", { CMD_TEMPL_DLG_MGR, IDM_HEXCTRL_TEMPL_DLGMGR } },
+		{ "CMD_HASH_DLG", { CMD_HASH_DLG, IDM_HEXCTRL_DLGHASH } },
+		{ "CMD_DIFF_NEXT", { CMD_DIFF_NEXT, 0 } },
+		{ "CMD_DIFF_PREV", { CMD_DIFF_PREV, 0 } }
 	};
 
 	//Mapping between JSON-data commands and actual keyboard codes, with names that appear in the menu.
@@ -1944,6 +2702,8 @@ void CHexCtrl::SetData(const HEXDATA& hds, bool fAdjust)
 			ut::DBG_REPORT(L"Data size must be equal to the prior data size.");
 			return;
 		}
+
+		m_pDlgSearch->CancelSearchAsync();
 	}
 	else { //Clear any previously set data before setting the new data.
 		ClearData();
@@ -1951,6 +2711,10 @@ void CHexCtrl::SetData(const HEXDATA& hds, bool fAdjust)
 
 	m_spnData = hds.spnData;
 	m_pHexVirtData = hds.pHexVirtData;
+	m_pEntropy->ClearAll();
+	m_pSearchIndex->ClearAll();
+	m_pSearchCache->ClearAll();
+	m_vecDiff.clear();
 	m_pHexVirtColors = hds.pHexVirtColors;
 	m_dwCacheSize = (std::max)(hds.dwCacheSize, 1024UL * 64UL); //Minimum cache size for VirtualData mode.
 	m_fMutable = hds.fMutable;
@@ -2038,6 +2802,9 @@ void CHexCtrl::SetDlgProperties(EHexWnd eWnd, std::uint64_t u64Flags)
 	case DLG_TEMPLMGR:
 		m_pDlgTemplMgr->SetDlgProperties(u64Flags);
 		break;
+	case DLG_HASH:
+		m_pDlgHash->SetDlgProperties(u64Flags);
+		break;
 	default:
 		break;
 	}
@@ -2169,6 +2936,17 @@ void CHexCtrl::SetScrollRatio(float flRatio, bool fLines)
 	m_pScrollV->SetScrollPageSize(GetScrollPageSize());
 }
 
+bool CHexCtrl::SetSearchIndex(std::wstring_view wsvPath)
+{
+	assert(IsCreated());
+	if (!IsCreated())
+		return false;
+
+	//The index is loaded from the side file if it matches the data, otherwise it's built in background.
+	//The "Search..." dialog uses it once it's ready.
+	return m_pSearchIndex->Open(wsvPath);
+}
+
 void CHexCtrl::SetSelection(const VecSpan& vecSel, bool fRedraw, bool fHighlight)
 {
 	assert(IsCreated());
@@ -2223,6 +3001,15 @@ void CHexCtrl::ShowInfoBar(bool fShow)
 	RecalcAll();
 }
 
+void CHexCtrl::WaitSearchIndex()
+{
+	assert(IsCreated());
+	if (!IsCreated())
+		return;
+
+	m_pSearchIndex->Wait();
+}
+
 
 //CHexCtrl Private methods.
 
@@ -3414,6 +4201,102 @@ void CHexCtrl::DrawBookmarks(HDC hDC, ULONGLONG ullStartLine, int iLines, std::w
 	}
 }
 
+void CHexCtrl::DrawDifferences(HDC hDC, ULONGLONG ullStartLine, int iLines, std::wstring_view wsvHex, std::wstring_view wsvText)const
+{
+	if (m_vecDiff.empty())
+		return;
+
+	std::vector<POLYTEXTW> vecPolyDiffHex;
+	std::vector<POLYTEXTW> vecPolyDiffText;
+	std::vector<std::unique_ptr<std::wstring>> vecWstrDiff; //unique_ptr to avoid wstring ptr invalidation.
+	const auto ullStartOffset = ullStartLine * GetCapacity();
+	std::size_t sIndexToPrint { };
+
+	//Offsets are hit tested in ascending order, so the iterator only goes forward.
+	auto iterDiff = std::lower_bound(m_vecDiff.begin(), m_vecDiff.end(), ullStartOffset,
+		[](const HEXSPAN& ref, ULONGLONG ullOffset) { return ref.ullOffset + ref.ullSize <= ullOffset; });
+	const auto lmbHitTest = [&](ULONGLONG ullOffset) {
+		while (iterDiff != m_vecDiff.end() && iterDiff->ullOffset + iterDiff->ullSize <= ullOffset) {
+			++iterDiff;
+		}
+		return iterDiff != m_vecDiff.end() && ullOffset >= iterDiff->ullOffset;
+		};
+
+	for (auto iterLines = 0; iterLines < iLines; ++iterLines) {
+		std::wstring wstrHexDiffToPrint; //Differing Hex and Text strings to print.
+		std::wstring wstrTextDiffToPrint;
+		int iDiffHexPosToPrintX { };
+		int iDiffTextPosToPrintX { };
+		bool fNeedChunkPoint { true };
+		bool fDiff { false };
+		const auto iPosToPrintY = m_iStartWorkAreaYPx + (m_sizeFontMain.cy * iterLines); //Hex and Text are the same.
+		const auto lmbPoly = [&]() {
+			if (wstrHexDiffToPrint.empty())
+				return;
+
+			//Hex differences Poly.
+			vecWstrDiff.emplace_back(std::make_unique<std::wstring>(std::move(wstrHexDiffToPrint)));
+			vecPolyDiffHex.emplace_back(iDiffHexPosToPrintX, iPosToPrintY,
+				static_cast<UINT>(vecWstrDiff.back()->size()), vecWstrDiff.back()->data(), 0, RECT { }, GetCharsWidthArray());
+
+			//Text differences Poly.
+			vecWstrDiff.emplace_back(std::make_unique<std::wstring>(std::move(wstrTextDiffToPrint)));
+			vecPolyDiffText.emplace_back(iDiffTextPosToPrintX, iPosToPrintY,
+				static_cast<UINT>(vecWstrDiff.back()->size()), vecWstrDiff.back()->data(), 0, RECT { }, GetCharsWidthArray());
+			};
+
+		//Main loop for printing Hex chunks and Text chars.
+		for (auto iterChunks { 0U }; iterChunks < GetCapacity() && sIndexToPrint < wsvText.size(); ++iterChunks, ++sIndexToPrint) {
+			//Differences.
+			if (lmbHitTest(ullStartOffset + sIndexToPrint)) {
+				if (fNeedChunkPoint) {
+					int iCy;
+					HexChunkPoint(sIndexToPrint, iDiffHexPosToPrintX, iCy);
+					TextChunkPoint(sIndexToPrint, iDiffTextPosToPrintX, iCy);
+					fNeedChunkPoint = false;
+				}
+
+				if (!wstrHexDiffToPrint.empty()) { //Only adding spaces if there are chars beforehead.
+					if ((iterChunks % GetGroupSize()) == 0) {
+						wstrHexDiffToPrint += L' ';
+					}
+
+					//Additional space between capacity halves, only in 1 byte grouping size.
+					if (GetGroupSize() == 1 && iterChunks == m_dwCapacityBlockSize) {
+						wstrHexDiffToPrint += L"  ";
+					}
+				}
+				wstrHexDiffToPrint += wsvHex[sIndexToPrint * 2];
+				wstrHexDiffToPrint += wsvHex[(sIndexToPrint * 2) + 1];
+				wstrTextDiffToPrint += wsvText[sIndexToPrint];
+				fDiff = true;
+			}
+			else if (fDiff) {
+				//There can be multiple differences in one line. 
+				//All the same as for bookmarks.
+
+				lmbPoly();
+				fNeedChunkPoint = true;
+				fDiff = false;
+			}
+		}
+
+		lmbPoly(); //Differences Poly.
+	}
+
+	//Differences printing.
+	if (!vecPolyDiffHex.empty()) {
+		wnd::CDC dc(hDC);
+		dc.SelectObject(m_hFntMain);
+		dc.SetTextColor(m_stColors.clrFontDiff);
+		dc.SetBkColor(m_stColors.clrBkDiff);
+		::PolyTextOutW(dc, vecPolyDiffHex.data(), static_cast<UINT>(vecPolyDiffHex.size())); //Hex differences printing.
+		for (const auto& iter : vecPolyDiffText) {
+			::ExtTextOutW(dc, iter.x, iter.y, iter.uiFlags, &iter.rcl, iter.lpstr, iter.n, iter.pdx); //Text differences printing.
+		}
+	}
+}
+
 void CHexCtrl::DrawSelection(HDC hDC, ULONGLONG ullStartLine, int iLines, std::wstring_view wsvHex, std::wstring_view wsvText)const
 {
 	if (!HasSelection())
@@ -3874,6 +4757,36 @@ auto CHexCtrl::GetVirtualOffset(ULONGLONG ullOffset)const->ULONGLONG
 	return GetOffset(ullOffset, true);
 }
 
+void CHexCtrl::GoToDiff(bool fNext)
+{
+	if (m_vecDiff.empty())
+		return;
+
+	//The next is the first difference after the caret, the previous is the last one before the caret,
+	//with the wrap around at the data ends, as for bookmarks.
+	const auto ullCaretPos = GetCaretPos();
+	VecSpan::const_iterator iterDiff;
+	if (fNext) {
+		iterDiff = std::upper_bound(m_vecDiff.begin(), m_vecDiff.end(), ullCaretPos,
+			[](ULONGLONG ullOffset, const HEXSPAN& ref) { return ullOffset < ref.ullOffset; });
+		if (iterDiff == m_vecDiff.end()) {
+			iterDiff = m_vecDiff.begin();
+		}
+	}
+	else {
+		iterDiff = std::lower_bound(m_vecDiff.begin(), m_vecDiff.end(), ullCaretPos,
+			[](const HEXSPAN& ref, ULONGLONG ullOffset) { return ref.ullOffset < ullOffset; });
+		iterDiff = iterDiff == m_vecDiff.begin() ? m_vecDiff.end() - 1 : iterDiff - 1;
+	}
+
+	const auto hss = *iterDiff;
+	SetCaretPos(hss.ullOffset, true, false);
+	if (!IsOffsetVisible(hss.ullOffset)) {
+		GoToOffset(hss.ullOffset);
+	}
+	SetSelection({ hss }, true, true);
+}
+
 void CHexCtrl::HexChunkPoint(ULONGLONG ullOffset, int& iCx, int& iCy)const
 {
 	//This func computes x and y pos of the given Hex chunk.
@@ -3960,6 +4873,56 @@ bool CHexCtrl::IsPageVisible()const
 	return GetPageSize() > 0 && (GetPageSize() % GetCapacity() == 0) && GetPageSize() >= GetCapacity();
 }
 
+void CHexCtrl::ModifyKeyStream(const HEXMODIFY& hms)
+{
+	assert(!hms.spnData.empty());
+	if (hms.spnData.empty())
+		return;
+
+	const auto& vecSpanRef = hms.vecSpan;
+	const auto ullTotalSize = std::reduce(vecSpanRef.begin(), vecSpanRef.end(), 0ULL,
+		[](ULONGLONG ullSumm, const HEXSPAN& ref) { return ullSumm + ref.ullSize; });
+	assert(ullTotalSize <= GetDataSize());
+
+	//The stream runs continuously through all the spans and all the chunks,
+	//hence the key alignment doesn't depend on the chunk or the span boundaries.
+	CKeyStream stKeyStream(hms.eKeyStream, hms.spnData);
+	CHexDlgProgress dlgProg(L"Modifying...", L"", 0, ullTotalSize);
+	const auto lmbModify = [&]() {
+		const auto ullSizeChunkMax = static_cast<ULONGLONG>(GetCacheSize());
+		auto ullProcessed { 0ULL };
+		for (const auto& iterSpan : vecSpanRef) {
+			auto ullOffsetCurr = iterSpan.ullOffset;
+			const auto ullOffsetEnd = (std::min)(iterSpan.ullOffset + iterSpan.ullSize, GetDataSize());
+			while (ullOffsetCurr < ullOffsetEnd) {
+				const auto ullSizeCurr = (std::min)(ullOffsetEnd - ullOffsetCurr, ullSizeChunkMax);
+				const auto spnData = GetData({ ullOffsetCurr, ullSizeCurr });
+				assert(!spnData.empty());
+				stKeyStream.Apply(spnData);
+				SetDataVirtual(spnData, { ullOffsetCurr, ullSizeCurr });
+				ullOffsetCurr += ullSizeCurr;
+				ullProcessed += ullSizeCurr;
+				if (dlgProg.IsCanceled())
+					goto exit;
+
+				dlgProg.SetCurrent(ullProcessed);
+			}
+		}
+	exit:
+		dlgProg.OnCancel();
+		};
+
+	static constexpr auto uSizeToRunThread { 1024U * 1024U * 50U }; //50MB.
+	if (ullTotalSize > uSizeToRunThread) { //Spawning new thread only if data size is big enough.
+		std::thread thrd(lmbModify);
+		dlgProg.DoModal(m_Wnd, m_hInstRes);
+		thrd.join();
+	}
+	else {
+		lmbModify();
+	}
+}
+
 void CHexCtrl::ModifyWorker(const HEXCTRL::HEXMODIFY& hms, const auto& FuncWorker, const HEXCTRL::SpanCByte spnOper)
 {
 	assert(!spnOper.empty());
@@ -3973,7 +4936,8 @@ void CHexCtrl::ModifyWorker(const HEXCTRL::HEXMODIFY& hms, const auto& FuncWorke
 
 	CHexDlgProgress dlgProg(L"Modifying...", L"", vecSpanRef.back().ullOffset, vecSpanRef.back().ullOffset + ullTotalSize);
 	const auto lmbModify = [&]() {
-		for (const auto& iterSpan : vecSpanRef) { //Span-vector's size times.
+		for (std::size_t iSpan { 0 }; iSpan < vecSpanRef.size(); ++iSpan) { //Span-vector's size times.
+			const auto& iterSpan = vecSpanRef[iSpan];
 			const auto ullOffsetToModify { iterSpan.ullOffset };
 			const auto ullSizeToModify { iterSpan.ullSize };
 			const auto ullSizeDataOper { spnOper.size() };
@@ -3983,6 +4947,42 @@ void CHexCtrl::ModifyWorker(const HEXCTRL::HEXMODIFY& hms, const auto& FuncWorke
 			if (ullSizeDataOper > ullSizeToModify)
 				break;
 
+			//In VirtualData mode the next ascending spans that fit into one cache size window with this span
+			//are modified within one data chunk, instead of getting and setting the data for every span.
+			//It makes modifying the many small spans, like the Replace All occurrences, much faster.
+			if (IsVirtual() && vecSpanRef.size() > 1 && ullSizeToModify <= GetCacheSize()
+				&& ullOffsetToModify + ullSizeToModify <= GetDataSize()) {
+				auto iSpanLast = iSpan;
+				while (iSpanLast + 1 < vecSpanRef.size()) {
+					const auto& refPrev = vecSpanRef[iSpanLast];
+					const auto& refNext = vecSpanRef[iSpanLast + 1];
+					if (refNext.ullOffset < refPrev.ullOffset + refPrev.ullSize || refNext.ullSize < ullSizeDataOper
+						|| refNext.ullOffset + refNext.ullSize - ullOffsetToModify > GetCacheSize()
+						|| refNext.ullOffset + refNext.ullSize > GetDataSize())
+						break;
+
+					++iSpanLast;
+				}
+
+				const auto ullSizeChunk = vecSpanRef[iSpanLast].ullOffset + vecSpanRef[iSpanLast].ullSize - ullOffsetToModify;
+				const auto spnData = GetData({ ullOffsetToModify, ullSizeChunk });
+				assert(!spnData.empty());
+				for (auto iSpanCurr = iSpan; iSpanCurr <= iSpanLast; ++iSpanCurr) {
+					const auto& refSpan = vecSpanRef[iSpanCurr];
+					const auto pDataSpan = spnData.data() + (refSpan.ullOffset - ullOffsetToModify);
+					for (auto ullIndex { 0ULL }; ullIndex <= (refSpan.ullSize - ullSizeDataOper); ullIndex += ullSizeDataOper) {
+						FuncWorker(pDataSpan + ullIndex, hms, spnOper);
+					}
+				}
+				SetDataVirtual(spnData, { ullOffsetToModify, ullSizeChunk });
+				if (dlgProg.IsCanceled())
+					goto exit;
+
+				dlgProg.SetCurrent(ullOffsetToModify + ullSizeChunk);
+				iSpan = iSpanLast;
+				continue;
+			}
+
 			ULONGLONG ullSizeCache { };
 			ULONGLONG ullChunks { };
 			bool fCacheIsLargeEnough { true }; //Cache is larger than ullSizeDataOper.
@@ -4276,6 +5276,7 @@ void CHexCtrl::Print()
 				DrawHexText(dcPrint, ullStartLine, iLines, wstrHex, wstrText);
 				DrawTemplates(dcPrint, ullStartLine, iLines, wstrHex, wstrText);
 				DrawBookmarks(dcPrint, ullStartLine, iLines, wstrHex, wstrText);
+				DrawDifferences(dcPrint, ullStartLine, iLines, wstrHex, wstrText);
 				DrawSelection(dcPrint, ullStartLine, iLines, wstrHex, wstrText);
 				DrawSelHighlight(dcPrint, ullStartLine, iLines, wstrHex, wstrText);
 				DrawCaret(dcPrint, ullStartLine, wstrHex, wstrText);
@@ -4389,7 +5390,11 @@ void CHexCtrl::Redo()
 	vecSpan.reserve(refRedo->size());
 	std::transform(refRedo->begin(), refRedo->end(), std::back_inserter(vecSpan),
 		[](UNDO& ref) { return HEXSPAN { ref.ullOffset, ref.vecData.size() }; });
+	m_pDlgSearch->CancelSearchAsync();
 	SnapshotUndo(vecSpan); //Creating new Undo data snapshot.
+	m_pEntropy->SetDirty(vecSpan);
+	m_pSearchIndex->SetDirty(vecSpan);
+	m_pSearchCache->SetDirty(vecSpan);
 
 	for (const auto& iter : *refRedo) {
 		const auto& refRedoData = iter.vecData;
@@ -4748,7 +5753,7 @@ void CHexCtrl::SnapshotUndo(const VecSpan& vecSpan)
 		[](ULONGLONG ullSumm, const HEXSPAN& ref) { return ullSumm + ref.ullSize; });
 
 	//Check for very big undo size.
-	if (ullTotalSize > 1024 * 1024 * 10)
+	if (ullTotalSize > ut::g_ullUndoSizeMax)
 		return;
 
 	//If Undo vec's size is exceeding Undo's max limit, remove first 64 snapshots (the oldest ones).
@@ -4852,6 +5857,7 @@ void CHexCtrl::Undo()
 	if (m_vecUndo.empty())
 		return;
 
+	m_pDlgSearch->CancelSearchAsync();
 	//Bad alloc may happen here! If there is no more free memory, just clear the vec and return.
 	try {
 		//Creating new Redo data snapshot.
@@ -4860,6 +5866,9 @@ void CHexCtrl::Undo()
 			auto& refRedoBack = refRedo->emplace_back(UNDO { iter.ullOffset, { } });
 			refRedoBack.vecData.resize(iter.vecData.size());
 			const auto& refUndoData = iter.vecData;
+			m_pEntropy->SetDirty({ { iter.ullOffset, refUndoData.size() } });
+			m_pSearchIndex->SetDirty({ { iter.ullOffset, refUndoData.size() } });
+			m_pSearchCache->SetDirty({ { iter.ullOffset, refUndoData.size() } });
 
 			if (IsVirtual() && refUndoData.size() > GetCacheSize()) { //In VirtualData mode processing data chunk by chunk.
 				const auto dwSizeChunk = GetCacheSize();
@@ -4902,7 +5911,7 @@ void CHexCtrl::ModifyOper(std::byte* pData, const HEXMODIFY& hms, [[maybe_unused
 	using enum EHexOperMode;
 
 	constexpr auto lmbOperT = []<typename T>(T * pData, const HEXMODIFY & hms) {
-		T tData = hms.fBigEndian ? ut::ByteSwap(*pData) : *pData;
+		T tData = ut::LoadTData<T>(reinterpret_cast<const std::byte*>(pData), hms.fBigEndian);
 		assert(!hms.spnData.empty());
 		const T tOper = *reinterpret_cast<const T*>(hms.spnData.data());
 
@@ -4976,40 +5985,9 @@ void CHexCtrl::ModifyOper(std::byte* pData, const HEXMODIFY& hms, [[maybe_unused
 		*pData = tData;
 	};
 
-	switch (hms.eDataType) {
-	case DATA_INT8:
-		lmbOperT(reinterpret_cast<std::int8_t*>(pData), hms);
-		break;
-	case DATA_UINT8:
-		lmbOperT(reinterpret_cast<std::uint8_t*>(pData), hms);
-		break;
-	case DATA_INT16:
-		lmbOperT(reinterpret_cast<std::int16_t*>(pData), hms);
-		break;
-	case DATA_UINT16:
-		lmbOperT(reinterpret_cast<std::uint16_t*>(pData), hms);
-		break;
-	case DATA_INT32:
-		lmbOperT(reinterpret_cast<std::int32_t*>(pData), hms);
-		break;
-	case DATA_UINT32:
-		lmbOperT(reinterpret_cast<std::uint32_t*>(pData), hms);
-		break;
-	case DATA_INT64:
-		lmbOperT(reinterpret_cast<std::int64_t*>(pData), hms);
-		break;
-	case DATA_UINT64:
-		lmbOperT(reinterpret_cast<std::uint64_t*>(pData), hms);
-		break;
-	case DATA_FLOAT:
-		lmbOperT(reinterpret_cast<float*>(pData), hms);
-		break;
-	case DATA_DOUBLE:
-		lmbOperT(reinterpret_cast<double*>(pData), hms);
-		break;
-	default:
-		break;
-	}
+	ut::VisitDataType(hms.eDataType, [&]<typename T>(std::type_identity<T>) {
+		lmbOperT(reinterpret_cast<T*>(pData), hms);
+		});
 }
 
 #if defined(_M_IX86) || defined(_M_X64)
@@ -6922,6 +7900,7 @@ auto CHexCtrl::OnDestroy()->LRESULT
 	m_pDlgGoTo->DestroyDlg();
 	m_pDlgSearch->DestroyDlg();
 	m_pDlgTemplMgr->DestroyDlg();
+	m_pDlgHash->DestroyDlg();
 	m_pDlgTemplMgr->UnloadAll(); //Templates could be loaded without creating the dialog itself.
 	m_vecHBITMAP.clear();
 	m_vecKeyBind.clear();
@@ -7028,6 +8007,7 @@ auto CHexCtrl::OnInitMenuPopup(const MSG& msg)->LRESULT
 	case 9: //Data Presentation.
 		m_MenuMain.EnableMenuItem(IDM_HEXCTRL_DLGDATAINTERP, IsCmdAvail(CMD_DATAINTERP_DLG));
 		m_MenuMain.EnableMenuItem(IDM_HEXCTRL_DLGCODEPAGE, IsCmdAvail(CMD_CODEPAGE_DLG));
+		m_MenuMain.EnableMenuItem(IDM_HEXCTRL_DLGHASH, IsCmdAvail(CMD_HASH_DLG));
 		break;
 	default:
 		break;
@@ -7425,6 +8405,7 @@ auto CHexCtrl::OnPaint()->LRESULT
 	DrawHexText(dcMem, ullStartLine, iLines, wstrHex, wstrText);
 	DrawTemplates(dcMem, ullStartLine, iLines, wstrHex, wstrText);
 	DrawBookmarks(dcMem, ullStartLine, iLines, wstrHex, wstrText);
+	DrawDifferences(dcMem, ullStartLine, iLines, wstrHex, wstrText);
 	DrawSelection(dcMem, ullStartLine, iLines, wstrHex, wstrText);
 	DrawSelHighlight(dcMem, ullStartLine, iLines, wstrHex, wstrText);
 	DrawCaret(dcMem, ullStartLine, wstrHex, wstrText);
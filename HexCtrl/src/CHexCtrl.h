@@ -23,9 +23,13 @@ namespace HEXCTRL::INTERNAL {
 	class CHexDlgDataInterp;
 	class CHexDlgModify;
 	class CHexDlgGoTo;
+	class CHexDlgHash;
 	class CHexDlgSearch;
 	class CHexDlgTemplMgr;
+	class CHexEntropy;
 	class CHexScroll;
+	class CHexSearchCache;
+	class CHexSearchIndex;
 	class CHexSelection;
 
 	/********************************************************************************************
@@ -40,11 +44,14 @@ namespace HEXCTRL::INTERNAL {
 		CHexCtrl& operator=(CHexCtrl&&) = delete;
 		~CHexCtrl();
 		void ClearData()override;
+		auto CompareData(const HEXCOMPARE& hcs)->VecSpan override;
 		bool Create(const HEXCREATE& hcs)override;
 		bool CreateDialogCtrl(UINT uCtrlID, HWND hWndParent)override;
 		void Delete()override;
 		void DestroyWindow()override;
+		auto DiffData(const HEXCOMPARE& hcs)->std::vector<HEXDIFFOP> override;
 		void ExecuteCmd(EHexCmd eCmd)override;
+		[[nodiscard]] auto ExtractStrings(const HEXSTRINGS& hss)const->IHexSearchPtr override;
 		[[nodiscard]] auto GetActualWidth()const->int override;
 		[[nodiscard]] auto GetBookmarks()const->IHexBookmarks* override;
 		[[nodiscard]] auto GetCacheSize()const->DWORD override;
@@ -57,6 +64,7 @@ namespace HEXCTRL::INTERNAL {
 		[[nodiscard]] auto GetDataSize()const->ULONGLONG override;
 		[[nodiscard]] auto GetDateInfo()const->std::tuple<DWORD, wchar_t> override;
 		[[nodiscard]] auto GetDlgItemHandle(EHexWnd eWnd, EHexDlgItem eItem)const->HWND override;
+		[[nodiscard]] auto GetEntropy(DWORD dwBlockSize)->HEXENTROPY override;
 		[[nodiscard]] auto GetFont()const->LOGFONTW override;
 		[[nodiscard]] auto GetGroupSize()const->DWORD override;
 		[[nodiscard]] auto GetMenuHandle()const->HMENU override;
@@ -66,11 +74,13 @@ namespace HEXCTRL::INTERNAL {
 		[[nodiscard]] auto GetPageSize()const->DWORD override;
 		[[nodiscard]] auto GetScrollRatio()const->std::tuple<float, bool> override;
 		[[nodiscard]] auto GetSelection()const->VecSpan override;
+		[[nodiscard]] auto GetStatistics(const VecSpan& vecSpan, EHexDataType eDataType, bool fBigEndian)const->HEXSTATS override;
 		[[nodiscard]] auto GetTemplates()const->IHexTemplates* override;
 		[[nodiscard]] auto GetUnprintableChar()const->wchar_t override;
 		[[nodiscard]] auto GetWndHandle(EHexWnd eWnd, bool fCreate)const->HWND override;
 		void GoToOffset(ULONGLONG ullOffset, int iPosAt = 0)override;
 		[[nodiscard]] bool HasSelection()const override;
+		[[nodiscard]] auto HashData(const HEXHASH& hhs)const->std::vector<HEXDIGEST> override;
 		[[nodiscard]] auto HitTest(POINT pt, bool fScreen)const->std::optional<HEXHITTEST> override;
 		[[nodiscard]] bool IsCmdAvail(EHexCmd eCmd)const override;
 		[[nodiscard]] bool IsCreated()const override;
@@ -84,6 +94,8 @@ namespace HEXCTRL::INTERNAL {
 		[[nodiscard]] bool PreTranslateMsg(MSG* pMsg)override;
 		[[nodiscard]] auto ProcessMsg(const MSG& msg) -> LRESULT;
 		void Redraw()override;
+		[[nodiscard]] auto SearchAsync(const HEXSEARCH& hss)const->IHexSearchPtr override;
+		[[nodiscard]] auto SearchPatterns(const HEXPATTERNS& hps)const->std::vector<HEXPATTERNHIT> override;
 		void SetCapacity(DWORD dwCapacity)override;
 		void SetCaretPos(ULONGLONG ullOffset, bool fHighLow = true, bool fRedraw = true)override;
 		void SetCharsExtraSpace(DWORD dwSpace)override;
@@ -100,11 +112,13 @@ namespace HEXCTRL::INTERNAL {
 		void SetPageSize(DWORD dwSize, std::wstring_view wsvName)override;
 		void SetRedraw(bool fRedraw)override;
 		void SetScrollRatio(float flRatio, bool fLines)override;
+		bool SetSearchIndex(std::wstring_view wsvPath)override;
 		void SetSelection(const VecSpan& vecSel, bool fRedraw = true, bool fHighlight = false)override;
 		void SetUnprintableChar(wchar_t wch)override;
 		void SetVirtualBkm(IHexBookmarks* pVirtBkm)override;
 		void SetWindowPos(HWND hWndAfter, int iX, int iY, int iWidth, int iHeight, UINT uFlags)override;
 		void ShowInfoBar(bool fShow)override;
+		void WaitSearchIndex()override;
 	private:
 		struct UNDO;
 		struct KEYBIND;
@@ -138,6 +152,7 @@ namespace HEXCTRL::INTERNAL {
 		void DrawHexText(HDC hDC, ULONGLONG ullStartLine, int iLines, std::wstring_view wsvHex, std::wstring_view wsvText)const;
 		void DrawTemplates(HDC hDC, ULONGLONG ullStartLine, int iLines, std::wstring_view wsvHex, std::wstring_view wsvText)const;
 		void DrawBookmarks(HDC hDC, ULONGLONG ullStartLine, int iLines, std::wstring_view wsvHex, std::wstring_view wsvText)const;
+		void DrawDifferences(HDC hDC, ULONGLONG ullStartLine, int iLines, std::wstring_view wsvHex, std::wstring_view wsvText)const;
 		void DrawSelection(HDC hDC, ULONGLONG ullStartLine, int iLines, std::wstring_view wsvHex, std::wstring_view wsvText)const;
 		void DrawSelHighlight(HDC hDC, ULONGLONG ullStartLine, int iLines, std::wstring_view wsvHex, std::wstring_view wsvText)const;
 		void DrawCaret(HDC hDC, ULONGLONG ullStartLine, std::wstring_view wsvHex, std::wstring_view wsvText)const;
@@ -158,11 +173,13 @@ namespace HEXCTRL::INTERNAL {
 		[[nodiscard]] auto GetScrollPageSize()const->ULONGLONG; //Get the "Page" size of the scroll.
 		[[nodiscard]] auto GetTopLine()const->ULONGLONG;       //Returns current top line number in view.
 		[[nodiscard]] auto GetVirtualOffset(ULONGLONG ullOffset)const->ULONGLONG;
+		void GoToDiff(bool fNext);                             //Go to the next or previous compare difference.
 		void HexChunkPoint(ULONGLONG ullOffset, int& iCx, int& iCy)const; //Point of Hex chunk.
 		[[nodiscard]] auto HitTest(POINT pt)const->std::optional<HEXHITTEST>; //Is any hex chunk withing given point?
 		[[nodiscard]] bool IsCurTextArea()const;               //Whether last focus was set at Text or Hex chunks area.
 		[[nodiscard]] bool IsDrawable()const;                  //Should WM_PAINT be handled atm or not.
 		[[nodiscard]] bool IsPageVisible()const;               //Returns m_fSectorVisible.
+		void ModifyKeyStream(const HEXMODIFY& hms);            //XOR data with the keystream, in the MODIFY_KEYSTREAM mode.
 		//Main "Modify" method with different workers.
 		void ModifyWorker(const HEXCTRL::HEXMODIFY& hms, const auto& FuncWorker, HEXCTRL::SpanCByte spnOper);
 		[[nodiscard]] auto OffsetToWstr(ULONGLONG ullOffset)const->std::wstring; //Format offset as std::wstring.
@@ -235,9 +252,13 @@ namespace HEXCTRL::INTERNAL {
 		const std::unique_ptr<CHexDlgDataInterp> m_pDlgDataInterp { std::make_unique<CHexDlgDataInterp>() }; //"Data interpreter" dialog.
 		const std::unique_ptr<CHexDlgModify> m_pDlgModify { std::make_unique<CHexDlgModify>() };             //"Modify..." dialog.
 		const std::unique_ptr<CHexDlgGoTo> m_pDlgGoTo { std::make_unique<CHexDlgGoTo>() };                   //"GoTo..." dialog.
+		const std::unique_ptr<CHexDlgHash> m_pDlgHash { std::make_unique<CHexDlgHash>() };                   //"Checksums and Hashes" dialog.
 		const std::unique_ptr<CHexDlgSearch> m_pDlgSearch { std::make_unique<CHexDlgSearch>() };             //"Search..." dialog.
 		const std::unique_ptr<CHexDlgTemplMgr> m_pDlgTemplMgr { std::make_unique<CHexDlgTemplMgr>() };       //"Template manager..." dialog.
 		const std::unique_ptr<CHexSelection> m_pSelection { std::make_unique<CHexSelection>() };             //Selection class.
+		const std::unique_ptr<CHexEntropy> m_pEntropy { std::make_unique<CHexEntropy>() };                   //Histogram and entropy map.
+		const std::unique_ptr<CHexSearchIndex> m_pSearchIndex { std::make_unique<CHexSearchIndex>() };       //Search index of the data.
+		const std::unique_ptr<CHexSearchCache> m_pSearchCache { std::make_unique<CHexSearchCache>() };       //Results of the recent searches.
 		const std::unique_ptr<CHexScroll> m_pScrollV { std::make_unique<CHexScroll>() };                     //Vertical scroll bar.
 		const std::unique_ptr<CHexScroll> m_pScrollH { std::make_unique<CHexScroll>() };                     //Horizontal scroll bar.
 		HINSTANCE m_hInstRes { };             //Hinstance of the HexCtrl resources.
@@ -260,6 +281,7 @@ namespace HEXCTRL::INTERNAL {
 			decltype([](HBITMAP hBmp) { DeleteObject(hBmp); }) >> m_vecHBITMAP; //Icons for the Menu.
 		std::vector<KEYBIND> m_vecKeyBind;    //Vector of key bindings.
 		std::vector<int> m_vecCharsWidth;     //Vector of chars widths.
+		VecSpan m_vecDiff;                    //Differences found by the CompareData.
 		IHexVirtData* m_pHexVirtData { };     //Data handler pointer for Virtual mode.
 		IHexVirtColors* m_pHexVirtColors { }; //Pointer for custom colors class.
 		SpanByte m_spnData;                   //Main data span.
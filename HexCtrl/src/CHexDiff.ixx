@@ -0,0 +1,360 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+export module HEXCTRL.CHexDiff;
+
+import HEXCTRL.CHexCompare;
+import HEXCTRL.HexUtility;
+
+namespace HEXCTRL::INTERNAL {
+	//Insertion aware difference of two data, the rsync algorithm.
+	//The other data is split into the blocks, that are indexed by their weak rolling and strong hashes.
+	//The data is scanned by the rolling weak hash, window by window, and the weak hash hits are confirmed
+	//by the strong hash. The scan jumps over the matched block, and the matches are then verified
+	//and extended byte by byte.
+	//After the BuildIndex the Scan is thread safe, the data parts are scanned independently and joined at the end.
+	export class CHexDiff final {
+	public:
+		struct MATCH {
+			ULONGLONG ullOffset { };      //Offset in the data.
+			ULONGLONG ullOffsetOther { }; //Offset in the other data.
+			ULONGLONG ullSize { };
+		};
+		CHexDiff(DWORD dwBlockSize, ULONGLONG ullSizeOther);
+		void AddBlocks(SpanCByte spnOther, ULONGLONG ullOffsetOther); //Whole blocks, the blocks can be added in parallel.
+		void BuildIndex(); //After all the blocks are added.
+		[[nodiscard]] auto GetBlockSize()const->DWORD;
+		//Scans the windows from the refPos up to the ullPosEnd that fit in the spnData at the ullOffset.
+		//The refPos is set to the position the next scan goes on from, it can be past the ullPosEnd after a match.
+		void Scan(SpanCByte spnData, ULONGLONG ullOffset, ULONGLONG& refPos, ULONGLONG ullPosEnd, std::vector<MATCH>& vecMatch)const;
+		template<typename TGetData, typename TGetOther>
+		static void ExtendMatches(std::vector<MATCH>& vecMatch, ULONGLONG ullDataSize, ULONGLONG ullSizeOther,
+			ULONGLONG ullSizeChunk, TGetData&& FuncGetData, TGetOther&& FuncGetOther); //The vecMatch is after the JoinMatches.
+		[[nodiscard]] static auto JoinMatches(std::vector<MATCH>&& vecMatch)->std::vector<MATCH>; //Sorted, non-overlapping.
+		[[nodiscard]] static auto ToOps(const std::vector<MATCH>& vecMatch, ULONGLONG ullDataSize)->std::vector<HEXDIFFOP>;
+	private:
+		struct BLOCK {
+			std::uint64_t u64Strong { };
+			std::uint32_t u32Weak { };
+			std::uint32_t u32Index { }; //Block index in the other data.
+		};
+		[[nodiscard]] auto Find(std::uint32_t u32Weak, const std::byte* pData, ULONGLONG ullOffsetOtherNext)const->ULONGLONG;
+		[[nodiscard]] static auto GetFilterBit(std::uint32_t u32Weak)->std::uint32_t;
+		[[nodiscard]] static auto GetStrong(const std::byte* pData, std::size_t sSize)->std::uint64_t;
+		[[nodiscard]] static auto GetWeak(const std::byte* pData, std::size_t sSize)->std::pair<std::uint32_t, std::uint32_t>;
+	private:
+		static constexpr auto m_ullNone { (std::numeric_limits<ULONGLONG>::max)() };
+		static constexpr auto m_uFilterBits { 20U }; //The weak hash misses are filtered out by the bitmap, before the binary search.
+		std::vector<BLOCK> m_vecBlock;          //Sorted by the weak hash after the BuildIndex.
+		std::vector<std::uint64_t> m_vecFilter; //1 << m_uFilterBits bits.
+		DWORD m_dwBlockSize { };
+	};
+
+	CHexDiff::CHexDiff(DWORD dwBlockSize, ULONGLONG ullSizeOther)
+	{
+		//Blocks indexes are 32-bit.
+		m_dwBlockSize = (std::max)({ dwBlockSize, 1UL, static_cast<DWORD>((ullSizeOther >> 32) + 1) });
+		m_vecBlock.resize(static_cast<std::size_t>(ullSizeOther / m_dwBlockSize));
+	}
+
+	void CHexDiff::AddBlocks(SpanCByte spnOther, ULONGLONG ullOffsetOther)
+	{
+		assert(ullOffsetOther % m_dwBlockSize == 0);
+		const auto sFirst = static_cast<std::size_t>(ullOffsetOther / m_dwBlockSize);
+		const auto sCount = (std::min)(spnOther.size() / m_dwBlockSize, m_vecBlock.size() - sFirst);
+		for (std::size_t i { 0 }; i < sCount; ++i) {
+			const auto pData = spnOther.data() + (i * m_dwBlockSize);
+			const auto [u32A, u32B] = GetWeak(pData, m_dwBlockSize);
+			m_vecBlock[sFirst + i] = { .u64Strong { GetStrong(pData, m_dwBlockSize) },
+				.u32Weak { (u32A & 0xFFFFU) | (u32B << 16) }, .u32Index { static_cast<std::uint32_t>(sFirst + i) } };
+		}
+	}
+
+	void CHexDiff::BuildIndex()
+	{
+		std::sort(m_vecBlock.begin(), m_vecBlock.end(), [](const BLOCK& lhs, const BLOCK& rhs) {
+			return lhs.u32Weak < rhs.u32Weak || (lhs.u32Weak == rhs.u32Weak && lhs.u32Index < rhs.u32Index); });
+		m_vecFilter.assign((1ULL << m_uFilterBits) / 64, 0);
+		for (const auto& refBlock : m_vecBlock) {
+			const auto u32Bit = GetFilterBit(refBlock.u32Weak);
+			m_vecFilter[u32Bit / 64] |= 1ULL << (u32Bit % 64);
+		}
+	}
+
+	auto CHexDiff::GetBlockSize()const->DWORD
+	{
+		return m_dwBlockSize;
+	}
+
+	void CHexDiff::Scan(SpanCByte spnData, ULONGLONG ullOffset, ULONGLONG& refPos, ULONGLONG ullPosEnd, std::vector<MATCH>& vecMatch)const
+	{
+		assert(refPos >= ullOffset);
+		const std::size_t sBlock { m_dwBlockSize };
+		if (m_vecBlock.empty()) {
+			refPos = (std::max)(refPos, ullPosEnd);
+			return;
+		}
+
+		if (spnData.size() < sBlock || refPos >= ullPosEnd)
+			return;
+
+		const auto pData = spnData.data();
+		const auto sPosEnd = static_cast<std::size_t>((std::min)(ullPosEnd - ullOffset, static_cast<ULONGLONG>(spnData.size() - sBlock + 1)));
+		auto sPos = static_cast<std::size_t>(refPos - ullOffset);
+		auto ullOffsetOtherNext { m_ullNone }; //The block that continues the last match is preferred.
+		std::uint32_t u32A { };
+		std::uint32_t u32B { };
+		bool fRoll { false };
+		while (sPos < sPosEnd) {
+			if (!fRoll) {
+				std::tie(u32A, u32B) = GetWeak(pData + sPos, sBlock);
+				fRoll = true;
+			}
+
+			const auto u32Weak = (u32A & 0xFFFFU) | (u32B << 16);
+			if (const auto u32Bit = GetFilterBit(u32Weak); (m_vecFilter[u32Bit / 64] & (1ULL << (u32Bit % 64))) != 0) {
+				if (const auto ullOffsetOther = Find(u32Weak, pData + sPos, ullOffsetOtherNext); ullOffsetOther != m_ullNone) {
+					vecMatch.emplace_back(ullOffset + sPos, ullOffsetOther, sBlock);
+					ullOffsetOtherNext = ullOffsetOther + sBlock;
+					sPos += sBlock;
+					fRoll = false;
+					continue;
+				}
+			}
+
+			if (sPos + 1 == sPosEnd) { //The next window may not fit.
+				++sPos;
+				break;
+			}
+
+			//Rolling the window one byte forward, modulo 2^16 in the end.
+			const auto u32Out = std::to_integer<std::uint32_t>(pData[sPos]);
+			u32A += std::to_integer<std::uint32_t>(pData[sPos + sBlock]) - u32Out;
+			u32B += u32A - (static_cast<std::uint32_t>(sBlock) * u32Out);
+			++sPos;
+		}
+
+		refPos = ullOffset + sPos;
+	}
+
+	template<typename TGetData, typename TGetOther>
+	void CHexDiff::ExtendMatches(std::vector<MATCH>& vecMatch, ULONGLONG ullDataSize, ULONGLONG ullSizeOther,
+		ULONGLONG ullSizeChunk, TGetData&& FuncGetData, TGetOther&& FuncGetOther)
+	{
+		//The bytes are got by the ullSizeChunk chunks, the FuncGetData and the FuncGetOther take the HEXSPAN.
+		//The hashes are not cryptographic, the colliding blocks are possible, so the matches' bytes are compared
+		//first, and only the equal runs of them are kept.
+		std::vector<MATCH> vecVerified;
+		vecVerified.reserve(vecMatch.size());
+		for (const auto& refMatch : vecMatch) {
+			for (auto ullPos { 0ULL }; ullPos < refMatch.ullSize;) {
+				const auto ullSize = (std::min)(refMatch.ullSize - ullPos, ullSizeChunk);
+				const auto spnData = FuncGetData(HEXSPAN { refMatch.ullOffset + ullPos, ullSize });
+				const auto spnOther = FuncGetOther(HEXSPAN { refMatch.ullOffsetOther + ullPos, ullSize });
+				if (spnData.size() < ullSize || spnOther.size() < ullSize)
+					break;
+
+				const auto sSize = static_cast<std::size_t>(ullSize);
+				for (std::size_t sPos { 0 }; sPos < sSize;) {
+					const auto sEqual = CHexCompare::FindMismatch(spnData.data() + sPos, spnOther.data() + sPos, sSize - sPos);
+					const auto ullOffset = refMatch.ullOffset + ullPos + sPos;
+					const auto ullOffsetOther = refMatch.ullOffsetOther + ullPos + sPos;
+					if (sEqual > 0 && !vecVerified.empty() && vecVerified.back().ullOffset + vecVerified.back().ullSize == ullOffset
+						&& vecVerified.back().ullOffsetOther + vecVerified.back().ullSize == ullOffsetOther) {
+						vecVerified.back().ullSize += sEqual; //Continues through the chunks.
+					}
+					else if (sEqual > 0) {
+						vecVerified.emplace_back(ullOffset, ullOffsetOther, sEqual);
+					}
+
+					sPos += sEqual;
+					if (sPos < sSize) {
+						sPos += CHexCompare::FindMatch(spnData.data() + sPos, spnOther.data() + sPos, sSize - sPos);
+					}
+				}
+				ullPos += ullSize;
+			}
+		}
+		vecMatch = std::move(vecVerified);
+
+		//Every match is extended backward up to the previous match end, and forward up to the next match start.
+		for (std::size_t i { 0 }; i < vecMatch.size(); ++i) {
+			auto& refMatch = vecMatch[i];
+			const auto ullPrevEnd = i > 0 ? vecMatch[i - 1].ullOffset + vecMatch[i - 1].ullSize : 0ULL;
+			auto ullMax = (std::min)(refMatch.ullOffset - ullPrevEnd, refMatch.ullOffsetOther);
+			while (ullMax > 0) {
+				const auto ullSize = (std::min)(ullMax, ullSizeChunk);
+				const auto spnData = FuncGetData(HEXSPAN { refMatch.ullOffset - ullSize, ullSize });
+				const auto spnOther = FuncGetOther(HEXSPAN { refMatch.ullOffsetOther - ullSize, ullSize });
+				if (spnData.size() < ullSize || spnOther.size() < ullSize)
+					break;
+
+				const auto sSize = static_cast<std::size_t>(ullSize);
+				std::size_t sEqual { 0 };
+				while (sEqual < sSize && spnData[sSize - sEqual - 1] == spnOther[sSize - sEqual - 1]) {
+					++sEqual;
+				}
+				refMatch.ullOffset -= sEqual;
+				refMatch.ullOffsetOther -= sEqual;
+				refMatch.ullSize += sEqual;
+				if (sEqual < sSize)
+					break;
+
+				ullMax -= ullSize;
+			}
+
+			const auto ullNextStart = i + 1 < vecMatch.size() ? vecMatch[i + 1].ullOffset : ullDataSize;
+			ullMax = (std::min)(ullNextStart - (refMatch.ullOffset + refMatch.ullSize),
+				ullSizeOther - (refMatch.ullOffsetOther + refMatch.ullSize));
+			while (ullMax > 0) {
+				const auto ullSize = (std::min)(ullMax, ullSizeChunk);
+				const auto spnData = FuncGetData(HEXSPAN { refMatch.ullOffset + refMatch.ullSize, ullSize });
+				const auto spnOther = FuncGetOther(HEXSPAN { refMatch.ullOffsetOther + refMatch.ullSize, ullSize });
+				if (spnData.size() < ullSize || spnOther.size() < ullSize)
+					break;
+
+				const auto sEqual = CHexCompare::FindMismatch(spnData.data(), spnOther.data(), static_cast<std::size_t>(ullSize));
+				refMatch.ullSize += sEqual;
+				if (sEqual < ullSize)
+					break;
+
+				ullMax -= ullSize;
+			}
+		}
+	}
+
+	auto CHexDiff::JoinMatches(std::vector<MATCH>&& vecMatch)->std::vector<MATCH>
+	{
+		//Parts' matches can overlap at the parts bounds, the later match is cut.
+		std::sort(vecMatch.begin(), vecMatch.end(), [](const MATCH& lhs, const MATCH& rhs) {
+			return lhs.ullOffset < rhs.ullOffset; });
+		std::vector<MATCH> vecJoined;
+		for (auto stMatch : vecMatch) {
+			if (!vecJoined.empty()) {
+				auto& refBack = vecJoined.back();
+				const auto ullBackEnd = refBack.ullOffset + refBack.ullSize;
+				if (stMatch.ullOffset < ullBackEnd) {
+					const auto ullCut = ullBackEnd - stMatch.ullOffset;
+					if (ullCut >= stMatch.ullSize)
+						continue;
+
+					stMatch.ullOffset += ullCut;
+					stMatch.ullOffsetOther += ullCut;
+					stMatch.ullSize -= ullCut;
+				}
+
+				if (stMatch.ullOffset == ullBackEnd && stMatch.ullOffsetOther == refBack.ullOffsetOther + refBack.ullSize) {
+					refBack.ullSize += stMatch.ullSize;
+					continue;
+				}
+			}
+			vecJoined.emplace_back(stMatch);
+		}
+
+		return vecJoined;
+	}
+
+	auto CHexDiff::ToOps(const std::vector<MATCH>& vecMatch, ULONGLONG ullDataSize)->std::vector<HEXDIFFOP>
+	{
+		using enum EHexDiffOp;
+		std::vector<HEXDIFFOP> vecOps;
+		ULONGLONG ullPos { 0 };
+		for (const auto& refMatch : vecMatch) {
+			if (refMatch.ullOffset > ullPos) {
+				vecOps.emplace_back(ullPos, refMatch.ullOffset - ullPos, 0ULL, DIFF_INSERT);
+			}
+
+			if (!vecOps.empty() && vecOps.back().eOp == DIFF_COPY && vecOps.back().ullOffset + vecOps.back().ullSize == refMatch.ullOffset
+				&& vecOps.back().ullOffsetOther + vecOps.back().ullSize == refMatch.ullOffsetOther) {
+				vecOps.back().ullSize += refMatch.ullSize; //Joined by the extension.
+			}
+			else {
+				vecOps.emplace_back(refMatch.ullOffset, refMatch.ullSize, refMatch.ullOffsetOther, DIFF_COPY);
+			}
+			ullPos = refMatch.ullOffset + refMatch.ullSize;
+		}
+
+		if (ullDataSize > ullPos) {
+			vecOps.emplace_back(ullPos, ullDataSize - ullPos, 0ULL, DIFF_INSERT);
+		}
+
+		return vecOps;
+	}
+
+
+	//Private methods.
+
+	auto CHexDiff::Find(std::uint32_t u32Weak, const std::byte* pData, ULONGLONG ullOffsetOtherNext)const->ULONGLONG
+	{
+		const auto [iterFirst, iterLast] = std::equal_range(m_vecBlock.begin(), m_vecBlock.end(), BLOCK { .u32Weak { u32Weak } },
+			[](const BLOCK& lhs, const BLOCK& rhs) { return lhs.u32Weak < rhs.u32Weak; });
+		if (iterFirst == iterLast)
+			return m_ullNone;
+
+		const auto u64Strong = GetStrong(pData, m_dwBlockSize);
+		auto ullFound { m_ullNone };
+		for (auto iter = iterFirst; iter != iterLast; ++iter) {
+			if (iter->u64Strong != u64Strong)
+				continue;
+
+			const auto ullOffsetOther = static_cast<ULONGLONG>(iter->u32Index) * m_dwBlockSize;
+			if (ullOffsetOther == ullOffsetOtherNext)
+				return ullOffsetOther;
+
+			if (ullFound == m_ullNone) {
+				ullFound = ullOffsetOther;
+			}
+		}
+
+		return ullFound;
+	}
+
+	auto CHexDiff::GetFilterBit(std::uint32_t u32Weak)->std::uint32_t
+	{
+		return (u32Weak * 0x9E3779B1U) >> (32 - m_uFilterBits);
+	}
+
+	auto CHexDiff::GetStrong(const std::byte* pData, std::size_t sSize)->std::uint64_t
+	{
+		//Only confirms the weak hash hits, it's not a cryptographic hash.
+		std::uint64_t u64Hash { 0x9E3779B97F4A7C15ULL ^ sSize };
+		std::size_t i { 0 };
+		for (; i + sizeof(std::uint64_t) <= sSize; i += sizeof(std::uint64_t)) {
+			u64Hash = (u64Hash ^ ut::LoadTData<std::uint64_t>(pData + i, false)) * 0xFF51AFD7ED558CCDULL;
+			u64Hash ^= u64Hash >> 32;
+		}
+		for (; i < sSize; ++i) {
+			u64Hash = (u64Hash ^ std::to_integer<std::uint64_t>(pData[i])) * 0xC4CEB9FE1A85EC53ULL;
+			u64Hash ^= u64Hash >> 29;
+		}
+
+		return u64Hash;
+	}
+
+	auto CHexDiff::GetWeak(const std::byte* pData, std::size_t sSize)->std::pair<std::uint32_t, std::uint32_t>
+	{
+		//The rsync checksum: the bytes sum, and the sum of the bytes weighted by their distance from the window end.
+		std::uint32_t u32A { };
+		std::uint32_t u32B { };
+		for (std::size_t i { 0 }; i < sSize; ++i) {
+			const auto u32Byte = std::to_integer<std::uint32_t>(pData[i]);
+			u32A += u32Byte;
+			u32B += static_cast<std::uint32_t>(sSize - i) * u32Byte;
+		}
+
+		return { u32A, u32B };
+	}
+}
\ No newline at end of file
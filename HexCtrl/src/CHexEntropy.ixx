@@ -0,0 +1,303 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <vector>
+export module HEXCTRL.CHexEntropy;
+
+import HEXCTRL.CHexDlgProgress;
+import HEXCTRL.CHexParallel;
+import HEXCTRL.CHexReader;
+
+namespace HEXCTRL::INTERNAL {
+	using HistBlock = std::array<std::uint32_t, 256>;
+
+	//Adds the byte-value counts of the data to the histogram.
+	//Consecutive increments of the same counter stall on the store-to-load forwarding,
+	//hence the bytes are spread among four sub-histograms that are summed at the end.
+	void Histogram(SpanCByte spnData, HistBlock& arrHist)
+	{
+		std::array<HistBlock, 4> arrSub { };
+		auto pData = reinterpret_cast<const std::uint8_t*>(spnData.data());
+		auto sSize = spnData.size();
+		for (; sSize >= sizeof(std::uint64_t); sSize -= sizeof(std::uint64_t), pData += sizeof(std::uint64_t)) {
+			std::uint64_t u64Data;
+			std::memcpy(&u64Data, pData, sizeof(u64Data));
+			++arrSub[0][u64Data & 0xFF];
+			++arrSub[1][(u64Data >> 8) & 0xFF];
+			++arrSub[2][(u64Data >> 16) & 0xFF];
+			++arrSub[3][(u64Data >> 24) & 0xFF];
+			++arrSub[0][(u64Data >> 32) & 0xFF];
+			++arrSub[1][(u64Data >> 40) & 0xFF];
+			++arrSub[2][(u64Data >> 48) & 0xFF];
+			++arrSub[3][u64Data >> 56];
+		}
+
+		for (; sSize > 0; --sSize) {
+			++arrSub[0][*pData++];
+		}
+
+		for (auto i { 0U }; i < 256U; ++i) {
+			arrHist[i] += arrSub[0][i] + arrSub[1][i] + arrSub[2][i] + arrSub[3][i];
+		}
+	}
+
+	//Shannon entropy in bits per byte.
+	template<typename T>
+	[[nodiscard]] auto Entropy(const std::array<T, 256>& arrHist, ULONGLONG ullTotal)->double
+	{
+		if (ullTotal == 0)
+			return 0.;
+
+		double dSum { };
+		for (const auto tCount : arrHist) {
+			if (tCount > 0) {
+				const auto dCount = static_cast<double>(tCount);
+				dSum += dCount * std::log2(dCount);
+			}
+		}
+
+		const auto dTotal = static_cast<double>(ullTotal);
+		return (std::max)(std::log2(dTotal) - (dSum / dTotal), 0.);
+	}
+
+	//Whole data histogram along with the per-block entropy map.
+	//Blocks touched by the data modifications are marked as dirty, their counts are subtracted
+	//from the whole histogram, and only these blocks are recomputed on the next Update call.
+	export class CHexEntropy final {
+	public:
+		void ClearAll();
+		[[nodiscard]] auto GetEntropy()const->HEXENTROPY;
+		[[nodiscard]] auto GetSizeToUpdate(DWORD dwBlockSize)const->ULONGLONG; //Data size the Update will process.
+		void Initialize(IHexCtrl* pHexCtrl);
+		[[nodiscard]] bool IsUpdated(DWORD dwBlockSize)const;                  //No blocks left to compute.
+		void SetDirty(const VecSpan& vecSpan); //Must be called before the data in the vecSpan is modified.
+		void Update(DWORD dwBlockSize, CHexDlgProgress& dlgProg);
+	private:
+		[[nodiscard]] auto GetBlockHist(CHexReader& refReader, ULONGLONG ullBlock)const->HistBlock;
+		[[nodiscard]] auto GetBlockSpan(ULONGLONG ullBlock)const->HEXSPAN;
+		[[nodiscard]] bool IsValid(DWORD dwBlockSize)const;
+		void UpdateBlocks(CHexReader& refReader, ULONGLONG ullFirst, ULONGLONG ullCount, std::array<ULONGLONG, 256>& arrHist);
+	private:
+		IHexCtrl* m_pHexCtrl { };
+		std::array<ULONGLONG, 256> m_arrHist { }; //Histogram of all the non-dirty blocks.
+		std::vector<float> m_vecBlockEntropy;     //Entropy of every block.
+		std::vector<std::uint8_t> m_vecDirty;     //Blocks to compute, not a vector<bool> to be written concurrently.
+		ULONGLONG m_ullDataSize { };              //Data size the blocks are laid out for.
+		ULONGLONG m_ullDirty { };                 //Dirty blocks count.
+		DWORD m_dwBlockSize { };
+	};
+
+	void CHexEntropy::ClearAll()
+	{
+		m_arrHist = { };
+		m_vecBlockEntropy.clear();
+		m_vecDirty.clear();
+		m_ullDataSize = 0;
+		m_ullDirty = 0;
+		m_dwBlockSize = 0;
+	}
+
+	auto CHexEntropy::GetEntropy()const->HEXENTROPY
+	{
+		return { .arrHist { m_arrHist }, .vecBlockEntropy { m_vecBlockEntropy }, .dwBlockSize { m_dwBlockSize },
+			.dEntropy { Entropy(m_arrHist, m_ullDataSize) } };
+	}
+
+	auto CHexEntropy::GetSizeToUpdate(DWORD dwBlockSize)const->ULONGLONG
+	{
+		if (m_pHexCtrl == nullptr || !m_pHexCtrl->IsDataSet())
+			return 0ULL;
+
+		if (!IsValid(dwBlockSize))
+			return m_pHexCtrl->GetDataSize();
+
+		return (std::min)(m_ullDirty * m_dwBlockSize, m_ullDataSize);
+	}
+
+	void CHexEntropy::Initialize(IHexCtrl* pHexCtrl)
+	{
+		assert(pHexCtrl != nullptr);
+		m_pHexCtrl = pHexCtrl;
+	}
+
+	bool CHexEntropy::IsUpdated(DWORD dwBlockSize)const
+	{
+		return IsValid(dwBlockSize) && m_ullDirty == 0;
+	}
+
+	void CHexEntropy::SetDirty(const VecSpan& vecSpan)
+	{
+		if (m_vecDirty.empty() || m_pHexCtrl == nullptr)
+			return;
+
+		if (m_ullDataSize != m_pHexCtrl->GetDataSize()) {
+			ClearAll();
+			return;
+		}
+
+		//Clean blocks' counts are read back to be subtracted from the whole histogram.
+		//If the modification is big, it's cheaper to just recompute everything later.
+		const auto ullBlocks = static_cast<ULONGLONG>(m_vecDirty.size());
+		ULONGLONG ullToSubtract { };
+		for (const auto& hss : vecSpan) {
+			if (hss.ullSize == 0 || hss.ullOffset >= m_ullDataSize)
+				continue;
+
+			const auto ullLast = (std::min)((hss.ullOffset + hss.ullSize - 1) / m_dwBlockSize, ullBlocks - 1);
+			for (auto ullBlock = hss.ullOffset / m_dwBlockSize; ullBlock <= ullLast; ++ullBlock) {
+				ullToSubtract += m_vecDirty[static_cast<std::size_t>(ullBlock)] == 0 ? 1 : 0;
+			}
+		}
+
+		if (ullToSubtract > ullBlocks / 4) {
+			ClearAll();
+			return;
+		}
+
+		CHexReader reader(m_pHexCtrl);
+		for (const auto& hss : vecSpan) {
+			if (hss.ullSize == 0 || hss.ullOffset >= m_ullDataSize)
+				continue;
+
+			const auto ullLast = (std::min)((hss.ullOffset + hss.ullSize - 1) / m_dwBlockSize, ullBlocks - 1);
+			for (auto ullBlock = hss.ullOffset / m_dwBlockSize; ullBlock <= ullLast; ++ullBlock) {
+				if (m_vecDirty[static_cast<std::size_t>(ullBlock)] != 0)
+					continue;
+
+				const auto arrBlock = GetBlockHist(reader, ullBlock);
+				for (auto i { 0U }; i < 256U; ++i) {
+					m_arrHist[i] -= arrBlock[i];
+				}
+				m_vecDirty[static_cast<std::size_t>(ullBlock)] = 1;
+				++m_ullDirty;
+			}
+		}
+	}
+
+	void CHexEntropy::Update(DWORD dwBlockSize, CHexDlgProgress& dlgProg)
+	{
+		assert(dwBlockSize > 0);
+		if (m_pHexCtrl == nullptr || !m_pHexCtrl->IsDataSet() || dwBlockSize == 0)
+			return;
+
+		if (!IsValid(dwBlockSize)) {
+			ClearAll();
+			m_dwBlockSize = dwBlockSize;
+			m_ullDataSize = m_pHexCtrl->GetDataSize();
+			m_ullDirty = (m_ullDataSize / dwBlockSize) + (m_ullDataSize % dwBlockSize > 0 ? 1 : 0);
+			m_vecBlockEntropy.assign(static_cast<std::size_t>(m_ullDirty), 0.F);
+			m_vecDirty.assign(static_cast<std::size_t>(m_ullDirty), 1);
+		}
+
+		if (m_ullDirty == 0)
+			return;
+
+		//Contiguous dirty blocks are grouped into runs, every run is read at once.
+		//In VirtualData mode the run is limited by the cache size.
+		const auto fVirtual = m_pHexCtrl->IsVirtual();
+		const auto ullRunSizeMax = fVirtual ? static_cast<ULONGLONG>(m_pHexCtrl->GetCacheSize()) : 1024ULL * 1024ULL;
+		const auto ullRunBlocksMax = (std::max)(ullRunSizeMax / m_dwBlockSize, 1ULL);
+		std::vector<std::pair<ULONGLONG, ULONGLONG>> vecRuns; //First block and blocks count.
+		for (auto ullBlock { 0ULL }; ullBlock < m_vecDirty.size(); ++ullBlock) {
+			if (m_vecDirty[static_cast<std::size_t>(ullBlock)] == 0)
+				continue;
+
+			if (!vecRuns.empty() && vecRuns.back().first + vecRuns.back().second == ullBlock
+				&& vecRuns.back().second < ullRunBlocksMax) {
+				++vecRuns.back().second;
+			}
+			else {
+				vecRuns.emplace_back(ullBlock, 1ULL);
+			}
+		}
+
+		//Runs' histograms are added to the whole one as they are done, the runs' blocks are disjoint.
+		std::mutex mtxHist;
+		CHexParallel par(m_pHexCtrl, &dlgProg);
+		par.Run(vecRuns.size(), [&](std::size_t sIndex, CHexReader& refReader) {
+			const auto [ullFirst, ullCount] = vecRuns[sIndex];
+			std::array<ULONGLONG, 256> arrHistRun { };
+			UpdateBlocks(refReader, ullFirst, ullCount, arrHistRun);
+			par.AddProcessed(ullCount * m_dwBlockSize);
+
+			const std::scoped_lock lock(mtxHist);
+			for (auto i { 0U }; i < 256U; ++i) {
+				m_arrHist[i] += arrHistRun[i];
+			}
+			}, fVirtual);
+
+		m_ullDirty = static_cast<ULONGLONG>(std::count(m_vecDirty.begin(), m_vecDirty.end(), std::uint8_t { 1 }));
+	}
+
+
+	//Private methods.
+
+	auto CHexEntropy::GetBlockHist(CHexReader& refReader, ULONGLONG ullBlock)const->HistBlock
+	{
+		HistBlock arrBlock { };
+		const auto hss = GetBlockSpan(ullBlock);
+		const auto ullSizeChunkMax = m_pHexCtrl->IsVirtual() ? static_cast<ULONGLONG>(m_pHexCtrl->GetCacheSize()) : hss.ullSize;
+		const auto ullOffsetEnd = hss.ullOffset + hss.ullSize;
+		for (auto ullOffsetCurr = hss.ullOffset; ullOffsetCurr < ullOffsetEnd;) {
+			const auto ullSizeCurr = (std::min)(ullOffsetEnd - ullOffsetCurr, ullSizeChunkMax);
+			const auto spnData = refReader.GetData({ ullOffsetCurr, ullSizeCurr });
+			assert(!spnData.empty());
+			Histogram(spnData, arrBlock);
+			ullOffsetCurr += ullSizeCurr;
+		}
+
+		return arrBlock;
+	}
+
+	auto CHexEntropy::GetBlockSpan(ULONGLONG ullBlock)const->HEXSPAN
+	{
+		const auto ullOffset = ullBlock * m_dwBlockSize;
+		return { .ullOffset { ullOffset }, .ullSize { (std::min)(static_cast<ULONGLONG>(m_dwBlockSize), m_ullDataSize - ullOffset) } };
+	}
+
+	bool CHexEntropy::IsValid(DWORD dwBlockSize)const
+	{
+		return m_pHexCtrl != nullptr && !m_vecDirty.empty() && m_dwBlockSize == dwBlockSize
+			&& m_ullDataSize == m_pHexCtrl->GetDataSize();
+	}
+
+	void CHexEntropy::UpdateBlocks(CHexReader& refReader, ULONGLONG ullFirst, ULONGLONG ullCount, std::array<ULONGLONG, 256>& arrHist)
+	{
+		const auto hssFirst = GetBlockSpan(ullFirst);
+		const auto hssLast = GetBlockSpan(ullFirst + ullCount - 1);
+		const auto ullSizeRun = hssLast.ullOffset + hssLast.ullSize - hssFirst.ullOffset;
+
+		//The block that is bigger than the cache size is read chunk by chunk in the GetBlockHist.
+		const auto fReadRun = !m_pHexCtrl->IsVirtual() || ullSizeRun <= m_pHexCtrl->GetCacheSize();
+		const auto spnRun = fReadRun ? refReader.GetData({ hssFirst.ullOffset, ullSizeRun }) : SpanCByte { };
+		for (auto ullBlock = ullFirst; ullBlock < ullFirst + ullCount; ++ullBlock) {
+			const auto hss = GetBlockSpan(ullBlock);
+			HistBlock arrBlock { };
+			if (fReadRun) {
+				Histogram(spnRun.subspan(static_cast<std::size_t>(hss.ullOffset - hssFirst.ullOffset),
+					static_cast<std::size_t>(hss.ullSize)), arrBlock);
+			}
+			else {
+				arrBlock = GetBlockHist(refReader, ullBlock);
+			}
+
+			for (auto i { 0U }; i < 256U; ++i) {
+				arrHist[i] += arrBlock[i];
+			}
+			m_vecBlockEntropy[static_cast<std::size_t>(ullBlock)] = static_cast<float>(Entropy(arrBlock, hss.ullSize));
+			m_vecDirty[static_cast<std::size_t>(ullBlock)] = 0;
+		}
+	}
+}
\ No newline at end of file
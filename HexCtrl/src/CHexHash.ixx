@@ -0,0 +1,716 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <intrin.h>
+#include <memory>
+#include <vector>
+export module HEXCTRL.CHexHash;
+
+import HEXCTRL.HexUtility;
+
+namespace HEXCTRL::INTERNAL {
+	//Streaming hasher interface, Update may be called any number of times before the Final.
+	export class IHexHasher {
+	public:
+		virtual ~IHexHasher() = default;
+		[[nodiscard]] virtual auto Final() -> std::vector<std::byte> = 0; //Finalize and get the digest.
+		virtual void Update(SpanCByte spnData) = 0;                       //Feed the next data chunk.
+	};
+
+	export [[nodiscard]] auto CreateHasher(EHexHash eHash) -> std::unique_ptr<IHexHasher>;
+	export [[nodiscard]] auto GetHashName(EHexHash eHash) -> std::wstring_view;
+}
+
+namespace HEXCTRL::INTERNAL {
+	template<typename T>
+	[[nodiscard]] auto LoadT(const std::byte* pData) -> T {
+		T tData;
+		std::memcpy(&tData, pData, sizeof(T));
+		return tData;
+	}
+
+	template<typename T>
+	[[nodiscard]] auto ToBytesBE(T tData) -> std::vector<std::byte> { //Integral to the big-endian bytes.
+		std::vector<std::byte> vecBytes(sizeof(T));
+		for (auto i { 0U }; i < sizeof(T); ++i) {
+			vecBytes[i] = static_cast<std::byte>(tData >> ((sizeof(T) - 1 - i) * 8));
+		}
+		return vecBytes;
+	}
+
+	//Slicing-by-8 tables for the reflected CRC32 polynomials.
+	using CRCTable = std::array<std::array<std::uint32_t, 256>, 8>;
+	[[nodiscard]] consteval auto MakeCRCTable(std::uint32_t u32Poly) -> CRCTable {
+		CRCTable arrTable { };
+		for (auto i { 0U }; i < 256U; ++i) {
+			auto u32CRC = i;
+			for (auto j { 0 }; j < 8; ++j) {
+				u32CRC = (u32CRC & 1U) ? ((u32CRC >> 1) ^ u32Poly) : (u32CRC >> 1);
+			}
+			arrTable[0][i] = u32CRC;
+		}
+		for (auto i { 0U }; i < 256U; ++i) {
+			for (auto iSlice { 1U }; iSlice < 8U; ++iSlice) {
+				const auto u32Prev = arrTable[iSlice - 1][i];
+				arrTable[iSlice][i] = (u32Prev >> 8) ^ arrTable[0][u32Prev & 0xFFU];
+			}
+		}
+		return arrTable;
+	}
+
+	constexpr auto g_arrCRC32 = MakeCRCTable(0xEDB88320U);  //CRC-32 (ISO-HDLC).
+	constexpr auto g_arrCRC32C = MakeCRCTable(0x82F63B78U); //CRC-32C (Castagnoli).
+
+	[[nodiscard]] auto CRCSlice8(const CRCTable& refTable, const std::byte* pData, std::size_t sSize,
+		std::uint32_t u32CRC) -> std::uint32_t {
+		for (; sSize >= 8; sSize -= 8, pData += 8) {
+			const auto u32Lo = LoadT<std::uint32_t>(pData) ^ u32CRC;
+			const auto u32Hi = LoadT<std::uint32_t>(pData + 4);
+			u32CRC = refTable[7][u32Lo & 0xFFU] ^ refTable[6][(u32Lo >> 8) & 0xFFU]
+				^ refTable[5][(u32Lo >> 16) & 0xFFU] ^ refTable[4][u32Lo >> 24]
+				^ refTable[3][u32Hi & 0xFFU] ^ refTable[2][(u32Hi >> 8) & 0xFFU]
+				^ refTable[1][(u32Hi >> 16) & 0xFFU] ^ refTable[0][u32Hi >> 24];
+		}
+		for (; sSize > 0; --sSize, ++pData) {
+			u32CRC = (u32CRC >> 8) ^ refTable[0][(u32CRC ^ static_cast<std::uint8_t>(*pData)) & 0xFFU];
+		}
+		return u32CRC;
+	}
+
+#if defined(_M_IX86) || defined(_M_X64)
+	//CRC-32 with the carry-less multiplication folding, four 128-bit lanes at a time.
+	//sSize must be at least 64 and a multiple of 16. Takes and returns the non-inverted CRC state.
+	[[nodiscard]] auto CRC32CLMUL(const std::byte* pData, std::size_t sSize, std::uint32_t u32CRC) -> std::uint32_t {
+		assert(sSize >= 64 && sSize % 16 == 0);
+		const auto pVec = reinterpret_cast<const __m128i*>(pData);
+		auto m128i1 = _mm_xor_si128(_mm_loadu_si128(pVec), _mm_cvtsi32_si128(static_cast<int>(u32CRC)));
+		auto m128i2 = _mm_loadu_si128(pVec + 1);
+		auto m128i3 = _mm_loadu_si128(pVec + 2);
+		auto m128i4 = _mm_loadu_si128(pVec + 3);
+		pData += 64;
+		sSize -= 64;
+
+		auto m128iK = _mm_set_epi64x(0x01C6E41596LL, 0x0154442BD4LL); //k1, k2.
+		const auto lmbFold = [&m128iK](__m128i m128iAcc, __m128i m128iNext) {
+			const auto m128iLo = _mm_clmulepi64_si128(m128iAcc, m128iK, 0x00);
+			const auto m128iHi = _mm_clmulepi64_si128(m128iAcc, m128iK, 0x11);
+			return _mm_xor_si128(_mm_xor_si128(m128iLo, m128iHi), m128iNext);
+			};
+
+		for (; sSize >= 64; sSize -= 64, pData += 64) {
+			const auto pVecCurr = reinterpret_cast<const __m128i*>(pData);
+			m128i1 = lmbFold(m128i1, _mm_loadu_si128(pVecCurr));
+			m128i2 = lmbFold(m128i2, _mm_loadu_si128(pVecCurr + 1));
+			m128i3 = lmbFold(m128i3, _mm_loadu_si128(pVecCurr + 2));
+			m128i4 = lmbFold(m128i4, _mm_loadu_si128(pVecCurr + 3));
+		}
+
+		//Fold four lanes into one, then the rest 16 bytes blocks.
+		m128iK = _mm_set_epi64x(0x00CCAA009ELL, 0x01751997D0LL); //k3, k4.
+		m128i1 = lmbFold(m128i1, m128i2);
+		m128i1 = lmbFold(m128i1, m128i3);
+		m128i1 = lmbFold(m128i1, m128i4);
+		for (; sSize >= 16; sSize -= 16, pData += 16) {
+			m128i1 = lmbFold(m128i1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData)));
+		}
+
+		//Fold 128 bits to 64 bits.
+		const auto m128iMask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+		auto m128iTmp = _mm_clmulepi64_si128(m128i1, m128iK, 0x10);
+		m128i1 = _mm_xor_si128(_mm_srli_si128(m128i1, 8), m128iTmp);
+		m128iK = _mm_set_epi64x(0, 0x0163CD6124LL); //k5.
+		m128iTmp = _mm_srli_si128(m128i1, 4);
+		m128i1 = _mm_clmulepi64_si128(_mm_and_si128(m128i1, m128iMask32), m128iK, 0x00);
+		m128i1 = _mm_xor_si128(m128i1, m128iTmp);
+
+		//Barrett reduction to 32 bits.
+		m128iK = _mm_set_epi64x(0x01F7011641LL, 0x01DB710641LL); //Polynomial and its mu.
+		m128iTmp = _mm_clmulepi64_si128(_mm_and_si128(m128i1, m128iMask32), m128iK, 0x10);
+		m128iTmp = _mm_clmulepi64_si128(_mm_and_si128(m128iTmp, m128iMask32), m128iK, 0x00);
+		m128i1 = _mm_xor_si128(m128i1, m128iTmp);
+
+		return static_cast<std::uint32_t>(_mm_extract_epi32(m128i1, 1));
+	}
+
+	//SHA-256 block function with the SHA extensions.
+	void SHA256SHANI(std::uint32_t* pState, const std::byte* pData, std::size_t sBlocks, const std::uint32_t* pK) {
+		const auto m128iMaskBE = _mm_set_epi64x(0x0C0D0E0F08090A0BLL, 0x0405060700010203LL);
+		auto m128iTmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pState)), 0xB1);
+		auto m128iState1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pState + 4)), 0x1B);
+		auto m128iState0 = _mm_alignr_epi8(m128iTmp, m128iState1, 8);    //ABEF.
+		m128iState1 = _mm_blend_epi16(m128iState1, m128iTmp, 0xF0);      //CDGH.
+
+		for (; sBlocks > 0; --sBlocks, pData += 64) {
+			const auto m128iSave0 = m128iState0;
+			const auto m128iSave1 = m128iState1;
+			__m128i arrMsg[4];
+			for (auto i { 0 }; i < 16; ++i) { //Four rounds per iteration.
+				if (i < 4) {
+					arrMsg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData) + i), m128iMaskBE);
+				}
+				else {
+					const auto m128iMsg1 = _mm_sha256msg1_epu32(arrMsg[i & 3], arrMsg[(i + 1) & 3]);
+					const auto m128iW7 = _mm_alignr_epi8(arrMsg[(i + 3) & 3], arrMsg[(i + 2) & 3], 4);
+					arrMsg[i & 3] = _mm_sha256msg2_epu32(_mm_add_epi32(m128iMsg1, m128iW7), arrMsg[(i + 3) & 3]);
+				}
+				auto m128iMsgK = _mm_add_epi32(arrMsg[i & 3], _mm_loadu_si128(reinterpret_cast<const __m128i*>(pK) + i));
+				m128iState1 = _mm_sha256rnds2_epu32(m128iState1, m128iState0, m128iMsgK);
+				m128iMsgK = _mm_shuffle_epi32(m128iMsgK, 0x0E);
+				m128iState0 = _mm_sha256rnds2_epu32(m128iState0, m128iState1, m128iMsgK);
+			}
+			m128iState0 = _mm_add_epi32(m128iState0, m128iSave0);
+			m128iState1 = _mm_add_epi32(m128iState1, m128iSave1);
+		}
+
+		m128iTmp = _mm_shuffle_epi32(m128iState0, 0x1B);           //FEBA.
+		m128iState1 = _mm_shuffle_epi32(m128iState1, 0xB1);        //DCHG.
+		m128iState0 = _mm_blend_epi16(m128iTmp, m128iState1, 0xF0); //DCBA.
+		m128iState1 = _mm_alignr_epi8(m128iState1, m128iTmp, 8);   //HGFE.
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pState), m128iState0);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pState + 4), m128iState1);
+	}
+#endif //^^^ _M_IX86 || _M_X64
+
+
+	//CRC-32.
+	class CHasherCRC32 final : public IHexHasher {
+	public:
+		[[nodiscard]] auto Final() -> std::vector<std::byte>override { return ToBytesBE(~m_u32CRC); }
+		void Update(SpanCByte spnData)override;
+	private:
+		std::uint32_t m_u32CRC { 0xFFFFFFFFU };
+	};
+
+	void CHasherCRC32::Update(SpanCByte spnData)
+	{
+		auto pData = spnData.data();
+		auto sSize = spnData.size();
+	#if defined(_M_IX86) || defined(_M_X64)
+		if (sSize >= 64 && ut::HasPCLMUL()) {
+			const auto sSizeFold = sSize & ~static_cast<std::size_t>(15);
+			m_u32CRC = CRC32CLMUL(pData, sSizeFold, m_u32CRC);
+			pData += sSizeFold;
+			sSize -= sSizeFold;
+		}
+	#endif //^^^ _M_IX86 || _M_X64
+		m_u32CRC = CRCSlice8(g_arrCRC32, pData, sSize, m_u32CRC);
+	}
+
+
+	//CRC-32C.
+	class CHasherCRC32C final : public IHexHasher {
+	public:
+		[[nodiscard]] auto Final() -> std::vector<std::byte>override { return ToBytesBE(~m_u32CRC); }
+		void Update(SpanCByte spnData)override;
+	private:
+		std::uint32_t m_u32CRC { 0xFFFFFFFFU };
+	};
+
+	void CHasherCRC32C::Update(SpanCByte spnData)
+	{
+		auto pData = spnData.data();
+		auto sSize = spnData.size();
+	#if defined(_M_IX86) || defined(_M_X64)
+		if (ut::HasSSE42()) {
+		#if defined(_M_X64)
+			auto u64CRC = static_cast<std::uint64_t>(m_u32CRC);
+			for (; sSize >= sizeof(std::uint64_t); sSize -= sizeof(std::uint64_t), pData += sizeof(std::uint64_t)) {
+				u64CRC = _mm_crc32_u64(u64CRC, LoadT<std::uint64_t>(pData));
+			}
+			m_u32CRC = static_cast<std::uint32_t>(u64CRC);
+		#else
+			for (; sSize >= sizeof(std::uint32_t); sSize -= sizeof(std::uint32_t), pData += sizeof(std::uint32_t)) {
+				m_u32CRC = _mm_crc32_u32(m_u32CRC, LoadT<std::uint32_t>(pData));
+			}
+		#endif //^^^ _M_X64
+			for (; sSize > 0; --sSize, ++pData) {
+				m_u32CRC = _mm_crc32_u8(m_u32CRC, static_cast<std::uint8_t>(*pData));
+			}
+			return;
+		}
+	#endif //^^^ _M_IX86 || _M_X64
+		m_u32CRC = CRCSlice8(g_arrCRC32C, pData, sSize, m_u32CRC);
+	}
+
+
+	//Adler-32.
+	class CHasherAdler32 final : public IHexHasher {
+	public:
+		[[nodiscard]] auto Final() -> std::vector<std::byte>override { return ToBytesBE((m_u32B << 16) | m_u32A); }
+		void Update(SpanCByte spnData)override;
+	private:
+		static constexpr auto m_u32Base { 65521U }; //Largest prime less than 65536.
+		static constexpr auto m_u32NMax { 5552U };  //Largest n with 255n(n+1)/2 + (n+1)(Base-1) <= 2^32-1.
+		std::uint32_t m_u32A { 1U };
+		std::uint32_t m_u32B { 0U };
+	};
+
+	void CHasherAdler32::Update(SpanCByte spnData)
+	{
+		auto pData = spnData.data();
+		auto sSize = spnData.size();
+	#if defined(_M_IX86) || defined(_M_X64)
+		//32 bytes per iteration: the A sum via the SAD, and the B weighted sum via the multiply-add.
+		//The _mm_maddubs_epi16 is the SSSE3, the scalar loop goes over all the data without it.
+		constexpr auto uSizeBlock { 32U };
+		const auto m128iTap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+		const auto m128iTap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+		const auto m128iZero = _mm_setzero_si128();
+		const auto m128iOnes = _mm_set1_epi16(1);
+		auto sBlocks = ut::HasSSSE3() ? sSize / uSizeBlock : 0;
+		sSize -= sBlocks * uSizeBlock;
+		while (sBlocks > 0) {
+			auto sBlocksCurr = (std::min)(sBlocks, static_cast<std::size_t>(m_u32NMax / uSizeBlock));
+			sBlocks -= sBlocksCurr;
+			auto m128iPrevA = _mm_cvtsi32_si128(static_cast<int>(m_u32A * sBlocksCurr));
+			auto m128iB = _mm_cvtsi32_si128(static_cast<int>(m_u32B));
+			auto m128iA = _mm_setzero_si128();
+			for (; sBlocksCurr > 0; --sBlocksCurr, pData += uSizeBlock) {
+				const auto m128iData1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData));
+				const auto m128iData2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData) + 1);
+				m128iPrevA = _mm_add_epi32(m128iPrevA, m128iA);
+				m128iA = _mm_add_epi32(m128iA, _mm_sad_epu8(m128iData1, m128iZero));
+				m128iB = _mm_add_epi32(m128iB, _mm_madd_epi16(_mm_maddubs_epi16(m128iData1, m128iTap1), m128iOnes));
+				m128iA = _mm_add_epi32(m128iA, _mm_sad_epu8(m128iData2, m128iZero));
+				m128iB = _mm_add_epi32(m128iB, _mm_madd_epi16(_mm_maddubs_epi16(m128iData2, m128iTap2), m128iOnes));
+			}
+			m128iB = _mm_add_epi32(m128iB, _mm_slli_epi32(m128iPrevA, 5));
+			m128iA = _mm_add_epi32(m128iA, _mm_shuffle_epi32(m128iA, _MM_SHUFFLE(1, 0, 3, 2)));
+			m128iB = _mm_add_epi32(m128iB, _mm_shuffle_epi32(m128iB, _MM_SHUFFLE(2, 3, 0, 1)));
+			m128iB = _mm_add_epi32(m128iB, _mm_shuffle_epi32(m128iB, _MM_SHUFFLE(1, 0, 3, 2)));
+			m_u32A = (m_u32A + static_cast<std::uint32_t>(_mm_cvtsi128_si32(m128iA))) % m_u32Base;
+			m_u32B = static_cast<std::uint32_t>(_mm_cvtsi128_si32(m128iB)) % m_u32Base;
+		}
+	#endif //^^^ _M_IX86 || _M_X64
+		while (sSize > 0) {
+			auto sSizeCurr = (std::min)(sSize, static_cast<std::size_t>(m_u32NMax));
+			sSize -= sSizeCurr;
+			for (; sSizeCurr > 0; --sSizeCurr, ++pData) {
+				m_u32A += static_cast<std::uint8_t>(*pData);
+				m_u32B += m_u32A;
+			}
+			m_u32A %= m_u32Base;
+			m_u32B %= m_u32Base;
+		}
+	}
+
+
+	//xxHash64, seed zero.
+	class CHasherXXH64 final : public IHexHasher {
+	public:
+		[[nodiscard]] auto Final() -> std::vector<std::byte>override;
+		void Update(SpanCByte spnData)override;
+	private:
+		[[nodiscard]] static auto Round(std::uint64_t u64Acc, std::uint64_t u64Input) -> std::uint64_t {
+			return std::rotl(u64Acc + u64Input * m_u64Prime2, 31) * m_u64Prime1;
+		}
+		[[nodiscard]] static auto MergeRound(std::uint64_t u64Acc, std::uint64_t u64Val) -> std::uint64_t {
+			return (u64Acc ^ Round(0, u64Val)) * m_u64Prime1 + m_u64Prime4;
+		}
+		void ProcessStripes(const std::byte* pData, std::size_t sStripes);
+	private:
+		static constexpr auto m_u64Prime1 { 0x9E3779B185EBCA87ULL };
+		static constexpr auto m_u64Prime2 { 0xC2B2AE3D27D4EB4FULL };
+		static constexpr auto m_u64Prime3 { 0x165667B19E3779F9ULL };
+		static constexpr auto m_u64Prime4 { 0x85EBCA77C2B2AE63ULL };
+		static constexpr auto m_u64Prime5 { 0x27D4EB2F165667C5ULL };
+		static constexpr auto m_uSizeStripe { 32U };
+		std::uint64_t m_arrAcc[4] { m_u64Prime1 + m_u64Prime2, m_u64Prime2, 0, 0 - m_u64Prime1 };
+		std::byte m_arrBuff[m_uSizeStripe] { };
+		std::uint64_t m_u64SizeTotal { };
+		std::size_t m_sSizeBuff { };
+	};
+
+	auto CHasherXXH64::Final()->std::vector<std::byte>
+	{
+		auto u64Hash = m_u64SizeTotal >= m_uSizeStripe ?
+			std::rotl(m_arrAcc[0], 1) + std::rotl(m_arrAcc[1], 7) + std::rotl(m_arrAcc[2], 12) + std::rotl(m_arrAcc[3], 18)
+			: m_u64Prime5;
+		if (m_u64SizeTotal >= m_uSizeStripe) {
+			for (const auto u64Acc : m_arrAcc) {
+				u64Hash = MergeRound(u64Hash, u64Acc);
+			}
+		}
+		u64Hash += m_u64SizeTotal;
+
+		auto pData = m_arrBuff;
+		auto sSize = m_sSizeBuff;
+		for (; sSize >= 8; sSize -= 8, pData += 8) {
+			u64Hash = std::rotl(u64Hash ^ Round(0, LoadT<std::uint64_t>(pData)), 27) * m_u64Prime1 + m_u64Prime4;
+		}
+		if (sSize >= 4) {
+			u64Hash = std::rotl(u64Hash ^ (LoadT<std::uint32_t>(pData) * m_u64Prime1), 23) * m_u64Prime2 + m_u64Prime3;
+			sSize -= 4;
+			pData += 4;
+		}
+		for (; sSize > 0; --sSize, ++pData) {
+			u64Hash = std::rotl(u64Hash ^ (static_cast<std::uint8_t>(*pData) * m_u64Prime5), 11) * m_u64Prime1;
+		}
+
+		u64Hash ^= u64Hash >> 33;
+		u64Hash *= m_u64Prime2;
+		u64Hash ^= u64Hash >> 29;
+		u64Hash *= m_u64Prime3;
+		u64Hash ^= u64Hash >> 32;
+
+		return ToBytesBE(u64Hash);
+	}
+
+	void CHasherXXH64::Update(SpanCByte spnData)
+	{
+		auto pData = spnData.data();
+		auto sSize = spnData.size();
+		m_u64SizeTotal += sSize;
+
+		if (m_sSizeBuff > 0) {
+			const auto sSizeFill = (std::min)(m_uSizeStripe - m_sSizeBuff, sSize);
+			std::memcpy(m_arrBuff + m_sSizeBuff, pData, sSizeFill);
+			m_sSizeBuff += sSizeFill;
+			pData += sSizeFill;
+			sSize -= sSizeFill;
+			if (m_sSizeBuff < m_uSizeStripe)
+				return;
+
+			ProcessStripes(m_arrBuff, 1);
+			m_sSizeBuff = 0;
+		}
+
+		const auto sStripes = sSize / m_uSizeStripe;
+		ProcessStripes(pData, sStripes);
+		pData += sStripes * m_uSizeStripe;
+		sSize -= sStripes * m_uSizeStripe;
+
+		std::memcpy(m_arrBuff, pData, sSize);
+		m_sSizeBuff = sSize;
+	}
+
+	void CHasherXXH64::ProcessStripes(const std::byte* pData, std::size_t sStripes)
+	{
+		auto u64Acc0 = m_arrAcc[0]; auto u64Acc1 = m_arrAcc[1]; auto u64Acc2 = m_arrAcc[2]; auto u64Acc3 = m_arrAcc[3];
+		for (; sStripes > 0; --sStripes, pData += m_uSizeStripe) {
+			u64Acc0 = Round(u64Acc0, LoadT<std::uint64_t>(pData));
+			u64Acc1 = Round(u64Acc1, LoadT<std::uint64_t>(pData + 8));
+			u64Acc2 = Round(u64Acc2, LoadT<std::uint64_t>(pData + 16));
+			u64Acc3 = Round(u64Acc3, LoadT<std::uint64_t>(pData + 24));
+		}
+		m_arrAcc[0] = u64Acc0; m_arrAcc[1] = u64Acc1; m_arrAcc[2] = u64Acc2; m_arrAcc[3] = u64Acc3;
+	}
+
+
+	//Base class for the Merkle–Damgård hashers with the 64 bytes block: MD5, SHA-1, SHA-256.
+	class CHasherBlock64 : public IHexHasher {
+	public:
+		[[nodiscard]] auto Final() -> std::vector<std::byte>override;
+		void Update(SpanCByte spnData)override;
+	protected:
+		explicit CHasherBlock64(bool fSizeBE) : m_fSizeBE(fSizeBE) { }
+		[[nodiscard]] virtual auto GetDigest()const->std::vector<std::byte> = 0;
+		virtual void ProcessBlocks(const std::byte* pData, std::size_t sBlocks) = 0;
+	protected:
+		static constexpr auto m_uSizeBlock { 64U };
+	private:
+		std::byte m_arrBuff[m_uSizeBlock] { };
+		std::uint64_t m_u64SizeTotal { };
+		std::size_t m_sSizeBuff { };
+		bool m_fSizeBE { }; //Message size is appended as big-endian (SHA) or little-endian (MD5).
+	};
+
+	auto CHasherBlock64::Final()->std::vector<std::byte>
+	{
+		const auto u64SizeBits = m_u64SizeTotal * 8;
+		std::byte arrPad[m_uSizeBlock * 2] { std::byte { 0x80 } };
+		const auto sSizePad = (m_sSizeBuff < 56 ? 56 : 120) - m_sSizeBuff;
+		for (auto i { 0U }; i < 8U; ++i) {
+			arrPad[sSizePad + i] = static_cast<std::byte>(u64SizeBits >> (m_fSizeBE ? (56 - i * 8) : (i * 8)));
+		}
+		Update({ arrPad, sSizePad + 8 });
+		assert(m_sSizeBuff == 0);
+
+		return GetDigest();
+	}
+
+	void CHasherBlock64::Update(SpanCByte spnData)
+	{
+		auto pData = spnData.data();
+		auto sSize = spnData.size();
+		m_u64SizeTotal += sSize;
+
+		if (m_sSizeBuff > 0) {
+			const auto sSizeFill = (std::min)(m_uSizeBlock - m_sSizeBuff, sSize);
+			std::memcpy(m_arrBuff + m_sSizeBuff, pData, sSizeFill);
+			m_sSizeBuff += sSizeFill;
+			pData += sSizeFill;
+			sSize -= sSizeFill;
+			if (m_sSizeBuff < m_uSizeBlock)
+				return;
+
+			ProcessBlocks(m_arrBuff, 1);
+			m_sSizeBuff = 0;
+		}
+
+		if (const auto sBlocks = sSize / m_uSizeBlock; sBlocks > 0) {
+			ProcessBlocks(pData, sBlocks);
+			pData += sBlocks * m_uSizeBlock;
+			sSize -= sBlocks * m_uSizeBlock;
+		}
+
+		std::memcpy(m_arrBuff, pData, sSize);
+		m_sSizeBuff = sSize;
+	}
+
+
+	//MD5.
+	class CHasherMD5 final : public CHasherBlock64 {
+	public:
+		CHasherMD5() : CHasherBlock64(false) { }
+	private:
+		[[nodiscard]] auto GetDigest()const->std::vector<std::byte>override;
+		void ProcessBlocks(const std::byte* pData, std::size_t sBlocks)override;
+	private:
+		std::uint32_t m_arrState[4] { 0x67452301U, 0xEFCDAB89U, 0x98BADCFEU, 0x10325476U };
+	};
+
+	auto CHasherMD5::GetDigest()const->std::vector<std::byte>
+	{
+		std::vector<std::byte> vecDigest(sizeof(m_arrState));
+		std::memcpy(vecDigest.data(), m_arrState, sizeof(m_arrState)); //Little-endian words.
+		return vecDigest;
+	}
+
+	void CHasherMD5::ProcessBlocks(const std::byte* pData, std::size_t sBlocks)
+	{
+		static constexpr std::uint32_t arrK[64] {
+			0xD76AA478U, 0xE8C7B756U, 0x242070DBU, 0xC1BDCEEEU, 0xF57C0FAFU, 0x4787C62AU, 0xA8304613U, 0xFD469501U,
+			0x698098D8U, 0x8B44F7AFU, 0xFFFF5BB1U, 0x895CD7BEU, 0x6B901122U, 0xFD987193U, 0xA679438EU, 0x49B40821U,
+			0xF61E2562U, 0xC040B340U, 0x265E5A51U, 0xE9B6C7AAU, 0xD62F105DU, 0x02441453U, 0xD8A1E681U, 0xE7D3FBC8U,
+			0x21E1CDE6U, 0xC33707D6U, 0xF4D50D87U, 0x455A14EDU, 0xA9E3E905U, 0xFCEFA3F8U, 0x676F02D9U, 0x8D2A4C8AU,
+			0xFFFA3942U, 0x8771F681U, 0x6D9D6122U, 0xFDE5380CU, 0xA4BEEA44U, 0x4BDECFA9U, 0xF6BB4B60U, 0xBEBFBC70U,
+			0x289B7EC6U, 0xEAA127FAU, 0xD4EF3085U, 0x04881D05U, 0xD9D4D039U, 0xE6DB99E5U, 0x1FA27CF8U, 0xC4AC5665U,
+			0xF4292244U, 0x432AFF97U, 0xAB9423A7U, 0xFC93A039U, 0x655B59C3U, 0x8F0CCC92U, 0xFFEFF47DU, 0x85845DD1U,
+			0x6FA87E4FU, 0xFE2CE6E0U, 0xA3014314U, 0x4E0811A1U, 0xF7537E82U, 0xBD3AF235U, 0x2AD7D2BBU, 0xEB86D391U };
+		static constexpr int arrShift[4][4] { { 7, 12, 17, 22 }, { 5, 9, 14, 20 }, { 4, 11, 16, 23 }, { 6, 10, 15, 21 } };
+
+		for (; sBlocks > 0; --sBlocks, pData += m_uSizeBlock) {
+			std::uint32_t arrM[16];
+			std::memcpy(arrM, pData, sizeof(arrM));
+			auto u32A = m_arrState[0]; auto u32B = m_arrState[1]; auto u32C = m_arrState[2]; auto u32D = m_arrState[3];
+			const auto lmbStep = [&](std::uint32_t u32F, int i, std::uint32_t u32M) {
+				u32F += u32A + arrK[i] + u32M;
+				u32A = u32D;
+				u32D = u32C;
+				u32C = u32B;
+				u32B += std::rotl(u32F, arrShift[i / 16][i % 4]);
+				};
+
+			for (auto i { 0 }; i < 16; ++i) {
+				lmbStep((u32B & u32C) | (~u32B & u32D), i, arrM[i]);
+			}
+			for (auto i { 16 }; i < 32; ++i) {
+				lmbStep((u32D & u32B) | (~u32D & u32C), i, arrM[(5 * i + 1) % 16]);
+			}
+			for (auto i { 32 }; i < 48; ++i) {
+				lmbStep(u32B ^ u32C ^ u32D, i, arrM[(3 * i + 5) % 16]);
+			}
+			for (auto i { 48 }; i < 64; ++i) {
+				lmbStep(u32C ^ (u32B | ~u32D), i, arrM[(7 * i) % 16]);
+			}
+
+			m_arrState[0] += u32A; m_arrState[1] += u32B; m_arrState[2] += u32C; m_arrState[3] += u32D;
+		}
+	}
+
+
+	//SHA-1.
+	class CHasherSHA1 final : public CHasherBlock64 {
+	public:
+		CHasherSHA1() : CHasherBlock64(true) { }
+	private:
+		[[nodiscard]] auto GetDigest()const->std::vector<std::byte>override;
+		void ProcessBlocks(const std::byte* pData, std::size_t sBlocks)override;
+	private:
+		std::uint32_t m_arrState[5] { 0x67452301U, 0xEFCDAB89U, 0x98BADCFEU, 0x10325476U, 0xC3D2E1F0U };
+	};
+
+	auto CHasherSHA1::GetDigest()const->std::vector<std::byte>
+	{
+		std::vector<std::byte> vecDigest;
+		for (const auto u32Word : m_arrState) {
+			const auto vecWord = ToBytesBE(u32Word);
+			vecDigest.insert(vecDigest.end(), vecWord.begin(), vecWord.end());
+		}
+		return vecDigest;
+	}
+
+	void CHasherSHA1::ProcessBlocks(const std::byte* pData, std::size_t sBlocks)
+	{
+		for (; sBlocks > 0; --sBlocks, pData += m_uSizeBlock) {
+			std::uint32_t arrW[80];
+			for (auto i { 0 }; i < 16; ++i) {
+				arrW[i] = ut::ByteSwap(LoadT<std::uint32_t>(pData + i * 4));
+			}
+			for (auto i { 16 }; i < 80; ++i) {
+				arrW[i] = std::rotl(arrW[i - 3] ^ arrW[i - 8] ^ arrW[i - 14] ^ arrW[i - 16], 1);
+			}
+
+			auto u32A = m_arrState[0]; auto u32B = m_arrState[1]; auto u32C = m_arrState[2];
+			auto u32D = m_arrState[3]; auto u32E = m_arrState[4];
+			const auto lmbStep = [&](std::uint32_t u32F, std::uint32_t u32K, std::uint32_t u32W) {
+				const auto u32Tmp = std::rotl(u32A, 5) + u32F + u32E + u32K + u32W;
+				u32E = u32D;
+				u32D = u32C;
+				u32C = std::rotl(u32B, 30);
+				u32B = u32A;
+				u32A = u32Tmp;
+				};
+
+			for (auto i { 0 }; i < 20; ++i) {
+				lmbStep((u32B & u32C) | (~u32B & u32D), 0x5A827999U, arrW[i]);
+			}
+			for (auto i { 20 }; i < 40; ++i) {
+				lmbStep(u32B ^ u32C ^ u32D, 0x6ED9EBA1U, arrW[i]);
+			}
+			for (auto i { 40 }; i < 60; ++i) {
+				lmbStep((u32B & u32C) | (u32B & u32D) | (u32C & u32D), 0x8F1BBCDCU, arrW[i]);
+			}
+			for (auto i { 60 }; i < 80; ++i) {
+				lmbStep(u32B ^ u32C ^ u32D, 0xCA62C1D6U, arrW[i]);
+			}
+
+			m_arrState[0] += u32A; m_arrState[1] += u32B; m_arrState[2] += u32C;
+			m_arrState[3] += u32D; m_arrState[4] += u32E;
+		}
+	}
+
+
+	//SHA-256.
+	class CHasherSHA256 final : public CHasherBlock64 {
+	public:
+		CHasherSHA256() : CHasherBlock64(true) { }
+	private:
+		[[nodiscard]] auto GetDigest()const->std::vector<std::byte>override;
+		void ProcessBlocks(const std::byte* pData, std::size_t sBlocks)override;
+	private:
+		static constexpr std::uint32_t m_arrK[64] {
+			0x428A2F98U, 0x71374491U, 0xB5C0FBCFU, 0xE9B5DBA5U, 0x3956C25BU, 0x59F111F1U, 0x923F82A4U, 0xAB1C5ED5U,
+			0xD807AA98U, 0x12835B01U, 0x243185BEU, 0x550C7DC3U, 0x72BE5D74U, 0x80DEB1FEU, 0x9BDC06A7U, 0xC19BF174U,
+			0xE49B69C1U, 0xEFBE4786U, 0x0FC19DC6U, 0x240CA1CCU, 0x2DE92C6FU, 0x4A7484AAU, 0x5CB0A9DCU, 0x76F988DAU,
+			0x983E5152U, 0xA831C66DU, 0xB00327C8U, 0xBF597FC7U, 0xC6E00BF3U, 0xD5A79147U, 0x06CA6351U, 0x14292967U,
+			0x27B70A85U, 0x2E1B2138U, 0x4D2C6DFCU, 0x53380D13U, 0x650A7354U, 0x766A0ABBU, 0x81C2C92EU, 0x92722C85U,
+			0xA2BFE8A1U, 0xA81A664BU, 0xC24B8B70U, 0xC76C51A3U, 0xD192E819U, 0xD6990624U, 0xF40E3585U, 0x106AA070U,
+			0x19A4C116U, 0x1E376C08U, 0x2748774CU, 0x34B0BCB5U, 0x391C0CB3U, 0x4ED8AA4AU, 0x5B9CCA4FU, 0x682E6FF3U,
+			0x748F82EEU, 0x78A5636FU, 0x84C87814U, 0x8CC70208U, 0x90BEFFFAU, 0xA4506CEBU, 0xBEF9A3F7U, 0xC67178F2U };
+		std::uint32_t m_arrState[8] { 0x6A09E667U, 0xBB67AE85U, 0x3C6EF372U, 0xA54FF53AU,
+			0x510E527FU, 0x9B05688CU, 0x1F83D9ABU, 0x5BE0CD19U };
+	};
+
+	auto CHasherSHA256::GetDigest()const->std::vector<std::byte>
+	{
+		std::vector<std::byte> vecDigest;
+		for (const auto u32Word : m_arrState) {
+			const auto vecWord = ToBytesBE(u32Word);
+			vecDigest.insert(vecDigest.end(), vecWord.begin(), vecWord.end());
+		}
+		return vecDigest;
+	}
+
+	void CHasherSHA256::ProcessBlocks(const std::byte* pData, std::size_t sBlocks)
+	{
+	#if defined(_M_IX86) || defined(_M_X64)
+		if (ut::HasSHA()) {
+			SHA256SHANI(m_arrState, pData, sBlocks, m_arrK);
+			return;
+		}
+	#endif //^^^ _M_IX86 || _M_X64
+
+		for (; sBlocks > 0; --sBlocks, pData += m_uSizeBlock) {
+			std::uint32_t arrW[64];
+			for (auto i { 0 }; i < 16; ++i) {
+				arrW[i] = ut::ByteSwap(LoadT<std::uint32_t>(pData + i * 4));
+			}
+			for (auto i { 16 }; i < 64; ++i) {
+				const auto u32S0 = std::rotr(arrW[i - 15], 7) ^ std::rotr(arrW[i - 15], 18) ^ (arrW[i - 15] >> 3);
+				const auto u32S1 = std::rotr(arrW[i - 2], 17) ^ std::rotr(arrW[i - 2], 19) ^ (arrW[i - 2] >> 10);
+				arrW[i] = arrW[i - 16] + u32S0 + arrW[i - 7] + u32S1;
+			}
+
+			auto u32A = m_arrState[0]; auto u32B = m_arrState[1]; auto u32C = m_arrState[2]; auto u32D = m_arrState[3];
+			auto u32E = m_arrState[4]; auto u32F = m_arrState[5]; auto u32G = m_arrState[6]; auto u32H = m_arrState[7];
+			for (auto i { 0 }; i < 64; ++i) {
+				const auto u32S1 = std::rotr(u32E, 6) ^ std::rotr(u32E, 11) ^ std::rotr(u32E, 25);
+				const auto u32Tmp1 = u32H + u32S1 + ((u32E & u32F) ^ (~u32E & u32G)) + m_arrK[i] + arrW[i];
+				const auto u32S0 = std::rotr(u32A, 2) ^ std::rotr(u32A, 13) ^ std::rotr(u32A, 22);
+				const auto u32Tmp2 = u32S0 + ((u32A & u32B) ^ (u32A & u32C) ^ (u32B & u32C));
+				u32H = u32G;
+				u32G = u32F;
+				u32F = u32E;
+				u32E = u32D + u32Tmp1;
+				u32D = u32C;
+				u32C = u32B;
+				u32B = u32A;
+				u32A = u32Tmp1 + u32Tmp2;
+			}
+
+			m_arrState[0] += u32A; m_arrState[1] += u32B; m_arrState[2] += u32C; m_arrState[3] += u32D;
+			m_arrState[4] += u32E; m_arrState[5] += u32F; m_arrState[6] += u32G; m_arrState[7] += u32H;
+		}
+	}
+}
+
+
+auto HEXCTRL::INTERNAL::CreateHasher(EHexHash eHash)->std::unique_ptr<IHexHasher>
+{
+	using enum EHexHash;
+	switch (eHash) {
+	case HASH_CRC32:
+		return std::make_unique<CHasherCRC32>();
+	case HASH_CRC32C:
+		return std::make_unique<CHasherCRC32C>();
+	case HASH_ADLER32:
+		return std::make_unique<CHasherAdler32>();
+	case HASH_XXH64:
+		return std::make_unique<CHasherXXH64>();
+	case HASH_MD5:
+		return std::make_unique<CHasherMD5>();
+	case HASH_SHA1:
+		return std::make_unique<CHasherSHA1>();
+	case HASH_SHA256:
+		return std::make_unique<CHasherSHA256>();
+	default:
+		ut::DBG_REPORT(L"Unknown EHexHash.");
+		return { };
+	}
+}
+
+auto HEXCTRL::INTERNAL::GetHashName(EHexHash eHash)->std::wstring_view
+{
+	using enum EHexHash;
+	switch (eHash) {
+	case HASH_CRC32:
+		return L"CRC-32";
+	case HASH_CRC32C:
+		return L"CRC-32C";
+	case HASH_ADLER32:
+		return L"Adler-32";
+	case HASH_XXH64:
+		return L"xxHash64";
+	case HASH_MD5:
+		return L"MD5";
+	case HASH_SHA1:
+		return L"SHA-1";
+	case HASH_SHA256:
+		return L"SHA-256";
+	default:
+		return { };
+	}
+}
\ No newline at end of file
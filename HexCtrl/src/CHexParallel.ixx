@@ -0,0 +1,175 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+export module HEXCTRL.CHexParallel;
+
+import HEXCTRL.CHexDlgProgress;
+import HEXCTRL.CHexReader;
+
+namespace HEXCTRL::INTERNAL {
+	//Pool of workers for the data scans split into the parts. Parts are taken in the ascending order,
+	//every worker reads the data with its own CHexReader. Concurrent data access is only allowed in non-virtual mode,
+	//the Run is fSerial if any data read is virtual, all the parts are processed by the calling thread then.
+	//The calling thread's worker is the only one that updates the progress dialog, and turns its cancel
+	//into the workers' cancel.
+	//The parts count can be limited by the count of items found in the consecutive done parts from the beginning.
+	export class CHexParallel final {
+	public:
+		explicit CHexParallel(const IHexCtrl* pHexCtrl, CHexDlgProgress* pDlgProg = nullptr);
+		CHexParallel(const CHexParallel&) = delete;
+		CHexParallel& operator=(const CHexParallel&) = delete;
+		void AddFound(ULONGLONG ullCount);    //Found items count for the progress dialog.
+		void AddProcessed(ULONGLONG ullSize); //Processed data size, can be added within the part too.
+		void Cancel();
+		[[nodiscard]] auto GetPartsDone()const->std::size_t; //Count of the consecutive done parts from the beginning.
+		[[nodiscard]] bool IsCanceled()const;
+		[[nodiscard]] bool IsPastLimit(std::size_t sPart)const;
+		void OnPartDone(std::size_t sPart, std::size_t sFound); //For the limit, the part has found sFound items.
+		template<typename TFuncPart> //void(std::size_t sPart, CHexReader& refReader).
+		void Run(std::size_t sParts, const TFuncPart& FuncPart, bool fSerial, ULONGLONG ullRngStart = 0,
+			ULONGLONG ullRngEnd = (std::numeric_limits<ULONGLONG>::max)()); //Range for the readers.
+		void SetLimit(std::size_t sLimit); //Items count, to be set before the Run.
+	private:
+		void UpdateProgress();
+	private:
+		const IHexCtrl* m_pHexCtrl { };
+		CHexDlgProgress* m_pDlgProg { };
+		std::vector<std::size_t> m_vecPartFound;
+		std::vector<std::uint8_t> m_vecPartDone;
+		std::mutex m_mtxParts;
+		std::thread::id m_idMain;                   //Thread that called the Run.
+		std::size_t m_sPartsDone { };               //Count of the consecutive done parts from the beginning.
+		std::size_t m_sFoundInDone { };             //Items found in these parts.
+		std::size_t m_sLimit { (std::numeric_limits<std::size_t>::max)() };
+		std::atomic<std::size_t> m_atomPartLimit { }; //Parts from this index on are past the limit.
+		std::atomic<ULONGLONG> m_atomFound { 0ULL };
+		std::atomic<ULONGLONG> m_atomProcessed { 0ULL };
+		std::atomic_bool m_atomCanceled { false };
+		std::atomic_bool m_atomRun { false };       //The dialog is closed by its OnCancel after the Run.
+	};
+}
+
+using namespace HEXCTRL::INTERNAL;
+
+CHexParallel::CHexParallel(const IHexCtrl* pHexCtrl, CHexDlgProgress* pDlgProg) :
+	m_pHexCtrl(pHexCtrl), m_pDlgProg(pDlgProg)
+{
+}
+
+void CHexParallel::AddFound(ULONGLONG ullCount)
+{
+	m_atomFound += ullCount;
+}
+
+void CHexParallel::AddProcessed(ULONGLONG ullSize)
+{
+	m_atomProcessed += ullSize;
+	UpdateProgress();
+}
+
+void CHexParallel::Cancel()
+{
+	m_atomCanceled = true;
+}
+
+auto CHexParallel::GetPartsDone()const->std::size_t
+{
+	return m_sPartsDone;
+}
+
+bool CHexParallel::IsCanceled()const
+{
+	return m_atomCanceled || (m_atomRun && m_pDlgProg != nullptr && m_pDlgProg->IsCanceled());
+}
+
+bool CHexParallel::IsPastLimit(std::size_t sPart)const
+{
+	return sPart >= m_atomPartLimit;
+}
+
+void CHexParallel::OnPartDone(std::size_t sPart, std::size_t sFound)
+{
+	//The limit is reached when the parts from the beginning have found enough items.
+	//All the parts after them are not needed anymore.
+	const std::scoped_lock lock(m_mtxParts);
+	m_vecPartFound[sPart] = sFound;
+	m_vecPartDone[sPart] = true;
+	while (m_sPartsDone < m_vecPartDone.size() && m_vecPartDone[m_sPartsDone] && m_sFoundInDone < m_sLimit) {
+		m_sFoundInDone += m_vecPartFound[m_sPartsDone++];
+		if (m_sFoundInDone >= m_sLimit) {
+			m_atomPartLimit = m_sPartsDone;
+		}
+	}
+}
+
+template<typename TFuncPart>
+void CHexParallel::Run(std::size_t sParts, const TFuncPart& FuncPart, bool fSerial, ULONGLONG ullRngStart, ULONGLONG ullRngEnd)
+{
+	m_vecPartFound.assign(sParts, 0);
+	m_vecPartDone.assign(sParts, 0);
+	m_sPartsDone = 0;
+	m_sFoundInDone = 0;
+	m_atomPartLimit = sParts;
+	m_idMain = std::this_thread::get_id();
+	m_atomRun = true;
+
+	std::atomic<std::size_t> atomNext { 0 };
+	const auto lmbWorker = [&]() {
+		CHexReader reader(m_pHexCtrl, ullRngStart, ullRngEnd);
+		for (auto sIndex = atomNext++; !IsPastLimit(sIndex) && !IsCanceled(); sIndex = atomNext++) {
+			FuncPart(sIndex, reader);
+			UpdateProgress();
+		}
+		};
+
+	const auto uThreads = fSerial ? 1U : static_cast<unsigned>((std::min)(static_cast<std::size_t>(
+		(std::max)(std::thread::hardware_concurrency(), 1U)), sParts));
+	std::vector<std::thread> vecThrd;
+	for (auto i { 1U }; i < uThreads; ++i) {
+		vecThrd.emplace_back(lmbWorker);
+	}
+	lmbWorker();
+	for (auto& thrd : vecThrd) {
+		thrd.join();
+	}
+
+	if (IsCanceled()) { //Canceled after the calling thread's worker is done.
+		m_atomCanceled = true;
+	}
+	m_atomRun = false;
+}
+
+void CHexParallel::SetLimit(std::size_t sLimit)
+{
+	m_sLimit = sLimit;
+}
+
+
+//Private methods.
+
+void CHexParallel::UpdateProgress()
+{
+	if (m_pDlgProg == nullptr || std::this_thread::get_id() != m_idMain)
+		return;
+
+	if (m_pDlgProg->IsCanceled()) {
+		m_atomCanceled = true;
+	}
+	else {
+		m_pDlgProg->SetCurrent(m_atomProcessed);
+		m_pDlgProg->SetCount(m_atomFound);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+export module HEXCTRL.CHexReader;
+
+namespace HEXCTRL::INTERNAL {
+	//Chunks reader for the streaming scans, the search, hashing, statistics and so on.
+	//In non-virtual mode the data is given as is. In VirtualData mode the next chunk is read on the reader's own
+	//I/O thread, into the second buffer, while the current chunk is scanned. The thread is started by the first
+	//read ahead and lives as long as the reader, the IHexVirtData::OnHexGetData is called from it then.
+	//The next chunk is predicted by the last two chunks' offsets, and its bytes that are in the current chunk
+	//are copied from there instead of re-reading.
+	//The first chunk is given as is, so the scan that is done within it costs neither copying nor a wasted read ahead.
+	//While the reader is alive, the data must be read only through it, every GetData invalidates the previous data.
+	export class CHexReader final {
+	public:
+		explicit CHexReader(const IHexCtrl* pHexCtrl, ULONGLONG ullRngStart = 0,
+			ULONGLONG ullRngEnd = (std::numeric_limits<ULONGLONG>::max)()); //Range to read ahead within.
+		CHexReader(const CHexReader&) = delete;
+		~CHexReader();
+		CHexReader& operator=(const CHexReader&) = delete;
+		[[nodiscard]] auto GetData(HEXSPAN hss)->SpanCByte; //Data is valid until the next call.
+		void Pause(); //Waits for the read ahead, the IHexCtrl::GetData can be called by others until the next GetData.
+	private:
+		void Fill(std::vector<std::byte>& refVec, HEXSPAN hss, SpanCByte spnFrom, HEXSPAN hssFrom)const;
+		[[nodiscard]] static bool IsWithin(HEXSPAN hss, HEXSPAN hssIn);
+		void ReadAhead(ULONGLONG ullOffsetPrev);
+		void ThreadIO();
+		void Wait();
+	private:
+		const IHexCtrl* m_pHexCtrl { };
+		std::vector<std::byte> m_vecCurr;
+		std::vector<std::byte> m_vecNext;
+		std::thread m_thrd;       //I/O thread, reads the next chunks.
+		std::mutex m_mtxIO;
+		std::condition_variable m_cvIO;
+		SpanCByte m_spnCurr;      //Current chunk's data, in the m_vecCurr, or as given by the IHexCtrl.
+		HEXSPAN m_hssCurr { };
+		HEXSPAN m_hssNext { };
+		ULONGLONG m_ullRngStart { };
+		ULONGLONG m_ullSentinel { }; //Range end, exclusive.
+		bool m_fVirtual { false };
+		bool m_fNext { false };   //The m_vecNext has the m_hssNext data.
+		bool m_fRead { false };   //The I/O thread is to read, or is reading, the m_hssNext data.
+		bool m_fStop { false };   //The I/O thread is to exit.
+	};
+}
+
+using namespace HEXCTRL::INTERNAL;
+
+CHexReader::CHexReader(const IHexCtrl* pHexCtrl, ULONGLONG ullRngStart, ULONGLONG ullRngEnd) :
+	m_pHexCtrl(pHexCtrl), m_ullRngStart(ullRngStart), m_fVirtual(pHexCtrl->IsVirtual())
+{
+	const auto ullDataSize = pHexCtrl->GetDataSize();
+	m_ullSentinel = ullRngEnd >= ullDataSize ? ullDataSize : ullRngEnd + 1;
+}
+
+CHexReader::~CHexReader()
+{
+	if (!m_thrd.joinable())
+		return;
+
+	{
+		const std::scoped_lock lock(m_mtxIO);
+		m_fStop = true;
+	}
+	m_cvIO.notify_all();
+	m_thrd.join();
+}
+
+auto CHexReader::GetData(HEXSPAN hss)->SpanCByte
+{
+	if (!m_fVirtual)
+		return m_pHexCtrl->GetData(hss);
+
+	Wait();
+	if (!m_spnCurr.empty() && IsWithin(hss, m_hssCurr)) {
+		return m_spnCurr.subspan(static_cast<std::size_t>(hss.ullOffset - m_hssCurr.ullOffset), static_cast<std::size_t>(hss.ullSize));
+	}
+
+	const auto fNext = m_fNext && IsWithin(hss, m_hssNext);
+	if (m_spnCurr.empty() && !fNext) { //First chunk.
+		m_spnCurr = m_pHexCtrl->GetData(hss);
+		m_hssCurr = { .ullOffset { hss.ullOffset }, .ullSize { (std::min)(hss.ullSize, static_cast<ULONGLONG>(m_spnCurr.size())) } };
+		m_fNext = false;
+		return m_spnCurr;
+	}
+
+	const auto ullOffsetPrev = m_hssCurr.ullOffset;
+	if (!fNext) { //Prediction missed.
+		Fill(m_vecNext, hss, m_spnCurr, m_hssCurr);
+		m_hssNext = hss;
+	}
+	std::swap(m_vecCurr, m_vecNext);
+	m_fNext = false;
+	m_hssCurr = m_hssNext;
+	m_spnCurr = { m_vecCurr.data(), m_vecCurr.size() };
+	ReadAhead(ullOffsetPrev);
+
+	return m_spnCurr.subspan(static_cast<std::size_t>(hss.ullOffset - m_hssCurr.ullOffset), static_cast<std::size_t>(hss.ullSize));
+}
+
+void CHexReader::Pause()
+{
+	Wait();
+	if (m_spnCurr.data() != m_vecCurr.data()) { //The data given as is, others' reads may overwrite it.
+		m_spnCurr = { };
+	}
+}
+
+
+//Private methods.
+
+void CHexReader::Fill(std::vector<std::byte>& refVec, HEXSPAN hss, SpanCByte spnFrom, HEXSPAN hssFrom)const
+{
+	//Bytes in the hssFrom are copied first, the IHexCtrl::GetData may invalidate the spnFrom.
+	refVec.resize(static_cast<std::size_t>(hss.ullSize));
+	const auto ullEnd = hss.ullOffset + hss.ullSize;
+	const auto ullCopyFirst = (std::max)(hss.ullOffset, hssFrom.ullOffset);
+	const auto ullCopyEnd = (std::min)(ullEnd, hssFrom.ullOffset + hssFrom.ullSize);
+	const auto lmbRead = [&](ULONGLONG ullOffset, ULONGLONG ullSize) {
+		if (ullSize == 0)
+			return;
+
+		const auto spnData = m_pHexCtrl->GetData({ ullOffset, ullSize });
+		assert(spnData.size() >= ullSize);
+		std::memcpy(refVec.data() + (ullOffset - hss.ullOffset), spnData.data(),
+			static_cast<std::size_t>((std::min)(ullSize, static_cast<ULONGLONG>(spnData.size()))));
+		};
+
+	if (ullCopyFirst >= ullCopyEnd) {
+		lmbRead(hss.ullOffset, hss.ullSize);
+		return;
+	}
+
+	std::memcpy(refVec.data() + (ullCopyFirst - hss.ullOffset), spnFrom.data() + (ullCopyFirst - hssFrom.ullOffset),
+		static_cast<std::size_t>(ullCopyEnd - ullCopyFirst));
+	lmbRead(hss.ullOffset, ullCopyFirst - hss.ullOffset);
+	lmbRead(ullCopyEnd, ullEnd - ullCopyEnd);
+}
+
+bool CHexReader::IsWithin(HEXSPAN hss, HEXSPAN hssIn)
+{
+	return hss.ullOffset >= hssIn.ullOffset && hss.ullOffset + hss.ullSize <= hssIn.ullOffset + hssIn.ullSize;
+}
+
+void CHexReader::ReadAhead(ULONGLONG ullOffsetPrev)
+{
+	//The next chunk is as far from the current one as the current one is from the previous.
+	//The chunk is cut at the range bounds, in most cases the last chunk is cut the same way by the scan.
+	const auto ullOffsetCurr = m_hssCurr.ullOffset;
+	ULONGLONG ullOffsetNext;
+	if (ullOffsetCurr > ullOffsetPrev) {
+		const auto ullDist = ullOffsetCurr - ullOffsetPrev;
+		if (ullDist >= m_ullSentinel || ullOffsetCurr >= m_ullSentinel - ullDist)
+			return;
+
+		ullOffsetNext = ullOffsetCurr + ullDist;
+	}
+	else if (ullOffsetCurr < ullOffsetPrev) {
+		const auto ullDist = ullOffsetPrev - ullOffsetCurr;
+		if (ullOffsetCurr <= m_ullRngStart)
+			return;
+
+		ullOffsetNext = ullOffsetCurr - m_ullRngStart > ullDist ? ullOffsetCurr - ullDist : m_ullRngStart;
+	}
+	else
+		return;
+
+	if (ullOffsetNext >= m_ullSentinel)
+		return;
+
+	const HEXSPAN hssNext { .ullOffset { ullOffsetNext },
+		.ullSize { (std::min)(m_hssCurr.ullSize, m_ullSentinel - ullOffsetNext) } };
+	if (hssNext.ullSize == 0 || IsWithin(hssNext, m_hssCurr))
+		return;
+
+	m_hssNext = hssNext;
+	m_fNext = true;
+	if (!m_thrd.joinable()) {
+		m_thrd = std::thread(&CHexReader::ThreadIO, this);
+	}
+
+	{
+		const std::scoped_lock lock(m_mtxIO);
+		m_fRead = true;
+	}
+	m_cvIO.notify_all();
+}
+
+void CHexReader::ThreadIO()
+{
+	//The current and the next chunks' members are not changed until the read is done, the Wait is called before.
+	std::unique_lock lock(m_mtxIO);
+	while (true) {
+		m_cvIO.wait(lock, [this]() { return m_fRead || m_fStop; });
+		if (m_fStop)
+			return;
+
+		lock.unlock();
+		Fill(m_vecNext, m_hssNext, m_spnCurr, m_hssCurr);
+		lock.lock();
+		m_fRead = false;
+		m_cvIO.notify_all();
+	}
+}
+
+void CHexReader::Wait()
+{
+	std::unique_lock lock(m_mtxIO);
+	m_cvIO.wait(lock, [this]() { return !m_fRead; });
+}
\ No newline at end of file
@@ -0,0 +1,896 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <cwctype>
+#include <format>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+export module HEXCTRL.CHexRegex;
+
+namespace HEXCTRL::INTERNAL {
+	//Byte-oriented regular expression.
+	//ASCII chars match themselves, \xHH is a byte, \n \r \t \f \v \0 and \<punctuation> are escapes.
+	//. is any byte, [...] and [^...] are byte classes with ranges, \d \D \w \W \s \S are ASCII classes.
+	//(...) and (?:...) are groups, | is alternation, * + ? {n} {n,} {n,m} are quantifiers.
+	//The expression is compiled into the forward and the reverse Thompson NFAs, that are run by the CHexRegexDFA.
+	export class CHexRegex final {
+	public:
+		[[nodiscard]] bool Compile(std::wstring_view wsvPattern, bool fMatchCase);
+		[[nodiscard]] auto GetError()const->const std::wstring&;
+		[[nodiscard]] auto GetMaxSize()const->std::optional<ULONGLONG>; //Max match size, empty if unbounded.
+		[[nodiscard]] auto GetMinSize()const->ULONGLONG;                //Min match size, always above zero.
+		[[nodiscard]] bool IsFirstByte(std::byte byte)const;            //Can a match start with this byte?
+	private:
+		friend class CHexRegexDFA;
+		enum class ENodeType : std::uint8_t { BYTESET, CONCAT, ALTER, REPEAT };
+		struct NODE { //Node of the parsed expression tree.
+			ENodeType                  eType { };
+			std::uint32_t              u32Set { };  //Index in the m_vecSet, for the BYTESET.
+			std::uint32_t              u32Min { };  //Repetitions, for the REPEAT.
+			std::uint32_t              u32Max { };
+			std::vector<std::uint32_t> vecChild;
+		};
+		enum class ENFAType : std::uint8_t { BYTESET, SPLIT, MATCH };
+		struct NFASTATE {
+			ENFAType      eType { };
+			std::uint32_t u32Set { };   //Index in the m_vecSet, for the BYTESET.
+			std::uint32_t u32Next { };
+			std::uint32_t u32Next2 { }; //Second alternative, for the SPLIT.
+		};
+		using SetByte = std::bitset<256>;
+		[[nodiscard]] auto AddNode(NODE&& stNode)->std::uint32_t;
+		[[nodiscard]] auto AddNFAState(bool fReverse, NFASTATE stState)->std::uint32_t;
+		[[nodiscard]] auto AddSet(SetByte stSet)->std::uint32_t;
+		void CalcByteClasses();
+		[[nodiscard]] auto CalcSize(std::uint32_t u32Node)const->std::pair<ULONGLONG, ULONGLONG>;
+		[[nodiscard]] auto Emit(std::uint32_t u32Node, std::uint32_t u32Next, bool fReverse)->std::uint32_t;
+		void Error(std::wstring_view wsvError);
+		[[nodiscard]] auto FoldCase(SetByte stSet)const->SetByte;
+		[[nodiscard]] bool IsEnd()const;
+		[[nodiscard]] auto ParseAlter()->std::uint32_t;
+		[[nodiscard]] auto ParseAtom()->std::uint32_t;
+		[[nodiscard]] auto ParseClass()->std::uint32_t;
+		[[nodiscard]] auto ParseConcat()->std::uint32_t;
+		[[nodiscard]] auto ParseEscape(SetByte& refSet)->int; //Byte value, or -1 for the multi-byte class.
+		[[nodiscard]] auto ParseNumber()->std::optional<std::uint32_t>;
+		[[nodiscard]] auto ParseRepeat()->std::uint32_t;
+		[[nodiscard]] auto Peek()const->wchar_t;
+	private:
+		static constexpr auto m_u32Unbounded { (std::numeric_limits<std::uint32_t>::max)() };
+		static constexpr auto m_ullUnbounded { (std::numeric_limits<ULONGLONG>::max)() };
+		static constexpr auto m_u32RepeatMax { 1000U };           //Max {n,m} value.
+		static constexpr auto m_sNFAStatesMax { 1024U * 256U };   //Max NFA states, to limit the expansion of repetitions.
+		static constexpr auto m_iDepthMax { 256 };                //Max groups nesting.
+		std::vector<SetByte> m_vecSet;                            //Byte sets of the nodes and the NFA states.
+		std::array<std::vector<NFASTATE>, 2> m_arrNFA;            //Forward and reverse NFAs.
+		std::array<std::uint32_t, 2> m_arrNFAStart { };
+		std::array<std::uint8_t, 256> m_arrClass { };             //Byte to byte class, bytes of a class are in the same sets.
+		std::array<std::uint8_t, 256> m_arrClassByte { };         //Representative byte of every class.
+		std::uint32_t m_u32Classes { };
+		SetByte m_stFirstByte;
+		ULONGLONG m_ullMinSize { };
+		ULONGLONG m_ullMaxSize { };
+		std::wstring m_wstrError;
+		std::wstring_view m_wsvPattern; //Parsing state.
+		std::size_t m_sPos { };
+		std::vector<NODE> m_vecNode;
+		int m_iDepth { };
+		bool m_fMatchCase { };
+	};
+
+	//Lazy DFA of the CHexRegex NFA, states are built on demand, and the cache of them is cleared when full.
+	//Reverse DFA runs the expression backward, unanchored DFA matches anywhere, not only at the run's beginning.
+	//Every thread must have its own DFA object.
+	export class CHexRegexDFA final {
+	public:
+		CHexRegexDFA(const CHexRegex& refRegex, bool fReverse, bool fUnanchored);
+		[[nodiscard]] auto GetStartState()->std::uint32_t; //State ids are valid only until the next Run, the cache can be cleared.
+		//The same NFA states as the refDFA's u32State has, for the DFA of the same direction but the other anchoring.
+		[[nodiscard]] auto ImportState(const CHexRegexDFA& refDFA, std::uint32_t u32State)->std::uint32_t;
+		//Size of the longest match at the ullOffset, or of the shortest one if !fLongest, zero if no match.
+		//Forward anchored DFA only.
+		[[nodiscard]] auto MatchSize(const IHexCtrl* pHexCtrl, ULONGLONG ullOffset, ULONGLONG ullSentinel, bool fLongest)->ULONGLONG;
+		//Runs the DFA over the spnData from the refState, from the first byte to the last one, or backward.
+		//The func(index) is called for every byte the state becomes a match at, the func returns false to stop.
+		//Returns false if stopped by the func, or as soon as the state is dead and nothing can match anymore.
+		template<bool fBackward, typename TFunc>
+		bool Run(SpanCByte spnData, std::uint32_t& refState, TFunc func);
+	private:
+		[[nodiscard]] auto AddState(std::vector<std::uint32_t>&& vecSet)->std::uint32_t;
+		void AddClosure(std::uint32_t u32NFA, std::vector<std::uint32_t>& vecSet);
+		void ClearCache();
+		[[nodiscard]] auto ComputeNext(std::uint32_t u32State, std::uint8_t u8Class)->std::uint32_t;
+		void NextVisitMark(); //Unmarks all the NFA states as visited.
+	private:
+		struct HASHSET { //Hash of the NFA states set.
+			auto operator()(const std::vector<std::uint32_t>& vecSet)const noexcept->std::size_t {
+				std::uint64_t u64Hash { 0xCBF29CE484222325ULL }; //FNV-1a.
+				for (const auto u32NFA : vecSet) {
+					u64Hash = (u64Hash ^ u32NFA) * 0x100000001B3ULL;
+				}
+				return static_cast<std::size_t>(u64Hash);
+			}
+		};
+		static constexpr auto m_u32Unknown { 0xFFFFFFFFU };
+		static constexpr auto m_sCacheSizeMax { 1024U * 1024U * 32U }; //Max memory of the states cache, in bytes.
+		static constexpr std::uint8_t m_u8FlagMatch { 0x1 };
+		static constexpr std::uint8_t m_u8FlagDead { 0x2 };
+		const CHexRegex* m_pRegex { };
+		const std::vector<CHexRegex::NFASTATE>* m_pNFA { };
+		std::vector<std::uint32_t> m_vecStartSet;            //Closure of the NFA start state.
+		std::vector<std::uint32_t> m_vecTrans;               //Transitions, m_u32Classes per state, m_u32Unknown if not built yet.
+		std::vector<const std::vector<std::uint32_t>*> m_vecStateSet; //NFA states of the DFA state, keys of the m_umapState.
+		std::vector<std::uint8_t> m_vecFlags;
+		std::unordered_map<std::vector<std::uint32_t>, std::uint32_t, HASHSET> m_umapState;
+		std::vector<std::uint32_t> m_vecVisited;             //Visit marks of the NFA states, for the closures.
+		std::vector<std::uint32_t> m_vecStack;
+		std::size_t m_sCacheSize { };
+		std::uint32_t m_u32VisitMark { };
+		std::uint32_t m_u32Classes { };
+		bool m_fUnanchored { };
+	};
+
+	bool CHexRegex::Compile(std::wstring_view wsvPattern, bool fMatchCase)
+	{
+		*this = { };
+		m_wsvPattern = wsvPattern;
+		m_fMatchCase = fMatchCase;
+
+		const auto u32Root = ParseAlter();
+		if (m_wstrError.empty() && !IsEnd()) {
+			Error(L"Unmatched ')'");
+		}
+		if (!m_wstrError.empty())
+			return false;
+
+		const auto [ullMin, ullMax] = CalcSize(u32Root);
+		if (ullMin == 0) {
+			Error(L"Expression matches empty data");
+			return false;
+		}
+		m_ullMinSize = ullMin;
+		m_ullMaxSize = ullMax;
+
+		for (const auto fReverse : { false, true }) {
+			const auto u32Match = AddNFAState(fReverse, { .eType { ENFAType::MATCH } });
+			m_arrNFAStart[fReverse] = Emit(u32Root, u32Match, fReverse);
+		}
+		if (!m_wstrError.empty())
+			return false;
+
+		CalcByteClasses();
+		m_wsvPattern = { };
+		m_vecNode = { };
+
+		CHexRegexDFA dfa(*this, false, false);
+		for (auto i { 0U }; i < 256U; ++i) {
+			auto u32State = dfa.GetStartState();
+			const auto byte = static_cast<std::byte>(i);
+			m_stFirstByte[i] = dfa.Run<false>({ &byte, 1 }, u32State, [](std::size_t) { return true; }); //Alive after the byte.
+		}
+
+		return true;
+	}
+
+	auto CHexRegex::GetError()const->const std::wstring&
+	{
+		return m_wstrError;
+	}
+
+	auto CHexRegex::GetMaxSize()const->std::optional<ULONGLONG>
+	{
+		if (m_ullMaxSize == m_ullUnbounded)
+			return std::nullopt;
+
+		return m_ullMaxSize;
+	}
+
+	auto CHexRegex::GetMinSize()const->ULONGLONG
+	{
+		return m_ullMinSize;
+	}
+
+	bool CHexRegex::IsFirstByte(std::byte byte)const
+	{
+		return m_stFirstByte[static_cast<std::uint8_t>(byte)];
+	}
+
+
+	//Private methods.
+
+	auto CHexRegex::AddNode(NODE&& stNode)->std::uint32_t
+	{
+		m_vecNode.emplace_back(std::move(stNode));
+		return static_cast<std::uint32_t>(m_vecNode.size() - 1);
+	}
+
+	auto CHexRegex::AddNFAState(bool fReverse, NFASTATE stState)->std::uint32_t
+	{
+		auto& vecNFA = m_arrNFA[fReverse];
+		if (vecNFA.size() >= m_sNFAStatesMax) {
+			Error(L"Expression is too complex, repetitions are too big");
+			return 0;
+		}
+
+		vecNFA.emplace_back(stState);
+		return static_cast<std::uint32_t>(vecNFA.size() - 1);
+	}
+
+	auto CHexRegex::AddSet(SetByte stSet)->std::uint32_t
+	{
+		if (!m_fMatchCase) {
+			stSet = FoldCase(stSet);
+		}
+
+		m_vecSet.emplace_back(stSet);
+		return static_cast<std::uint32_t>(m_vecSet.size() - 1);
+	}
+
+	void CHexRegex::CalcByteClasses()
+	{
+		//Every set splits the bytes of a class into the two classes: in the set, and not in it.
+		std::array<std::uint16_t, 256> arrClass { };
+		std::uint16_t u16Classes { 1 };
+		for (const auto& stSet : m_vecSet) {
+			std::map<std::pair<std::uint16_t, bool>, std::uint16_t> mapSplit;
+			for (auto i { 0U }; i < 256U; ++i) {
+				const auto [it, fInserted] = mapSplit.try_emplace({ arrClass[i], stSet[i] }, static_cast<std::uint16_t>(mapSplit.size()));
+				arrClass[i] = it->second;
+			}
+			u16Classes = static_cast<std::uint16_t>(mapSplit.size());
+		}
+
+		m_u32Classes = u16Classes;
+		for (auto i { 0U }; i < 256U; ++i) {
+			m_arrClass[i] = static_cast<std::uint8_t>(arrClass[i]);
+			m_arrClassByte[arrClass[i]] = static_cast<std::uint8_t>(i);
+		}
+	}
+
+	auto CHexRegex::CalcSize(std::uint32_t u32Node)const->std::pair<ULONGLONG, ULONGLONG>
+	{
+		const auto lmbAdd = [](ULONGLONG ullLhs, ULONGLONG ullRhs) {
+			return ullLhs > m_ullUnbounded - ullRhs ? m_ullUnbounded : ullLhs + ullRhs; };
+		const auto lmbMul = [](ULONGLONG ullLhs, ULONGLONG ullRhs) {
+			return (ullLhs != 0 && ullRhs > m_ullUnbounded / ullLhs) ? m_ullUnbounded : ullLhs * ullRhs; };
+
+		const auto& refNode = m_vecNode[u32Node];
+		switch (refNode.eType) {
+		case ENodeType::BYTESET:
+			return { 1, 1 };
+		case ENodeType::CONCAT:
+		{
+			ULONGLONG ullMin { 0 };
+			ULONGLONG ullMax { 0 };
+			for (const auto u32Child : refNode.vecChild) {
+				const auto [ullChildMin, ullChildMax] = CalcSize(u32Child);
+				ullMin = lmbAdd(ullMin, ullChildMin);
+				ullMax = lmbAdd(ullMax, ullChildMax);
+			}
+			return { ullMin, ullMax };
+		}
+		case ENodeType::ALTER:
+		{
+			auto ullMin = m_ullUnbounded;
+			ULONGLONG ullMax { 0 };
+			for (const auto u32Child : refNode.vecChild) {
+				const auto [ullChildMin, ullChildMax] = CalcSize(u32Child);
+				ullMin = (std::min)(ullMin, ullChildMin);
+				ullMax = (std::max)(ullMax, ullChildMax);
+			}
+			return { ullMin, ullMax };
+		}
+		case ENodeType::REPEAT:
+		{
+			const auto [ullChildMin, ullChildMax] = CalcSize(refNode.vecChild.front());
+			const auto ullMax = (refNode.u32Max == m_u32Unbounded && ullChildMax > 0) ? m_ullUnbounded :
+				lmbMul(ullChildMax, refNode.u32Max == m_u32Unbounded ? 0 : refNode.u32Max);
+			return { lmbMul(ullChildMin, refNode.u32Min), ullMax };
+		}
+		default:
+			return { };
+		}
+	}
+
+	auto CHexRegex::Emit(std::uint32_t u32Node, std::uint32_t u32Next, bool fReverse)->std::uint32_t
+	{
+		//The NFA is built from the end: every fragment is emitted with the state that follows it already known.
+		if (!m_wstrError.empty())
+			return 0;
+
+		const auto& refNode = m_vecNode[u32Node];
+		switch (refNode.eType) {
+		case ENodeType::BYTESET:
+			return AddNFAState(fReverse, { .eType { ENFAType::BYTESET }, .u32Set { refNode.u32Set }, .u32Next { u32Next } });
+		case ENodeType::CONCAT:
+		{
+			auto u32Curr = u32Next;
+			if (fReverse) { //Reverse NFA matches the children in the reverse order.
+				for (const auto u32Child : refNode.vecChild) {
+					u32Curr = Emit(u32Child, u32Curr, fReverse);
+				}
+			}
+			else {
+				for (auto it = refNode.vecChild.rbegin(); it != refNode.vecChild.rend(); ++it) {
+					u32Curr = Emit(*it, u32Curr, fReverse);
+				}
+			}
+			return u32Curr;
+		}
+		case ENodeType::ALTER:
+		{
+			auto u32Curr = Emit(refNode.vecChild.back(), u32Next, fReverse);
+			for (auto it = refNode.vecChild.rbegin() + 1; it != refNode.vecChild.rend(); ++it) {
+				const auto u32Alt = Emit(*it, u32Next, fReverse);
+				u32Curr = AddNFAState(fReverse, { .eType { ENFAType::SPLIT }, .u32Next { u32Alt }, .u32Next2 { u32Curr } });
+			}
+			return u32Curr;
+		}
+		case ENodeType::REPEAT:
+		{
+			const auto u32Child = refNode.vecChild.front();
+			auto u32Curr = u32Next;
+			if (refNode.u32Max == m_u32Unbounded) { //Loop: the SPLIT goes either into the child or further.
+				u32Curr = AddNFAState(fReverse, { .eType { ENFAType::SPLIT }, .u32Next2 { u32Next } });
+				const auto u32Body = Emit(u32Child, u32Curr, fReverse);
+				if (!m_wstrError.empty())
+					return 0;
+
+				m_arrNFA[fReverse][u32Curr].u32Next = u32Body;
+			}
+			else { //Optional repetitions are nested: (x(x)?)?.
+				for (auto i = refNode.u32Min; i < refNode.u32Max; ++i) {
+					const auto u32Body = Emit(u32Child, u32Curr, fReverse);
+					u32Curr = AddNFAState(fReverse, { .eType { ENFAType::SPLIT }, .u32Next { u32Body }, .u32Next2 { u32Next } });
+				}
+			}
+
+			for (auto i { 0U }; i < refNode.u32Min; ++i) { //Mandatory repetitions.
+				u32Curr = Emit(u32Child, u32Curr, fReverse);
+			}
+			return u32Curr;
+		}
+		default:
+			return 0;
+		}
+	}
+
+	void CHexRegex::Error(std::wstring_view wsvError)
+	{
+		if (m_wstrError.empty()) { //Only the first error is reported.
+			m_wstrError = std::format(L"{}, at the position {}.", wsvError, m_sPos + 1);
+		}
+	}
+
+	auto CHexRegex::FoldCase(SetByte stSet)const->SetByte
+	{
+		for (auto i { static_cast<unsigned>('a') }; i <= static_cast<unsigned>('z'); ++i) {
+			const auto iUpper = i - ('a' - 'A');
+			if (stSet[i] || stSet[iUpper]) {
+				stSet[i] = true;
+				stSet[iUpper] = true;
+			}
+		}
+
+		return stSet;
+	}
+
+	bool CHexRegex::IsEnd()const
+	{
+		return m_sPos >= m_wsvPattern.size();
+	}
+
+	auto CHexRegex::ParseAlter()->std::uint32_t
+	{
+		if (++m_iDepth > m_iDepthMax) {
+			Error(L"Groups are nested too deep");
+			return 0;
+		}
+
+		const auto u32First = ParseConcat();
+		if (IsEnd() || Peek() != L'|') {
+			--m_iDepth;
+			return u32First;
+		}
+
+		NODE stAlter { .eType { ENodeType::ALTER }, .vecChild { u32First } };
+		while (m_wstrError.empty() && !IsEnd() && Peek() == L'|') {
+			++m_sPos;
+			stAlter.vecChild.emplace_back(ParseConcat());
+		}
+		--m_iDepth;
+
+		return AddNode(std::move(stAlter));
+	}
+
+	auto CHexRegex::ParseAtom()->std::uint32_t
+	{
+		const auto wch = Peek();
+		++m_sPos;
+		SetByte stSet;
+		switch (wch) {
+		case L'(':
+		{
+			if (m_wsvPattern.substr(m_sPos).starts_with(L"?:")) { //Non-capturing group is the same group here.
+				m_sPos += 2;
+			}
+
+			const auto u32Node = ParseAlter();
+			if (IsEnd() || Peek() != L')') {
+				Error(L"Missing ')'");
+				return 0;
+			}
+			++m_sPos;
+			return u32Node;
+		}
+		case L'[':
+			return ParseClass();
+		case L'.':
+			stSet.set();
+			break;
+		case L'\\':
+			if (const auto iByte = ParseEscape(stSet); iByte >= 0) {
+				stSet[static_cast<std::size_t>(iByte)] = true;
+			}
+			break;
+		case L'*':
+		case L'+':
+		case L'?':
+		case L'{':
+			--m_sPos;
+			Error(L"Nothing to repeat");
+			return 0;
+		default:
+			if (wch > 0x7F) {
+				--m_sPos;
+				Error(L"Only ASCII chars are allowed, use \\xHH for the other bytes");
+				return 0;
+			}
+			stSet[wch] = true;
+			break;
+		}
+
+		return AddNode({ .eType { ENodeType::BYTESET }, .u32Set { AddSet(stSet) } });
+	}
+
+	auto CHexRegex::ParseClass()->std::uint32_t
+	{
+		SetByte stSet;
+		const auto fNegate = !IsEnd() && Peek() == L'^';
+		if (fNegate) {
+			++m_sPos;
+		}
+
+		//Single byte of the class, or -1 for the multi-byte escape class, that is added to the stSet directly.
+		const auto lmbByte = [this, &stSet]()->int {
+			const auto wch = Peek();
+			++m_sPos;
+			if (wch == L'\\')
+				return ParseEscape(stSet);
+
+			if (wch > 0x7F) {
+				--m_sPos;
+				Error(L"Only ASCII chars are allowed, use \\xHH for the other bytes");
+				return -1;
+			}
+			return static_cast<int>(wch);
+			};
+
+		bool fFirst { true }; //The ']' right after the '[' or the '[^' is a plain char.
+		while (m_wstrError.empty()) {
+			if (IsEnd()) {
+				Error(L"Missing ']'");
+				return 0;
+			}
+			if (Peek() == L']' && !fFirst) {
+				++m_sPos;
+				break;
+			}
+			fFirst = false;
+
+			const auto iFirst = lmbByte();
+			if (iFirst < 0)
+				continue;
+
+			//Range: the '-' that is not the last char of the class.
+			if (m_wsvPattern.substr(m_sPos).starts_with(L'-') && m_sPos + 1 < m_wsvPattern.size() && m_wsvPattern[m_sPos + 1] != L']') {
+				++m_sPos;
+				const auto iLast = lmbByte();
+				if (!m_wstrError.empty())
+					return 0;
+
+				if (iLast < 0 || iLast < iFirst) {
+					Error(L"Wrong class range");
+					return 0;
+				}
+				for (auto i = iFirst; i <= iLast; ++i) {
+					stSet[static_cast<std::size_t>(i)] = true;
+				}
+			}
+			else {
+				stSet[static_cast<std::size_t>(iFirst)] = true;
+			}
+		}
+
+		if (!m_fMatchCase) { //Folded before the negation, [^a] excludes both the 'a' and the 'A'.
+			stSet = FoldCase(stSet);
+		}
+		if (fNegate) {
+			stSet.flip();
+		}
+
+		return AddNode({ .eType { ENodeType::BYTESET }, .u32Set { AddSet(stSet) } });
+	}
+
+	auto CHexRegex::ParseConcat()->std::uint32_t
+	{
+		NODE stConcat { .eType { ENodeType::CONCAT } };
+		while (m_wstrError.empty() && !IsEnd() && Peek() != L'|' && Peek() != L')') {
+			stConcat.vecChild.emplace_back(ParseRepeat());
+		}
+
+		if (stConcat.vecChild.size() == 1)
+			return stConcat.vecChild.front();
+
+		return AddNode(std::move(stConcat));
+	}
+
+	auto CHexRegex::ParseEscape(SetByte& refSet)->int
+	{
+		if (IsEnd()) {
+			Error(L"Escape at the end of the expression");
+			return -1;
+		}
+
+		const auto wch = Peek();
+		++m_sPos;
+		const auto lmbRange = [&refSet](char chFirst, char chLast) {
+			for (auto i = static_cast<int>(chFirst); i <= static_cast<int>(chLast); ++i) {
+				refSet[static_cast<std::size_t>(i)] = true;
+			}
+			};
+
+		switch (wch) {
+		case L'x':
+		{
+			const auto lmbHex = [](wchar_t wchHex)->int {
+				if (wchHex >= L'0' && wchHex <= L'9') { return wchHex - L'0'; }
+				if (wchHex >= L'a' && wchHex <= L'f') { return wchHex - L'a' + 10; }
+				if (wchHex >= L'A' && wchHex <= L'F') { return wchHex - L'A' + 10; }
+				return -1;
+				};
+			const auto iHigh = IsEnd() ? -1 : lmbHex(m_wsvPattern[m_sPos]);
+			const auto iLow = m_sPos + 1 >= m_wsvPattern.size() ? -1 : lmbHex(m_wsvPattern[m_sPos + 1]);
+			if (iHigh < 0 || iLow < 0) {
+				Error(L"Two hex digits are expected after the \\x");
+				return -1;
+			}
+			m_sPos += 2;
+			return (iHigh << 4) | iLow;
+		}
+		case L'n': return '\n';
+		case L'r': return '\r';
+		case L't': return '\t';
+		case L'f': return '\f';
+		case L'v': return '\v';
+		case L'0': return 0;
+		case L'd':
+		case L'D':
+		case L'w':
+		case L'W':
+		case L's':
+		case L'S':
+		{
+			SetByte stClass;
+			std::swap(stClass, refSet);
+			if (wch == L'd' || wch == L'D') {
+				lmbRange('0', '9');
+			}
+			else if (wch == L'w' || wch == L'W') {
+				lmbRange('0', '9');
+				lmbRange('a', 'z');
+				lmbRange('A', 'Z');
+				refSet['_'] = true;
+			}
+			else {
+				lmbRange('\t', '\r');
+				refSet[' '] = true;
+			}
+			if (wch == L'D' || wch == L'W' || wch == L'S') {
+				refSet.flip();
+			}
+			refSet |= stClass;
+			return -1;
+		}
+		default:
+			if (wch > 0x7F || std::iswalnum(wch)) {
+				--m_sPos;
+				Error(L"Unknown escape");
+				return -1;
+			}
+			return static_cast<int>(wch); //Escaped punctuation, like \. or \\.
+		}
+	}
+
+	auto CHexRegex::ParseNumber()->std::optional<std::uint32_t>
+	{
+		std::uint32_t u32Num { 0 };
+		const auto sPosBegin = m_sPos;
+		while (!IsEnd() && Peek() >= L'0' && Peek() <= L'9') {
+			u32Num = (u32Num * 10) + static_cast<std::uint32_t>(Peek() - L'0');
+			++m_sPos;
+			if (u32Num > m_u32RepeatMax) {
+				Error(std::format(L"Repetitions count is above {}", m_u32RepeatMax));
+				return std::nullopt;
+			}
+		}
+
+		if (m_sPos == sPosBegin)
+			return std::nullopt;
+
+		return u32Num;
+	}
+
+	auto CHexRegex::ParseRepeat()->std::uint32_t
+	{
+		auto u32Node = ParseAtom();
+		while (m_wstrError.empty() && !IsEnd()) {
+			std::uint32_t u32Min;
+			std::uint32_t u32Max;
+			switch (Peek()) {
+			case L'*':
+				u32Min = 0;
+				u32Max = m_u32Unbounded;
+				++m_sPos;
+				break;
+			case L'+':
+				u32Min = 1;
+				u32Max = m_u32Unbounded;
+				++m_sPos;
+				break;
+			case L'?':
+				u32Min = 0;
+				u32Max = 1;
+				++m_sPos;
+				break;
+			case L'{':
+			{
+				++m_sPos;
+				const auto optMin = ParseNumber();
+				if (!optMin) {
+					Error(L"Wrong repetitions count");
+					return 0;
+				}
+				u32Min = u32Max = *optMin;
+				if (!IsEnd() && Peek() == L',') {
+					++m_sPos;
+					const auto optMax = ParseNumber();
+					if (!m_wstrError.empty())
+						return 0;
+
+					u32Max = optMax ? *optMax : m_u32Unbounded;
+				}
+				if (IsEnd() || Peek() != L'}') {
+					Error(L"Missing '}'");
+					return 0;
+				}
+				++m_sPos;
+				if (u32Max < u32Min) {
+					Error(L"Wrong repetitions range");
+					return 0;
+				}
+			}
+			break;
+			default:
+				return u32Node;
+			}
+
+			u32Node = AddNode({ .eType { ENodeType::REPEAT }, .u32Min { u32Min }, .u32Max { u32Max }, .vecChild { u32Node } });
+		}
+
+		return u32Node;
+	}
+
+	auto CHexRegex::Peek()const->wchar_t
+	{
+		return m_wsvPattern[m_sPos];
+	}
+
+
+	//CHexRegexDFA.
+
+	CHexRegexDFA::CHexRegexDFA(const CHexRegex& refRegex, bool fReverse, bool fUnanchored)
+	{
+		m_pRegex = &refRegex;
+		m_pNFA = &refRegex.m_arrNFA[fReverse];
+		m_u32Classes = refRegex.m_u32Classes;
+		m_fUnanchored = fUnanchored;
+
+		m_vecVisited.resize(m_pNFA->size());
+		NextVisitMark();
+		AddClosure(refRegex.m_arrNFAStart[fReverse], m_vecStartSet);
+		std::sort(m_vecStartSet.begin(), m_vecStartSet.end());
+	}
+
+	auto CHexRegexDFA::GetStartState()->std::uint32_t
+	{
+		return AddState(std::vector(m_vecStartSet));
+	}
+
+	auto CHexRegexDFA::ImportState(const CHexRegexDFA& refDFA, std::uint32_t u32State)->std::uint32_t
+	{
+		assert(refDFA.m_pNFA == m_pNFA);
+		return AddState(std::vector(*refDFA.m_vecStateSet[u32State]));
+	}
+
+	auto CHexRegexDFA::MatchSize(const IHexCtrl* pHexCtrl, ULONGLONG ullOffset, ULONGLONG ullSentinel, bool fLongest)->ULONGLONG
+	{
+		assert(!m_fUnanchored);
+		const auto ullSizeChunkMax = static_cast<ULONGLONG>(pHexCtrl->GetCacheSize());
+		if (m_pRegex->m_ullMaxSize < ullSentinel - ullOffset) { //Nothing to read past the max match size.
+			ullSentinel = ullOffset + m_pRegex->m_ullMaxSize;
+		}
+
+		auto u32State = GetStartState();
+		ULONGLONG ullSize { 0 };
+		for (auto ullOffsetCurr = ullOffset; ullOffsetCurr < ullSentinel;) {
+			const auto ullSizeChunk = (std::min)(ullSentinel - ullOffsetCurr, ullSizeChunkMax);
+			const auto fRun = Run<false>(pHexCtrl->GetData({ .ullOffset { ullOffsetCurr }, .ullSize { ullSizeChunk } }), u32State,
+				[&](std::size_t sIndex) {
+					ullSize = ullOffsetCurr - ullOffset + sIndex + 1;
+					return fLongest;
+				});
+			if (!fRun)
+				break;
+
+			ullOffsetCurr += ullSizeChunk;
+		}
+
+		return ullSize;
+	}
+
+	template<bool fBackward, typename TFunc>
+	bool CHexRegexDFA::Run(SpanCByte spnData, std::uint32_t& refState, TFunc func)
+	{
+		const auto pData = reinterpret_cast<const std::uint8_t*>(spnData.data());
+		const auto sSize = spnData.size();
+		const auto& refClass = m_pRegex->m_arrClass;
+		auto u32State = refState;
+		for (std::size_t i { 0 }; i < sSize; ++i) {
+			const auto sIndex = fBackward ? sSize - 1 - i : i;
+			const auto u8Class = refClass[pData[sIndex]];
+			auto u32Next = m_vecTrans[(static_cast<std::size_t>(u32State) * m_u32Classes) + u8Class];
+			if (u32Next == m_u32Unknown) [[unlikely]] {
+				u32Next = ComputeNext(u32State, u8Class);
+			}
+			u32State = u32Next;
+
+			const auto u8Flags = m_vecFlags[u32State];
+			if (u8Flags == 0) [[likely]]
+				continue;
+
+			if ((u8Flags & m_u8FlagDead) || !func(sIndex)) {
+				refState = u32State;
+				return false;
+			}
+		}
+
+		refState = u32State;
+		return true;
+	}
+
+
+	//CHexRegexDFA private methods.
+
+	auto CHexRegexDFA::AddState(std::vector<std::uint32_t>&& vecSet)->std::uint32_t
+	{
+		if (const auto it = m_umapState.find(vecSet); it != m_umapState.end())
+			return it->second;
+
+		std::uint8_t u8Flags { 0 };
+		if (vecSet.empty()) {
+			u8Flags |= m_u8FlagDead;
+		}
+		if (std::any_of(vecSet.begin(), vecSet.end(), [this](std::uint32_t u32NFA) {
+			return (*m_pNFA)[u32NFA].eType == CHexRegex::ENFAType::MATCH; })) {
+			u8Flags |= m_u8FlagMatch;
+		}
+
+		const auto u32State = static_cast<std::uint32_t>(m_vecStateSet.size());
+		constexpr auto sSizeNode { 64U }; //Approximate overhead of the map node and the vectors.
+		m_sCacheSize += ((vecSet.size() + m_u32Classes) * sizeof(std::uint32_t)) + sSizeNode;
+		const auto it = m_umapState.emplace(std::move(vecSet), u32State).first;
+		m_vecStateSet.emplace_back(&it->first);
+		m_vecFlags.emplace_back(u8Flags);
+		m_vecTrans.resize(m_vecTrans.size() + m_u32Classes, m_u32Unknown);
+
+		return u32State;
+	}
+
+	void CHexRegexDFA::AddClosure(std::uint32_t u32NFA, std::vector<std::uint32_t>& vecSet)
+	{
+		//Only the byte consuming and the match states are kept in the DFA state's set.
+		m_vecStack.emplace_back(u32NFA);
+		while (!m_vecStack.empty()) {
+			const auto u32Curr = m_vecStack.back();
+			m_vecStack.pop_back();
+			if (m_vecVisited[u32Curr] == m_u32VisitMark)
+				continue;
+
+			m_vecVisited[u32Curr] = m_u32VisitMark;
+			const auto& refState = (*m_pNFA)[u32Curr];
+			if (refState.eType == CHexRegex::ENFAType::SPLIT) {
+				m_vecStack.emplace_back(refState.u32Next2);
+				m_vecStack.emplace_back(refState.u32Next);
+			}
+			else {
+				vecSet.emplace_back(u32Curr);
+			}
+		}
+	}
+
+	void CHexRegexDFA::ClearCache()
+	{
+		m_vecTrans.clear();
+		m_vecStateSet.clear();
+		m_vecFlags.clear();
+		m_umapState.clear();
+		m_sCacheSize = 0;
+	}
+
+	auto CHexRegexDFA::ComputeNext(std::uint32_t u32State, std::uint8_t u8Class)->std::uint32_t
+	{
+		const auto u8Byte = m_pRegex->m_arrClassByte[u8Class];
+		std::vector<std::uint32_t> vecSet;
+		NextVisitMark();
+		for (const auto u32NFA : *m_vecStateSet[u32State]) {
+			const auto& refNFA = (*m_pNFA)[u32NFA];
+			if (refNFA.eType == CHexRegex::ENFAType::BYTESET && m_pRegex->m_vecSet[refNFA.u32Set][u8Byte]) {
+				AddClosure(refNFA.u32Next, vecSet);
+			}
+		}
+		if (m_fUnanchored) { //A new match can begin at every byte.
+			for (const auto u32NFA : m_vecStartSet) {
+				if (m_vecVisited[u32NFA] != m_u32VisitMark) {
+					m_vecVisited[u32NFA] = m_u32VisitMark;
+					vecSet.emplace_back(u32NFA);
+				}
+			}
+		}
+		std::sort(vecSet.begin(), vecSet.end());
+
+		//The state ids are not valid after the cache is cleared, only the returned one is.
+		if (m_sCacheSize > m_sCacheSizeMax) {
+			ClearCache();
+			return AddState(std::move(vecSet));
+		}
+
+		const auto u32Next = AddState(std::move(vecSet));
+		m_vecTrans[(static_cast<std::size_t>(u32State) * m_u32Classes) + u8Class] = u32Next;
+		return u32Next;
+	}
+
+	void CHexRegexDFA::NextVisitMark()
+	{
+		if (++m_u32VisitMark == 0) { //Marks overflow.
+			std::fill(m_vecVisited.begin(), m_vecVisited.end(), 0U);
+			m_u32VisitMark = 1;
+		}
+	}
+}
\ No newline at end of file
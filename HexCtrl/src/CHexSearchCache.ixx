@@ -0,0 +1,150 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+export module HEXCTRL.CHexSearchCache;
+
+import HEXCTRL.CHexSearchResult;
+
+namespace HEXCTRL::INTERNAL {
+	//Complete results of the recent searches, keyed by the search data, the search options and the range.
+	//Every data modification increments the data generation, and its spans are logged with that generation.
+	//A result is cached with the generation it was found at, and is taken together with the spans modified
+	//since then, so that only the offsets around these spans are searched again.
+	//The log keeps up to m_sLogMax spans, the results older than the log's oldest generation are dropped.
+	export class CHexSearchCache final {
+	public:
+		struct CACHED {
+			CHexSearchResult Res;   //All the occurrences from the ullFirst to the range end.
+			VecSpan vecDirty;       //Sorted, non-overlapping spans modified after the ullGen, set by the Take.
+			ULONGLONG ullFirst { }; //Offset the search was started from.
+			ULONGLONG ullGen { };   //Data generation the result was found at.
+		};
+		void ClearAll();
+		[[nodiscard]] auto GetGeneration()const->ULONGLONG;
+		void Put(std::vector<std::byte>&& vecKey, CACHED&& refCached);
+		void SetDirty(const VecSpan& vecSpan);
+		[[nodiscard]] auto Take(const std::vector<std::byte>& vecKey)->std::optional<CACHED>; //Removes the result from the cache.
+	private:
+		struct ENTRY {
+			std::vector<std::byte> vecKey;
+			CHexSearchResult Res;
+			ULONGLONG ullFirst { };
+			ULONGLONG ullGen { };
+		};
+		struct DIRTY {
+			HEXSPAN hss;
+			ULONGLONG ullGen { };
+		};
+	private:
+		static constexpr std::size_t m_sEntriesMax { 8 };
+		static constexpr std::size_t m_sLogMax { 4096 };
+		std::vector<ENTRY> m_vecEntry; //The most recently used is the last.
+		std::deque<DIRTY> m_deqLog;    //Modified spans, in the generations order.
+		ULONGLONG m_ullGen { };        //Data generation.
+		ULONGLONG m_ullGenLog { };     //All the spans modified after this generation are in the log.
+		mutable std::mutex m_mtx;
+	};
+
+	void CHexSearchCache::ClearAll()
+	{
+		//The generation goes on, the results are dropped anyway.
+		const std::scoped_lock lock(m_mtx);
+		m_vecEntry.clear();
+		m_deqLog.clear();
+		m_ullGenLog = m_ullGen;
+	}
+
+	auto CHexSearchCache::GetGeneration()const->ULONGLONG
+	{
+		const std::scoped_lock lock(m_mtx);
+		return m_ullGen;
+	}
+
+	void CHexSearchCache::Put(std::vector<std::byte>&& vecKey, CACHED&& refCached)
+	{
+		const std::scoped_lock lock(m_mtx);
+		if (refCached.ullGen < m_ullGenLog) //Data was modified beyond the log since then.
+			return;
+
+		std::erase_if(m_vecEntry, [&vecKey](const ENTRY& ref) { return ref.vecKey == vecKey; });
+		if (m_vecEntry.size() >= m_sEntriesMax) {
+			m_vecEntry.erase(m_vecEntry.begin());
+		}
+
+		m_vecEntry.emplace_back(ENTRY { .vecKey { std::move(vecKey) }, .Res { std::move(refCached.Res) },
+			.ullFirst { refCached.ullFirst }, .ullGen { refCached.ullGen } });
+	}
+
+	void CHexSearchCache::SetDirty(const VecSpan& vecSpan)
+	{
+		const std::scoped_lock lock(m_mtx);
+		++m_ullGen;
+		if (m_vecEntry.empty()) { //Nothing to patch, the log isn't needed.
+			m_deqLog.clear();
+			m_ullGenLog = m_ullGen;
+			return;
+		}
+
+		for (const auto& hss : vecSpan) {
+			if (hss.ullSize > 0) {
+				m_deqLog.emplace_back(hss, m_ullGen);
+			}
+		}
+
+		if (m_deqLog.size() > m_sLogMax) {
+			while (m_deqLog.size() > m_sLogMax / 2) { //The whole generation goes out.
+				m_ullGenLog = m_deqLog.front().ullGen;
+				while (!m_deqLog.empty() && m_deqLog.front().ullGen == m_ullGenLog) {
+					m_deqLog.pop_front();
+				}
+			}
+			std::erase_if(m_vecEntry, [this](const ENTRY& ref) { return ref.ullGen < m_ullGenLog; });
+		}
+	}
+
+	auto CHexSearchCache::Take(const std::vector<std::byte>& vecKey)->std::optional<CACHED>
+	{
+		const std::scoped_lock lock(m_mtx);
+		const auto iter = std::find_if(m_vecEntry.begin(), m_vecEntry.end(), [&vecKey](const ENTRY& ref) {
+			return ref.vecKey == vecKey; });
+		if (iter == m_vecEntry.end())
+			return std::nullopt;
+
+		CACHED stCached { .Res { std::move(iter->Res) }, .ullFirst { iter->ullFirst }, .ullGen { iter->ullGen } };
+		m_vecEntry.erase(iter);
+		for (const auto& refDirty : m_deqLog) {
+			if (refDirty.ullGen > stCached.ullGen) {
+				stCached.vecDirty.emplace_back(refDirty.hss);
+			}
+		}
+
+		std::sort(stCached.vecDirty.begin(), stCached.vecDirty.end(), [](const HEXSPAN& lhs, const HEXSPAN& rhs) {
+			return lhs.ullOffset < rhs.ullOffset; });
+		VecSpan vecMerged;
+		for (const auto& hss : stCached.vecDirty) {
+			if (!vecMerged.empty() && hss.ullOffset <= vecMerged.back().ullOffset + vecMerged.back().ullSize) {
+				auto& refBack = vecMerged.back();
+				refBack.ullSize = (std::max)(refBack.ullOffset + refBack.ullSize, hss.ullOffset + hss.ullSize) - refBack.ullOffset;
+			}
+			else {
+				vecMerged.emplace_back(hss);
+			}
+		}
+		stCached.vecDirty = std::move(vecMerged);
+
+		return stCached;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,563 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+export module HEXCTRL.CHexSearchIndex;
+
+import HEXCTRL.CHexDlgProgress;
+import HEXCTRL.CHexHash;
+
+namespace HEXCTRL::INTERNAL {
+	//Sampled 4-gram posting index of the whole data, to find the search data without scanning everything.
+	//Only the 4-grams at the offsets that are multiples of the sample step are indexed, and every offset
+	//of the search data that is at least (sample step + 3) bytes long has exactly one of its first
+	//sample-step 4-grams at such an offset. The 4-grams are hashed into buckets, every bucket holds
+	//the ascending sample numbers of its 4-grams. Candidates are always verified against the data.
+	//The data modified after the index was built is kept as the dirty spans, that are searched directly.
+	//The index is stale then, it's not saved to the side file anymore, but the side file is kept.
+	export class CHexSearchIndex final {
+	public:
+		CHexSearchIndex() = default;
+		CHexSearchIndex(const CHexSearchIndex&) = delete;
+		CHexSearchIndex& operator=(const CHexSearchIndex&) = delete;
+		~CHexSearchIndex();
+		void ClearAll();
+		//Offset of the last occurrence within the [ullFirst, ullLast], that is stepped from the ullLast.
+		//Returns std::nullopt if nothing is found, or if the pDlgProg is canceled.
+		[[nodiscard]] auto FindBack(SpanCByte spnFind, ULONGLONG ullFirst, ULONGLONG ullLast, ULONGLONG ullStep,
+			CHexDlgProgress* pDlgProg)const->std::optional<ULONGLONG>;
+		//Offset of the first occurrence within the [ullFirst, ullLast], that is stepped from the ullFirst.
+		[[nodiscard]] auto FindFwd(SpanCByte spnFind, ULONGLONG ullFirst, ULONGLONG ullLast, ULONGLONG ullStep,
+			CHexDlgProgress* pDlgProg)const->std::optional<ULONGLONG>;
+		void Initialize(IHexCtrl* pHexCtrl);
+		[[nodiscard]] bool IsUsable(std::size_t sSizeSearch)const; //Index is built and the search data is long enough.
+		bool Open(std::wstring_view wsvPath); //Loads the index side file, or builds it, in background, "" to clear.
+		void SetDirty(const VecSpan& vecSpan); //Must be called before the data in the vecSpan is modified.
+		void Wait(); //Waits until the index is loaded, or built and saved.
+	private:
+		struct INDEXHEADER { //Side file header, followed by the bucket starts and by the postings.
+			std::uint32_t u32Signature { m_u32Signature };
+			std::uint32_t u32Version { m_u32Version };
+			ULONGLONG ullDataSize { };
+			ULONGLONG ullDataHash { };
+			std::uint32_t u32SampleStep { };
+			std::uint32_t u32BucketBits { };
+			ULONGLONG ullPostings { };
+		};
+		struct INDEXCURSOR { //Position in the posting list of the search data's 4-gram at the sIndex.
+			const std::uint32_t* pCurr { };
+			const std::uint32_t* pEnd { };
+			std::size_t sIndex { };
+		};
+		void Build(std::stop_token stToken, std::wstring wstrPath);
+		[[nodiscard]] auto GetBucket(const std::byte* pData)const->std::uint32_t;
+		[[nodiscard]] auto GetCursors(SpanCByte spnFind)const->std::vector<INDEXCURSOR>;
+		[[nodiscard]] auto GetDataHash(std::stop_token stToken)const->std::optional<ULONGLONG>;
+		[[nodiscard]] bool IsMatch(SpanCByte spnFind, ULONGLONG ullOffset)const;
+		[[nodiscard]] bool Load(const std::wstring& wstrPath, ULONGLONG ullDataHash);
+		void Save(std::stop_token stToken, const std::wstring& wstrPath, ULONGLONG ullDataHash)const;
+	private:
+		static constexpr auto m_u32Signature { 0x58495848U }; //"HXIX".
+		static constexpr auto m_u32Version { 2U };
+		static constexpr auto m_ullSizeChunk { 1024ULL * 1024ULL * 16ULL }; //Stop request is checked every chunk.
+		static constexpr auto m_ullPostingsMax { 1ULL << 28 }; //Sample step grows with the data to fit this.
+		IHexCtrl* m_pHexCtrl { };
+		std::vector<std::uint32_t> m_vecBucket;   //Start of every bucket's postings, m_vecBucket[bucket + 1] is the end.
+		std::vector<std::uint32_t> m_vecPosting;  //Sample numbers of the 4-grams, ascending within a bucket.
+		VecSpan m_vecDirty;                       //Sorted, non-overlapping spans modified after the index was built.
+		std::jthread m_thrdBuild;
+		mutable std::mutex m_mtx;                 //Guards the m_vecDirty.
+		std::atomic_bool m_atomReady { false };   //Index can be used.
+		ULONGLONG m_ullDataSize { };              //Data size the index is built for.
+		ULONGLONG m_ullDirtySize { };             //Total size of the m_vecDirty spans.
+		std::uint32_t m_u32SampleStep { };
+		std::uint32_t m_u32BucketBits { };
+	};
+
+	CHexSearchIndex::~CHexSearchIndex()
+	{
+		ClearAll();
+	}
+
+	void CHexSearchIndex::ClearAll()
+	{
+		if (m_thrdBuild.joinable()) {
+			m_thrdBuild.request_stop();
+			m_thrdBuild.join();
+		}
+
+		m_atomReady = false;
+		const std::scoped_lock lock(m_mtx);
+		m_vecBucket.clear();
+		m_vecBucket.shrink_to_fit();
+		m_vecPosting.clear();
+		m_vecPosting.shrink_to_fit();
+		m_vecDirty.clear();
+		m_ullDataSize = 0;
+		m_ullDirtySize = 0;
+		m_u32SampleStep = 0;
+		m_u32BucketBits = 0;
+	}
+
+	auto CHexSearchIndex::FindBack(SpanCByte spnFind, ULONGLONG ullFirst, ULONGLONG ullLast, ULONGLONG ullStep,
+		CHexDlgProgress* pDlgProg)const->std::optional<ULONGLONG>
+	{
+		assert(IsUsable(spnFind.size()));
+		if (ullFirst > ullLast || ullLast + spnFind.size() > m_ullDataSize)
+			return std::nullopt;
+
+		const auto lmbAligned = [=](ULONGLONG ullOffset) { return (ullLast - ullOffset) % ullStep == 0; };
+		VecSpan vecDirty;
+		{
+			const std::scoped_lock lock(m_mtx);
+			vecDirty = m_vecDirty;
+		}
+
+		//Occurrences that cross the dirty spans are searched directly, the index may not have them.
+		std::optional<ULONGLONG> optDirty;
+		for (auto it = vecDirty.rbegin(); it != vecDirty.rend() && !optDirty; ++it) {
+			if (it->ullOffset + it->ullSize - 1 < ullFirst)
+				break;
+
+			const auto ullDirtyFirst = it->ullOffset >= spnFind.size() - 1 ? it->ullOffset - (spnFind.size() - 1) : 0ULL;
+			if (ullDirtyFirst > ullLast)
+				continue;
+
+			const auto ullScanFirst = (std::max)(ullDirtyFirst, ullFirst);
+			auto ullScan = (std::min)(it->ullOffset + it->ullSize - 1, ullLast);
+			ullScan -= (ullStep - ((ullLast - ullScan) % ullStep)) % ullStep;
+			for (; ullScan >= ullScanFirst && ullScan <= ullLast; ullScan -= ullStep) {
+				if (IsMatch(spnFind, ullScan)) {
+					optDirty = ullScan;
+					break;
+				}
+			}
+		}
+
+		if (optDirty && *optDirty == ullLast)
+			return optDirty;
+
+		const auto ullFloor = optDirty ? *optDirty + 1 : ullFirst; //Candidates lower than that are not needed.
+		const auto ullSampleStep = static_cast<ULONGLONG>(m_u32SampleStep);
+		auto vecCursor = GetCursors(spnFind);
+		for (auto& refCursor : vecCursor) { //Cursors go backward, from the pEnd to the pCurr.
+			const auto ullSampleMax = (ullLast + refCursor.sIndex) / ullSampleStep;
+			refCursor.pEnd = std::upper_bound(refCursor.pCurr, refCursor.pEnd, ullSampleMax);
+		}
+
+		for (auto ullCandidates { 0ULL }; ; ++ullCandidates) {
+			INDEXCURSOR* pCursorMax { };
+			auto ullOffsetMax { 0ULL };
+			for (auto& refCursor : vecCursor) {
+				if (refCursor.pCurr == refCursor.pEnd)
+					continue;
+
+				const auto ullSampleOffset = refCursor.pEnd[-1] * ullSampleStep;
+				if (ullSampleOffset < refCursor.sIndex) { //Would start before the data beginning.
+					refCursor.pEnd = refCursor.pCurr;
+					continue;
+				}
+
+				if (const auto ullOffset = ullSampleOffset - refCursor.sIndex; pCursorMax == nullptr || ullOffset > ullOffsetMax) {
+					pCursorMax = &refCursor;
+					ullOffsetMax = ullOffset;
+				}
+			}
+
+			if (pCursorMax == nullptr || ullOffsetMax < ullFloor)
+				break;
+
+			--pCursorMax->pEnd;
+			if (lmbAligned(ullOffsetMax) && IsMatch(spnFind, ullOffsetMax))
+				return ullOffsetMax;
+
+			if (pDlgProg != nullptr && (ullCandidates & 0xFFFFULL) == 0 && pDlgProg->IsCanceled())
+				return std::nullopt;
+		}
+
+		return optDirty;
+	}
+
+	auto CHexSearchIndex::FindFwd(SpanCByte spnFind, ULONGLONG ullFirst, ULONGLONG ullLast, ULONGLONG ullStep,
+		CHexDlgProgress* pDlgProg)const->std::optional<ULONGLONG>
+	{
+		assert(IsUsable(spnFind.size()));
+		if (ullFirst > ullLast || ullLast + spnFind.size() > m_ullDataSize)
+			return std::nullopt;
+
+		const auto lmbAligned = [=](ULONGLONG ullOffset) { return (ullOffset - ullFirst) % ullStep == 0; };
+		VecSpan vecDirty;
+		{
+			const std::scoped_lock lock(m_mtx);
+			vecDirty = m_vecDirty;
+		}
+
+		//Occurrences that cross the dirty spans are searched directly, the index may not have them.
+		std::optional<ULONGLONG> optDirty;
+		for (auto it = vecDirty.begin(); it != vecDirty.end() && !optDirty; ++it) {
+			const auto ullDirtyFirst = it->ullOffset >= spnFind.size() - 1 ? it->ullOffset - (spnFind.size() - 1) : 0ULL;
+			if (ullDirtyFirst > ullLast)
+				break;
+
+			const auto ullDirtyLast = (std::min)(it->ullOffset + it->ullSize - 1, ullLast);
+			if (ullDirtyLast < ullFirst)
+				continue;
+
+			auto ullScan = (std::max)(ullDirtyFirst, ullFirst);
+			ullScan += (ullStep - ((ullScan - ullFirst) % ullStep)) % ullStep;
+			for (; ullScan <= ullDirtyLast; ullScan += ullStep) {
+				if (IsMatch(spnFind, ullScan)) {
+					optDirty = ullScan;
+					break;
+				}
+			}
+		}
+
+		if (optDirty && *optDirty == ullFirst)
+			return optDirty;
+
+		const auto ullCeil = optDirty ? *optDirty - 1 : ullLast; //Candidates higher than that are not needed.
+		const auto ullSampleStep = static_cast<ULONGLONG>(m_u32SampleStep);
+		auto vecCursor = GetCursors(spnFind);
+		for (auto& refCursor : vecCursor) {
+			const auto ullSampleMin = (ullFirst + refCursor.sIndex + ullSampleStep - 1) / ullSampleStep;
+			refCursor.pCurr = std::lower_bound(refCursor.pCurr, refCursor.pEnd, ullSampleMin);
+		}
+
+		for (auto ullCandidates { 0ULL }; ; ++ullCandidates) {
+			INDEXCURSOR* pCursorMin { };
+			auto ullOffsetMin { 0ULL };
+			for (auto& refCursor : vecCursor) {
+				if (refCursor.pCurr == refCursor.pEnd)
+					continue;
+
+				//The lower_bound above ensures that the sample offset is not less than the sIndex.
+				if (const auto ullOffset = *refCursor.pCurr * ullSampleStep - refCursor.sIndex; pCursorMin == nullptr || ullOffset < ullOffsetMin) {
+					pCursorMin = &refCursor;
+					ullOffsetMin = ullOffset;
+				}
+			}
+
+			if (pCursorMin == nullptr || ullOffsetMin > ullCeil)
+				break;
+
+			++pCursorMin->pCurr;
+			if (lmbAligned(ullOffsetMin) && IsMatch(spnFind, ullOffsetMin))
+				return ullOffsetMin;
+
+			if (pDlgProg != nullptr && (ullCandidates & 0xFFFFULL) == 0 && pDlgProg->IsCanceled())
+				return std::nullopt;
+		}
+
+		return optDirty;
+	}
+
+	void CHexSearchIndex::Initialize(IHexCtrl* pHexCtrl)
+	{
+		assert(pHexCtrl != nullptr);
+		m_pHexCtrl = pHexCtrl;
+	}
+
+	bool CHexSearchIndex::IsUsable(std::size_t sSizeSearch)const
+	{
+		return m_atomReady && sSizeSearch >= static_cast<std::size_t>(m_u32SampleStep) + 3
+			&& m_pHexCtrl != nullptr && m_ullDataSize == m_pHexCtrl->GetDataSize();
+	}
+
+	bool CHexSearchIndex::Open(std::wstring_view wsvPath)
+	{
+		ClearAll();
+		if (wsvPath.empty())
+			return true;
+
+		//The index is built in background, while the data is accessed from the other threads,
+		//that's only allowed in non-virtual mode.
+		assert(m_pHexCtrl != nullptr);
+		if (m_pHexCtrl == nullptr || !m_pHexCtrl->IsDataSet() || m_pHexCtrl->IsVirtual()
+			|| m_pHexCtrl->GetDataSize() < sizeof(std::uint32_t))
+			return false;
+
+		m_ullDataSize = m_pHexCtrl->GetDataSize();
+		m_u32SampleStep = 8U;
+		while (m_ullDataSize / m_u32SampleStep > m_ullPostingsMax) {
+			m_u32SampleStep *= 2;
+		}
+
+		//About 32 postings per bucket on average.
+		const auto ullPostings = ((m_ullDataSize - sizeof(std::uint32_t)) / m_u32SampleStep) + 1;
+		m_u32BucketBits = std::clamp(static_cast<std::uint32_t>(std::bit_width(ullPostings / 32)), 12U, 24U);
+		m_thrdBuild = std::jthread([this](std::stop_token stToken, std::wstring wstrPath) {
+			Build(stToken, std::move(wstrPath)); }, std::wstring { wsvPath });
+
+		return true;
+	}
+
+	void CHexSearchIndex::SetDirty(const VecSpan& vecSpan)
+	{
+		if (m_ullDataSize == 0 || m_pHexCtrl == nullptr)
+			return;
+
+		if (m_ullDataSize != m_pHexCtrl->GetDataSize()) {
+			ClearAll();
+			return;
+		}
+
+		//The side file is not removed, it's still built for the data as it was, if the modifications are discarded.
+		//Otherwise it doesn't match the data hash and is rebuilt next time.
+		bool fTooDirty;
+		{
+			const std::scoped_lock lock(m_mtx);
+			for (const auto& hss : vecSpan) {
+				if (hss.ullSize == 0 || hss.ullOffset >= m_ullDataSize)
+					continue;
+
+				m_vecDirty.emplace_back(hss.ullOffset, (std::min)(hss.ullSize, m_ullDataSize - hss.ullOffset));
+			}
+
+			std::sort(m_vecDirty.begin(), m_vecDirty.end(), [](const HEXSPAN& lhs, const HEXSPAN& rhs) {
+				return lhs.ullOffset < rhs.ullOffset; });
+			VecSpan vecMerged;
+			for (const auto& hss : m_vecDirty) {
+				if (!vecMerged.empty() && hss.ullOffset <= vecMerged.back().ullOffset + vecMerged.back().ullSize) {
+					auto& refBack = vecMerged.back();
+					refBack.ullSize = (std::max)(refBack.ullOffset + refBack.ullSize, hss.ullOffset + hss.ullSize) - refBack.ullOffset;
+				}
+				else {
+					vecMerged.emplace_back(hss);
+				}
+			}
+
+			m_vecDirty = std::move(vecMerged);
+			m_ullDirtySize = 0;
+			for (const auto& hss : m_vecDirty) {
+				m_ullDirtySize += hss.ullSize;
+			}
+
+			//Searching through the big dirty spans directly is no faster than searching without the index.
+			fTooDirty = m_ullDirtySize > m_ullDataSize / 16;
+		}
+
+		if (fTooDirty) {
+			ClearAll();
+		}
+	}
+
+	void CHexSearchIndex::Wait()
+	{
+		if (m_thrdBuild.joinable()) {
+			m_thrdBuild.join();
+		}
+	}
+
+
+	//Private methods.
+
+	void CHexSearchIndex::Build(std::stop_token stToken, std::wstring wstrPath)
+	{
+		//The side file is only loaded if it was built for the very same data, the data might be changed
+		//outside, keeping its size. Otherwise the index is rebuilt.
+		const auto optDataHash = GetDataHash(stToken);
+		if (!optDataHash)
+			return;
+
+		if (Load(wstrPath, *optDataHash)) {
+			m_atomReady = true;
+			return;
+		}
+
+		//Two passes over the data: buckets' sizes are counted first, then the postings are placed.
+		const auto spnData = m_pHexCtrl->GetData({ 0, m_ullDataSize });
+		const auto u32Samples = static_cast<std::uint32_t>(((m_ullDataSize - sizeof(std::uint32_t)) / m_u32SampleStep) + 1);
+		const auto u32SamplesChunk = static_cast<std::uint32_t>(m_ullSizeChunk / m_u32SampleStep);
+		std::vector<std::uint32_t> vecBucket((1ULL << m_u32BucketBits) + 1);
+		for (auto u32Sample { 0U }; u32Sample < u32Samples;) {
+			if (stToken.stop_requested())
+				return;
+
+			const auto u32SampleEnd = u32Samples - u32Sample > u32SamplesChunk ? u32Sample + u32SamplesChunk : u32Samples;
+			for (; u32Sample < u32SampleEnd; ++u32Sample) {
+				++vecBucket[GetBucket(spnData.data() + (static_cast<ULONGLONG>(u32Sample) * m_u32SampleStep)) + 1];
+			}
+		}
+
+		for (auto i { 1ULL }; i < vecBucket.size(); ++i) {
+			vecBucket[i] += vecBucket[i - 1];
+		}
+
+		std::vector<std::uint32_t> vecPosting(u32Samples);
+		std::vector<std::uint32_t> vecBucketNext(vecBucket.begin(), vecBucket.end() - 1);
+		for (auto u32Sample { 0U }; u32Sample < u32Samples;) {
+			if (stToken.stop_requested())
+				return;
+
+			const auto u32SampleEnd = u32Samples - u32Sample > u32SamplesChunk ? u32Sample + u32SamplesChunk : u32Samples;
+			for (; u32Sample < u32SampleEnd; ++u32Sample) {
+				const auto u32Bucket = GetBucket(spnData.data() + (static_cast<ULONGLONG>(u32Sample) * m_u32SampleStep));
+				vecPosting[vecBucketNext[u32Bucket]++] = u32Sample;
+			}
+		}
+
+		m_vecBucket = std::move(vecBucket);
+		m_vecPosting = std::move(vecPosting);
+		m_atomReady = true;
+
+		{
+			const std::scoped_lock lock(m_mtx);
+			if (!m_vecDirty.empty()) //Data was modified while building, the index is stale.
+				return;
+		}
+
+		//The postings are built for the hashed data, the data modified while writing doesn't change them.
+		Save(stToken, wstrPath, *optDataHash);
+	}
+
+	auto CHexSearchIndex::GetBucket(const std::byte* pData)const->std::uint32_t
+	{
+		std::uint32_t u32Gram;
+		std::memcpy(&u32Gram, pData, sizeof(u32Gram));
+		return (u32Gram * 0x9E3779B1U) >> (32U - m_u32BucketBits); //Fibonacci hashing.
+	}
+
+	auto CHexSearchIndex::GetCursors(SpanCByte spnFind)const->std::vector<INDEXCURSOR>
+	{
+		//Any sample-step consecutive 4-grams of the search data cover all its offsets.
+		//The window with the least postings in total is taken.
+		const auto sStep = static_cast<std::size_t>(m_u32SampleStep);
+		const auto sWindows = spnFind.size() - sStep - 2;
+		const auto lmbPostings = [this, spnFind](std::size_t sIndex) {
+			const auto u32Bucket = GetBucket(spnFind.data() + sIndex);
+			return static_cast<ULONGLONG>(m_vecBucket[u32Bucket + 1] - m_vecBucket[u32Bucket]);
+			};
+
+		auto ullSum { 0ULL };
+		for (auto i { 0ULL }; i < sStep; ++i) {
+			ullSum += lmbPostings(i);
+		}
+
+		auto ullSumMin = ullSum;
+		std::size_t sWindowMin { 0 };
+		for (auto sWindow { 1ULL }; sWindow < sWindows; ++sWindow) {
+			ullSum += lmbPostings(sWindow + sStep - 1);
+			ullSum -= lmbPostings(sWindow - 1);
+			if (ullSum < ullSumMin) {
+				ullSumMin = ullSum;
+				sWindowMin = sWindow;
+			}
+		}
+
+		std::vector<INDEXCURSOR> vecCursor;
+		vecCursor.reserve(sStep);
+		for (auto sIndex = sWindowMin; sIndex < sWindowMin + sStep; ++sIndex) {
+			const auto u32Bucket = GetBucket(spnFind.data() + sIndex);
+			vecCursor.emplace_back(m_vecPosting.data() + m_vecBucket[u32Bucket], m_vecPosting.data() + m_vecBucket[u32Bucket + 1], sIndex);
+		}
+
+		return vecCursor;
+	}
+
+	auto CHexSearchIndex::GetDataHash(std::stop_token stToken)const->std::optional<ULONGLONG>
+	{
+		//xxHash64 of all the data, to tell the side file of the changed data.
+		const auto pHasher = CreateHasher(EHexHash::HASH_XXH64);
+		for (auto ullOffset { 0ULL }; ullOffset < m_ullDataSize; ullOffset += m_ullSizeChunk) {
+			if (stToken.stop_requested())
+				return std::nullopt;
+
+			pHasher->Update(m_pHexCtrl->GetData({ ullOffset, (std::min)(m_ullSizeChunk, m_ullDataSize - ullOffset) }));
+		}
+
+		auto ullHash { 0ULL };
+		for (const auto byte : pHasher->Final()) { //Big-endian digest.
+			ullHash = (ullHash << 8) | static_cast<std::uint8_t>(byte);
+		}
+
+		return ullHash;
+	}
+
+	bool CHexSearchIndex::IsMatch(SpanCByte spnFind, ULONGLONG ullOffset)const
+	{
+		const auto spnData = m_pHexCtrl->GetData({ ullOffset, spnFind.size() });
+		return std::memcmp(spnData.data(), spnFind.data(), spnFind.size()) == 0;
+	}
+
+	bool CHexSearchIndex::Load(const std::wstring& wstrPath, ULONGLONG ullDataHash)
+	{
+		std::ifstream ifs(wstrPath, std::ios::binary);
+		if (!ifs.is_open())
+			return false;
+
+		INDEXHEADER stHdr;
+		const auto ullSamples = ((m_ullDataSize - sizeof(std::uint32_t)) / m_u32SampleStep) + 1;
+		if (!ifs.read(reinterpret_cast<char*>(&stHdr), sizeof(stHdr)) || stHdr.u32Signature != m_u32Signature
+			|| stHdr.u32Version != m_u32Version || stHdr.ullDataSize != m_ullDataSize || stHdr.u32SampleStep != m_u32SampleStep
+			|| stHdr.u32BucketBits != m_u32BucketBits || stHdr.ullPostings != ullSamples || stHdr.ullDataHash != ullDataHash)
+			return false;
+
+		std::vector<std::uint32_t> vecBucket((1ULL << m_u32BucketBits) + 1);
+		std::vector<std::uint32_t> vecPosting(static_cast<std::size_t>(ullSamples));
+		if (!ifs.read(reinterpret_cast<char*>(vecBucket.data()), vecBucket.size() * sizeof(std::uint32_t))
+			|| !ifs.read(reinterpret_cast<char*>(vecPosting.data()), vecPosting.size() * sizeof(std::uint32_t)))
+			return false;
+
+		if (vecBucket.front() != 0 || vecBucket.back() != ullSamples || !std::is_sorted(vecBucket.begin(), vecBucket.end())
+			|| std::any_of(vecPosting.begin(), vecPosting.end(), [=](std::uint32_t u32Sample) { return u32Sample >= ullSamples; }))
+			return false;
+
+		m_vecBucket = std::move(vecBucket);
+		m_vecPosting = std::move(vecPosting);
+		return true;
+	}
+
+	void CHexSearchIndex::Save(std::stop_token stToken, const std::wstring& wstrPath, ULONGLONG ullDataHash)const
+	{
+		//Failure to save is not an error, the index is just rebuilt next time.
+		//Only the index side file is overwritten, the path may point to some other file by mistake.
+		if (std::error_code ec; std::filesystem::exists(wstrPath, ec)) {
+			std::ifstream ifs(wstrPath, std::ios::binary);
+			std::uint32_t u32Signature { };
+			if (!ifs.read(reinterpret_cast<char*>(&u32Signature), sizeof(u32Signature)) || u32Signature != m_u32Signature)
+				return;
+		}
+
+		std::ofstream ofs(wstrPath, std::ios::binary | std::ios::trunc);
+		if (!ofs.is_open())
+			return;
+
+		const INDEXHEADER stHdr { .ullDataSize { m_ullDataSize }, .ullDataHash { ullDataHash },
+			.u32SampleStep { m_u32SampleStep }, .u32BucketBits { m_u32BucketBits }, .ullPostings { m_vecPosting.size() } };
+		ofs.write(reinterpret_cast<const char*>(&stHdr), sizeof(stHdr));
+		ofs.write(reinterpret_cast<const char*>(m_vecBucket.data()), m_vecBucket.size() * sizeof(std::uint32_t));
+
+		//Postings are written by chunks, the ClearAll waits for this thread.
+		constexpr auto sPostingsChunk = static_cast<std::size_t>(m_ullSizeChunk / sizeof(std::uint32_t));
+		for (std::size_t sPos { 0 }; sPos < m_vecPosting.size() && ofs && !stToken.stop_requested(); sPos += sPostingsChunk) {
+			ofs.write(reinterpret_cast<const char*>(m_vecPosting.data() + sPos),
+				(std::min)(sPostingsChunk, m_vecPosting.size() - sPos) * sizeof(std::uint32_t));
+		}
+
+		if (!ofs || stToken.stop_requested()) {
+			ofs.close();
+			std::error_code ec;
+			std::filesystem::remove(wstrPath, ec);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,304 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+export module HEXCTRL.CHexSearchResult;
+
+namespace HEXCTRL::INTERNAL {
+	//Sorted set of the found offsets, that takes about two bytes per offset instead of eight.
+	//Offsets are kept in blocks of up to m_sBlockMax offsets, every block holds its first offset as is,
+	//and the deltas of all the next offsets as the LEB128 varints. The blocks' first offsets and
+	//the indexes of their first offsets give the O(log n) lookup by offset and by index.
+	//The last decoded block is cached, the owner-data list asks for the adjacent items.
+	export class CHexSearchResult final {
+	public:
+		[[nodiscard]] auto operator[](std::size_t sIndex)const->ULONGLONG;
+		void Append(ULONGLONG ullOffset);        //Offset must be greater than the Back().
+		void Append(CHexSearchResult&& refRes);   //All refRes offsets must be greater than the Back().
+		[[nodiscard]] auto Back()const->ULONGLONG;
+		void Clear();
+		[[nodiscard]] bool Empty()const;
+		[[nodiscard]] auto Find(ULONGLONG ullOffset)const->std::optional<std::size_t>; //Index of the offset.
+		auto Insert(ULONGLONG ullOffset)->std::pair<std::size_t, bool>; //Index of the offset, and if it was inserted.
+		[[nodiscard]] auto LowerBound(ULONGLONG ullOffset)const->std::size_t; //Index of the first offset >= ullOffset, or Size().
+		[[nodiscard]] auto Size()const->std::size_t;
+		void Truncate(std::size_t sSize); //Keeps only the first sSize offsets.
+	private:
+		struct BLOCK {
+			ULONGLONG ullFirst { };            //First offset as is.
+			ULONGLONG ullLast { };             //Last offset, for the appending.
+			std::uint32_t u32Count { };        //Offsets count, including the first one.
+			std::vector<std::uint8_t> vecDelta; //LEB128 deltas of all the next offsets.
+		};
+		[[nodiscard]] auto Decode(std::size_t sBlock)const->const std::vector<ULONGLONG>&;
+		void Encode(BLOCK& refBlock, const ULONGLONG* pOffsets, std::size_t sCount);
+		[[nodiscard]] auto GetBlockByIndex(std::size_t sIndex)const->std::size_t;
+		[[nodiscard]] auto GetBlockByOffset(ULONGLONG ullOffset)const->std::size_t;
+		static void PutDelta(std::vector<std::uint8_t>& refVec, ULONGLONG ullDelta);
+		void ResetCache()const;
+		void UpdateStarts(std::size_t sFromBlock);
+	private:
+		static constexpr std::size_t m_sBlockMax { 256 }; //Full block is split in two halves on the insertion.
+		std::vector<BLOCK> m_vecBlock;
+		std::vector<ULONGLONG> m_vecFirst;     //ullFirst of every block, for the binary search.
+		std::vector<std::size_t> m_vecStart;   //Index of the first offset of every block.
+		std::size_t m_sSize { };
+		mutable std::vector<ULONGLONG> m_vecCache; //Decoded block.
+		mutable std::size_t m_sCacheBlock { };
+		mutable bool m_fCache { false };
+	};
+}
+
+using namespace HEXCTRL::INTERNAL;
+
+auto CHexSearchResult::operator[](std::size_t sIndex)const->ULONGLONG
+{
+	assert(sIndex < m_sSize);
+	const auto sBlock = GetBlockByIndex(sIndex);
+	return Decode(sBlock)[sIndex - m_vecStart[sBlock]];
+}
+
+void CHexSearchResult::Append(ULONGLONG ullOffset)
+{
+	assert(Empty() || ullOffset > Back());
+	if (m_vecBlock.empty() || m_vecBlock.back().u32Count >= m_sBlockMax / 2) { //Appended blocks are half full.
+		m_vecBlock.emplace_back(BLOCK { .ullFirst { ullOffset }, .ullLast { ullOffset }, .u32Count { 1 } });
+		m_vecFirst.emplace_back(ullOffset);
+		m_vecStart.emplace_back(m_sSize);
+	}
+	else {
+		auto& refBlock = m_vecBlock.back();
+		PutDelta(refBlock.vecDelta, ullOffset - refBlock.ullLast);
+		refBlock.ullLast = ullOffset;
+		++refBlock.u32Count;
+		if (m_fCache && m_sCacheBlock == m_vecBlock.size() - 1) {
+			m_vecCache.emplace_back(ullOffset);
+		}
+	}
+	++m_sSize;
+}
+
+void CHexSearchResult::Append(CHexSearchResult&& refRes)
+{
+	if (refRes.Empty())
+		return;
+
+	assert(Empty() || refRes.m_vecBlock.front().ullFirst > Back());
+	if (Empty()) {
+		*this = std::move(refRes);
+		refRes.Clear();
+		return;
+	}
+
+	const auto sFromBlock = m_vecBlock.size();
+	m_vecBlock.insert(m_vecBlock.end(), std::make_move_iterator(refRes.m_vecBlock.begin()),
+		std::make_move_iterator(refRes.m_vecBlock.end()));
+	m_vecFirst.insert(m_vecFirst.end(), refRes.m_vecFirst.begin(), refRes.m_vecFirst.end());
+	m_vecStart.resize(m_vecBlock.size());
+	UpdateStarts(sFromBlock);
+	refRes.Clear();
+}
+
+auto CHexSearchResult::Back()const->ULONGLONG
+{
+	assert(!Empty());
+	return m_vecBlock.back().ullLast;
+}
+
+void CHexSearchResult::Clear()
+{
+	m_vecBlock.clear();
+	m_vecFirst.clear();
+	m_vecStart.clear();
+	m_sSize = 0;
+	ResetCache();
+}
+
+bool CHexSearchResult::Empty()const
+{
+	return m_sSize == 0;
+}
+
+auto CHexSearchResult::Find(ULONGLONG ullOffset)const->std::optional<std::size_t>
+{
+	if (Empty() || ullOffset < m_vecFirst.front())
+		return std::nullopt;
+
+	const auto sBlock = GetBlockByOffset(ullOffset);
+	if (ullOffset > m_vecBlock[sBlock].ullLast)
+		return std::nullopt;
+
+	const auto& refVec = Decode(sBlock);
+	const auto iter = std::lower_bound(refVec.begin(), refVec.end(), ullOffset);
+	if (iter == refVec.end() || *iter != ullOffset)
+		return std::nullopt;
+
+	return m_vecStart[sBlock] + static_cast<std::size_t>(iter - refVec.begin());
+}
+
+auto CHexSearchResult::Insert(ULONGLONG ullOffset)->std::pair<std::size_t, bool>
+{
+	if (Empty() || ullOffset > Back()) {
+		Append(ullOffset);
+		return { m_sSize - 1, true };
+	}
+
+	const auto sBlock = ullOffset < m_vecFirst.front() ? 0 : GetBlockByOffset(ullOffset);
+	auto vecOffsets = Decode(sBlock); //Copy, the cache is reset below.
+	const auto iter = std::lower_bound(vecOffsets.begin(), vecOffsets.end(), ullOffset);
+	const auto sInBlock = static_cast<std::size_t>(iter - vecOffsets.begin());
+	if (iter != vecOffsets.end() && *iter == ullOffset)
+		return { m_vecStart[sBlock] + sInBlock, false };
+
+	vecOffsets.insert(iter, ullOffset);
+	ResetCache();
+	if (vecOffsets.size() > m_sBlockMax) { //Splitting the block in two halves.
+		const auto sHalf = vecOffsets.size() / 2;
+		m_vecBlock.insert(m_vecBlock.begin() + sBlock + 1, BLOCK { });
+		m_vecFirst.insert(m_vecFirst.begin() + sBlock + 1, vecOffsets[sHalf]);
+		m_vecStart.insert(m_vecStart.begin() + sBlock + 1, 0);
+		Encode(m_vecBlock[sBlock], vecOffsets.data(), sHalf);
+		Encode(m_vecBlock[sBlock + 1], vecOffsets.data() + sHalf, vecOffsets.size() - sHalf);
+	}
+	else {
+		Encode(m_vecBlock[sBlock], vecOffsets.data(), vecOffsets.size());
+	}
+	m_vecFirst[sBlock] = m_vecBlock[sBlock].ullFirst;
+	UpdateStarts(sBlock + 1);
+
+	return { m_vecStart[sBlock] + sInBlock, true };
+}
+
+auto CHexSearchResult::LowerBound(ULONGLONG ullOffset)const->std::size_t
+{
+	if (Empty() || ullOffset <= m_vecFirst.front())
+		return 0;
+
+	if (ullOffset > Back())
+		return m_sSize;
+
+	const auto sBlock = GetBlockByOffset(ullOffset);
+	const auto& refVec = Decode(sBlock);
+	return m_vecStart[sBlock] + static_cast<std::size_t>(std::lower_bound(refVec.begin(), refVec.end(), ullOffset) - refVec.begin());
+}
+
+auto CHexSearchResult::Size()const->std::size_t
+{
+	return m_sSize;
+}
+
+void CHexSearchResult::Truncate(std::size_t sSize)
+{
+	if (sSize >= m_sSize)
+		return;
+
+	if (sSize == 0) {
+		Clear();
+		return;
+	}
+
+	const auto sBlock = GetBlockByIndex(sSize - 1);
+	const auto vecOffsets = Decode(sBlock);
+	ResetCache();
+	Encode(m_vecBlock[sBlock], vecOffsets.data(), sSize - m_vecStart[sBlock]);
+	m_vecBlock.resize(sBlock + 1);
+	m_vecFirst.resize(sBlock + 1);
+	m_vecStart.resize(sBlock + 1);
+	m_sSize = sSize;
+}
+
+
+//Private methods.
+
+auto CHexSearchResult::Decode(std::size_t sBlock)const->const std::vector<ULONGLONG>&
+{
+	if (m_fCache && m_sCacheBlock == sBlock)
+		return m_vecCache;
+
+	const auto& refBlock = m_vecBlock[sBlock];
+	m_vecCache.clear();
+	m_vecCache.reserve(refBlock.u32Count);
+	m_vecCache.emplace_back(refBlock.ullFirst);
+	auto ullOffset = refBlock.ullFirst;
+	ULONGLONG ullDelta { };
+	int iShift { 0 };
+	for (const auto u8 : refBlock.vecDelta) {
+		ullDelta |= static_cast<ULONGLONG>(u8 & 0x7FU) << iShift;
+		if ((u8 & 0x80U) != 0) {
+			iShift += 7;
+			continue;
+		}
+
+		ullOffset += ullDelta;
+		m_vecCache.emplace_back(ullOffset);
+		ullDelta = 0;
+		iShift = 0;
+	}
+	assert(m_vecCache.size() == refBlock.u32Count);
+	m_sCacheBlock = sBlock;
+	m_fCache = true;
+
+	return m_vecCache;
+}
+
+void CHexSearchResult::Encode(BLOCK& refBlock, const ULONGLONG* pOffsets, std::size_t sCount)
+{
+	assert(sCount > 0);
+	refBlock.ullFirst = pOffsets[0];
+	refBlock.ullLast = pOffsets[sCount - 1];
+	refBlock.u32Count = static_cast<std::uint32_t>(sCount);
+	refBlock.vecDelta.clear();
+	for (std::size_t i { 1 }; i < sCount; ++i) {
+		PutDelta(refBlock.vecDelta, pOffsets[i] - pOffsets[i - 1]);
+	}
+	refBlock.vecDelta.shrink_to_fit();
+}
+
+auto CHexSearchResult::GetBlockByIndex(std::size_t sIndex)const->std::size_t
+{
+	//The last block whose first index is not greater than the sIndex.
+	return static_cast<std::size_t>(std::upper_bound(m_vecStart.begin(), m_vecStart.end(), sIndex) - m_vecStart.begin()) - 1;
+}
+
+auto CHexSearchResult::GetBlockByOffset(ULONGLONG ullOffset)const->std::size_t
+{
+	//The last block whose first offset is not greater than the ullOffset.
+	return static_cast<std::size_t>(std::upper_bound(m_vecFirst.begin(), m_vecFirst.end(), ullOffset) - m_vecFirst.begin()) - 1;
+}
+
+void CHexSearchResult::PutDelta(std::vector<std::uint8_t>& refVec, ULONGLONG ullDelta)
+{
+	while (ullDelta >= 0x80U) {
+		refVec.emplace_back(static_cast<std::uint8_t>(ullDelta | 0x80U));
+		ullDelta >>= 7;
+	}
+	refVec.emplace_back(static_cast<std::uint8_t>(ullDelta));
+}
+
+void CHexSearchResult::ResetCache()const
+{
+	m_fCache = false;
+	m_vecCache.clear();
+}
+
+void CHexSearchResult::UpdateStarts(std::size_t sFromBlock)
+{
+	auto sStart = sFromBlock == 0 ? 0 : m_vecStart[sFromBlock - 1] + m_vecBlock[sFromBlock - 1].u32Count;
+	for (auto i = sFromBlock; i < m_vecBlock.size(); ++i) {
+		m_vecStart[i] = sStart;
+		sStart += m_vecBlock[i].u32Count;
+	}
+	m_sSize = sStart;
+}
\ No newline at end of file
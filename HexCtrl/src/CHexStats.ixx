@@ -0,0 +1,163 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <intrin.h>
+#include <limits>
+#include <type_traits>
+export module HEXCTRL.CHexStats;
+
+import HEXCTRL.HexUtility;
+
+namespace HEXCTRL::INTERNAL {
+	//Statistics of a part of the data.
+	//Parts are computed independently, and then merged together in any order.
+	export class CHexStats final {
+	public:
+		void Add(SpanCByte spnData, EHexDataType eDataType, bool fBigEndian); //Trailing bytes of an incomplete element are ignored.
+		[[nodiscard]] auto GetResult()const->HEXSTATS;
+		void Merge(const CHexStats& rhs);
+	private:
+		void AddTile(const double* pTile, std::size_t sCount);
+	private:
+		static constexpr auto m_sTileSize { 256U }; //Elements are decoded into the tiles of doubles.
+		ULONGLONG m_ullCount { };                   //Count of all the elements except NaNs.
+		ULONGLONG m_ullCountNaN { };
+		ULONGLONG m_ullCountZero { };
+		double m_dMin { (std::numeric_limits<double>::max)() };
+		double m_dMax { std::numeric_limits<double>::lowest() };
+		double m_dSum { };
+		double m_dMean { };
+		double m_dM2 { };                           //Sum of squared differences from the mean.
+	};
+
+	void CHexStats::Add(SpanCByte spnData, EHexDataType eDataType, bool fBigEndian)
+	{
+		ut::VisitDataType(eDataType, [&]<typename T>(std::type_identity<T>) {
+			const auto sCount = spnData.size() / sizeof(T);
+			const auto pData = spnData.data();
+			double arrTile[m_sTileSize];
+			std::size_t sTile { 0 };
+			for (std::size_t i { 0 }; i < sCount; ++i) {
+				const auto tData = ut::LoadTData<T>(pData + (i * sizeof(T)), fBigEndian);
+				if constexpr (std::is_floating_point_v<T>) {
+					if (std::isnan(tData)) {
+						++m_ullCountNaN;
+						continue;
+					}
+				}
+
+				arrTile[sTile++] = static_cast<double>(tData);
+				if (sTile == m_sTileSize) {
+					AddTile(arrTile, sTile);
+					sTile = 0;
+				}
+			}
+			AddTile(arrTile, sTile);
+			});
+	}
+
+	auto CHexStats::GetResult()const->HEXSTATS
+	{
+		if (m_ullCount == 0)
+			return { .ullCount { m_ullCountNaN }, .ullCountNaN { m_ullCountNaN } };
+
+		return { .ullCount { m_ullCount + m_ullCountNaN }, .ullCountNaN { m_ullCountNaN }, .ullCountZero { m_ullCountZero },
+			.dMin { m_dMin }, .dMax { m_dMax }, .dSum { m_dSum }, .dMean { m_dMean },
+			.dStdDev { std::sqrt(m_dM2 / static_cast<double>(m_ullCount)) } };
+	}
+
+	void CHexStats::Merge(const CHexStats& rhs)
+	{
+		m_ullCountNaN += rhs.m_ullCountNaN;
+		if (rhs.m_ullCount == 0)
+			return;
+
+		//Chan's parallel variance algorithm.
+		const auto ullCount = m_ullCount + rhs.m_ullCount;
+		const auto dDelta = rhs.m_dMean - m_dMean;
+		const auto dRatio = static_cast<double>(rhs.m_ullCount) / static_cast<double>(ullCount);
+		m_dMean += dDelta * dRatio;
+		m_dM2 += rhs.m_dM2 + (dDelta * dDelta * static_cast<double>(m_ullCount) * dRatio);
+		m_dSum += rhs.m_dSum;
+		m_dMin = (std::min)(m_dMin, rhs.m_dMin);
+		m_dMax = (std::max)(m_dMax, rhs.m_dMax);
+		m_ullCountZero += rhs.m_ullCountZero;
+		m_ullCount = ullCount;
+	}
+
+
+	//Private methods.
+
+	void CHexStats::AddTile(const double* pTile, std::size_t sCount)
+	{
+		if (sCount == 0)
+			return;
+
+		//The first pass: min, max, sum and zeros. The second pass: squared differences from the tile's mean.
+		//The tile stays in the L1 cache between the passes, and the two-pass variance is much more
+		//precise than the sum of squares.
+		CHexStats stTile;
+		stTile.m_ullCount = sCount;
+		std::size_t i { 0 };
+	#if defined(_M_IX86) || defined(_M_X64)
+		if (ut::HasAVX2()) {
+			auto m256dMin = _mm256_set1_pd(stTile.m_dMin);
+			auto m256dMax = _mm256_set1_pd(stTile.m_dMax);
+			auto m256dSum = _mm256_setzero_pd();
+			const auto m256dZero = _mm256_setzero_pd();
+			for (; i + 4 <= sCount; i += 4) {
+				const auto m256dData = _mm256_loadu_pd(pTile + i);
+				m256dMin = _mm256_min_pd(m256dMin, m256dData);
+				m256dMax = _mm256_max_pd(m256dMax, m256dData);
+				m256dSum = _mm256_add_pd(m256dSum, m256dData);
+				stTile.m_ullCountZero += std::popcount(static_cast<unsigned>(
+					_mm256_movemask_pd(_mm256_cmp_pd(m256dData, m256dZero, _CMP_EQ_OQ))));
+			}
+
+			alignas(32) double arrMin[4];
+			alignas(32) double arrMax[4];
+			alignas(32) double arrSum[4];
+			_mm256_store_pd(arrMin, m256dMin);
+			_mm256_store_pd(arrMax, m256dMax);
+			_mm256_store_pd(arrSum, m256dSum);
+			stTile.m_dMin = (std::min)({ arrMin[0], arrMin[1], arrMin[2], arrMin[3] });
+			stTile.m_dMax = (std::max)({ arrMax[0], arrMax[1], arrMax[2], arrMax[3] });
+			stTile.m_dSum = (arrSum[0] + arrSum[1]) + (arrSum[2] + arrSum[3]);
+		}
+	#endif //^^^ _M_IX86 || _M_X64
+		for (; i < sCount; ++i) {
+			const auto dData = pTile[i];
+			stTile.m_dMin = (std::min)(stTile.m_dMin, dData);
+			stTile.m_dMax = (std::max)(stTile.m_dMax, dData);
+			stTile.m_dSum += dData;
+			stTile.m_ullCountZero += dData == 0. ? 1 : 0;
+		}
+
+		stTile.m_dMean = stTile.m_dSum / static_cast<double>(sCount);
+		double arrM2[4] { };
+		i = 0;
+		for (; i + 4 <= sCount; i += 4) {
+			for (auto j { 0U }; j < 4U; ++j) {
+				const auto dDiff = pTile[i + j] - stTile.m_dMean;
+				arrM2[j] += dDiff * dDiff;
+			}
+		}
+		for (; i < sCount; ++i) {
+			const auto dDiff = pTile[i] - stTile.m_dMean;
+			arrM2[0] += dDiff * dDiff;
+		}
+		stTile.m_dM2 = (arrM2[0] + arrM2[1]) + (arrM2[2] + arrM2[3]);
+
+		Merge(stTile);
+	}
+}
\ No newline at end of file
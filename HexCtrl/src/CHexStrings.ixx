@@ -0,0 +1,631 @@
+module;
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include <SDKDDKVer.h>
+#include "../HexCtrl.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <intrin.h>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+export module HEXCTRL.CHexStrings;
+
+import HEXCTRL.CHexParallel;
+import HEXCTRL.CHexReader;
+import HEXCTRL.HexUtility;
+
+namespace HEXCTRL::INTERNAL {
+	//Printable strings extraction in a separate thread, in non-virtual mode, returned by the IHexCtrl::ExtractStrings.
+	//The range is split into the partitions, that are scanned in parallel in non-virtual mode.
+	//Every string belongs to the partition it starts in, and is read past the partition's end up to its own end.
+	//The first string of a partition is skipped, if it continues the previous partition's string.
+	//Strings are given out in the offsets order as soon as all the previous partitions are done,
+	//so only the partitions in work keep their strings in memory.
+	export class CHexStrings final : public IHexSearch {
+	public:
+		CHexStrings(const IHexCtrl* pHexCtrl, const HEXSTRINGS& hss, ULONGLONG ullRngStart, ULONGLONG ullRngEnd);
+		void Cancel()override;
+		void Delete()override;
+		[[nodiscard]] auto GetCount()const->ULONGLONG override;
+		[[nodiscard]] bool IsCanceled()const override;
+		[[nodiscard]] bool IsDone()const override;
+		[[nodiscard]] bool Run(); //Starts the extraction, false if the wstrPath file can't be created.
+		void Wait()override;
+	private:
+		struct CLASSES { //Classes of the 64 bytes, bit per byte.
+			std::uint64_t u64Print { }; //0x09 and 0x20-0x7E.
+			std::uint64_t u64Latin { }; //0xA0-0xFF.
+			std::uint64_t u64Zero { };  //0x00.
+			std::uint64_t u64High { };  //0x80-0xFF.
+		};
+		struct UTF8LEAD { //UTF-8 sequence's size, and the range of its second byte.
+			std::uint8_t u8Size { };
+			std::uint8_t u8Lo { };
+			std::uint8_t u8Hi { };
+		};
+		struct SCAN { //Scan state of one encoding.
+			ULONGLONG ullStart { };     //Current string's first byte.
+			ULONGLONG ullLength { };    //Current string's characters count, for the UTF-8 only.
+			ULONGLONG ullSeqStart { };  //UTF-8 multibyte sequence's first byte.
+			std::uint64_t u64Carry { }; //UTF-16 code unit's second byte, that is in the next block.
+			EHexStringType eType { };
+			std::uint8_t u8Pend { };    //UTF-8 continuation bytes yet to come.
+			std::uint8_t u8Lo { };      //UTF-8 next continuation byte's range.
+			std::uint8_t u8Hi { };
+			std::uint8_t u8Continued { }; //Bits of the partition's first bytes, where the previous string continues.
+			bool fOdd { false };        //UTF-16 code units at the odd offsets.
+			bool fIn { false };         //String is in progress.
+			bool fSkip { false };       //String is not of this partition.
+			bool fFirst { true };       //No string has started in this partition yet.
+			bool fMulti { false };      //UTF-8 string has multibyte characters.
+		};
+		struct PART {
+			ULONGLONG ullOffset { };
+			ULONGLONG ullEnd { };          //Strings that start from here on are of the next partitions.
+			std::vector<HEXSTRING> vecStr; //Strings found, until they are given out.
+			bool fDone { false };
+		};
+		[[nodiscard]] static auto Classify(const std::byte* pData)->CLASSES;
+		void EndString(SCAN& refScan, ULONGLONG ullEnd, std::vector<HEXSTRING>& refVecStr)const;
+		void Extract();
+		[[nodiscard]] static auto GetUTF8Lead(std::uint8_t u8Lead)->UTF8LEAD;
+		[[nodiscard]] bool IsContinued(const SCAN& refScan, ULONGLONG ullOffset)const;
+		[[nodiscard]] static bool IsPrintable(std::uint8_t u8Char);
+		void OnPartDone(std::size_t sPart);
+		[[nodiscard]] bool Output(const HEXSTRING& refStr);
+		void PutChar(SCAN& refScan, const PART& refPart, ULONGLONG ullOffset, bool fMulti)const;
+		void PutMask(SCAN& refScan, const PART& refPart, ULONGLONG ullOffset, std::uint64_t u64Mask,
+			std::vector<HEXSTRING>& refVecStr)const;
+		void PutUTF8(SCAN& refScan, const PART& refPart, ULONGLONG ullOffset, const std::byte* pData, unsigned uSize,
+			std::vector<HEXSTRING>& refVecStr)const;
+		void ScanBlock(std::vector<SCAN>& refVecScan, PART& refPart, ULONGLONG ullOffset, const std::byte* pData,
+			unsigned uSize)const;
+		void ScanPart(PART& refPart, CHexReader& refReader)const;
+		void StartString(SCAN& refScan, const PART& refPart, ULONGLONG ullOffset)const;
+		void WriteString(const HEXSTRING& refStr);
+	private:
+		static constexpr auto m_uBlockSize { 64U };                      //Bytes classified at once.
+		static constexpr auto m_ullSizePartMax { 1024ULL * 1024ULL * 16ULL }; //16MB.
+		const IHexCtrl* m_pHexCtrl { };
+		CHexParallel m_Par;             //Partitions' workers, and the cancel.
+		HEXSTRINGS m_hss;
+		std::vector<SCAN> m_vecScan;    //Initial scan state of every encoding.
+		std::vector<PART> m_vecPart;
+		std::ofstream m_ofs;
+		std::thread m_thrd;
+		std::mutex m_mtxWait;
+		std::mutex m_mtxOut;            //Guards the strings output.
+		std::size_t m_sPartsOut { };    //Count of the partitions given out, from the beginning.
+		ULONGLONG m_ullRngStart { };
+		ULONGLONG m_ullSentinel { };    //Range end, exclusive.
+		ULONGLONG m_ullSizeChunk { };   //Data size read at once, multiple of the m_uBlockSize.
+		std::atomic<ULONGLONG> m_atomCount { 0ULL };
+		std::atomic_bool m_atomDone { false };
+		bool m_fUTF16 { false };        //Any of the UTF-16 encodings.
+	};
+}
+
+using namespace HEXCTRL::INTERNAL;
+
+CHexStrings::CHexStrings(const IHexCtrl* pHexCtrl, const HEXSTRINGS& hss, ULONGLONG ullRngStart, ULONGLONG ullRngEnd) :
+	m_pHexCtrl(pHexCtrl), m_Par(pHexCtrl), m_hss(hss), m_ullRngStart(ullRngStart), m_ullSentinel(ullRngEnd + 1)
+{
+	using enum EHexStringType;
+	if (m_hss.fASCII || m_hss.fUTF8) {
+		m_vecScan.emplace_back(SCAN { .eType { m_hss.fUTF8 ? STRING_UTF8 : STRING_ASCII } });
+	}
+	if (m_hss.fUTF16LE) {
+		m_vecScan.emplace_back(SCAN { .eType { STRING_UTF16LE }, .fOdd { false } });
+		m_vecScan.emplace_back(SCAN { .eType { STRING_UTF16LE }, .fOdd { true } });
+	}
+	if (m_hss.fUTF16BE) {
+		m_vecScan.emplace_back(SCAN { .eType { STRING_UTF16BE }, .fOdd { false } });
+		m_vecScan.emplace_back(SCAN { .eType { STRING_UTF16BE }, .fOdd { true } });
+	}
+	m_fUTF16 = m_hss.fUTF16LE || m_hss.fUTF16BE;
+
+	//One byte more is read with every chunk, for the UTF-16 code unit that crosses the chunk's end.
+	const auto ullSizeCache = m_pHexCtrl->IsVirtual() ? static_cast<ULONGLONG>(m_pHexCtrl->GetCacheSize()) - 1 : m_ullSizePartMax;
+	m_ullSizeChunk = (std::max)(ullSizeCache - (ullSizeCache % m_uBlockSize), static_cast<ULONGLONG>(m_uBlockSize));
+}
+
+void CHexStrings::Cancel()
+{
+	m_Par.Cancel();
+}
+
+void CHexStrings::Delete()
+{
+	Cancel();
+	Wait();
+	delete this;
+}
+
+auto CHexStrings::GetCount()const->ULONGLONG
+{
+	return m_atomCount;
+}
+
+bool CHexStrings::IsCanceled()const
+{
+	return m_Par.IsCanceled();
+}
+
+bool CHexStrings::IsDone()const
+{
+	return m_atomDone;
+}
+
+bool CHexStrings::Run()
+{
+	if (!m_hss.wstrPath.empty()) {
+		m_ofs.open(m_hss.wstrPath, std::ios::binary | std::ios::trunc);
+		if (!m_ofs.is_open())
+			return false;
+	}
+
+	//Concurrent data access is only allowed in non-virtual mode, the virtual data is extracted in the calling thread.
+	if (m_pHexCtrl->IsVirtual()) {
+		Extract();
+		m_atomDone = true;
+		return true;
+	}
+
+	m_thrd = std::thread([this]() {
+		Extract();
+		m_atomDone = true;
+		});
+
+	return true;
+}
+
+void CHexStrings::Wait()
+{
+	const std::scoped_lock lock(m_mtxWait);
+	if (m_thrd.joinable()) {
+		m_thrd.join();
+	}
+}
+
+
+//Private methods.
+
+auto CHexStrings::Classify(const std::byte* pData)->CLASSES
+{
+	//Printable are the bytes greater than 0x1F as signed, except the 0x7F, and the tab.
+	//Latin are the negative bytes greater than 0x9F as signed.
+	CLASSES stCls;
+#if defined(_M_IX86) || defined(_M_X64)
+	if (ut::HasAVX2()) {
+		for (auto i { 0U }; i < m_uBlockSize; i += 32U) {
+			const auto m256iData = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + i));
+			const auto m256iPrint = _mm256_or_si256(_mm256_andnot_si256(_mm256_cmpeq_epi8(m256iData, _mm256_set1_epi8(0x7F)),
+				_mm256_cmpgt_epi8(m256iData, _mm256_set1_epi8(0x1F))), _mm256_cmpeq_epi8(m256iData, _mm256_set1_epi8(0x09)));
+			const auto m256iLatin = _mm256_and_si256(_mm256_cmpgt_epi8(m256iData, _mm256_set1_epi8(static_cast<char>(0x9F))),
+				_mm256_cmpgt_epi8(_mm256_setzero_si256(), m256iData));
+			const auto m256iZero = _mm256_cmpeq_epi8(m256iData, _mm256_setzero_si256());
+			stCls.u64Print |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iPrint))) << i;
+			stCls.u64Latin |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iLatin))) << i;
+			stCls.u64Zero |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iZero))) << i;
+			stCls.u64High |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iData))) << i;
+		}
+		return stCls;
+	}
+
+	for (auto i { 0U }; i < m_uBlockSize; i += 16U) {
+		const auto m128iData = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+		const auto m128iPrint = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(m128iData, _mm_set1_epi8(0x7F)),
+			_mm_cmpgt_epi8(m128iData, _mm_set1_epi8(0x1F))), _mm_cmpeq_epi8(m128iData, _mm_set1_epi8(0x09)));
+		const auto m128iLatin = _mm_and_si128(_mm_cmpgt_epi8(m128iData, _mm_set1_epi8(static_cast<char>(0x9F))),
+			_mm_cmpgt_epi8(_mm_setzero_si128(), m128iData));
+		const auto m128iZero = _mm_cmpeq_epi8(m128iData, _mm_setzero_si128());
+		stCls.u64Print |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(m128iPrint))) << i;
+		stCls.u64Latin |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(m128iLatin))) << i;
+		stCls.u64Zero |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(m128iZero))) << i;
+		stCls.u64High |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(m128iData))) << i;
+	}
+#elif defined(_M_ARM64)  //^^^ _M_IX86 || _M_X64 / vvv _M_ARM64
+	for (auto i { 0U }; i < m_uBlockSize; ++i) {
+		const auto u8Data = static_cast<std::uint8_t>(pData[i]);
+		const auto u64Bit = 1ULL << i;
+		stCls.u64Print |= IsPrintable(u8Data) ? u64Bit : 0ULL;
+		stCls.u64Latin |= u8Data >= 0xA0U ? u64Bit : 0ULL;
+		stCls.u64Zero |= u8Data == 0U ? u64Bit : 0ULL;
+		stCls.u64High |= u8Data >= 0x80U ? u64Bit : 0ULL;
+	}
+#endif //^^^ _M_ARM64
+
+	return stCls;
+}
+
+void CHexStrings::EndString(SCAN& refScan, ULONGLONG ullEnd, std::vector<HEXSTRING>& refVecStr)const
+{
+	using enum EHexStringType;
+	if (!refScan.fIn)
+		return;
+
+	refScan.fIn = false;
+	if (refScan.fSkip)
+		return;
+
+	const auto ullSize = ullEnd - refScan.ullStart;
+	auto eType = refScan.eType;
+	ULONGLONG ullLength;
+	switch (eType) {
+	case STRING_UTF8:
+		ullLength = refScan.ullLength;
+		if (!refScan.fMulti && m_hss.fASCII) {
+			eType = STRING_ASCII;
+		}
+		break;
+	case STRING_UTF16LE:
+	case STRING_UTF16BE:
+		ullLength = ullSize / 2;
+		break;
+	default:
+		ullLength = ullSize;
+		break;
+	}
+
+	if (ullLength >= m_hss.dwMinLength) {
+		refVecStr.emplace_back(HEXSTRING { .ullOffset { refScan.ullStart }, .ullSize { ullSize }, .ullLength { ullLength },
+			.eType { eType } });
+	}
+}
+
+void CHexStrings::Extract()
+{
+	for (auto ullOffset = m_ullRngStart; ullOffset < m_ullSentinel; ullOffset += m_ullSizePartMax) {
+		m_vecPart.emplace_back(PART { .ullOffset { ullOffset },
+			.ullEnd { ullOffset + (std::min)(m_ullSentinel - ullOffset, m_ullSizePartMax) } });
+	}
+
+	//Partitions are taken in the ascending order, so they are given out with the least waiting.
+	m_Par.Run(m_vecPart.size(), [this](std::size_t sIndex, CHexReader& refReader) {
+		ScanPart(m_vecPart[sIndex], refReader);
+		refReader.Pause(); //Strings are written, and the next part's start is checked, with the direct reads.
+		OnPartDone(sIndex);
+		}, m_pHexCtrl->IsVirtual(), m_ullRngStart, m_ullSentinel - 1);
+
+	if (m_ofs.is_open()) {
+		m_ofs.close();
+	}
+}
+
+auto CHexStrings::GetUTF8Lead(std::uint8_t u8Lead)->UTF8LEAD
+{
+	//Overlong forms, surrogates, code points above U+10FFFF and the C1 controls U+0080-U+009F are not printable.
+	if (u8Lead == 0xC2U)
+		return { .u8Size { 2 }, .u8Lo { 0xA0 }, .u8Hi { 0xBF } };
+	if (u8Lead > 0xC2U && u8Lead <= 0xDFU)
+		return { .u8Size { 2 }, .u8Lo { 0x80 }, .u8Hi { 0xBF } };
+	if (u8Lead == 0xE0U)
+		return { .u8Size { 3 }, .u8Lo { 0xA0 }, .u8Hi { 0xBF } };
+	if (u8Lead == 0xEDU)
+		return { .u8Size { 3 }, .u8Lo { 0x80 }, .u8Hi { 0x9F } };
+	if (u8Lead > 0xE0U && u8Lead <= 0xEFU)
+		return { .u8Size { 3 }, .u8Lo { 0x80 }, .u8Hi { 0xBF } };
+	if (u8Lead == 0xF0U)
+		return { .u8Size { 4 }, .u8Lo { 0x90 }, .u8Hi { 0xBF } };
+	if (u8Lead > 0xF0U && u8Lead <= 0xF3U)
+		return { .u8Size { 4 }, .u8Lo { 0x80 }, .u8Hi { 0xBF } };
+	if (u8Lead == 0xF4U)
+		return { .u8Size { 4 }, .u8Lo { 0x80 }, .u8Hi { 0x8F } };
+
+	return { };
+}
+
+bool CHexStrings::IsContinued(const SCAN& refScan, ULONGLONG ullOffset)const
+{
+	//Whether a printable character of the refScan's encoding ends right at the ullOffset.
+	//UTF-8 is self-synchronizing, so such a character starts before the partition, and the string is not ours.
+	using enum EHexStringType;
+	switch (refScan.eType) {
+	case STRING_ASCII:
+		if (ullOffset < m_ullRngStart + 1)
+			return false;
+
+		return IsPrintable(static_cast<std::uint8_t>(m_pHexCtrl->GetData({ ullOffset - 1, 1 })[0]));
+	case STRING_UTF16LE:
+	case STRING_UTF16BE:
+	{
+		if (ullOffset < m_ullRngStart + 2)
+			return false;
+
+		const auto spnData = m_pHexCtrl->GetData({ ullOffset - 2, 2 });
+		const auto u8Char = static_cast<std::uint8_t>(spnData[refScan.eType == STRING_UTF16LE ? 0 : 1]);
+		const auto u8Zero = static_cast<std::uint8_t>(spnData[refScan.eType == STRING_UTF16LE ? 1 : 0]);
+		return u8Zero == 0U && (IsPrintable(u8Char) || u8Char >= 0xA0U);
+	}
+	case STRING_UTF8:
+	{
+		const auto ullBack = (std::min)(ullOffset - m_ullRngStart, 4ULL);
+		if (ullBack == 0)
+			return false;
+
+		const auto spnData = m_pHexCtrl->GetData({ ullOffset - ullBack, ullBack });
+		for (auto ullSize { 1ULL }; ullSize <= ullBack; ++ullSize) {
+			const auto pChar = spnData.data() + (ullBack - ullSize);
+			const auto u8Lead = static_cast<std::uint8_t>(pChar[0]);
+			if (u8Lead < 0x80U)
+				return ullSize == 1 && IsPrintable(u8Lead);
+
+			if (u8Lead < 0xC0U) //Continuation byte.
+				continue;
+
+			const auto stLead = GetUTF8Lead(u8Lead);
+			if (stLead.u8Size != ullSize)
+				return false;
+
+			const auto u8Second = static_cast<std::uint8_t>(pChar[1]);
+			return u8Second >= stLead.u8Lo && u8Second <= stLead.u8Hi;
+		}
+		return false;
+	}
+	default:
+		return false;
+	}
+}
+
+bool CHexStrings::IsPrintable(std::uint8_t u8Char)
+{
+	return (u8Char >= 0x20U && u8Char <= 0x7EU) || u8Char == 0x09U;
+}
+
+void CHexStrings::OnPartDone(std::size_t sPart)
+{
+	const std::scoped_lock lock(m_mtxOut);
+	m_vecPart[sPart].fDone = true;
+	while (m_sPartsOut < m_vecPart.size() && m_vecPart[m_sPartsOut].fDone) {
+		auto& refPart = m_vecPart[m_sPartsOut++];
+		for (const auto& refStr : refPart.vecStr) {
+			if (IsCanceled())
+				break;
+
+			if (!Output(refStr)) {
+				Cancel();
+				break;
+			}
+		}
+		std::vector<HEXSTRING>().swap(refPart.vecStr); //Memory is freed as soon as the strings are given out.
+	}
+}
+
+bool CHexStrings::Output(const HEXSTRING& refStr)
+{
+	++m_atomCount;
+	if (m_ofs.is_open()) {
+		WriteString(refStr);
+	}
+
+	return !m_hss.FuncString || m_hss.FuncString(refStr);
+}
+
+void CHexStrings::PutChar(SCAN& refScan, const PART& refPart, ULONGLONG ullOffset, bool fMulti)const
+{
+	if (!refScan.fIn) {
+		StartString(refScan, refPart, ullOffset);
+	}
+
+	++refScan.ullLength;
+	refScan.fMulti |= fMulti;
+}
+
+void CHexStrings::PutMask(SCAN& refScan, const PART& refPart, ULONGLONG ullOffset, std::uint64_t u64Mask,
+	std::vector<HEXSTRING>& refVecStr)const
+{
+	//Strings are the runs of the set bits, every run is handled at once.
+	auto uPos { 0U };
+	while (uPos < m_uBlockSize) {
+		const auto u64Rest = u64Mask >> uPos;
+		if (refScan.fIn) {
+			const auto uOnes = static_cast<unsigned>(std::countr_one(u64Rest));
+			refScan.ullLength += uOnes;
+			uPos += uOnes;
+			if (uPos < m_uBlockSize) {
+				EndString(refScan, ullOffset + uPos, refVecStr);
+			}
+		}
+		else {
+			if (u64Rest == 0)
+				break;
+
+			uPos += static_cast<unsigned>(std::countr_zero(u64Rest));
+			StartString(refScan, refPart, ullOffset + uPos);
+		}
+	}
+}
+
+void CHexStrings::PutUTF8(SCAN& refScan, const PART& refPart, ULONGLONG ullOffset, const std::byte* pData, unsigned uSize,
+	std::vector<HEXSTRING>& refVecStr)const
+{
+	for (auto i { 0U }; i < uSize; ++i) {
+		const auto u8Data = static_cast<std::uint8_t>(pData[i]);
+		const auto ullCurr = ullOffset + i;
+		if (refScan.u8Pend > 0) {
+			if (u8Data >= refScan.u8Lo && u8Data <= refScan.u8Hi) {
+				refScan.u8Lo = 0x80U;
+				refScan.u8Hi = 0xBFU;
+				if (--refScan.u8Pend == 0) {
+					PutChar(refScan, refPart, refScan.ullSeqStart, true);
+				}
+				continue;
+			}
+
+			refScan.u8Pend = 0; //Broken sequence ends the string, this byte is a new character's start.
+			EndString(refScan, refScan.ullSeqStart, refVecStr);
+		}
+
+		if (u8Data < 0x80U) {
+			if (IsPrintable(u8Data)) {
+				PutChar(refScan, refPart, ullCurr, false);
+			}
+			else {
+				EndString(refScan, ullCurr, refVecStr);
+			}
+		}
+		else if (const auto stLead = GetUTF8Lead(u8Data); stLead.u8Size > 0) {
+			refScan.u8Pend = stLead.u8Size - 1;
+			refScan.u8Lo = stLead.u8Lo;
+			refScan.u8Hi = stLead.u8Hi;
+			refScan.ullSeqStart = ullCurr;
+		}
+		else {
+			EndString(refScan, ullCurr, refVecStr);
+		}
+	}
+}
+
+void CHexStrings::ScanBlock(std::vector<SCAN>& refVecScan, PART& refPart, ULONGLONG ullOffset, const std::byte* pData,
+	unsigned uSize)const
+{
+	//The pData has one byte more than the uSize, that is the next block's first byte.
+	using enum EHexStringType;
+	const auto u64Valid = uSize == m_uBlockSize ? (std::numeric_limits<std::uint64_t>::max)() : (1ULL << uSize) - 1;
+	const auto stCls = Classify(pData);
+	const auto stClsNext = m_fUTF16 ? Classify(pData + 1) : CLASSES { };
+	const auto u64Even = (ullOffset & 1) == 0 ? 0x5555555555555555ULL : 0xAAAAAAAAAAAAAAAAULL; //Bytes at the even offsets.
+
+	for (auto& refScan : refVecScan) {
+		switch (refScan.eType) {
+		case STRING_ASCII:
+			PutMask(refScan, refPart, ullOffset, stCls.u64Print & u64Valid, refPart.vecStr);
+			break;
+		case STRING_UTF8:
+			if (refScan.u8Pend == 0 && (stCls.u64High & u64Valid) == 0) { //ASCII only block.
+				PutMask(refScan, refPart, ullOffset, stCls.u64Print & u64Valid, refPart.vecStr);
+			}
+			else {
+				PutUTF8(refScan, refPart, ullOffset, pData, uSize, refPart.vecStr);
+			}
+			break;
+		case STRING_UTF16LE:
+		case STRING_UTF16BE:
+		{
+			//Bits of the printable code units' first bytes, then both bytes of every such code unit.
+			auto u64Units = refScan.eType == STRING_UTF16LE ? ((stCls.u64Print | stCls.u64Latin) & stClsNext.u64Zero) :
+				(stCls.u64Zero & (stClsNext.u64Print | stClsNext.u64Latin));
+			u64Units &= u64Valid & (refScan.fOdd ? ~u64Even : u64Even);
+			const auto u64Bytes = u64Units | (u64Units << 1) | refScan.u64Carry;
+			refScan.u64Carry = u64Units >> 63;
+			PutMask(refScan, refPart, ullOffset, u64Bytes, refPart.vecStr);
+		}
+		break;
+		default:
+			break;
+		}
+	}
+}
+
+void CHexStrings::ScanPart(PART& refPart, CHexReader& refReader)const
+{
+	//Checked before the data is read, in virtual mode every GetData may overwrite the previous data.
+	auto vecScan = m_vecScan;
+	if (refPart.ullOffset > m_ullRngStart) {
+		for (auto& refScan : vecScan) {
+			for (auto i { 0U }; i < 4U && refPart.ullOffset + i < m_ullSentinel; ++i) {
+				refScan.u8Continued |= IsContinued(refScan, refPart.ullOffset + i) ? static_cast<std::uint8_t>(1U << i) : 0U;
+			}
+		}
+	}
+
+	auto ullOffset = refPart.ullOffset;
+	while (ullOffset < m_ullSentinel && !IsCanceled()) {
+		const auto ullSize = (std::min)(m_ullSizeChunk, m_ullSentinel - ullOffset);
+		const auto ullSizeRead = (std::min)(ullSize + 1, m_ullSentinel - ullOffset);
+		const auto spnData = refReader.GetData({ ullOffset, ullSizeRead });
+		assert(spnData.size() >= ullSizeRead);
+		for (auto ullPos { 0ULL }; ullPos < ullSize; ullPos += m_uBlockSize) {
+			const auto uSize = static_cast<unsigned>((std::min)(ullSize - ullPos, static_cast<ULONGLONG>(m_uBlockSize)));
+			if (ullPos + m_uBlockSize + 1 <= ullSizeRead) {
+				ScanBlock(vecScan, refPart, ullOffset + ullPos, spnData.data() + ullPos, uSize);
+			}
+			else { //The range's last block, the bytes past the range end are neither printable nor zero.
+				std::byte arrBlock[m_uBlockSize + 1];
+				std::memset(arrBlock, 0x01, sizeof(arrBlock));
+				std::memcpy(arrBlock, spnData.data() + ullPos, static_cast<std::size_t>(ullSizeRead - ullPos));
+				ScanBlock(vecScan, refPart, ullOffset + ullPos, arrBlock, uSize);
+			}
+		}
+		ullOffset += ullSize;
+
+		//Past the partition's end only the partition's own strings are read up to their ends.
+		if (ullOffset >= refPart.ullEnd && std::none_of(vecScan.begin(), vecScan.end(), [&](const SCAN& refScan) {
+			return (refScan.fIn && !refScan.fSkip) || (!refScan.fIn && refScan.u8Pend > 0 && refScan.ullSeqStart < refPart.ullEnd); }))
+			break;
+	}
+
+	if (IsCanceled())
+		return;
+
+	if (ullOffset >= m_ullSentinel) {
+		for (auto& refScan : vecScan) {
+			if (refScan.u8Pend > 0) {
+				refScan.u8Pend = 0;
+				EndString(refScan, refScan.ullSeqStart, refPart.vecStr);
+			}
+			EndString(refScan, m_ullSentinel, refPart.vecStr);
+		}
+	}
+
+	std::sort(refPart.vecStr.begin(), refPart.vecStr.end(), [](const HEXSTRING& lhs, const HEXSTRING& rhs) {
+		return lhs.ullOffset < rhs.ullOffset || (lhs.ullOffset == rhs.ullOffset && lhs.eType < rhs.eType); });
+}
+
+void CHexStrings::StartString(SCAN& refScan, const PART& refPart, ULONGLONG ullOffset)const
+{
+	refScan.fIn = true;
+	refScan.ullStart = ullOffset;
+	refScan.ullLength = 0;
+	refScan.fMulti = false;
+	refScan.fSkip = ullOffset >= refPart.ullEnd || (refScan.fFirst && ullOffset < refPart.ullOffset + 4
+		&& (refScan.u8Continued & (1U << (ullOffset - refPart.ullOffset))) != 0);
+	refScan.fFirst = false;
+}
+
+void CHexStrings::WriteString(const HEXSTRING& refStr)
+{
+	//Line of the hex offset, the encoding, the length and the string itself in UTF-8.
+	//UTF-16 code units are all below 0x100, two UTF-8 bytes at most.
+	using enum EHexStringType;
+	static constexpr const char* arrType[] { "ASCII", "UTF-8", "UTF-16LE", "UTF-16BE" };
+	m_ofs << std::format("{:016X} {} {} ", refStr.ullOffset, arrType[static_cast<std::size_t>(refStr.eType)], refStr.ullLength);
+
+	const auto fUTF16 = refStr.eType == STRING_UTF16LE || refStr.eType == STRING_UTF16BE;
+	const auto ullSizeMax = m_ullSizeChunk - (m_ullSizeChunk % 2);
+	std::string strText;
+	for (auto ullPos { 0ULL }; ullPos < refStr.ullSize; ullPos += ullSizeMax) {
+		const auto spnData = m_pHexCtrl->GetData({ refStr.ullOffset + ullPos, (std::min)(refStr.ullSize - ullPos, ullSizeMax) });
+		if (!fUTF16) {
+			m_ofs.write(reinterpret_cast<const char*>(spnData.data()), static_cast<std::streamsize>(spnData.size()));
+			continue;
+		}
+
+		strText.clear();
+		for (std::size_t i { 0 }; i + 1 < spnData.size(); i += 2) {
+			const auto u8Char = static_cast<std::uint8_t>(spnData[refStr.eType == STRING_UTF16LE ? i : i + 1]);
+			if (u8Char < 0x80U) {
+				strText.push_back(static_cast<char>(u8Char));
+			}
+			else {
+				strText.push_back(static_cast<char>(0xC0U | (u8Char >> 6)));
+				strText.push_back(static_cast<char>(0x80U | (u8Char & 0x3FU)));
+			}
+		}
+		m_ofs.write(strText.data(), static_cast<std::streamsize>(strText.size()));
+	}
+	m_ofs.write("\r\n", 2);
+}
\ No newline at end of file
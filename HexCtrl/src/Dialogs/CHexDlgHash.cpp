@@ -0,0 +1,253 @@
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#include "../../res/HexCtrlRes.h"
+#include "CHexDlgHash.h"
+#include <cassert>
+#include <cstring>
+#include <format>
+
+import HEXCTRL.CHexHash;
+
+using namespace HEXCTRL::INTERNAL;
+
+namespace {
+	using HEXCTRL::EHexHash;
+
+	//Mapping between the dialog's check-boxes and the hash algorithms.
+	constexpr std::pair<int, EHexHash> g_arrChkHash[] {
+		{ IDC_HEXCTRL_HASH_CHK_CRC32, EHexHash::HASH_CRC32 }, { IDC_HEXCTRL_HASH_CHK_CRC32C, EHexHash::HASH_CRC32C },
+		{ IDC_HEXCTRL_HASH_CHK_ADLER32, EHexHash::HASH_ADLER32 }, { IDC_HEXCTRL_HASH_CHK_XXH64, EHexHash::HASH_XXH64 },
+		{ IDC_HEXCTRL_HASH_CHK_MD5, EHexHash::HASH_MD5 }, { IDC_HEXCTRL_HASH_CHK_SHA1, EHexHash::HASH_SHA1 },
+		{ IDC_HEXCTRL_HASH_CHK_SHA256, EHexHash::HASH_SHA256 } };
+}
+
+void CHexDlgHash::CreateDlg()
+{
+	//m_Wnd is set in the OnInitDialog().
+	if (const auto hWnd = ::CreateDialogParamW(m_hInstRes, MAKEINTRESOURCEW(IDD_HEXCTRL_HASH),
+		m_pHexCtrl->GetWndHandle(EHexWnd::WND_MAIN), wnd::DlgProc<CHexDlgHash>, reinterpret_cast<LPARAM>(this));
+		hWnd == nullptr) {
+		ut::DBG_REPORT(L"CreateDialogParamW failed.");
+	}
+}
+
+void CHexDlgHash::DestroyDlg()
+{
+	if (m_Wnd.IsWindow()) {
+		m_Wnd.DestroyWindow();
+	}
+}
+
+void CHexDlgHash::Initialize(IHexCtrl* pHexCtrl, HINSTANCE hInstRes)
+{
+	if (pHexCtrl == nullptr || hInstRes == nullptr) {
+		ut::DBG_REPORT(L"Initialize == nullptr");
+		return;
+	}
+
+	m_pHexCtrl = pHexCtrl;
+	m_hInstRes = hInstRes;
+}
+
+auto CHexDlgHash::GetHWND()const->HWND
+{
+	return m_Wnd;
+}
+
+bool CHexDlgHash::PreTranslateMsg(MSG* pMsg)
+{
+	return m_Wnd.IsDlgMessage(pMsg);
+}
+
+auto CHexDlgHash::ProcessMsg(const MSG& msg)->INT_PTR
+{
+	switch (msg.message) {
+	case WM_ACTIVATE: return OnActivate(msg);
+	case WM_CLOSE: return OnClose();
+	case WM_COMMAND: return OnCommand(msg);
+	case WM_DESTROY: return OnDestroy();
+	case WM_INITDIALOG: return OnInitDialog(msg);
+	default:
+		return 0;
+	}
+}
+
+void CHexDlgHash::SetDlgProperties(std::uint64_t u64Flags)
+{
+	m_u64Flags = u64Flags;
+}
+
+void CHexDlgHash::ShowWindow(int iCmdShow)
+{
+	if (!m_Wnd.IsWindow()) {
+		CreateDlg();
+	}
+
+	m_Wnd.ShowWindow(iCmdShow);
+}
+
+
+//Private methods.
+
+auto CHexDlgHash::GetHexCtrl()const->IHexCtrl*
+{
+	return m_pHexCtrl;
+}
+
+bool CHexDlgHash::IsNoEsc()const
+{
+	return m_u64Flags & HEXCTRL_FLAG_DLG_NOESC;
+}
+
+auto CHexDlgHash::OnActivate(const MSG& msg)->INT_PTR
+{
+	const auto pHexCtrl = GetHexCtrl();
+	if (pHexCtrl == nullptr || !pHexCtrl->IsCreated() || !pHexCtrl->IsDataSet())
+		return FALSE;
+
+	const auto nState = LOWORD(msg.wParam);
+	if (nState == WA_ACTIVE || nState == WA_CLICKACTIVE) {
+		const auto fSelection { pHexCtrl->HasSelection() };
+		m_Wnd.CheckRadioButton(IDC_HEXCTRL_HASH_RAD_ALL, IDC_HEXCTRL_HASH_RAD_SEL,
+			fSelection ? IDC_HEXCTRL_HASH_RAD_SEL : IDC_HEXCTRL_HASH_RAD_ALL);
+		wnd::CWnd::FromHandle(m_Wnd.GetDlgItem(IDC_HEXCTRL_HASH_RAD_SEL)).EnableWindow(fSelection);
+	}
+
+	return FALSE; //Default handler.
+}
+
+void CHexDlgHash::OnBtnCopy()
+{
+	if (m_WndEditResult.IsWndTextEmpty())
+		return;
+
+	const auto wstrData = m_WndEditResult.GetWndText();
+	constexpr auto sCharSize { sizeof(wchar_t) };
+	const std::size_t sMemSize = (wstrData.size() * sCharSize) + sCharSize;
+	const auto hMem = ::GlobalAlloc(GMEM_MOVEABLE, sMemSize);
+	if (!hMem) {
+		ut::DBG_REPORT(L"GlobalAlloc error.");
+		return;
+	}
+
+	const auto lpMemLock = ::GlobalLock(hMem);
+	if (!lpMemLock) {
+		ut::DBG_REPORT(L"GlobalLock error.");
+		return;
+	}
+
+	std::memcpy(lpMemLock, wstrData.data(), sMemSize);
+	::GlobalUnlock(hMem);
+	::OpenClipboard(m_Wnd);
+	::EmptyClipboard();
+	::SetClipboardData(CF_UNICODETEXT, hMem);
+	::CloseClipboard();
+}
+
+void CHexDlgHash::OnCancel()
+{
+	if (IsNoEsc()) //Not closing Dialog on Escape key.
+		return;
+
+	ShowWindow(SW_HIDE);
+}
+
+auto CHexDlgHash::OnClose()->INT_PTR
+{
+	ShowWindow(SW_HIDE);
+	return TRUE;
+}
+
+auto CHexDlgHash::OnCommand(const MSG& msg)->INT_PTR
+{
+	const auto uCtrlID = LOWORD(msg.wParam);
+	switch (uCtrlID) {
+	case IDOK:
+		OnOK();
+		break;
+	case IDCANCEL:
+		OnCancel();
+		break;
+	case IDC_HEXCTRL_HASH_BTN_COPY:
+		OnBtnCopy();
+		break;
+	default:
+		return FALSE;
+	}
+	return TRUE;
+}
+
+auto CHexDlgHash::OnDestroy()->INT_PTR
+{
+	m_u64Flags = { };
+	m_pHexCtrl = nullptr;
+
+	return TRUE;
+}
+
+auto CHexDlgHash::OnInitDialog(const MSG& msg)->INT_PTR
+{
+	m_Wnd.Attach(msg.hwnd);
+	m_WndEditResult.Attach(m_Wnd.GetDlgItem(IDC_HEXCTRL_HASH_EDIT_RESULT));
+	::CheckDlgButton(m_Wnd, IDC_HEXCTRL_HASH_CHK_CRC32, BST_CHECKED);
+	::CheckDlgButton(m_Wnd, IDC_HEXCTRL_HASH_CHK_SHA256, BST_CHECKED);
+	m_Wnd.CheckRadioButton(IDC_HEXCTRL_HASH_RAD_ALL, IDC_HEXCTRL_HASH_RAD_SEL, IDC_HEXCTRL_HASH_RAD_ALL);
+	OnActivate({ .wParam { WA_ACTIVE } }); //To properly activate "All-Selection" radios on the first launch.
+
+	return TRUE;
+}
+
+void CHexDlgHash::OnOK()
+{
+	const auto pHexCtrl = GetHexCtrl();
+	if (!pHexCtrl->IsCreated() || !pHexCtrl->IsDataSet())
+		return;
+
+	HEXHASH hhs;
+	for (const auto& [iChkID, eHash] : g_arrChkHash) {
+		if (::IsDlgButtonChecked(m_Wnd, iChkID) == BST_CHECKED) {
+			hhs.vecHash.emplace_back(eHash);
+		}
+	}
+
+	if (hhs.vecHash.empty()) {
+		MessageBoxW(m_Wnd, L"Choose at least one algorithm.", L"Error", MB_ICONERROR);
+		return;
+	}
+
+	const auto fSelection = m_Wnd.GetCheckedRadioButton(IDC_HEXCTRL_HASH_RAD_ALL, IDC_HEXCTRL_HASH_RAD_SEL)
+		== IDC_HEXCTRL_HASH_RAD_SEL;
+	if (fSelection) {
+		if (!pHexCtrl->HasSelection())
+			return;
+
+		hhs.vecSpan = pHexCtrl->GetSelection();
+		hhs.fPerSpan = ::IsDlgButtonChecked(m_Wnd, IDC_HEXCTRL_HASH_CHK_PERSPAN) == BST_CHECKED;
+	}
+	else {
+		hhs.vecSpan.emplace_back(0, pHexCtrl->GetDataSize());
+	}
+
+	const auto vecDigest = pHexCtrl->HashData(hhs);
+	std::wstring wstrResult;
+	for (const auto& refDigest : vecDigest) {
+		std::wstring wstrDigest;
+		for (const auto byte : refDigest.vecDigest) {
+			wstrDigest += std::format(L"{:02X}", static_cast<std::uint8_t>(byte));
+		}
+
+		const auto wsvName = GetHashName(refDigest.eHash);
+		if (hhs.fPerSpan) {
+			const auto ullOffset = pHexCtrl->GetOffset(hhs.vecSpan[refDigest.sSpanIndex].ullOffset, true);
+			wstrResult += std::format(L"0x{:X}\t{}:\t{}\r\n", ullOffset, wsvName, wstrDigest);
+		}
+		else {
+			wstrResult += std::format(L"{}:\t{}\r\n", wsvName, wstrDigest);
+		}
+	}
+	m_WndEditResult.SetWndText(wstrResult);
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+/****************************************************************************************
+* Copyright © 2018-present Jovibor https://github.com/jovibor/                          *
+* Hex Control for Windows applications.                                                 *
+* Official git repository: https://github.com/jovibor/HexCtrl/                          *
+* This software is available under "The HexCtrl License", see the LICENSE file.         *
+****************************************************************************************/
+#pragma once
+#include "../../HexCtrl.h"
+
+import HEXCTRL.HexUtility;
+
+namespace HEXCTRL::INTERNAL {
+	class CHexDlgHash final {
+	public:
+		void CreateDlg();
+		void DestroyDlg();
+		void Initialize(IHexCtrl* pHexCtrl, HINSTANCE hInstRes);
+		[[nodiscard]] auto GetHWND()const->HWND;
+		[[nodiscard]] bool PreTranslateMsg(MSG* pMsg);
+		[[nodiscard]] auto ProcessMsg(const MSG& msg) -> INT_PTR;
+		void SetDlgProperties(std::uint64_t u64Flags);
+		void ShowWindow(int iCmdShow);
+	private:
+		[[nodiscard]] auto GetHexCtrl()const->IHexCtrl*;
+		[[nodiscard]] bool IsNoEsc()const;
+		auto OnActivate(const MSG& msg) -> INT_PTR;
+		void OnBtnCopy();
+		void OnCancel();
+		auto OnClose() -> INT_PTR;
+		auto OnCommand(const MSG& msg) -> INT_PTR;
+		auto OnDestroy() -> INT_PTR;
+		auto OnInitDialog(const MSG& msg) -> INT_PTR;
+		void OnOK();
+	private:
+		HINSTANCE m_hInstRes { };
+		wnd::CWnd m_Wnd;
+		wnd::CWndEdit m_WndEditResult;
+		IHexCtrl* m_pHexCtrl { };
+		std::uint64_t m_u64Flags { }; //Data from SetDlgProperties.
+	};
+}
\ No newline at end of file
@@ -581,7 +581,8 @@ namespace HEXCTRL::INTERNAL {
 }
 
 enum class CHexDlgFillData::EFillType : std::uint8_t {
-	FILL_HEX, FILL_ASCII, FILL_WCHAR, FILL_RAND_MT19937, FILL_RAND_FAST
+	FILL_HEX, FILL_ASCII, FILL_WCHAR, FILL_RAND_MT19937, FILL_RAND_FAST,
+	FILL_XOR_KEY, FILL_XOR_ROLL, FILL_XOR_COUNTER, FILL_XOR_RC4
 };
 
 void CHexDlgFillData::CreateDlg(HWND hWndParent, IHexCtrl* pHexCtrl, HINSTANCE hInstRes)
@@ -734,6 +735,14 @@ auto CHexDlgFillData::OnInitDialog(const MSG& msg)->INT_PTR
 	m_WndCmbType.SetItemData(iIndex, static_cast<DWORD_PTR>(EFillType::FILL_RAND_MT19937));
 	iIndex = m_WndCmbType.AddString(L"Pseudo Random Data (fast, but less secure)");
 	m_WndCmbType.SetItemData(iIndex, static_cast<DWORD_PTR>(EFillType::FILL_RAND_FAST));
+	iIndex = m_WndCmbType.AddString(L"XOR with Hex Key");
+	m_WndCmbType.SetItemData(iIndex, static_cast<DWORD_PTR>(EFillType::FILL_XOR_KEY));
+	iIndex = m_WndCmbType.AddString(L"Rolling XOR with Hex Key");
+	m_WndCmbType.SetItemData(iIndex, static_cast<DWORD_PTR>(EFillType::FILL_XOR_ROLL));
+	iIndex = m_WndCmbType.AddString(L"Counter XOR with Hex Key");
+	m_WndCmbType.SetItemData(iIndex, static_cast<DWORD_PTR>(EFillType::FILL_XOR_COUNTER));
+	iIndex = m_WndCmbType.AddString(L"RC4 with Hex Key");
+	m_WndCmbType.SetItemData(iIndex, static_cast<DWORD_PTR>(EFillType::FILL_XOR_RC4));
 
 	m_Wnd.CheckRadioButton(IDC_HEXCTRL_FILLDATA_RAD_ALL, IDC_HEXCTRL_FILLDATA_RAD_SEL, IDC_HEXCTRL_FILLDATA_RAD_ALL);
 	m_WndCmbData.LimitText(256); //Max characters of the combo-box.
@@ -749,7 +758,8 @@ void CHexDlgFillData::OnOK()
 
 	using enum EFillType;
 	const auto eType = GetFillType();
-	if (eType == FILL_HEX || eType == FILL_ASCII || eType == FILL_WCHAR) {
+	const auto fKeyStream = eType == FILL_XOR_KEY || eType == FILL_XOR_ROLL || eType == FILL_XOR_COUNTER || eType == FILL_XOR_RC4;
+	if (eType == FILL_HEX || eType == FILL_ASCII || eType == FILL_WCHAR || fKeyStream) {
 		if (m_WndCmbData.IsWndTextEmpty()) {
 			MessageBoxW(m_Wnd, L"Missing fill data.", L"Data error", MB_ICONERROR);
 			return;
@@ -772,10 +782,28 @@ void CHexDlgFillData::OnOK()
 		vecSpan = m_pHexCtrl->GetSelection();
 	}
 
-	using enum EHexModifyMode;
+	using enum EHexModifyMode; using enum EHexKeyStream;
 	EHexModifyMode eModifyMode;
+	EHexKeyStream eKeyStream { };
 	const auto wstrText = m_WndCmbData.GetWndText();
 	switch (eType) {
+	case FILL_XOR_KEY:
+	case FILL_XOR_ROLL:
+	case FILL_XOR_COUNTER:
+	case FILL_XOR_RC4:
+	{
+		auto optData = ut::NumStrToHex(wstrText);
+		if (!optData) {
+			MessageBoxW(m_Wnd, L"Wrong Hex format.", L"Format error", MB_ICONERROR);
+			return;
+		}
+
+		m_vecFillData = ut::RangeToVecBytes(*optData);
+		eModifyMode = MODIFY_KEYSTREAM;
+		eKeyStream = eType == FILL_XOR_KEY ? KEYSTREAM_XOR : (eType == FILL_XOR_ROLL ? KEYSTREAM_ROLLXOR
+			: (eType == FILL_XOR_COUNTER ? KEYSTREAM_COUNTER : KEYSTREAM_RC4));
+	}
+	break;
 	case FILL_HEX:
 	{
 		auto optData = ut::NumStrToHex(wstrText);
@@ -814,13 +842,14 @@ void CHexDlgFillData::OnOK()
 		m_WndCmbData.InsertString(0, wstrText);
 	}
 
-	if (m_vecFillData.size() > vecSpan.back().ullSize) {
+	if (!fKeyStream && m_vecFillData.size() > vecSpan.back().ullSize) { //The keystream key can be of any size.
 		MessageBoxW(m_Wnd, L"Fill data size is bigger than the region selected for modification, please select a larger region.",
 			L"Data region size error", MB_ICONERROR);
 		return;
 	}
 
-	const HEXMODIFY hms { .eModifyMode { eModifyMode }, .spnData { m_vecFillData }, .vecSpan { std::move(vecSpan) } };
+	const HEXMODIFY hms { .eModifyMode { eModifyMode }, .eKeyStream { eKeyStream }, .spnData { m_vecFillData },
+		.vecSpan { std::move(vecSpan) } };
 	m_pHexCtrl->ModifyData(hms);
 	m_pHexCtrl->Redraw();
 }
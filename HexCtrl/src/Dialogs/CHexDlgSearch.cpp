@@ -7,25 +7,33 @@
 #include "../../res/HexCtrlRes.h"
 #include "CHexDlgSearch.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <cmath>
 #include <commctrl.h>
 #include <cwctype>
 #include <format>
+#include <functional>
 #include <intrin.h>
 #include <limits>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <type_traits>
+#include <vector>
 
 using namespace HEXCTRL::INTERNAL;
 
 enum class CHexDlgSearch::ESearchMode : std::uint8_t {
-	MODE_HEXBYTES, MODE_TEXT, MODE_NUMBERS, MODE_STRUCT
+	MODE_HEXBYTES, MODE_TEXT, MODE_NUMBERS, MODE_STRUCT, MODE_REGEX
 };
 
 enum class CHexDlgSearch::ESearchType : std::uint8_t {
 	HEXBYTES, TEXT_ASCII, TEXT_UTF8, TEXT_UTF16, NUM_INT8, NUM_UINT8, NUM_INT16, NUM_UINT16,
-	NUM_INT32, NUM_UINT32, NUM_INT64, NUM_UINT64, NUM_FLOAT, NUM_DOUBLE, STRUCT_FILETIME
+	NUM_INT32, NUM_UINT32, NUM_INT64, NUM_UINT64, NUM_FLOAT, NUM_DOUBLE, STRUCT_FILETIME, REGEX
 };
 
 enum class CHexDlgSearch::EMenuID : std::uint16_t {
@@ -47,13 +55,142 @@ struct CHexDlgSearch::SEARCHFUNCDATA {
 	ULONGLONG ullChunks { };         //How many memory chunks to search in.
 	ULONGLONG ullChunkSize { };      //Size of one chunk.
 	ULONGLONG ullChunkMaxOffset { }; //Maximum offset to start search from, in the chunk.
+	ULONGLONG ullChunkSkip { };      //Offsets to skip in the first chunk, for the forward search only.
 	CHexDlgProgress* pDlgProg { };
 	IHexCtrl* pHexCtrl { };
+	const CHexRegex* pRegex { };     //Compiled expression, for the regex search only.
+	const CHexSearchIndex* pIndex { }; //Search index, for the index search only.
+	CHexReader* pReader { };         //Reader of the consecutive searches, or nullptr for the search's own one.
 	SpanCByte spnFind;
+	SpanCByte spnMask;               //Bits of the spnFind to compare, for the hex bytes only.
+	std::array<ULONGLONG, 256> arrShift { }; //Shifts by the data byte value, for the long search data.
+	std::array<std::byte, 8> arrNumMin { }; //Min number, for the numbers range search only.
+	std::array<std::byte, 8> arrNumMax { }; //Max number, for the numbers range search only.
+	DWORD dwMismatch { };            //Maximum mismatching bytes, for the fuzzy search only.
+	bool fBigEndian { };             //Numbers are in the big-endian order, for the numbers range search only.
 	bool fBigStep { };
 	bool fInverted { };
 };
 
+namespace HEXCTRL::INTERNAL {
+	//Search of the CHexDlgSearch::SearchAsync, that runs in its own thread.
+	//The never shown progress dialog object is only the search kernels' cancel flag.
+	class CHexSearchAsync final : public IHexSearch {
+	public:
+		CHexSearchAsync(const CHexDlgSearch* pOwner, const HEXSEARCH& hss, ULONGLONG ullMin, ULONGLONG ullMax);
+		void Cancel()override;
+		void Delete()override;
+		[[nodiscard]] auto GetCount()const->ULONGLONG override;
+		[[nodiscard]] auto GetDlgProg()->CHexDlgProgress*;
+		[[nodiscard]] auto GetSearch()->HEXSEARCH&;
+		[[nodiscard]] bool IsCanceled()const override;
+		[[nodiscard]] bool IsDone()const override;
+		[[nodiscard]] bool IsSearchThread()const; //The calling thread is the search's own thread.
+		void OnHit();
+		void Run(std::function<void()> FuncSearch, bool fAsync); //Searches in the calling thread if !fAsync.
+		void Wait()override;
+	private:
+		const CHexDlgSearch* m_pOwner { };
+		HEXSEARCH m_hss;
+		CHexDlgProgress m_DlgProg;
+		std::thread m_thrd;
+		std::mutex m_mtxWait;
+		std::atomic<std::thread::id> m_atomIDThrd { };
+		std::atomic<ULONGLONG> m_atomCount { 0ULL };
+		std::atomic_bool m_atomDone { false };
+	};
+}
+
+CHexSearchAsync::CHexSearchAsync(const CHexDlgSearch* pOwner, const HEXSEARCH& hss, ULONGLONG ullMin, ULONGLONG ullMax) :
+	m_pOwner(pOwner), m_hss(hss), m_DlgProg(L"", L"", ullMin, ullMax) {
+}
+
+void CHexSearchAsync::Cancel()
+{
+	m_DlgProg.OnCancel();
+}
+
+void CHexSearchAsync::Delete()
+{
+	Cancel();
+	Wait();
+	m_pOwner->RemoveSearchAsync(this);
+	delete this;
+}
+
+auto CHexSearchAsync::GetCount()const->ULONGLONG
+{
+	return m_atomCount;
+}
+
+auto CHexSearchAsync::GetDlgProg()->CHexDlgProgress*
+{
+	return &m_DlgProg;
+}
+
+auto CHexSearchAsync::GetSearch()->HEXSEARCH&
+{
+	return m_hss;
+}
+
+bool CHexSearchAsync::IsCanceled()const
+{
+	return m_DlgProg.IsCanceled();
+}
+
+bool CHexSearchAsync::IsDone()const
+{
+	return m_atomDone;
+}
+
+bool CHexSearchAsync::IsSearchThread()const
+{
+	return m_atomIDThrd.load() == std::this_thread::get_id();
+}
+
+void CHexSearchAsync::OnHit()
+{
+	++m_atomCount;
+}
+
+void CHexSearchAsync::Run(std::function<void()> FuncSearch, bool fAsync)
+{
+	if (!fAsync) {
+		FuncSearch();
+		m_atomDone = true;
+		return;
+	}
+
+	m_thrd = std::thread([this, FuncSearch = std::move(FuncSearch)]() {
+		m_atomIDThrd = std::this_thread::get_id();
+		FuncSearch();
+		m_atomDone = true;
+		});
+}
+
+void CHexSearchAsync::Wait()
+{
+	const std::scoped_lock lock(m_mtxWait);
+	if (m_thrd.joinable()) {
+		m_thrd.join();
+	}
+}
+
+void CHexDlgSearch::CancelSearchAsync()
+{
+	//The search that modifies the data from its FuncHit is only canceled, it can't wait for itself.
+	const std::scoped_lock lock(m_mtxSearchAsync);
+	for (const auto pSearch : m_vecSearchAsync) {
+		pSearch->Cancel();
+	}
+
+	for (const auto pSearch : m_vecSearchAsync) {
+		if (!pSearch->IsSearchThread()) {
+			pSearch->Wait();
+		}
+	}
+}
+
 void CHexDlgSearch::ClearData()
 {
 	if (!m_Wnd.IsWindow())
@@ -101,6 +238,8 @@ auto CHexDlgSearch::GetDlgItemHandle(EHexDlgItem eItem)const->HWND
 		return m_WndEditRngEnd;
 	case SEARCH_EDIT_LIMIT:
 		return m_WndEditLimit;
+	case SEARCH_EDIT_MISMATCH:
+		return m_WndEditMismatch;
 	default:
 		return { };
 	}
@@ -111,15 +250,17 @@ auto CHexDlgSearch::GetHWND()const->HWND
 	return m_Wnd;
 }
 
-void CHexDlgSearch::Initialize(IHexCtrl* pHexCtrl, HINSTANCE hInstRes)
+void CHexDlgSearch::Initialize(IHexCtrl* pHexCtrl, HINSTANCE hInstRes, const CHexSearchIndex* pSearchIndex, CHexSearchCache* pSearchCache)
 {
-	if (pHexCtrl == nullptr || hInstRes == nullptr) {
+	if (pHexCtrl == nullptr || hInstRes == nullptr || pSearchIndex == nullptr || pSearchCache == nullptr) {
 		ut::DBG_REPORT(L"Initialize == nullptr");
 		return;
 	}
 
 	m_pHexCtrl = pHexCtrl;
 	m_hInstRes = hInstRes;
+	m_pSearchIndex = pSearchIndex;
+	m_pSearchCache = pSearchCache;
 }
 
 bool CHexDlgSearch::IsSearchAvail()const
@@ -149,11 +290,91 @@ auto CHexDlgSearch::ProcessMsg(const MSG& msg)->INT_PTR
 	}
 }
 
+auto CHexDlgSearch::SearchAsync(const HEXSEARCH& hss)const->IHexSearchPtr
+{
+	const auto pHexCtrl = GetHexCtrl();
+	const auto ullDataSize = pHexCtrl->GetDataSize();
+	const auto ullRngStart = hss.stRange.ullOffset;
+	const auto nSizeSearch = hss.vecData.size();
+	if (nSizeSearch == 0 || hss.ullStep == 0 || hss.dwLimit == 0 || !hss.FuncHit || ullRngStart >= ullDataSize
+		|| (hss.eType == EHexSearchType::SEARCH_TEXT_UTF16 && nSizeSearch % sizeof(wchar_t) != 0)) {
+		ut::DBG_REPORT(L"Wrong HEXSEARCH data.");
+		return { };
+	}
+
+	const auto ullRngEnd = hss.stRange.ullSize == 0 || hss.stRange.ullSize > ullDataSize - ullRngStart ?
+		ullDataSize - 1 : ullRngStart + hss.stRange.ullSize - 1;
+	if (ullRngEnd - ullRngStart + 1 < nSizeSearch) //Nothing to search within.
+		return { };
+
+	auto pSearchFunc = GetSearchFuncAsync<EVecSize::VEC128>(hss);
+#if defined(_M_IX86) || defined(_M_X64)
+	if (ut::HasAVX2()) {
+		pSearchFunc = GetSearchFuncAsync<EVecSize::VEC256>(hss);
+	}
+#endif
+
+	const auto pSearch = new CHexSearchAsync(this, hss, ullRngStart, ullRngEnd);
+	{
+		const std::scoped_lock lock(m_mtxSearchAsync);
+		m_vecSearchAsync.emplace_back(pSearch);
+	}
+	auto& refHss = pSearch->GetSearch();
+	if (refHss.eType != EHexSearchType::SEARCH_BYTES && !refHss.fMatchCase) {
+		//Case insensitive search functions expect the lowercase search data, as the dialog makes it.
+		//The UTF-16 ASCII letters are the ones with the zero high byte.
+		auto& vecData = refHss.vecData;
+		const auto fUTF16 = refHss.eType == EHexSearchType::SEARCH_TEXT_UTF16;
+		for (std::size_t i { 0 }; i < vecData.size(); i += fUTF16 ? sizeof(wchar_t) : sizeof(char)) {
+			if (!fUTF16 || (i + 1 < vecData.size() && vecData[i + 1] == std::byte { })) {
+				vecData[i] = ToLowerASCII<SEARCHTYPE(EMemCmp::CHAR_STR, EVecSize::VEC128)>(vecData[i]);
+			}
+		}
+	}
+
+	SEARCHFUNCDATA stData { .ullStartFrom { ullRngStart }, .ullRngStart { ullRngStart }, .ullRngEnd { ullRngEnd },
+		.ullStep { refHss.ullStep }, .pDlgProg { pSearch->GetDlgProg() }, .pHexCtrl { pHexCtrl }, .spnFind { refHss.vecData },
+		.fInverted { refHss.fInverted } };
+	CalcShifts(stData, true);
+
+	//The data handler is called from the search thread, while the paint routine calls it from the main thread.
+	//Concurrent data access is only allowed in non-virtual mode, the virtual data is searched in the calling thread,
+	//the search is done when the SearchAsync returns.
+	pSearch->Run([pSearch, pSearchFunc, stData]()mutable {
+		const auto& refHss = pSearch->GetSearch();
+		const auto ullLastOffset = stData.ullRngEnd + 1 - stData.spnFind.size();
+		CHexReader reader(stData.pHexCtrl, stData.ullRngStart, stData.ullRngEnd); //The next search starts in the read data.
+		stData.pReader = &reader;
+		ULONGLONG ullCount { 0 };
+		while (true) {
+			CalcMemChunks(stData, true);
+			const auto findRes = pSearchFunc(stData);
+			if (!findRes || pSearch->IsCanceled())
+				break;
+
+			pSearch->OnHit();
+			reader.Pause(); //The FuncHit may read the data itself.
+			if (!refHss.FuncHit(findRes.ullOffset)) {
+				pSearch->Cancel();
+				break;
+			}
+
+			if (++ullCount >= refHss.dwLimit || refHss.ullStep > ullLastOffset - findRes.ullOffset)
+				break;
+
+			stData.ullStartFrom = findRes.ullOffset + refHss.ullStep;
+		}
+		}, !pHexCtrl->IsVirtual());
+
+	return IHexSearchPtr { pSearch };
+}
+
 void CHexDlgSearch::SearchNextPrev(bool fForward)
 {
 	m_fForward = fForward;
 	m_fReplace = false;
 	m_fAll = false;
+	m_fCount = false;
 	m_fSearchNext = true;
 	Prepare();
 }
@@ -177,68 +398,20 @@ void CHexDlgSearch::ShowWindow(int iCmdShow)
 
 void CHexDlgSearch::AddToList(ULONGLONG ullOffset)
 {
-	int iHighlight { -1 };
-	if (const auto iter = std::find(m_vecSearchRes.begin(), m_vecSearchRes.end(), ullOffset);
-		iter == m_vecSearchRes.end()) { //Max-found search occurences.
-		if (m_vecSearchRes.size() < static_cast<std::size_t>(m_dwLimit)) {
-			m_vecSearchRes.emplace_back(ullOffset);
-			iHighlight = static_cast<int>(m_vecSearchRes.size());
-			m_ListEx.SetItemCountEx(iHighlight--);
-		}
-	}
-	else {
-		iHighlight = static_cast<int>(iter - m_vecSearchRes.begin());
+	auto optHighlight = m_SearchRes.Find(ullOffset);
+	if (!optHighlight && m_SearchRes.Size() < static_cast<std::size_t>(m_dwLimit)) { //Max-found search occurences.
+		optHighlight = m_SearchRes.Insert(ullOffset).first;
+		SetListCount();
 	}
 
-	if (iHighlight != -1) {
+	if (optHighlight && *optHighlight < static_cast<std::size_t>(m_ListEx.GetItemCount())) {
+		const auto iHighlight = static_cast<int>(*optHighlight);
 		m_ListEx.SetItemState(-1, 0, LVIS_SELECTED);
 		m_ListEx.SetItemState(iHighlight, LVIS_SELECTED, LVIS_SELECTED);
 		m_ListEx.EnsureVisible(iHighlight, TRUE);
 	}
 }
 
-void CHexDlgSearch::CalcMemChunks(SEARCHFUNCDATA& refData)const
-{
-	const auto nSizeSearch = refData.spnFind.size();
-	if (refData.ullStartFrom + nSizeSearch > GetSentinel()) {
-		refData.ullChunks = { };
-		refData.ullChunkSize = { };
-		refData.ullChunkMaxOffset = { };
-		return;
-	}
-
-	const auto ullSizeTotal = GetSearchRngSize(); //Depends on search direction.
-	const auto pHexCtrl = refData.pHexCtrl;
-	const auto ullStep = refData.ullStep;
-	ULONGLONG ullChunks;
-	ULONGLONG ullChunkSize;
-	ULONGLONG ullChunkMaxOffset;
-	bool fBigStep { false };
-
-	if (!pHexCtrl->IsVirtual()) {
-		ullChunks = 1;
-		ullChunkSize = ullSizeTotal;
-		ullChunkMaxOffset = ullSizeTotal - nSizeSearch;
-	}
-	else {
-		ullChunkSize = (std::min)(static_cast<ULONGLONG>(pHexCtrl->GetCacheSize()), ullSizeTotal);
-		ullChunkMaxOffset = ullChunkSize - nSizeSearch;
-		if (ullStep > ullChunkMaxOffset) { //For very big steps.
-			ullChunks = ullSizeTotal > ullStep ? (ullSizeTotal / ullStep) + ((ullSizeTotal % ullStep) ? 1 : 0) : 1;
-			fBigStep = true;
-		}
-		else {
-			ullChunks = ullSizeTotal > ullChunkMaxOffset ? (ullSizeTotal / ullChunkMaxOffset)
-				+ ((ullSizeTotal % ullChunkMaxOffset) ? 1 : 0) : 1;
-		}
-	}
-
-	refData.ullChunks = ullChunks;
-	refData.ullChunkSize = ullChunkSize;
-	refData.ullChunkMaxOffset = ullChunkMaxOffset;
-	refData.fBigStep = fBigStep;
-}
-
 void CHexDlgSearch::ClearComboType()
 {
 	m_WndCmbType.SetRedraw(FALSE);
@@ -251,7 +424,7 @@ void CHexDlgSearch::ClearComboType()
 void CHexDlgSearch::ClearList()
 {
 	m_ListEx.SetItemCountEx(0);
-	m_vecSearchRes.clear();
+	m_SearchRes.Clear();
 }
 
 void CHexDlgSearch::ComboSearchFill(LPCWSTR pwsz)
@@ -282,10 +455,16 @@ auto CHexDlgSearch::CreateSearchData(CHexDlgProgress* pDlgProg)const->SEARCHFUNC
 {
 	SEARCHFUNCDATA stData { .ullStartFrom { GetStartFrom() }, .ullRngStart { GetRngStart() },
 		.ullRngEnd { GetRngEnd() }, .ullStep { GetStep() }, .pDlgProg { pDlgProg }, .pHexCtrl { GetHexCtrl() },
-		.spnFind { GetSearchSpan() }, .fInverted { IsInverted() }
+		.pRegex { IsRegex() ? &m_Regex : nullptr }, .pIndex { IsIndexSearch() ? m_pSearchIndex : nullptr }, .spnFind { GetSearchSpan() }, .spnMask { m_vecSearchMask },
+		.arrNumMin { m_arrNumMin }, .arrNumMax { m_arrNumMax }, .dwMismatch { IsFuzzy() ? m_dwMismatch : 0 },
+		.fBigEndian { IsBigEndian() }, .fInverted { IsInverted() }
 	};
 
-	CalcMemChunks(stData);
+	CalcMemChunks(stData, IsForward());
+
+	if (IsLongSearch()) {
+		CalcShifts(stData, IsForward());
+	}
 
 	return stData;
 }
@@ -294,65 +473,230 @@ void CHexDlgSearch::FindAll()
 {
 	ClearList(); //Clearing all results.
 	m_dwCount = 0;
-	const auto pSearchFunc = GetSearchFunc(true, !IsSmallSearch());
-	auto stFuncData = CreateSearchData();
+	m_ullCounted = 0;
+	const auto ullStartFrom = GetStartFrom();
+	const auto ullLastOffset = GetLastSearchOffset();
+	if (ullStartFrom + GetSearchDataSize() > GetSentinel())
+		return;
 
-	if (IsSmallSearch()) {
-		auto lmbWrapper = [&]()mutable->FINDRESULT {
-			CalcMemChunks(stFuncData);
-			return pSearchFunc(stFuncData);
-			};
+	const auto ullGen = m_pSearchCache->GetGeneration();
+	if (auto optCached = m_fCount ? std::nullopt : TakeCached(ullStartFrom, true); optCached) {
+		const auto& refRes = optCached->Res;
+		for (auto sIndex = refRes.LowerBound(ullStartFrom); sIndex < refRes.Size() && m_SearchRes.Size() < m_dwLimit; ++sIndex) {
+			m_SearchRes.Append(refRes[sIndex]);
+		}
+		PutCached(std::move(*optCached));
 
-		while (const auto findRes = lmbWrapper()) {
-			m_vecSearchRes.emplace_back(findRes.ullOffset); //Filling the vector of Found occurences.
+		SetFoundAll();
+		return;
+	}
 
-			const auto ullNext = findRes.ullOffset + GetStep();
-			if (ullNext > GetLastSearchOffset() || m_vecSearchRes.size() >= m_dwLimit)
-				break;
+	//The search start offsets are split into partitions that are searched independently, in parallel.
+	//Every partition's data window overlaps the next partition by the (search data size - 1) bytes,
+	//to find occurrences that cross the partitions' boundaries. The partition size is a multiple
+	//of the step, to keep the start offsets in line with the step.
+	static constexpr auto ullPartSizeMin { 1024ULL * 1024ULL * 16ULL }; //16MB.
+	const auto ullStep = GetStep();
+	const auto ullPartSize = ullStep >= ullPartSizeMin ? ullStep : ((ullPartSizeMin + ullStep - 1) / ullStep) * ullStep;
+	const auto ullOffsets = ullLastOffset - ullStartFrom + 1;
+	//Partition's offsets are searched by the slices, to check for the cancel within the partition.
+	static constexpr auto ullSliceSizeMin { 1024ULL * 1024ULL }; //1MB.
+	const auto ullSliceSize = ullStep >= ullSliceSizeMin ? ullStep : ((ullSliceSizeMin + ullStep - 1) / ullStep) * ullStep;
+	const auto sParts = static_cast<std::size_t>((ullOffsets / ullPartSize) + ((ullOffsets % ullPartSize) ? 1 : 0));
+	const auto pSearchFunc = GetSearchFunc(true, false);
+	const auto fCount = m_fCount; //Counting has no limit, and the match bits are counted within the kernel if possible.
+	const auto pCountFunc = fCount ? GetCountFunc() : nullptr;
+	const auto stFuncDataTmpl = CreateSearchData(); //Dialog's controls are only accessed from this thread.
+	const auto sLimit = fCount ? (std::numeric_limits<std::size_t>::max)() : static_cast<std::size_t>(m_dwLimit);
+	const auto fRegex = IsRegex();
+	const auto optRegexMax = m_Regex.GetMaxSize();
+	const auto fRegexSerial = fRegex && !optRegexMax; //Unbounded expression.
+	std::vector<CHexSearchResult> vecPartRes(sParts);
+	std::vector<ULONGLONG> vecPartCount(fCount ? sParts : 0);
+	CHexDlgProgress dlgProg(L"Searching...", L"Found: ", 0, ullOffsets);
+	CHexParallel par(GetHexCtrl(), &dlgProg);
+	par.SetLimit(sLimit);
+
+	//The regex occurrences are found by the reverse unanchored DFA, that runs backward over the partition's data.
+	//Its state at an offset tells whether a match starts there, the data is read only once, in chunks.
+	//The bounded expression's partition data overlaps the next partition by the (max match size - 1) bytes.
+	//The unbounded expression's partitions are scanned one by one, from the last to the first,
+	//and the DFA state is carried over from the next partition instead of the overlap.
+	std::optional<CHexRegexDFA> optDFASerial;
+	std::uint32_t u32StateSerial { };
+	if (fRegexSerial) {
+		optDFASerial.emplace(m_Regex, true, true);
+	}
+	const auto ullSentinel = GetSentinel();
+	const auto ullChunkSizeMax = GetHexCtrl()->IsVirtual() ? static_cast<ULONGLONG>(GetHexCtrl()->GetCacheSize()) :
+		(std::numeric_limits<ULONGLONG>::max)();
+	const auto lmbSearchPartRegex = [&](ULONGLONG ullPartFirst, ULONGLONG ullPartLast, bool fPartLast, CHexSearchResult& refRes,
+		ULONGLONG& refCount, CHexReader& refReader) {
+		std::optional<CHexRegexDFA> optDFAPart;
+		auto& refDFA = fRegexSerial ? *optDFASerial : optDFAPart.emplace(m_Regex, true, true);
+		ULONGLONG ullDataEnd; //Non-dereferenceable.
+		if (optRegexMax) {
+			ullDataEnd = *optRegexMax >= ullSentinel - ullPartLast ? ullSentinel : ullPartLast + *optRegexMax;
+		}
+		else {
+			ullDataEnd = fPartLast ? ullSentinel : ullPartLast + 1;
+		}
 
-			m_ullStartFrom = stFuncData.ullStartFrom = ullNext;
+		std::vector<ULONGLONG> vecRes; //Descending offsets.
+		std::uint32_t u32StatePart { };
+		auto& u32State = fRegexSerial ? u32StateSerial : u32StatePart;
+		if (!fRegexSerial || fPartLast) {
+			u32State = refDFA.GetStartState();
 		}
-	}
-	else {
-		CHexDlgProgress dlgProg(L"Searching...", L"Found: ", GetStartFrom(), GetLastSearchOffset());
-		stFuncData.pDlgProg = &dlgProg;
-		const auto lmbFindAllThread = [&]() {
-			auto lmbWrapper = [&]()mutable->FINDRESULT {
-				CalcMemChunks(stFuncData);
-				return pSearchFunc(stFuncData);
-				};
 
-			while (const auto findRes = lmbWrapper()) {
-				m_vecSearchRes.emplace_back(findRes.ullOffset); //Filling the vector of Found occurences.
-				dlgProg.SetCurrent(findRes.ullOffset);
-				dlgProg.SetCount(m_vecSearchRes.size());
+		for (auto ullChunkEnd = ullDataEnd; ullChunkEnd > ullPartFirst && !par.IsCanceled();) {
+			const auto ullChunkFirst = ullChunkEnd - ullPartFirst > ullChunkSizeMax ? ullChunkEnd - ullChunkSizeMax : ullPartFirst;
+			const auto spnData = refReader.GetData({ .ullOffset { ullChunkFirst }, .ullSize { ullChunkEnd - ullChunkFirst } });
+			refDFA.Run<true>(spnData, u32State, [&](std::size_t sIndex) {
+				const auto ullOffset = ullChunkFirst + sIndex;
+				if (ullOffset <= ullPartLast && (ullOffset - ullStartFrom) % ullStep == 0) {
+					if (fCount) {
+						++refCount;
+					}
+					else {
+						vecRes.emplace_back(ullOffset);
+						if (vecRes.size() >= sLimit * 2) { //Offsets go descending, only the last sLimit ones are needed.
+							vecRes.erase(vecRes.begin(), vecRes.end() - sLimit);
+						}
+					}
+				}
+				return true;
+				});
+			ullChunkEnd = ullChunkFirst;
+		}
+
+		if (vecRes.size() > sLimit) {
+			vecRes.erase(vecRes.begin(), vecRes.end() - sLimit);
+		}
+		for (auto iter = vecRes.rbegin(); iter != vecRes.rend(); ++iter) {
+			refRes.Append(*iter);
+		}
+		};
+
+	const auto lmbSearchPart = [&](std::size_t sPart, CHexReader& refReader) {
+		const auto ullPartFirst = ullStartFrom + (sPart * ullPartSize);
+		const auto ullPartLast = (std::min)(ullPartFirst + (ullPartSize - 1), ullLastOffset);
+		auto stFuncData = stFuncDataTmpl;
+		stFuncData.ullStartFrom = ullPartFirst;
+		stFuncData.ullRngEnd = ullPartLast + (GetSearchDataSize() - 1); //Overlap with the next partition.
+		stFuncData.pReader = &refReader;
+		auto& refRes = vecPartRes[sPart];
+		ULONGLONG ullCount { 0 };
+
+		if (fRegex) {
+			lmbSearchPartRegex(ullPartFirst, ullPartLast, sPart == sParts - 1, refRes, ullCount, refReader);
+		}
+		else {
+			//Every search goes from the slice's start, or from the last found offset, up to the slice's end at most.
+			while (!par.IsPastLimit(sPart) && !par.IsCanceled()) {
+				const auto ullSliceLast = ullPartLast - stFuncData.ullStartFrom > ullSliceSize - 1 ?
+					stFuncData.ullStartFrom + (ullSliceSize - 1) : ullPartLast;
+				stFuncData.ullRngEnd = ullSliceLast + (GetSearchDataSize() - 1);
+				if (pCountFunc != nullptr) {
+					ullCount += pCountFunc(stFuncData);
+					if (ullSliceLast == ullPartLast)
+						break;
+
+					stFuncData.ullStartFrom = ullSliceLast + 1;
+					continue;
+				}
+
+				//The search goes on from the found offset within the slice's chunks, that are read only once.
+				CalcMemChunks(stFuncData, true);
+				for (auto findRes = pSearchFunc(stFuncData); findRes; findRes = pSearchFunc(stFuncData)) {
+					if (fCount) {
+						++ullCount;
+					}
+					else {
+						refRes.Append(findRes.ullOffset);
+					}
+
+					if (ullStep > ullSliceLast - findRes.ullOffset || refRes.Size() >= sLimit
+						|| !CalcMemChunksNext(stFuncData, findRes.ullOffset + ullStep))
+						break;
+				}
 
-				const auto ullNext = findRes.ullOffset + GetStep();
-				if (ullNext > GetLastSearchOffset() || m_vecSearchRes.size() >= m_dwLimit
-					|| dlgProg.IsCanceled())
+				if (ullSliceLast == ullPartLast || refRes.Size() >= sLimit)
 					break;
 
-				m_ullStartFrom = stFuncData.ullStartFrom = ullNext;
+				stFuncData.ullStartFrom = ullSliceLast + 1; //Slice size is a multiple of the step.
 			}
-			dlgProg.OnCancel();
-			};
-		std::thread thrd(lmbFindAllThread);
+		}
+
+		//The partition interrupted by the cancel is not done, its results are incomplete.
+		if (par.IsCanceled())
+			return;
+
+		if (fCount) {
+			vecPartCount[sPart] = ullCount;
+		}
+		par.AddFound(fCount ? ullCount : refRes.Size());
+		par.AddProcessed(ullPartLast - ullPartFirst + 1);
+		par.OnPartDone(sPart, refRes.Size());
+		};
+
+	const auto lmbFindAll = [&]() {
+		//Partitions are taken in the ascending order, so the limit cuts off the latest ones.
+		//The unbounded regex partitions go in the descending order, in one thread.
+		//The worker's reader goes on through the data of its partitions and the searches from the found offsets.
+		par.Run(sParts, [&](std::size_t sIndex, CHexReader& refReader) {
+			lmbSearchPart(fRegexSerial ? sParts - 1 - sIndex : sIndex, refReader);
+			}, GetHexCtrl()->IsVirtual() || fRegexSerial, ullStartFrom, ullSentinel - 1);
+		dlgProg.OnCancel();
+		};
+
+	if (IsSmallSearch()) {
+		lmbFindAll();
+	}
+	else {
+		std::thread thrd(lmbFindAll);
 		dlgProg.DoModal(m_Wnd, m_hInstRes);
 		thrd.join();
 	}
 
-	if (!m_vecSearchRes.empty()) {
-		m_fFound = true;
-		m_dwCount = static_cast<DWORD>(m_vecSearchRes.size());
+	//On cancel only the consecutive done partitions from the beginning are taken, without gaps.
+	//The unbounded regex partitions are done from the last one, none of them is taken then.
+	const auto sPartsTaken = par.IsCanceled() ? par.GetPartsDone() : sParts;
+	if (fCount) {
+		for (std::size_t sIndex { 0 }; sIndex < sPartsTaken; ++sIndex) {
+			m_ullCounted += vecPartCount[sIndex];
+		}
+		m_fFound = m_ullCounted > 0;
+		return;
+	}
+
+	//Partitions are disjoint and go in the offsets order, their results' blocks are moved as is.
+	for (std::size_t sIndex { 0 }; sIndex < sPartsTaken && m_SearchRes.Size() < sLimit; ++sIndex) {
+		auto& refRes = vecPartRes[sIndex];
+		refRes.Truncate(sLimit - m_SearchRes.Size());
+		m_SearchRes.Append(std::move(refRes));
+	}
+
+	//Only the complete results are cached, the ones cut by the limit can't be patched.
+	if (!par.IsCanceled() && m_SearchRes.Size() < sLimit && IsCacheable()) {
+		PutCached({ .Res { m_SearchRes }, .ullFirst { ullStartFrom }, .ullGen { ullGen } });
 	}
 
-	m_ListEx.SetItemCountEx(static_cast<int>(m_vecSearchRes.size()));
+	SetFoundAll();
 }
 
 void CHexDlgSearch::FindForward()
 {
 	FINDRESULT findRes;
 	auto lmbFind = [&]() {
+		if (auto optCached = TakeCached(GetStartFrom(), true); optCached) {
+			const auto& refRes = optCached->Res;
+			const auto sIndex = refRes.LowerBound(GetStartFrom());
+			findRes = sIndex < refRes.Size() ? FINDRESULT { .ullOffset { refRes[sIndex] }, .fFound { true } } : FINDRESULT { };
+			PutCached(std::move(*optCached));
+			return;
+		}
+
 		const auto pSearchFunc = GetSearchFunc(true, !IsSmallSearch());
 		auto stFuncData = CreateSearchData();
 
@@ -396,6 +740,14 @@ void CHexDlgSearch::FindBackward()
 {
 	FINDRESULT findRes;
 	auto lmbFind = [&]() {
+		if (auto optCached = TakeCached(GetStartFrom(), false); optCached) {
+			const auto& refRes = optCached->Res;
+			const auto sIndex = refRes.LowerBound(GetStartFrom() + 1);
+			findRes = sIndex > 0 ? FINDRESULT { .ullOffset { refRes[sIndex - 1] }, .fFound { true } } : FINDRESULT { };
+			PutCached(std::move(*optCached));
+			return;
+		}
+
 		const auto pSearchFunc = GetSearchFunc(false, !IsSmallSearch());
 		auto stFuncData = CreateSearchData();
 
@@ -439,6 +791,85 @@ void CHexDlgSearch::FindBackward()
 	m_fFound = findRes.fFound;
 }
 
+auto CHexDlgSearch::GetCacheKey()const->std::vector<std::byte>
+{
+	std::vector<std::byte> vecKey;
+	const auto lmbPut = [&vecKey](const void* pData, std::size_t sSize) {
+		const auto pBytes = static_cast<const std::byte*>(pData);
+		vecKey.insert(vecKey.end(), pBytes, pBytes + sSize);
+		};
+	const auto lmbPutValue = [&lmbPut](const auto tValue) { lmbPut(&tValue, sizeof(tValue)); };
+
+	lmbPutValue(GetSearchType());
+	lmbPutValue(IsMatchCase());
+	lmbPutValue(IsWildcard());
+	lmbPutValue(IsInverted());
+	lmbPutValue(IsBigEndian());
+	lmbPutValue(IsNumRange());
+	lmbPutValue(IsFuzzy() ? m_dwMismatch : 0UL);
+	lmbPutValue(GetRngStart());
+	lmbPutValue(GetRngEnd());
+	lmbPutValue(GetStep());
+	lmbPutValue(m_vecSearchData.size());
+	lmbPut(m_vecSearchData.data(), m_vecSearchData.size());
+	lmbPutValue(m_vecSearchMask.size());
+	lmbPut(m_vecSearchMask.data(), m_vecSearchMask.size());
+	if (IsNumRange()) {
+		lmbPut(m_arrNumMin.data(), m_arrNumMin.size());
+		lmbPut(m_arrNumMax.data(), m_arrNumMax.size());
+	}
+
+	return vecKey;
+}
+
+auto CHexDlgSearch::GetCountFunc()const->PtrCountFunc
+{
+	using enum EVecSize;
+#if defined(_M_IX86) || defined(_M_X64)
+	if (ut::HasAVX2()) {
+		return GetCountFuncFwd<VEC256>();
+	}
+#endif
+	//For ARM64 and VEC128 path is the same.
+	return GetCountFuncFwd<VEC128>();
+}
+
+template<CHexDlgSearch::EVecSize eVecSize>
+auto CHexDlgSearch::GetCountFuncFwd()const->PtrCountFunc
+{
+	//Only the whole search data compared at every offset is counted by the match bits.
+	//Inverted search counts the offsets where the search data doesn't match.
+	if (GetStep() != 1 || IsRegex() || IsNumRange() || IsIndexSearch() || IsFuzzy() || IsHexWildcard() || IsWildcard())
+		return { };
+
+	using enum ESearchType; using enum EMemCmp;
+	if (!IsMatchCase()) {
+		switch (GetSearchType()) {
+		case TEXT_ASCII:
+			return CountFuncVecFwd<SEARCHTYPE(CHAR_STR, eVecSize, false, false)>;
+		case TEXT_UTF16:
+			return CountFuncVecFwd<SEARCHTYPE(WCHAR_STR, eVecSize, false, false)>;
+		default:
+			break;
+		}
+	}
+
+	return CountFuncVecFwd<SEARCHTYPE(CHAR_STR, eVecSize, false, true)>;
+}
+
+auto CHexDlgSearch::GetFoundSize(ULONGLONG ullOffset)const->ULONGLONG
+{
+	if (m_fReplace)
+		return GetReplaceDataSize();
+
+	if (IsRegex()) { //The longest match, the data might have changed since the search.
+		CHexRegexDFA dfa(m_Regex, false, false);
+		return (std::max)(dfa.MatchSize(GetHexCtrl(), ullOffset, GetSentinel(), true), 1ULL);
+	}
+
+	return GetSearchDataSize();
+}
+
 auto CHexDlgSearch::GetHexCtrl()const->IHexCtrl*
 {
 	return m_pHexCtrl;
@@ -476,11 +907,20 @@ auto CHexDlgSearch::GetRngSize()const->ULONGLONG
 
 auto CHexDlgSearch::GetSearchDataSize()const->DWORD
 {
+	if (IsRegex()) {
+		return static_cast<DWORD>((std::min)(m_Regex.GetMinSize(), static_cast<ULONGLONG>((std::numeric_limits<DWORD>::max)())));
+	}
+
 	return static_cast<DWORD>(m_vecSearchData.size());
 }
 
 auto CHexDlgSearch::GetSearchFunc(bool fFwd, bool fDlgProg)const->PtrSearchFunc
 {
+	if (IsRegex()) {
+		return fFwd ? (fDlgProg ? SearchFuncRegexFwd<true> : SearchFuncRegexFwd<false>) :
+			(fDlgProg ? SearchFuncRegexBack<true> : SearchFuncRegexBack<false>);
+	}
+
 	using enum EVecSize;
 #if defined(_M_IX86) || defined(_M_X64)
 	if (ut::HasAVX2()) {
@@ -493,45 +933,192 @@ auto CHexDlgSearch::GetSearchFunc(bool fFwd, bool fDlgProg)const->PtrSearchFunc
 		(fDlgProg ? GetSearchFuncBack<true, VEC128>() : GetSearchFuncBack<false, VEC128>());
 }
 
-template<bool fDlgProg, CHexDlgSearch::EVecSize eVecSize>
-auto CHexDlgSearch::GetSearchFuncFwd()const->PtrSearchFunc
+template<CHexDlgSearch::EVecSize eVecSize>
+auto CHexDlgSearch::GetSearchFuncAsync(const HEXSEARCH& hss)->PtrSearchFunc
 {
-	//The `fDlgProg` arg ensures that no runtime check will be performed for the 
-	//'SEARCHFUNCDATA::pDlgProg == nullptr', at the hot path inside the SearchFunc function.
-
-	using enum ESearchType; using enum EMemCmp;
+	//The same choice as in the GetSearchFuncFwd, for the exact data and the text only.
+	//The progress is always set, it's the cancel flag of the async search.
+	using enum EMemCmp;
+	const auto fUTF16 = hss.eType == EHexSearchType::SEARCH_TEXT_UTF16;
+	const auto fMatchCase = hss.eType == EHexSearchType::SEARCH_BYTES || hss.fMatchCase;
+	const auto fInverted = hss.fInverted;
+
+	if (hss.ullStep == 1) {
+		if (!fMatchCase && !fInverted) { //Case insensitive text SIMD, for any data size.
+			return fUTF16 ? SearchFuncVecFwdFilter<SEARCHTYPE(WCHAR_STR, eVecSize, true, false, false)> :
+				SearchFuncVecFwdFilter<SEARCHTYPE(CHAR_STR, eVecSize, true, false, false)>;
+		}
 
-	if (GetStep() == 1 && !IsWildcard()) {
-		switch (GetSearchDataSize()) {
-		case 1: //Special case for 1 byte data size SIMD.
-			return IsInverted() ?
-				SearchFuncVecFwdByte1<SEARCHTYPE(DATA_BYTE1, eVecSize, fDlgProg, false, false, true)> :
-				SearchFuncVecFwdByte1<SEARCHTYPE(DATA_BYTE1, eVecSize, fDlgProg, false, false, false)>;
-		case 2: //Special case for 2 bytes data size SIMD.
-			return IsInverted() ?
-				SearchFuncVecFwdByte2<SEARCHTYPE(DATA_BYTE2, eVecSize, fDlgProg, false, false, true)> :
-				SearchFuncVecFwdByte2<SEARCHTYPE(DATA_BYTE2, eVecSize, fDlgProg, false, false, false)>;
-		case 4: //Special case for 4 bytes data size SIMD.
-			return IsInverted() ?
-				SearchFuncVecFwdByte4<SEARCHTYPE(DATA_BYTE4, eVecSize, fDlgProg, false, false, true)> :
-				SearchFuncVecFwdByte4<SEARCHTYPE(DATA_BYTE4, eVecSize, fDlgProg, false, false, false)>;
-		default:
-			break;
-		};
+		if (fMatchCase) {
+			switch (hss.vecData.size()) {
+			case 1:
+				return fInverted ?
+					SearchFuncVecFwdByte1<SEARCHTYPE(DATA_BYTE1, eVecSize, true, false, false, true)> :
+					SearchFuncVecFwdByte1<SEARCHTYPE(DATA_BYTE1, eVecSize, true, false, false, false)>;
+			case 2:
+				return fInverted ?
+					SearchFuncVecFwdByte2<SEARCHTYPE(DATA_BYTE2, eVecSize, true, false, false, true)> :
+					SearchFuncVecFwdByte2<SEARCHTYPE(DATA_BYTE2, eVecSize, true, false, false, false)>;
+			case 4:
+				return fInverted ?
+					SearchFuncVecFwdByte4<SEARCHTYPE(DATA_BYTE4, eVecSize, true, false, false, true)> :
+					SearchFuncVecFwdByte4<SEARCHTYPE(DATA_BYTE4, eVecSize, true, false, false, false)>;
+			default:
+				if (!fInverted) {
+					return SearchFuncVecFwdFilter<SEARCHTYPE(CHAR_STR, eVecSize, true, true, false)>;
+				}
+				break;
+			}
+		}
 	}
 
-	switch (GetSearchType()) {
-	case HEXBYTES:
-		return IsWildcard() ?
-			SearchFuncFwd<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, true)> :
-			SearchFuncFwd<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
-	case TEXT_ASCII:
-		if (IsMatchCase() && !IsWildcard()) {
-			return SearchFuncFwd<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
+	if (const auto ullStep = hss.ullStep; ullStep == 2 || ullStep == 4 || ullStep == 8 || ullStep == 16) {
+		if (!fMatchCase && !fInverted) {
+			return fUTF16 ? SearchFuncVecFwdFilter<SEARCHTYPE(WCHAR_STR, eVecSize, true, false, false)> :
+				SearchFuncVecFwdFilter<SEARCHTYPE(CHAR_STR, eVecSize, true, false, false)>;
 		}
 
-		if (IsMatchCase() && IsWildcard()) {
-			return SearchFuncFwd<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, true)>;
+		if (fMatchCase) {
+			if (hss.vecData.size() == ullStep && ullStep <= 8) {
+				return fInverted ?
+					SearchFuncVecFwdLane<SEARCHTYPE(CHAR_STR, eVecSize, true, true, false, true)> :
+					SearchFuncVecFwdLane<SEARCHTYPE(CHAR_STR, eVecSize, true, true, false, false)>;
+			}
+
+			if (!fInverted) {
+				return SearchFuncVecFwdFilter<SEARCHTYPE(CHAR_STR, eVecSize, true, true, false)>;
+			}
+		}
+	}
+
+	constexpr auto uSizeLongMin { 16U }; //The same as in the IsLongSearch.
+	if (hss.vecData.size() >= uSizeLongMin && !fInverted) {
+		if (fMatchCase) {
+			return fUTF16 ? SearchFuncFwdLong<SEARCHTYPE(WCHAR_STR, eVecSize, true, true, false)> :
+				SearchFuncFwdLong<SEARCHTYPE(CHAR_STR, eVecSize, true, true, false)>;
+		}
+
+		if (!fUTF16) {
+			return SearchFuncFwdLong<SEARCHTYPE(CHAR_STR, eVecSize, true, false, false)>;
+		}
+	}
+
+	if (fUTF16) {
+		return fMatchCase ? SearchFuncFwd<SEARCHTYPE(WCHAR_STR, eVecSize, true, true, false)> :
+			SearchFuncFwd<SEARCHTYPE(WCHAR_STR, eVecSize, true, false, false)>;
+	}
+
+	return fMatchCase ? SearchFuncFwd<SEARCHTYPE(CHAR_STR, eVecSize, true, true, false)> :
+		SearchFuncFwd<SEARCHTYPE(CHAR_STR, eVecSize, true, false, false)>;
+}
+
+template<bool fDlgProg, CHexDlgSearch::EVecSize eVecSize>
+auto CHexDlgSearch::GetSearchFuncFwd()const->PtrSearchFunc
+{
+	//The `fDlgProg` arg ensures that no runtime check will be performed for the 
+	//'SEARCHFUNCDATA::pDlgProg == nullptr', at the hot path inside the SearchFunc function.
+
+	using enum ESearchType; using enum EMemCmp;
+
+	if (IsNumRange()) {
+		return GetSearchFuncNumRange<fDlgProg, eVecSize>(true);
+	}
+
+	if (IsIndexSearch()) {
+		return SearchFuncFwdIndex<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
+	}
+
+	if (IsFuzzy()) {
+		return SearchFuncFwdFuzzy<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, true)>;
+	}
+
+	if (IsHexWildcard()) { //Hex bytes with the byte and the nibble wildcards are compared under the mask.
+		return GetStep() == 1 && !IsInverted() ?
+			SearchFuncVecFwdMask<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, true)> :
+			SearchFuncFwdMask<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, true)>;
+	}
+
+	if (GetStep() == 1 && !IsWildcard()) {
+		const auto fText = GetSearchType() == TEXT_ASCII || GetSearchType() == TEXT_UTF16;
+		if (fText && !IsMatchCase()) { //Case insensitive text SIMD, for any data size.
+			if (!IsInverted()) {
+				return GetSearchType() == TEXT_ASCII ?
+					SearchFuncVecFwdFilter<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, false, false)> :
+					SearchFuncVecFwdFilter<SEARCHTYPE(WCHAR_STR, eVecSize, fDlgProg, false, false)>;
+			} //The inverted one is for the case folding functions below, not for the exact bytes ones.
+		}
+		else {
+			switch (GetSearchDataSize()) {
+			case 1: //Special case for 1 byte data size SIMD.
+				return IsInverted() ?
+					SearchFuncVecFwdByte1<SEARCHTYPE(DATA_BYTE1, eVecSize, fDlgProg, false, false, true)> :
+					SearchFuncVecFwdByte1<SEARCHTYPE(DATA_BYTE1, eVecSize, fDlgProg, false, false, false)>;
+			case 2: //Special case for 2 bytes data size SIMD.
+				return IsInverted() ?
+					SearchFuncVecFwdByte2<SEARCHTYPE(DATA_BYTE2, eVecSize, fDlgProg, false, false, true)> :
+					SearchFuncVecFwdByte2<SEARCHTYPE(DATA_BYTE2, eVecSize, fDlgProg, false, false, false)>;
+			case 4: //Special case for 4 bytes data size SIMD.
+				return IsInverted() ?
+					SearchFuncVecFwdByte4<SEARCHTYPE(DATA_BYTE4, eVecSize, fDlgProg, false, false, true)> :
+					SearchFuncVecFwdByte4<SEARCHTYPE(DATA_BYTE4, eVecSize, fDlgProg, false, false, false)>;
+			default: //SIMD filter by the first and the last bytes, for any other data size.
+				if (!IsInverted()) {
+					return SearchFuncVecFwdFilter<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
+				}
+				break;
+			};
+		}
+	}
+
+	if (const auto ullStep = GetStep(); (ullStep == 2 || ullStep == 4 || ullStep == 8 || ullStep == 16) && !IsWildcard()) {
+		//Strided SIMD, only the vector's offsets in line with the step are compared.
+		const auto fText = GetSearchType() == TEXT_ASCII || GetSearchType() == TEXT_UTF16;
+		if (fText && !IsMatchCase()) {
+			if (!IsInverted()) {
+				return GetSearchType() == TEXT_ASCII ?
+					SearchFuncVecFwdFilter<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, false, false)> :
+					SearchFuncVecFwdFilter<SEARCHTYPE(WCHAR_STR, eVecSize, fDlgProg, false, false)>;
+			}
+		}
+		else if (GetSearchDataSize() == ullStep && ullStep <= 8) { //Data fills the whole lane.
+			return IsInverted() ?
+				SearchFuncVecFwdLane<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false, true)> :
+				SearchFuncVecFwdLane<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false, false)>;
+		}
+		else if (!IsInverted()) {
+			return SearchFuncVecFwdFilter<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
+		}
+	}
+
+	if (IsLongSearch()) {
+		switch (GetSearchType()) {
+		case HEXBYTES:
+		case TEXT_UTF8:
+			return SearchFuncFwdLong<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
+		case TEXT_ASCII:
+			return IsMatchCase() ?
+				SearchFuncFwdLong<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)> :
+				SearchFuncFwdLong<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, false, false)>;
+		case TEXT_UTF16:
+			if (IsMatchCase()) {
+				return SearchFuncFwdLong<SEARCHTYPE(WCHAR_STR, eVecSize, fDlgProg, true, false)>;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	switch (GetSearchType()) {
+	case HEXBYTES:
+		return SearchFuncFwd<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
+	case TEXT_ASCII:
+		if (IsMatchCase() && !IsWildcard()) {
+			return SearchFuncFwd<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
+		}
+
+		if (IsMatchCase() && IsWildcard()) {
+			return SearchFuncFwd<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, true)>;
 		}
 
 		if (!IsMatchCase() && IsWildcard()) {
@@ -590,11 +1177,62 @@ auto CHexDlgSearch::GetSearchFuncBack()const->PtrSearchFunc
 	//'SEARCHFUNCDATA::pDlgProg == nullptr', at the hot path inside the SearchFunc function.
 	using enum ESearchType; using enum EMemCmp; using enum EVecSize;
 
+	if (IsNumRange()) {
+		return GetSearchFuncNumRange<fDlgProg, eVecSize>(false);
+	}
+
+	if (IsIndexSearch()) {
+		return SearchFuncBackIndex<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
+	}
+
+	if (IsFuzzy()) {
+		return SearchFuncBackFuzzy<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, true)>;
+	}
+
+	if (IsHexWildcard()) { //Hex bytes with the byte and the nibble wildcards are compared under the mask.
+		return GetStep() == 1 && !IsInverted() ?
+			SearchFuncVecBackMask<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, true)> :
+			SearchFuncBackMask<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, true)>;
+	}
+
+	//SIMD filter by the first and the last bytes, for any data size.
+	if (GetStep() == 1 && !IsWildcard() && !IsInverted()) {
+		if (!IsMatchCase()) {
+			switch (GetSearchType()) {
+			case TEXT_ASCII:
+				return SearchFuncVecBackFilter<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, false, false)>;
+			case TEXT_UTF16:
+				return SearchFuncVecBackFilter<SEARCHTYPE(WCHAR_STR, eVecSize, fDlgProg, false, false)>;
+			default:
+				break;
+			}
+		}
+
+		return SearchFuncVecBackFilter<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
+	}
+
+	if (IsLongSearch()) {
+		switch (GetSearchType()) {
+		case HEXBYTES:
+		case TEXT_UTF8:
+			return SearchFuncBackLong<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
+		case TEXT_ASCII:
+			return IsMatchCase() ?
+				SearchFuncBackLong<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)> :
+				SearchFuncBackLong<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, false, false)>;
+		case TEXT_UTF16:
+			if (IsMatchCase()) {
+				return SearchFuncBackLong<SEARCHTYPE(WCHAR_STR, eVecSize, fDlgProg, true, false)>;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
 	switch (GetSearchType()) {
 	case HEXBYTES:
-		return IsWildcard() ?
-			SearchFuncBack<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, true)> :
-			SearchFuncBack<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
+		return SearchFuncBack<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
 	case TEXT_ASCII:
 		if (IsMatchCase() && !IsWildcard()) {
 			return SearchFuncBack<SEARCHTYPE(CHAR_STR, eVecSize, fDlgProg, true, false)>;
@@ -653,6 +1291,50 @@ auto CHexDlgSearch::GetSearchFuncBack()const->PtrSearchFunc
 	return { };
 }
 
+template<bool fDlgProg, CHexDlgSearch::EVecSize eVecSize>
+auto CHexDlgSearch::GetSearchFuncNumRange(bool fFwd)const->PtrSearchFunc
+{
+	//SIMD is for the steps that the number's size is a multiple of, a vector is loaded at sizeof(T) / step offsets.
+	const auto lmbSearchFunc = [this, fFwd]<typename T>(std::type_identity<T>)->PtrSearchFunc {
+		using enum EMemCmp;
+		constexpr auto stType = SEARCHTYPE(sizeof(T) == sizeof(std::uint8_t) ? DATA_BYTE1 : (sizeof(T) == sizeof(std::uint16_t) ?
+			DATA_BYTE2 : (sizeof(T) == sizeof(std::uint32_t) ? DATA_BYTE4 : DATA_BYTE8)), eVecSize, fDlgProg);
+		const auto ullStep = GetStep();
+		const auto fVec = ullStep <= sizeof(T) && (sizeof(T) % ullStep) == 0 && !IsInverted();
+		if (fFwd) {
+			return fVec ? SearchFuncVecFwdNumRange<stType, T> : SearchFuncFwdNumRange<stType, T>;
+		}
+
+		return fVec ? SearchFuncVecBackNumRange<stType, T> : SearchFuncBackNumRange<stType, T>;
+		};
+
+	using enum ESearchType;
+	switch (GetSearchType()) {
+	case NUM_INT8:
+		return lmbSearchFunc(std::type_identity<std::int8_t> { });
+	case NUM_UINT8:
+		return lmbSearchFunc(std::type_identity<std::uint8_t> { });
+	case NUM_INT16:
+		return lmbSearchFunc(std::type_identity<std::int16_t> { });
+	case NUM_UINT16:
+		return lmbSearchFunc(std::type_identity<std::uint16_t> { });
+	case NUM_INT32:
+		return lmbSearchFunc(std::type_identity<std::int32_t> { });
+	case NUM_UINT32:
+		return lmbSearchFunc(std::type_identity<std::uint32_t> { });
+	case NUM_INT64:
+		return lmbSearchFunc(std::type_identity<std::int64_t> { });
+	case NUM_UINT64:
+		return lmbSearchFunc(std::type_identity<std::uint64_t> { });
+	case NUM_FLOAT:
+		return lmbSearchFunc(std::type_identity<float> { });
+	case NUM_DOUBLE:
+		return lmbSearchFunc(std::type_identity<double> { });
+	default:
+		return { };
+	}
+}
+
 auto CHexDlgSearch::GetSearchMode()const->CHexDlgSearch::ESearchMode
 {
 	return static_cast<ESearchMode>(m_WndCmbMode.GetItemData(m_WndCmbMode.GetCurSel()));
@@ -675,6 +1357,10 @@ auto CHexDlgSearch::GetSearchType()const->ESearchType
 		return ESearchType::HEXBYTES;
 	}
 
+	if (GetSearchMode() == ESearchMode::MODE_REGEX) {
+		return ESearchType::REGEX;
+	}
+
 	return static_cast<ESearchType>(m_WndCmbType.GetItemData(m_WndCmbType.GetCurSel()));
 }
 
@@ -708,6 +1394,13 @@ bool CHexDlgSearch::IsBigEndian()const
 	return m_WndBtnBE.IsChecked();
 }
 
+bool CHexDlgSearch::IsCacheable()const
+{
+	//The regex occurrences' size is not fixed, the modified data may change the occurrences far before it.
+	//The VirtualData may be changed by its owner, not only by the ModifyData.
+	return m_pSearchCache != nullptr && !IsRegex() && !GetHexCtrl()->IsVirtual();
+}
+
 bool CHexDlgSearch::IsForward()const
 {
 	return m_fForward;
@@ -718,9 +1411,35 @@ bool CHexDlgSearch::IsFreshSearch()const
 	return m_fFreshSearch;
 }
 
+bool CHexDlgSearch::IsFuzzy()const
+{
+	return GetSearchType() == ESearchType::HEXBYTES && m_dwMismatch > 0;
+}
+
+bool CHexDlgSearch::IsHexWildcard()const
+{
+	return GetSearchType() == ESearchType::HEXBYTES && IsWildcard();
+}
+
+bool CHexDlgSearch::IsIndexSearch()const
+{
+	//Case insensitive text is not byte exact.
+	using enum ESearchType;
+	const auto eType = GetSearchType();
+	return m_pSearchIndex != nullptr && m_pSearchIndex->IsUsable(GetSearchDataSize()) && !IsWildcard() && !IsInverted()
+		&& !IsRegex() && !IsFuzzy() && !IsNumRange() && (IsMatchCase() || (eType != TEXT_ASCII && eType != TEXT_UTF16));
+}
+
 bool CHexDlgSearch::IsInverted()const
 {
-	return m_WndBtnInv.IsChecked();
+	return m_WndBtnInv.IsWindowEnabled() && m_WndBtnInv.IsChecked();
+}
+
+bool CHexDlgSearch::IsLongSearch()const
+{
+	//Shifts are only as good as the search data is long, and wildcards match any byte.
+	constexpr auto uSizeLongMin { 16U };
+	return GetSearchDataSize() >= uSizeLongMin && !IsWildcard() && !IsInverted() && !IsRegex() && !IsFuzzy();
 }
 
 bool CHexDlgSearch::IsMatchCase()const
@@ -733,6 +1452,16 @@ bool CHexDlgSearch::IsNoEsc()const
 	return m_u64Flags & HEXCTRL_FLAG_DLG_NOESC;
 }
 
+bool CHexDlgSearch::IsNumRange()const
+{
+	return GetSearchMode() == ESearchMode::MODE_NUMBERS && m_fNumRange;
+}
+
+bool CHexDlgSearch::IsRegex()const
+{
+	return GetSearchMode() == ESearchMode::MODE_REGEX;
+}
+
 bool CHexDlgSearch::IsReplace()const
 {
 	return m_fReplace;
@@ -773,6 +1502,7 @@ void CHexDlgSearch::OnButtonSearchF()
 	m_fForward = true;
 	m_fReplace = false;
 	m_fAll = false;
+	m_fCount = false;
 	Prepare();
 }
 
@@ -781,6 +1511,7 @@ void CHexDlgSearch::OnButtonSearchB()
 	m_fForward = false;
 	m_fReplace = false;
 	m_fAll = false;
+	m_fCount = false;
 	Prepare();
 }
 
@@ -789,6 +1520,16 @@ void CHexDlgSearch::OnButtonFindAll()
 	m_fForward = true;
 	m_fReplace = false;
 	m_fAll = true;
+	m_fCount = false;
+	Prepare();
+}
+
+void CHexDlgSearch::OnButtonCountAll()
+{
+	m_fForward = true;
+	m_fReplace = false;
+	m_fAll = true;
+	m_fCount = true;
 	Prepare();
 }
 
@@ -797,6 +1538,7 @@ void CHexDlgSearch::OnButtonReplace()
 	m_fForward = true;
 	m_fReplace = true;
 	m_fAll = false;
+	m_fCount = false;
 	Prepare();
 }
 
@@ -805,6 +1547,7 @@ void CHexDlgSearch::OnButtonReplaceAll()
 	m_fForward = true;
 	m_fReplace = true;
 	m_fAll = true;
+	m_fCount = false;
 	Prepare();
 }
 
@@ -838,6 +1581,8 @@ void CHexDlgSearch::OnComboModeSelChange()
 	}
 
 	using enum ESearchMode;
+	m_WndBtnInv.EnableWindow(eMode != MODE_REGEX); //Regex has its own negated classes.
+	m_WndEditMismatch.EnableWindow(eMode == MODE_HEXBYTES); //Mismatches are counted in the whole bytes.
 	switch (eMode) {
 	case MODE_HEXBYTES:
 		OnSelectModeHEXBYTES();
@@ -851,6 +1596,9 @@ void CHexDlgSearch::OnComboModeSelChange()
 	case MODE_STRUCT:
 		OnSelectModeSTRUCT();
 		break;
+	case MODE_REGEX:
+		OnSelectModeREGEX();
+		break;
 	default:
 		break;
 	}
@@ -882,6 +1630,26 @@ void CHexDlgSearch::OnComboTypeSelChange()
 		m_WndBtnMC.EnableWindow(false);
 		m_WndBtnWC.EnableWindow(false);
 		break;
+	case REGEX:
+		m_WndCmbFind.SetCueBanner(LR"(e.g. [\x00-\x1F]{4,}MZ.{58}PE)");
+		m_WndCmbReplace.SetCueBanner(L"Hex bytes");
+		break;
+	case NUM_FLOAT:
+	case NUM_DOUBLE:
+		m_WndCmbFind.SetCueBanner(L"e.g. 3.14, or 3.1..3.2, or 3.14 ~0.01, or 3.14 ~1%");
+		m_WndCmbReplace.SetCueBanner(L"");
+		break;
+	case NUM_INT8:
+	case NUM_UINT8:
+	case NUM_INT16:
+	case NUM_UINT16:
+	case NUM_INT32:
+	case NUM_UINT32:
+	case NUM_INT64:
+	case NUM_UINT64:
+		m_WndCmbFind.SetCueBanner(L"e.g. 1500, or 1000..2000, or 1500 ~500");
+		m_WndCmbReplace.SetCueBanner(L"");
+		break;
 	default:
 		m_WndCmbFind.SetCueBanner(L"");
 		m_WndCmbReplace.SetCueBanner(L"");
@@ -904,6 +1672,7 @@ auto CHexDlgSearch::OnCommand(const MSG& msg)->INT_PTR
 		case IDC_HEXCTRL_SEARCH_BTN_SEARCHF: OnButtonSearchF(); break;
 		case IDC_HEXCTRL_SEARCH_BTN_SEARCHB: OnButtonSearchB(); break;
 		case IDC_HEXCTRL_SEARCH_BTN_FINDALL: OnButtonFindAll(); break;
+		case IDC_HEXCTRL_SEARCH_BTN_COUNTALL: OnButtonCountAll(); break;
 		case IDC_HEXCTRL_SEARCH_BTN_REPL: OnButtonReplace(); break;
 		case IDC_HEXCTRL_SEARCH_BTN_REPLALL: OnButtonReplaceAll(); break;
 		case IDC_HEXCTRL_SEARCH_CHK_SEL: OnCheckSel(); break;
@@ -921,8 +1690,8 @@ auto CHexDlgSearch::OnCommand(const MSG& msg)->INT_PTR
 			int nItem { -1 };
 			for (auto i = 0UL; i < m_ListEx.GetSelectedCount(); ++i) {
 				nItem = m_ListEx.GetNextItem(nItem, LVNI_SELECTED);
-				const HEXBKM hbs { .vecSpan { HEXSPAN { m_vecSearchRes.at(static_cast<std::size_t>(nItem)),
-					m_fReplace ? m_vecReplaceData.size() : m_vecSearchData.size() } }, .wstrDesc { m_wstrSearch },
+				const auto ullOffset = m_SearchRes[static_cast<std::size_t>(nItem)];
+				const HEXBKM hbs { .vecSpan { HEXSPAN { ullOffset, GetFoundSize(ullOffset) } }, .wstrDesc { m_wstrSearch },
 					.stClr { GetHexCtrl()->GetColors().clrBkBkm, GetHexCtrl()->GetColors().clrFontBkm } };
 				GetHexCtrl()->GetBookmarks()->AddBkm(hbs, false);
 			}
@@ -956,8 +1725,9 @@ auto CHexDlgSearch::OnCtlClrStatic(const MSG& msg)->INT_PTR
 auto CHexDlgSearch::OnDestroy()->INT_PTR
 {
 	m_MenuList.DestroyMenu();
-	m_vecSearchRes.clear();
+	m_SearchRes.Clear();
 	m_vecSearchData.clear();
+	m_vecSearchMask.clear();
 	m_vecReplaceData.clear();
 	m_wstrSearch.clear();
 	m_wstrReplace.clear();
@@ -995,6 +1765,7 @@ auto CHexDlgSearch::OnInitDialog(const MSG& msg)->INT_PTR
 	m_WndEditRngBegin.Attach(m_Wnd.GetDlgItem(IDC_HEXCTRL_SEARCH_EDIT_RNGBEG));
 	m_WndEditRngEnd.Attach(m_Wnd.GetDlgItem(IDC_HEXCTRL_SEARCH_EDIT_RNGEND));
 	m_WndEditLimit.Attach(m_Wnd.GetDlgItem(IDC_HEXCTRL_SEARCH_EDIT_LIMIT));
+	m_WndEditMismatch.Attach(m_Wnd.GetDlgItem(IDC_HEXCTRL_SEARCH_EDIT_MISMATCH));
 
 	constexpr auto iTextLimit { 512 };
 	m_WndCmbFind.LimitText(iTextLimit);
@@ -1009,6 +1780,8 @@ auto CHexDlgSearch::OnInitDialog(const MSG& msg)->INT_PTR
 	m_WndCmbMode.SetItemData(iIndex, static_cast<DWORD_PTR>(ESearchMode::MODE_NUMBERS));
 	iIndex = m_WndCmbMode.AddString(L"Structs");
 	m_WndCmbMode.SetItemData(iIndex, static_cast<DWORD_PTR>(ESearchMode::MODE_STRUCT));
+	iIndex = m_WndCmbMode.AddString(L"Regex");
+	m_WndCmbMode.SetItemData(iIndex, static_cast<DWORD_PTR>(ESearchMode::MODE_REGEX));
 
 	m_ListEx.Create({ .hWndParent { m_Wnd }, .uID { IDC_HEXCTRL_SEARCH_LIST }, .dwSizeFontList { 10 },
 		.dwSizeFontHdr { 10 }, .fDialogCtrl { true } });
@@ -1024,6 +1797,7 @@ auto CHexDlgSearch::OnInitDialog(const MSG& msg)->INT_PTR
 
 	m_WndEditStep.SetWndText(std::format(L"{}", GetStep())); //"Step" edit box text.
 	m_WndEditLimit.SetWndText(std::format(L"{}", m_dwLimit).data()); //"Limit search hits" edit box text.
+	m_WndEditMismatch.SetWndText(std::format(L"{}", m_dwMismatch).data()); //"Mismatches" edit box text.
 	m_WndEditRngBegin.SetCueBanner(L"range begin");
 	m_WndEditRngEnd.SetCueBanner(L"range end");
 
@@ -1042,9 +1816,10 @@ auto CHexDlgSearch::OnInitDialog(const MSG& msg)->INT_PTR
 	std::wstring wstrToolText;
 	wstrToolText += L"Use ";
 	wstrToolText += static_cast<wchar_t>(m_uWildcard);
-	wstrToolText += L" character to match any symbol, or any byte if in \"Hex Bytes\" search mode.\r\n";
+	wstrToolText += L" character to match any symbol, or any half-byte (nibble) if in \"Hex Bytes\" search mode.\r\n";
 	wstrToolText += L"Example:\r\n";
-	wstrToolText += L"  Hex Bytes: 11?11 will match: 112211, 113311, 114411, 119711, etc...\r\n";
+	wstrToolText += L"  Hex Bytes: 11??11 will match: 112211, 113311, 114411, 119711, etc...\r\n";
+	wstrToolText += L"  Hex Bytes: 48 8B ?? 4? will match: 488B0040, 488B1741, 488BFF4F, etc...\r\n";
 	wstrToolText += L"  ASCII Text: sa??le will match: sample, saAAle, saxale, saZble, etc...\r\n";
 	stToolInfo.lpszText = wstrToolText.data();
 	::SendMessageW(hwndTipWC, TTM_ADDTOOLW, 0, reinterpret_cast<LPARAM>(&stToolInfo));
@@ -1108,7 +1883,7 @@ void CHexDlgSearch::OnNotifyListGetDispInfo(NMHDR* pNMHDR)
 		*std::format_to(pItem->pszText, L"{}", iItem + 1) = L'\0';
 		break;
 	case 1: //Offset.
-		*std::format_to(pItem->pszText, L"0x{:X}", GetHexCtrl()->GetOffset(m_vecSearchRes[iItem], true)) = L'\0';
+		*std::format_to(pItem->pszText, L"0x{:X}", GetHexCtrl()->GetOffset(m_SearchRes[iItem], true)) = L'\0';
 		break;
 	default:
 		break;
@@ -1129,13 +1904,13 @@ void CHexDlgSearch::OnNotifyListItemChanged(NMHDR* pNMHDR)
 		//Do not yet add selected (clicked) item (in multiselect), will add it after the loop,
 		//so that it's always last in the vecSpan to highlight it in HexCtrlHighlight.
 		if (pNMI->iItem != nItem) {
-			vecSpan.emplace_back(m_vecSearchRes.at(static_cast<std::size_t>(nItem)),
-				m_fReplace ? m_vecReplaceData.size() : m_vecSearchData.size());
+			const auto ullOffsetItem = m_SearchRes[static_cast<std::size_t>(nItem)];
+			vecSpan.emplace_back(ullOffsetItem, GetFoundSize(ullOffsetItem));
 		}
 	}
 
-	const auto ullOffset = m_vecSearchRes[static_cast<std::size_t>(pNMI->iItem)];
-	vecSpan.emplace_back(ullOffset, m_fReplace ? m_vecReplaceData.size() : m_vecSearchData.size());
+	const auto ullOffset = m_SearchRes[static_cast<std::size_t>(pNMI->iItem)];
+	vecSpan.emplace_back(ullOffset, GetFoundSize(ullOffset));
 	HexCtrlHighlight(vecSpan);
 	SetEditStartFrom(GetHexCtrl()->GetOffset(ullOffset, true)); //Show virtual offset.
 	m_ullStartFrom = ullOffset;
@@ -1199,6 +1974,15 @@ void CHexDlgSearch::OnSelectModeNUMBERS()
 	m_WndBtnWC.EnableWindow(false);
 }
 
+void CHexDlgSearch::OnSelectModeREGEX()
+{
+	ClearComboType();
+	m_WndCmbType.EnableWindow(false);
+	m_WndBtnBE.EnableWindow(false);
+	m_WndBtnMC.EnableWindow(true);
+	m_WndBtnWC.EnableWindow(false);
+}
+
 void CHexDlgSearch::OnSelectModeSTRUCT()
 {
 	ClearComboType();
@@ -1228,6 +2012,77 @@ void CHexDlgSearch::OnSearchModeTEXT()
 	m_WndBtnBE.EnableWindow(false);
 }
 
+bool CHexDlgSearch::PatchCached(CHexSearchCache::CACHED& refCached)const
+{
+	//Offsets whose occurrence's data intersects a modified span are searched again, the others are kept.
+	const auto ullSizeFind = static_cast<ULONGLONG>(GetSearchDataSize());
+	const auto ullFirst = refCached.ullFirst;
+	const auto ullLast = GetLastSearchOffset();
+	const auto ullStep = GetStep();
+	VecSpan vecWnd; //Offsets to search again, in line with the step.
+	ULONGLONG ullWndTotal { 0 };
+	for (const auto& hss : refCached.vecDirty) {
+		auto ullWndFirst = (std::max)(ullFirst, hss.ullOffset >= ullSizeFind - 1 ? hss.ullOffset - (ullSizeFind - 1) : 0ULL);
+		ullWndFirst += (ullStep - ((ullWndFirst - ullFirst) % ullStep)) % ullStep;
+		const auto ullWndLast = (std::min)(ullLast, hss.ullOffset + hss.ullSize - 1);
+		if (ullWndFirst > ullWndLast || ullWndFirst < ullFirst) //Also the step's overflow.
+			continue;
+
+		if (!vecWnd.empty() && ullWndFirst <= vecWnd.back().ullOffset + vecWnd.back().ullSize - 1) {
+			ullWndTotal -= vecWnd.back().ullSize;
+			vecWnd.back().ullSize = (std::max)(vecWnd.back().ullOffset + vecWnd.back().ullSize - 1, ullWndLast) - vecWnd.back().ullOffset + 1;
+		}
+		else {
+			vecWnd.emplace_back(ullWndFirst, ullWndLast - ullWndFirst + 1);
+		}
+		ullWndTotal += vecWnd.back().ullSize;
+	}
+
+	//Searching through the big modified data is no faster than searching everything.
+	if (ullWndTotal > (ullLast - ullFirst) / 16)
+		return false;
+
+	const auto pSearchFunc = GetSearchFunc(true, false);
+	auto stFuncData = CreateSearchData();
+	if (IsLongSearch()) {
+		CalcShifts(stFuncData, true);
+	}
+
+	const auto& refResOld = refCached.Res;
+	CHexSearchResult Res;
+	std::size_t sIndexOld { 0 };
+	for (const auto& hssWnd : vecWnd) {
+		const auto ullWndLast = hssWnd.ullOffset + hssWnd.ullSize - 1;
+		for (const auto sIndexEnd = refResOld.LowerBound(hssWnd.ullOffset); sIndexOld < sIndexEnd; ++sIndexOld) {
+			Res.Append(refResOld[sIndexOld]);
+		}
+		sIndexOld = ullWndLast == ullLast ? refResOld.Size() : refResOld.LowerBound(ullWndLast + 1);
+
+		stFuncData.ullStartFrom = hssWnd.ullOffset;
+		stFuncData.ullRngEnd = ullWndLast + (ullSizeFind - 1);
+		while (true) {
+			CalcMemChunks(stFuncData, true);
+			const auto findRes = pSearchFunc(stFuncData);
+			if (!findRes)
+				break;
+
+			Res.Append(findRes.ullOffset);
+			if (ullStep > ullWndLast - findRes.ullOffset)
+				break;
+
+			stFuncData.ullStartFrom = findRes.ullOffset + ullStep;
+		}
+	}
+	for (; sIndexOld < refResOld.Size(); ++sIndexOld) {
+		Res.Append(refResOld[sIndexOld]);
+	}
+
+	refCached.Res = std::move(Res);
+	refCached.vecDirty.clear();
+
+	return true;
+}
+
 void CHexDlgSearch::Prepare()
 {
 	if (!m_Wnd.IsWindow())
@@ -1270,6 +2125,9 @@ void CHexDlgSearch::Prepare()
 	case ESearchMode::MODE_HEXBYTES:
 		fSuccess = PrepareHexBytes();
 		break;
+	case ESearchMode::MODE_REGEX:
+		fSuccess = PrepareRegex();
+		break;
 	default:
 		using enum ESearchType;
 		switch (GetSearchType()) {
@@ -1457,6 +2315,20 @@ void CHexDlgSearch::Prepare()
 		return;
 	}
 
+	//"Mismatches", an empty box is the exact search.
+	DWORD dwMismatch { };
+	if (m_WndEditMismatch.IsWindowEnabled() && !m_WndEditMismatch.IsWndTextEmpty()) {
+		if (const auto optMismatch = stn::StrToUInt32(m_WndEditMismatch.GetWndText());
+			optMismatch && *optMismatch < GetSearchDataSize()) {
+			dwMismatch = *optMismatch;
+		}
+		else {
+			m_WndEditMismatch.SetFocus();
+			MessageBoxW(m_Wnd, L"Mismatches must be less than the search data size.", L"Incorrect mismatches", MB_ICONERROR);
+			return;
+		}
+	}
+
 	if (IsReplace() && GetReplaceDataSize() > GetSearchDataSize()) {
 		static constexpr auto wstrReplaceWarning { L"The replacing data is longer than search data.\r\n"
 			"Do you want to overwrite bytes following search occurrence?\r\nChoosing No will cancel replace." };
@@ -1469,6 +2341,10 @@ void CHexDlgSearch::Prepare()
 	m_ullStartFrom = ullStartFrom;
 	m_ullStep = ullStep;
 	m_dwLimit = dwLimit;
+	if (dwMismatch != m_dwMismatch) {
+		ResetSearch();
+		m_dwMismatch = dwMismatch;
+	}
 
 	Search();
 	m_Wnd.SetActiveWindow();
@@ -1477,14 +2353,16 @@ void CHexDlgSearch::Prepare()
 bool CHexDlgSearch::PrepareHexBytes()
 {
 	static constexpr auto pwszWrongInput { L"Unacceptable input character.\r\nAllowed characters are: 0123456789AaBbCcDdEeFf" };
-	auto optData = ut::NumStrToHex(m_wstrSearch, IsWildcard() ? static_cast<char>(m_uWildcard) : 0);
-	if (!optData) {
+	auto optBytes = ut::HexStrToBytes(m_wstrSearch, IsWildcard() ? static_cast<wchar_t>(m_uWildcard) : 0);
+	if (!optBytes) {
 		m_iWrap = 1;
 		MessageBoxW(m_Wnd, pwszWrongInput, L"Error", MB_OK | MB_ICONERROR | MB_TOPMOST);
 		return false;
 	}
 
-	m_vecSearchData = ut::RangeToVecBytes(*optData);
+	//Wildcard nibbles are zeroed in the search data, and the mask tells which bits to compare.
+	m_vecSearchData = std::move(optBytes->vecData);
+	m_vecSearchMask = std::move(optBytes->vecMask);
 
 	if (m_fReplace) {
 		auto optDataRepl = ut::NumStrToHex(m_wstrReplace);
@@ -1500,6 +2378,30 @@ bool CHexDlgSearch::PrepareHexBytes()
 	return true;
 }
 
+bool CHexDlgSearch::PrepareRegex()
+{
+	if (!m_Regex.Compile(m_wstrSearch, IsMatchCase())) {
+		m_iWrap = 1;
+		MessageBoxW(m_Wnd, m_Regex.GetError().data(), L"Error", MB_OK | MB_ICONERROR | MB_TOPMOST);
+		return false;
+	}
+
+	m_vecSearchData.clear();
+
+	if (m_fReplace) { //Replace data is hex bytes, it overwrites the data from the beginning of the match.
+		auto optDataRepl = ut::NumStrToHex(m_wstrReplace);
+		if (!optDataRepl) {
+			MessageBoxW(m_Wnd, m_pwszWrongInput, L"Error", MB_OK | MB_ICONERROR | MB_TOPMOST);
+			m_WndCmbReplace.SetFocus();
+			return false;
+		}
+
+		m_vecReplaceData = ut::RangeToVecBytes(*optDataRepl);
+	}
+
+	return true;
+}
+
 bool CHexDlgSearch::PrepareTextASCII()
 {
 	auto strSearch = ut::WstrToStr(m_wstrSearch, CP_ACP); //Convert to the system default Windows ANSI code page.
@@ -1539,13 +2441,69 @@ bool CHexDlgSearch::PrepareTextUTF8()
 template<typename T> requires ut::TSize1248<T>
 bool CHexDlgSearch::PrepareNumber()
 {
-	const auto optData = stn::StrToNum<T>(m_wstrSearch);
+	//"Min..Max" is the range, "Number ~Tolerance" is the absolute tolerance,
+	//and "Number ~Tolerance%" is the relative one, for the floating point numbers only.
+	auto wstrSearch = m_wstrSearch;
+	std::erase(wstrSearch, L' ');
+	std::optional<T> optData;
+	T tMin { };
+	T tMax { };
+	m_fNumRange = false;
+
+	if (const auto nPosRange = wstrSearch.find(L".."); nPosRange != std::wstring::npos) {
+		const auto optMin = stn::StrToNum<T>(std::wstring_view { wstrSearch }.substr(0, nPosRange));
+		const auto optMax = stn::StrToNum<T>(std::wstring_view { wstrSearch }.substr(nPosRange + 2));
+		if (optMin && optMax && *optMin <= *optMax) {
+			tMin = *optMin;
+			tMax = *optMax;
+			optData = tMin;
+			m_fNumRange = true;
+		}
+	}
+	else if (const auto nPosTol = wstrSearch.find(L'~'); nPosTol != std::wstring::npos) {
+		auto wsvTol = std::wstring_view { wstrSearch }.substr(nPosTol + 1);
+		const auto fRelative = wsvTol.ends_with(L'%');
+		if (fRelative) {
+			wsvTol.remove_suffix(1);
+		}
+
+		const auto optNum = stn::StrToNum<T>(std::wstring_view { wstrSearch }.substr(0, nPosTol));
+		const auto optTol = stn::StrToNum<T>(wsvTol);
+		if (optNum && optTol && *optTol >= T { }) {
+			if constexpr (std::is_floating_point_v<T>) {
+				const auto tTol = fRelative ? std::abs(*optNum) * *optTol / 100 : *optTol;
+				tMin = *optNum - tTol;
+				tMax = *optNum + tTol;
+				if (!std::isnan(tMin) && !std::isnan(tMax)) {
+					optData = *optNum;
+					m_fNumRange = true;
+				}
+			}
+			else if (!fRelative) { //Saturated at the type's limits.
+				constexpr auto tLowest = (std::numeric_limits<T>::lowest)();
+				constexpr auto tHighest = (std::numeric_limits<T>::max)();
+				tMin = *optNum >= static_cast<T>(tLowest + *optTol) ? static_cast<T>(*optNum - *optTol) : tLowest;
+				tMax = *optNum <= static_cast<T>(tHighest - *optTol) ? static_cast<T>(*optNum + *optTol) : tHighest;
+				optData = *optNum;
+				m_fNumRange = true;
+			}
+		}
+	}
+	else {
+		optData = stn::StrToNum<T>(wstrSearch);
+	}
+
 	if (!optData) {
 		m_WndCmbFind.SetFocus();
 		MessageBoxW(m_Wnd, m_pwszWrongInput, L"Error", MB_OK | MB_ICONERROR | MB_TOPMOST);
 		return false;
 	}
 
+	if (m_fNumRange) { //Bounds are in the native byte order, the data is swapped at the search time.
+		std::copy_n(reinterpret_cast<const std::byte*>(&tMin), sizeof(T), m_arrNumMin.begin());
+		std::copy_n(reinterpret_cast<const std::byte*>(&tMax), sizeof(T), m_arrNumMax.begin());
+	}
+
 	T tData = *optData;
 	T tDataRep { };
 
@@ -1605,17 +2563,33 @@ bool CHexDlgSearch::PrepareFILETIME()
 	return true;
 }
 
+void CHexDlgSearch::PutCached(CHexSearchCache::CACHED&& refCached)
+{
+	m_pSearchCache->Put(GetCacheKey(), std::move(refCached));
+}
+
+void CHexDlgSearch::RemoveSearchAsync(CHexSearchAsync* pSearch)const
+{
+	const std::scoped_lock lock(m_mtxSearchAsync);
+	std::erase(m_vecSearchAsync, pSearch);
+}
+
 void CHexDlgSearch::ReplaceAll()
 {
 	ClearList();
 	m_dwCount = 0;
 	m_dwReplaced = 0;
 
+	//All the occurrences are found first, and then replaced at once, with one ModifyData call and one Undo snapshot.
+	//Replacing doesn't change the data the next occurrences are found in, they're searched from past the replaced data.
+	VecSpan vecSpan;
 	if (IsSmallSearch()) {
 		const auto pSearchFunc = GetSearchFunc(true, false);
 		auto stFuncData = CreateSearchData();
+		CHexReader reader(GetHexCtrl(), GetRngStart(), GetRngEnd());
+		stFuncData.pReader = &reader;
 		auto lmbWrapper = [&]()mutable->FINDRESULT {
-			CalcMemChunks(stFuncData);
+			CalcMemChunks(stFuncData, IsForward());
 			return pSearchFunc(stFuncData);
 			};
 
@@ -1624,12 +2598,12 @@ void CHexDlgSearch::ReplaceAll()
 			if (findRes.ullOffset + sSizeRepl > GetSentinel())
 				break;
 
-			Replace(stFuncData.pHexCtrl, findRes.ullOffset, GetReplaceSpan());
-			m_vecSearchRes.emplace_back(findRes.ullOffset); //Filling the vector of Found occurences.
+			vecSpan.emplace_back(findRes.ullOffset, sSizeRepl);
+			m_SearchRes.Append(findRes.ullOffset); //Filling the Found occurences.
 
 			const auto ullNext = findRes.ullOffset + (sSizeRepl <= stFuncData.ullStep ?
 				stFuncData.ullStep : sSizeRepl);
-			if (ullNext > GetLastSearchOffset() || m_vecSearchRes.size() >= m_dwLimit) {
+			if (ullNext > GetLastSearchOffset() || m_SearchRes.Size() >= m_dwLimit) {
 				break;
 			}
 
@@ -1641,8 +2615,10 @@ void CHexDlgSearch::ReplaceAll()
 		CHexDlgProgress dlgProg(L"Replacing...", L"Replaced: ", GetStartFrom(), GetLastSearchOffset());
 		const auto lmbReplaceAllThread = [&]() {
 			auto stFuncData = CreateSearchData(&dlgProg);
+			CHexReader reader(GetHexCtrl(), GetRngStart(), GetRngEnd());
+			stFuncData.pReader = &reader;
 			auto lmbWrapper = [&]()mutable->FINDRESULT {
-				CalcMemChunks(stFuncData);
+				CalcMemChunks(stFuncData, IsForward());
 				return pSearchFunc(stFuncData);
 				};
 
@@ -1651,14 +2627,14 @@ void CHexDlgSearch::ReplaceAll()
 				if (findRes.ullOffset + sSizeRepl > GetSentinel())
 					break;
 
-				Replace(stFuncData.pHexCtrl, findRes.ullOffset, m_vecReplaceData);
-				m_vecSearchRes.emplace_back(findRes.ullOffset); //Filling the vector of Replaced occurences.
+				vecSpan.emplace_back(findRes.ullOffset, sSizeRepl);
+				m_SearchRes.Append(findRes.ullOffset); //Filling the Replaced occurences.
 				dlgProg.SetCurrent(findRes.ullOffset);
-				dlgProg.SetCount(m_vecSearchRes.size());
+				dlgProg.SetCount(m_SearchRes.Size());
 
 				const auto ullNext = findRes.ullOffset + (sSizeRepl <= stFuncData.ullStep ?
 					stFuncData.ullStep : sSizeRepl);
-				if (ullNext > GetLastSearchOffset() || m_vecSearchRes.size() >= m_dwLimit
+				if (ullNext > GetLastSearchOffset() || m_SearchRes.Size() >= m_dwLimit
 					|| dlgProg.IsCanceled()) {
 					break;
 				}
@@ -1673,11 +2649,24 @@ void CHexDlgSearch::ReplaceAll()
 		thrd.join();
 	}
 
-	if (!m_vecSearchRes.empty()) {
+	//The too big modification has no Undo snapshot, it's replaced only if the user agrees.
+	if (static_cast<ULONGLONG>(vecSpan.size()) * m_vecReplaceData.size() > ut::g_ullUndoSizeMax
+		&& MessageBoxW(m_Wnd, L"The replaced data is too big to be undone.\r\nReplace anyway?",
+			L"Replace all?", MB_YESNO | MB_ICONWARNING) == IDNO) {
+		vecSpan.clear();
+	}
+
+	if (!vecSpan.empty()) { //The spans are all of the replace data size, so the repeat mode just copies it.
+		m_dwReplaced = static_cast<DWORD>(vecSpan.size());
+		GetHexCtrl()->ModifyData({ .eModifyMode { EHexModifyMode::MODIFY_REPEAT }, .spnData { GetReplaceSpan() },
+			.vecSpan { std::move(vecSpan) } });
+	}
+
+	if (!m_SearchRes.Empty()) {
 		m_fFound = true;
-		m_dwCount = m_dwReplaced = static_cast<DWORD>(m_vecSearchRes.size());
+		m_dwCount = static_cast<DWORD>(m_SearchRes.Size());
 	}
-	m_ListEx.SetItemCountEx(static_cast<int>(m_vecSearchRes.size()));
+	SetListCount();
 }
 
 void CHexDlgSearch::ResetSearch()
@@ -1740,6 +2729,9 @@ void CHexDlgSearch::Search()
 				m_dwReplaced = 0;
 				GetHexCtrl()->Redraw(); //Redraw in case of Replace all.
 			}
+			else if (m_fCount) {
+				wstrInfo = std::format(ut::GetLocale(), L"Counted {:L} occurrences.", m_ullCounted);
+			}
 			else {
 				wstrInfo = std::format(ut::GetLocale(), L"Found {:L} occurrences.", m_dwCount);
 				m_dwCount = 0;
@@ -1754,7 +2746,7 @@ void CHexDlgSearch::Search()
 			}
 
 			auto ullStartFrom = GetStartFrom();
-			HexCtrlHighlight({ { ullStartFrom, m_fReplace ? GetReplaceDataSize() : GetSearchDataSize() } });
+			HexCtrlHighlight({ { ullStartFrom, GetFoundSize(ullStartFrom) } });
 			AddToList(ullStartFrom);
 
 			if (m_fReplace) { //Increase next search step to replaced or m_ullStep amount.
@@ -1797,6 +2789,7 @@ void CHexDlgSearch::SetControlsState()
 	wnd::CWnd::FromHandle(m_Wnd.GetDlgItem(IDC_HEXCTRL_SEARCH_BTN_SEARCHF)).EnableWindow(fSearchEnabled);
 	wnd::CWnd::FromHandle(m_Wnd.GetDlgItem(IDC_HEXCTRL_SEARCH_BTN_SEARCHB)).EnableWindow(fSearchEnabled);
 	wnd::CWnd::FromHandle(m_Wnd.GetDlgItem(IDC_HEXCTRL_SEARCH_BTN_FINDALL)).EnableWindow(fSearchEnabled);
+	wnd::CWnd::FromHandle(m_Wnd.GetDlgItem(IDC_HEXCTRL_SEARCH_BTN_COUNTALL)).EnableWindow(fSearchEnabled);
 	wnd::CWnd::FromHandle(m_Wnd.GetDlgItem(IDC_HEXCTRL_SEARCH_BTN_REPL)).EnableWindow(fReplaceEnabled);
 	wnd::CWnd::FromHandle(m_Wnd.GetDlgItem(IDC_HEXCTRL_SEARCH_BTN_REPLALL)).EnableWindow(fReplaceEnabled);
 }
@@ -1806,10 +2799,172 @@ void CHexDlgSearch::SetEditStartFrom(ULONGLONG ullOffset)
 	m_WndEditStart.SetWndText(std::format(L"0x{:X}", ullOffset));
 }
 
-
-//Static functions.
-
-void CHexDlgSearch::Replace(IHexCtrl* pHexCtrl, ULONGLONG ullIndex, SpanCByte spnReplace)
+void CHexDlgSearch::SetFoundAll()
+{
+	if (!m_SearchRes.Empty()) {
+		m_fFound = true;
+		m_dwCount = static_cast<DWORD>(m_SearchRes.Size());
+
+		//Next search goes on after the last found occurrence.
+		if (const auto ullNext = m_SearchRes.Back() + GetStep(); ullNext <= GetLastSearchOffset()) {
+			m_ullStartFrom = ullNext;
+		}
+	}
+
+	SetListCount();
+}
+
+void CHexDlgSearch::SetListCount()
+{
+	//The list's items count is an int, the results past it are kept but not shown.
+	m_ListEx.SetItemCountEx(static_cast<int>((std::min)(m_SearchRes.Size(),
+		static_cast<std::size_t>((std::numeric_limits<int>::max)()))));
+}
+
+auto CHexDlgSearch::TakeCached(ULONGLONG ullFrom, bool fFwd)->std::optional<CHexSearchCache::CACHED>
+{
+	if (!IsCacheable())
+		return std::nullopt;
+
+	const auto ullGen = m_pSearchCache->GetGeneration();
+	auto optCached = m_pSearchCache->Take(GetCacheKey());
+	if (!optCached)
+		return std::nullopt;
+
+	//The backward search also needs the result to start from the first offset of the range.
+	const auto ullStep = GetStep();
+	if (optCached->ullFirst > ullFrom || (ullFrom - optCached->ullFirst) % ullStep != 0
+		|| (!fFwd && optCached->ullFirst - GetRngStart() >= ullStep)) {
+		PutCached(std::move(*optCached));
+		return std::nullopt;
+	}
+
+	if (!optCached->vecDirty.empty()) {
+		if (!PatchCached(*optCached))
+			return std::nullopt;
+
+		optCached->ullGen = ullGen;
+	}
+
+	return optCached;
+}
+
+
+//Static functions.
+
+void CHexDlgSearch::CalcMemChunks(SEARCHFUNCDATA& refData, bool fFwd)
+{
+	refData.ullChunkSkip = { };
+	const auto nSizeSearch = refData.spnFind.size();
+	const auto ullSentinel = refData.ullRngEnd + 1;
+	if (refData.ullStartFrom + nSizeSearch > ullSentinel) {
+		refData.ullChunks = { };
+		refData.ullChunkSize = { };
+		refData.ullChunkMaxOffset = { };
+		return;
+	}
+
+	//Depends on search direction. Only the refData bounds are used, it can be a window of the whole range.
+	const auto ullSizeTotal = fFwd ? ullSentinel - refData.ullStartFrom :
+		(refData.ullStartFrom - refData.ullRngStart) + nSizeSearch;
+	const auto pHexCtrl = refData.pHexCtrl;
+	const auto ullStep = refData.ullStep;
+	ULONGLONG ullChunks;
+	ULONGLONG ullChunkSize;
+	ULONGLONG ullChunkMaxOffset;
+	bool fBigStep { false };
+
+	if (!pHexCtrl->IsVirtual()) {
+		ullChunks = 1;
+		ullChunkSize = ullSizeTotal;
+		ullChunkMaxOffset = ullSizeTotal - nSizeSearch;
+	}
+	else {
+		ullChunkSize = (std::min)(static_cast<ULONGLONG>(pHexCtrl->GetCacheSize()), ullSizeTotal);
+		ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		if (ullStep > ullChunkMaxOffset) { //For very big steps.
+			ullChunks = ullSizeTotal > ullStep ? (ullSizeTotal / ullStep) + ((ullSizeTotal % ullStep) ? 1 : 0) : 1;
+			fBigStep = true;
+		}
+		else {
+			ullChunkMaxOffset -= ullChunkMaxOffset % ullStep; //Next chunks start from the offsets in line with the step.
+			//Chunks overlap by the search data size, so the last offset to search from is what must be covered.
+			//One more chunk would start past it, from the offset that is not in line with the step.
+			const auto ullOffsetLast = ullSizeTotal - nSizeSearch;
+			ullChunks = ullOffsetLast > ullChunkMaxOffset ? (ullOffsetLast / ullChunkMaxOffset)
+				+ ((ullOffsetLast % ullChunkMaxOffset) ? 1 : 0) : 1;
+		}
+	}
+
+	refData.ullChunks = ullChunks;
+	refData.ullChunkSize = ullChunkSize;
+	refData.ullChunkMaxOffset = ullChunkMaxOffset;
+	refData.fBigStep = fBigStep;
+}
+
+bool CHexDlgSearch::CalcMemChunksNext(SEARCHFUNCDATA& refData, ULONGLONG ullOffsetNext)
+{
+	//The forward search goes on from the ullOffsetNext within the chunks of the previous search.
+	//Chunks start from the same offsets, the chunk with the ullOffsetNext is already in the reader
+	//and is not read anew, only the offsets before the ullOffsetNext in it are skipped.
+	if (refData.fBigStep) { //Only one offset in a chunk.
+		refData.ullStartFrom = ullOffsetNext;
+		CalcMemChunks(refData, true);
+		return refData.ullChunks > 0;
+	}
+
+	const auto nSizeSearch = refData.spnFind.size();
+	const auto ullSentinel = refData.ullRngEnd + 1;
+	if (refData.ullChunks == 0 || ullOffsetNext < refData.ullStartFrom || ullOffsetNext + nSizeSearch > ullSentinel)
+		return false;
+
+	const auto ullChunk = refData.ullChunks == 1 ? 0ULL :
+		(std::min)((ullOffsetNext - refData.ullStartFrom) / refData.ullChunkMaxOffset, refData.ullChunks - 1);
+	refData.ullStartFrom += ullChunk * refData.ullChunkMaxOffset;
+	refData.ullChunks -= ullChunk;
+	refData.ullChunkSkip = ullOffsetNext - refData.ullStartFrom;
+	if (refData.ullStartFrom + refData.ullChunkSize > ullSentinel) { //The last chunk.
+		refData.ullChunkSize = ullSentinel - refData.ullStartFrom;
+		refData.ullChunkMaxOffset = refData.ullChunkSize - nSizeSearch;
+	}
+
+	return true;
+}
+
+void CHexDlgSearch::CalcShifts(SEARCHFUNCDATA& refData, bool fFwd)
+{
+	//Boyer-Moore-Horspool bad character shifts. Forward search takes the data byte under the last byte
+	//of the search data, and backward search under the first one. Shifts are in line with the step.
+	const auto spnFind = refData.spnFind;
+	const auto nSizeSearch = spnFind.size();
+	auto& arrShift = refData.arrShift;
+	arrShift.fill(nSizeSearch);
+	if (fFwd) {
+		for (std::size_t i { 0 }; i < nSizeSearch - 1; ++i) {
+			arrShift[static_cast<std::uint8_t>(spnFind[i])] = nSizeSearch - 1 - i;
+		}
+	}
+	else {
+		for (auto i = nSizeSearch - 1; i > 0; --i) {
+			arrShift[static_cast<std::uint8_t>(spnFind[i])] = i;
+		}
+	}
+
+	const auto ullStep = refData.ullStep;
+	for (auto& ullShift : arrShift) {
+		ullShift = ullShift >= ullStep ? ullShift - (ullShift % ullStep) : ullStep;
+	}
+}
+
+auto CHexDlgSearch::GetReader(const SEARCHFUNCDATA& refSearch, std::optional<CHexReader>& refOptReader)->CHexReader&
+{
+	if (refSearch.pReader != nullptr)
+		return *refSearch.pReader;
+
+	return refOptReader.emplace(refSearch.pHexCtrl, refSearch.ullRngStart, refSearch.ullRngEnd);
+}
+
+void CHexDlgSearch::Replace(IHexCtrl* pHexCtrl, ULONGLONG ullIndex, SpanCByte spnReplace)
 {
 	pHexCtrl->ModifyData({ .eModifyMode { EHexModifyMode::MODIFY_ONCE }, .spnData { spnReplace },
 		.vecSpan { { ullIndex, spnReplace.size() } } });
@@ -1881,6 +3036,152 @@ bool CHexDlgSearch::MemCmp(const std::byte* pWhere, const std::byte* pWhat, std:
 	}
 }
 
+template<CHexDlgSearch::EVecSize eVecSize>
+bool CHexDlgSearch::MemCmpMask(const std::byte* pWhere, const std::byte* pWhat, const std::byte* pMask, std::size_t nSize)
+{
+	std::size_t sOffset { 0 };
+#if defined(_M_IX86) || defined(_M_X64)
+	if constexpr (eVecSize == EVecSize::VEC256) {
+		for (; sOffset + sizeof(__m256i) <= nSize; sOffset += sizeof(__m256i)) {
+			const auto m256iWhere = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + sOffset)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pMask + sOffset)));
+			const auto m256iWhat = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhat + sOffset));
+			if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(m256iWhere, m256iWhat)) != -1)
+				return false;
+		}
+	}
+
+	for (; sOffset + sizeof(__m128i) <= nSize; sOffset += sizeof(__m128i)) {
+		const auto m128iWhere = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere + sOffset)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pMask + sOffset)));
+		const auto m128iWhat = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhat + sOffset));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(m128iWhere, m128iWhat)) != 0xFFFF)
+			return false;
+	}
+#endif //^^^ _M_IX86 || _M_X64
+
+	for (; sOffset < nSize; ++sOffset) { //Remainder.
+		if ((pWhere[sOffset] & pMask[sOffset]) != pWhat[sOffset])
+			return false;
+	}
+
+	return true;
+}
+
+template<CHexDlgSearch::EVecSize eVecSize>
+auto CHexDlgSearch::MemCmpMaskDist(const std::byte* pWhere, const std::byte* pWhat, const std::byte* pMask,
+	std::size_t nSize, std::size_t nMax)->std::size_t
+{
+	std::size_t nDist { 0 };
+	std::size_t sOffset { 0 };
+#if defined(_M_IX86) || defined(_M_X64)
+	if constexpr (eVecSize == EVecSize::VEC256) {
+		for (; sOffset + sizeof(__m256i) <= nSize && nDist <= nMax; sOffset += sizeof(__m256i)) {
+			const auto m256iWhere = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + sOffset)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pMask + sOffset)));
+			const auto m256iWhat = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhat + sOffset));
+			nDist += std::popcount(~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(m256iWhere, m256iWhat))));
+		}
+	}
+
+	for (; sOffset + sizeof(__m128i) <= nSize && nDist <= nMax; sOffset += sizeof(__m128i)) {
+		const auto m128iWhere = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere + sOffset)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pMask + sOffset)));
+		const auto m128iWhat = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhat + sOffset));
+		nDist += std::popcount(~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m128iWhere, m128iWhat))) & 0xFFFFU);
+	}
+#endif //^^^ _M_IX86 || _M_X64
+
+	for (; sOffset < nSize && nDist <= nMax; ++sOffset) { //Remainder.
+		if ((pWhere[sOffset] & pMask[sOffset]) != pWhat[sOffset]) {
+			++nDist;
+		}
+	}
+
+	return nDist;
+}
+
+auto CHexDlgSearch::GetMaskAnchors(SpanCByte spnMask)->std::pair<std::size_t, std::size_t>
+{
+	//A fully defined byte matches one value of 256, a byte with a nibble wildcard one of 16.
+	//The all-wildcards data matches everywhere, any anchors do.
+	const auto lmbAnchors = [spnMask](std::byte byteMin)->std::optional<std::pair<std::size_t, std::size_t>> {
+		const auto lmbPred = [byteMin](std::byte byteMask) { return (byteMask & byteMin) == byteMin && byteMask != std::byte { }; };
+		const auto itFirst = std::find_if(spnMask.begin(), spnMask.end(), lmbPred);
+		if (itFirst == spnMask.end())
+			return std::nullopt;
+
+		const auto itLast = std::find_if(spnMask.rbegin(), spnMask.rend(), lmbPred);
+		return { { static_cast<std::size_t>(itFirst - spnMask.begin()),
+			static_cast<std::size_t>(spnMask.rend() - itLast) - 1 } };
+		};
+
+	if (const auto optFull = lmbAnchors(std::byte { 0xFF }); optFull) {
+		return *optFull;
+	}
+
+	return lmbAnchors(std::byte { }).value_or(std::pair<std::size_t, std::size_t> { 0, spnMask.size() - 1 });
+}
+
+auto CHexDlgSearch::GetStepMask(ULONGLONG ullStep)->std::uint32_t
+{
+	//The vector's offsets are always in line with any such step, because the vector size is a multiple of it.
+	assert(ullStep == 1 || ullStep == 2 || ullStep == 4 || ullStep == 8 || ullStep == 16);
+	std::uint32_t u32Mask { };
+	for (auto ullBit = 0ULL; ullBit < 32; ullBit += ullStep) {
+		u32Mask |= 1U << ullBit;
+	}
+
+	return u32Mask;
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::ToLowerASCII(std::byte byte)->std::byte
+{
+	if constexpr ((stType.eMemCmp == EMemCmp::CHAR_STR || stType.eMemCmp == EMemCmp::WCHAR_STR) && !stType.fMatchCase) {
+		if (byte >= std::byte { 'A' } && byte <= std::byte { 'Z' }) { //If it's a capital letter.
+			return byte | std::byte { 0x20 }; //Lowering this letter ('a' - 'A' = 32).
+		}
+	}
+
+	return byte;
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::CountFuncFwd(const SEARCHFUNCDATA& refSearch)->ULONGLONG
+{
+	const auto ullStartFrom = refSearch.ullStartFrom;
+	const auto pHexCtrl = refSearch.pHexCtrl;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	if (ullStartFrom + nSizeSearch > refSearch.ullRngEnd + 1)
+		return 0;
+
+	const auto ullLast = refSearch.ullRngEnd + 1 - nSizeSearch; //Last offset to compare at.
+	const auto ullChunkSizeMax = pHexCtrl->IsVirtual() ? static_cast<ULONGLONG>(pHexCtrl->GetCacheSize()) :
+		(std::numeric_limits<ULONGLONG>::max)();
+	ULONGLONG ullCount { 0 };
+
+	//Every chunk's data overlaps the next chunk by the (search data size - 1) bytes.
+	for (auto ullOffsetSearch = ullStartFrom; ullOffsetSearch <= ullLast;) {
+		const auto ullOffsets = (std::min)(ullLast - ullOffsetSearch, ullChunkSizeMax - nSizeSearch) + 1;
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullOffsets + nSizeSearch - 1 });
+		assert(spnData.size() >= ullOffsets + nSizeSearch - 1);
+		for (auto ullOffsetData = 0ULL; ullOffsetData < ullOffsets; ++ullOffsetData) {
+			ullCount += MemCmp<stType>(spnData.data() + ullOffsetData, pDataSearch, nSizeSearch) ? 1 : 0;
+		}
+
+		if (ullOffsets > ullLast - ullOffsetSearch)
+			break; //Upper bound reached.
+
+		ullOffsetSearch += ullOffsets;
+	}
+
+	return refSearch.fInverted ? (ullLast - ullStartFrom + 1) - ullCount : ullCount;
+}
+
 template<CHexDlgSearch::SEARCHTYPE stType>
 auto CHexDlgSearch::SearchFuncFwd(const SEARCHFUNCDATA& refSearch)->FINDRESULT
 {
@@ -1888,7 +3189,8 @@ auto CHexDlgSearch::SearchFuncFwd(const SEARCHFUNCDATA& refSearch)->FINDRESULT
 	static constexpr auto LOOP_UNROLL_SIZE = 8U; //How many comparisons we do at one loop cycle.
 	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
 	const auto ullStep = refSearch.ullStep;
-	const auto pHexCtrl = refSearch.pHexCtrl;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
 	const auto pDlgProg = refSearch.pDlgProg;
 	const auto pDataSearch = refSearch.spnFind.data();
 	const auto nSizeSearch = refSearch.spnFind.size();
@@ -1901,12 +3203,12 @@ auto CHexDlgSearch::SearchFuncFwd(const SEARCHFUNCDATA& refSearch)->FINDRESULT
 	auto ullOffsetSearch = refSearch.ullStartFrom;
 
 	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
-		const auto spnData = pHexCtrl->GetData({ ullOffsetSearch, ullChunkSize });
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
 		assert(!spnData.empty());
 		assert(spnData.size() >= ullChunkSize);
 
 		//Unrolling the loop, making LOOP_UNROLL_SIZE comparisons at one cycle.
-		for (auto ullOffsetData = 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += ullStep * LOOP_UNROLL_SIZE) {
+		for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += ullStep * LOOP_UNROLL_SIZE) {
 			//First memory comparison is always unconditional.
 			if (MemCmp<stType>(spnData.data() + ullOffsetData, pDataSearch, nSizeSearch) == !fInverted) {
 				return { ullOffsetSearch + ullOffsetData, true, false };
@@ -1992,251 +3294,155 @@ auto CHexDlgSearch::SearchFuncFwd(const SEARCHFUNCDATA& refSearch)->FINDRESULT
 	return { };
 }
 
-#if defined(_M_IX86) || defined(_M_X64)
-template<CHexDlgSearch::EVecSize eVecSize>
-int CHexDlgSearch::MemCmpVecEQByte1(const std::byte* pWhere, std::byte bWhat)
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncFwdLong(const SEARCHFUNCDATA& refSearch)->FINDRESULT
 {
-	if constexpr (eVecSize == EVecSize::VEC128) {
-		const auto m128iWhere = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
-		const auto m128iWhat = _mm_set1_epi8(static_cast<char>(bWhat));
-		const auto m128iResult = _mm_cmpeq_epi8(m128iWhere, m128iWhat);
-		const auto uiMask = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult));
-		return std::countr_zero(uiMask); //>15 here means not found, all in mask are zeros.
-	}
-	else if constexpr (eVecSize == EVecSize::VEC256) {
-		const auto m256iWhere = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
-		const auto m256iWhat = _mm256_set1_epi8(static_cast<char>(bWhat));
-		const auto m256iResult = _mm256_cmpeq_epi8(m256iWhere, m256iWhat);
-		const auto uiMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult));
-		return std::countr_zero(uiMask); //>31 here means not found, all in mask are zeros.
+	//Boyer-Moore-Horspool search. The data byte under the last byte of the search data
+	//defines how far the next comparison can be shifted. The offset in a chunk that exceeds
+	//the chunk's max offset is carried over to the next chunk.
+	if (refSearch.fBigStep) { //Only one offset to compare at in a chunk, nothing to shift.
+		return SearchFuncFwd<stType>(refSearch);
 	}
-}
 
-template<CHexDlgSearch::EVecSize eVecSize>
-int CHexDlgSearch::MemCmpVecNEQByte1(const std::byte* pWhere, std::byte bWhat)
-{
-	if constexpr (eVecSize == EVecSize::VEC128) {
-		const auto m128iWhere = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
-		const auto m128iWhat = _mm_set1_epi8(static_cast<char>(bWhat));
-		const auto m128iResult = _mm_cmpeq_epi8(m128iWhere, m128iWhat);
-		const auto iMask = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult));
-		return std::countr_zero(~iMask);
-	}
-	else if constexpr (eVecSize == EVecSize::VEC256) {
-		const auto m256iWhere = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
-		const auto m256iWhat = _mm256_set1_epi8(static_cast<char>(bWhat));
-		const auto m256iResult = _mm256_cmpeq_epi8(m256iWhere, m256iWhat);
-		const auto iMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult));
-		return std::countr_zero(~iMask);
+	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto byteLast = pDataSearch[nSizeSearch - 1];
+	const auto& arrShift = refSearch.arrShift;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom;
+	auto ullOffsetData = refSearch.ullChunkSkip;
+	auto ullIter = 0ULL;
+
+	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+		const auto pData = spnData.data();
+
+		while (ullOffsetData <= ullChunkMaxOffset) {
+			const auto byteKey = ToLowerASCII<stType>(pData[ullOffsetData + nSizeSearch - 1]);
+			if (byteKey == byteLast && MemCmp<stType>(pData + ullOffsetData, pDataSearch, nSizeSearch)) {
+				return { ullOffsetSearch + ullOffsetData, true, false };
+			}
+			ullOffsetData += arrShift[static_cast<std::uint8_t>(byteKey)];
+
+			if constexpr (stType.fDlgProg) {
+				if ((++ullIter % 0x1000) == 0) {
+					if (pDlgProg->IsCanceled()) {
+						return { { }, false, true };
+					}
+					pDlgProg->SetCurrent(ullOffsetSearch + ullOffsetData);
+				}
+			}
+		}
+
+		ullOffsetSearch += ullChunkMaxOffset;
+		ullOffsetData -= ullChunkMaxOffset;
+		if (ullOffsetSearch + ullChunkSize > ullOffsetSentinel) {
+			ullChunkSize = ullOffsetSentinel - ullOffsetSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		}
 	}
+
+	return { };
 }
 
-template<CHexDlgSearch::EVecSize eVecSize>
-int CHexDlgSearch::MemCmpVecEQByte2(const std::byte* pWhere, std::uint16_t ui16What)
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncFwdFuzzy(const SEARCHFUNCDATA& refSearch)->FINDRESULT
 {
-	if constexpr (eVecSize == EVecSize::VEC128) {
-		const auto m128iWhere0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
-		const auto m128iWhere1 = _mm_srli_si128(m128iWhere0, 1); //Shifting-right the whole vector by 1 byte.
-		const auto m128iWhat = _mm_set1_epi16(ui16What);
-		const auto m128iResult0 = _mm_cmpeq_epi16(m128iWhere0, m128iWhat);
-		const auto m128iResult1 = _mm_cmpeq_epi16(m128iWhere1, m128iWhat); //Comparing both loads simultaneously.
-		const auto uiMask0 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult0));
-		//Shifting-left the mask by 1 to compensate previous 1 byte right-shift by _mm_srli_si128.
-		const auto uiMask1 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult1)) << 1;
-		const auto iRes0 = std::countr_zero(uiMask0);
-		//Setting the last bit (of 16) to zero, to avoid false positives when searching for `0000` and last byte is `00`.
-		const auto iRes1 = std::countr_zero(uiMask1 & 0b01111111'11111110);
-		return (std::min)(iRes0, iRes1); //>15 here means not found, all in mask are zeros.
-	}
-	else if constexpr (eVecSize == EVecSize::VEC256) {
-		const auto m256iWhere0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
-		const auto m256iWhere1 = _mm256_srli_si256(m256iWhere0, 1); //Shifting-right the whole vector by 1 byte.
-		const auto m256iWhat = _mm256_set1_epi16(ui16What);
-		const auto m256iResult0 = _mm256_cmpeq_epi16(m256iWhere0, m256iWhat);
-		const auto m256iResult1 = _mm256_cmpeq_epi16(m256iWhere1, m256iWhat); //Comparing both loads simultaneously.
-		const auto uiMask0 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult0));
-		//Shifting-left the mask by 1 to compensate previous 1 byte right-shift by _mm256_srli_si256.
-		const auto uiMask1 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult1)) << 1;
-		const auto iRes0 = std::countr_zero(uiMask0);
-		//Setting the last bit (of 32) to zero, to avoid false positives when searching for `0000` and last byte is `00`.
-		const auto iRes1 = std::countr_zero(uiMask1 & 0b01111111'11111111'11111111'11111110);
-		return (std::min)(iRes0, iRes1); //>31 here means not found, all in mask are zeros.
+	//Hex bytes that differ from the search data in no more than dwMismatch bytes (Hamming distance).
+	//Step 1 runs the bit-parallel shift-and (Bitap) over the first up to 64 bytes of the search data,
+	//one state per number of mismatches, and only its matches are verified for the whole data size.
+	//Bit N of the state is set if the last N+1 data bytes match the first N+1 search bytes.
+	constexpr auto nSizeBitapMax { sizeof(std::uint64_t) * 8 };
+	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
+	const auto ullStep = refSearch.ullStep;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto pDataMask = refSearch.spnMask.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto nMismatch = static_cast<std::size_t>(refSearch.dwMismatch);
+	const auto nSizeBitap = (std::min)(nSizeSearch, nSizeBitapMax);
+	const auto ullEnd = ullOffsetSentinel - nSizeSearch;
+	const auto fBigStep = refSearch.fBigStep;
+	const auto fInverted = refSearch.fInverted;
+	const auto fBitap = ullStep == 1 && !fInverted && nMismatch < nSizeBitap;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom;
+	std::array<std::uint64_t, 256> arrByteBits { }; //Bit N is set if the byte matches the search byte N.
+	std::vector<std::uint64_t> vecState(nMismatch + 1);
+	const auto u64StateFound = 1ULL << (nSizeBitap - 1);
+
+	if (fBitap) {
+		for (auto itByte = 0U; itByte < arrByteBits.size(); ++itByte) {
+			for (auto itBit = 0U; itBit < nSizeBitap; ++itBit) {
+				if ((static_cast<std::byte>(itByte) & pDataMask[itBit]) == pDataSearch[itBit]) {
+					arrByteBits[itByte] |= 1ULL << itBit;
+				}
+			}
+		}
 	}
-}
-
-template<CHexDlgSearch::EVecSize eVecSize>
-int CHexDlgSearch::MemCmpVecNEQByte2(const std::byte* pWhere, std::uint16_t ui16What)
-{
-	if constexpr (eVecSize == EVecSize::VEC128) {
-		const auto m128iWhere0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
-		const auto m128iWhere1 = _mm_srli_si128(m128iWhere0, 1);
-		const auto m128iWhat = _mm_set1_epi16(ui16What);
-		const auto m128iResult0 = _mm_cmpeq_epi16(m128iWhere0, m128iWhat);
-		const auto m128iResult1 = _mm_cmpeq_epi16(m128iWhere1, m128iWhat);
-		const auto uiMask0 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult0));
-		const auto uiMask1 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult1)) << 1;
-		const auto iRes0 = std::countr_zero(~uiMask0);
-		//Setting the first bit (of 16), after inverting, to zero, because it's always 0 after the left-shifting above.
-		const auto iRes1 = std::countr_zero((~uiMask1) & 0b01111111'11111110);
-		return (std::min)(iRes0, iRes1);
-	}
-	else if constexpr (eVecSize == EVecSize::VEC256) {
-		const auto m256iWhere0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
-		const auto m256iWhere1 = _mm256_srli_si256(m256iWhere0, 1);
-		const auto m256iWhat = _mm256_set1_epi16(ui16What);
-		const auto m256iResult0 = _mm256_cmpeq_epi16(m256iWhere0, m256iWhat);
-		const auto m256iResult1 = _mm256_cmpeq_epi16(m256iWhere1, m256iWhat);
-		const auto uiMask0 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult0));
-		const auto uiMask1 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult1)) << 1;
-		const auto iRes0 = std::countr_zero(~uiMask0);
-		//Setting the first bit (of 32), after inverting, to zero, because it's always 0 after the left-shifting above.
-		const auto iRes1 = std::countr_zero((~uiMask1) & 0b01111111'11111111'11111111'11111110);
-		return (std::min)(iRes0, iRes1);
-	}
-}
-
-template<CHexDlgSearch::EVecSize eVecSize>
-int CHexDlgSearch::MemCmpVecEQByte4(const std::byte* pWhere, std::uint32_t ui32What)
-{
-	if constexpr (eVecSize == EVecSize::VEC128) {
-		const auto m128iWhere0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
-		const auto m128iWhere1 = _mm_srli_si128(m128iWhere0, 1);
-		const auto m128iWhere2 = _mm_srli_si128(m128iWhere0, 2);
-		const auto m128iWhere3 = _mm_srli_si128(m128iWhere0, 3);
-		const auto m128iWhat = _mm_set1_epi32(ui32What);
-		const auto m128iResult0 = _mm_cmpeq_epi32(m128iWhere0, m128iWhat);
-		const auto m128iResult1 = _mm_cmpeq_epi32(m128iWhere1, m128iWhat);
-		const auto m128iResult2 = _mm_cmpeq_epi32(m128iWhere2, m128iWhat);
-		const auto m128iResult3 = _mm_cmpeq_epi32(m128iWhere3, m128iWhat);
-		const auto uiMask0 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult0));
-		const auto uiMask1 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult1)) << 1;
-		const auto uiMask2 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult2)) << 2;
-		const auto uiMask3 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult3)) << 3;
-		const auto iRes0 = std::countr_zero(uiMask0);
-		const auto iRes1 = std::countr_zero(uiMask1 & 0b00011111'11111110);
-		const auto iRes2 = std::countr_zero(uiMask2 & 0b00111111'11111100);
-		const auto iRes3 = std::countr_zero(uiMask3 & 0b01111111'11111000);
-		return (std::min)(iRes0, (std::min)(iRes1, (std::min)(iRes2, iRes3)));
-	}
-	else if constexpr (eVecSize == EVecSize::VEC256) {
-		const auto m256iWhere0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
-		const auto m256iWhere1 = _mm256_srli_si256(m256iWhere0, 1);
-		const auto m256iWhere2 = _mm256_srli_si256(m256iWhere0, 2);
-		const auto m256iWhere3 = _mm256_srli_si256(m256iWhere0, 3);
-		const auto m256iWhat = _mm256_set1_epi32(ui32What);
-		const auto m256iResult0 = _mm256_cmpeq_epi32(m256iWhere0, m256iWhat);
-		const auto m256iResult1 = _mm256_cmpeq_epi32(m256iWhere1, m256iWhat);
-		const auto m256iResult2 = _mm256_cmpeq_epi32(m256iWhere2, m256iWhat);
-		const auto m256iResult3 = _mm256_cmpeq_epi32(m256iWhere3, m256iWhat);
-		const auto uiMask0 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult0));
-		const auto uiMask1 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult1)) << 1;
-		const auto uiMask2 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult2)) << 2;
-		const auto uiMask3 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult3)) << 3;
-		const auto iRes0 = std::countr_zero(uiMask0);
-		const auto iRes1 = std::countr_zero(uiMask1 & 0b00011111'11111111'11111111'11111110);
-		const auto iRes2 = std::countr_zero(uiMask2 & 0b00111111'11111111'11111111'11111100);
-		const auto iRes3 = std::countr_zero(uiMask3 & 0b01111111'11111111'11111111'11111000);
-		return (std::min)(iRes0, (std::min)(iRes1, (std::min)(iRes2, iRes3)));
-	}
-}
-
-template<CHexDlgSearch::EVecSize eVecSize>
-int CHexDlgSearch::MemCmpVecNEQByte4(const std::byte* pWhere, std::uint32_t ui32What)
-{
-	if constexpr (eVecSize == EVecSize::VEC128) {
-		const auto m128iWhere0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
-		const auto m128iWhere1 = _mm_srli_si128(m128iWhere0, 1);
-		const auto m128iWhere2 = _mm_srli_si128(m128iWhere0, 2);
-		const auto m128iWhere3 = _mm_srli_si128(m128iWhere0, 3);
-		const auto m128iWhat = _mm_set1_epi32(ui32What);
-		const auto m128iResult0 = _mm_cmpeq_epi32(m128iWhere0, m128iWhat);
-		const auto m128iResult1 = _mm_cmpeq_epi32(m128iWhere1, m128iWhat);
-		const auto m128iResult2 = _mm_cmpeq_epi32(m128iWhere2, m128iWhat);
-		const auto m128iResult3 = _mm_cmpeq_epi32(m128iWhere3, m128iWhat);
-		const auto uiMask0 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult0));
-		const auto uiMask1 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult1)) << 1;
-		const auto uiMask2 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult2)) << 2;
-		const auto uiMask3 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult3)) << 3;
-		const auto iRes0 = std::countr_zero(~uiMask0);
-		const auto iRes1 = std::countr_zero((~uiMask1) & 0b00011111'11111110);
-		const auto iRes2 = std::countr_zero((~uiMask2) & 0b00111111'11111100);
-		const auto iRes3 = std::countr_zero((~uiMask3) & 0b01111111'11111000);
-		return (std::min)(iRes0, (std::min)(iRes1, (std::min)(iRes2, iRes3)));
-	}
-	else if constexpr (eVecSize == EVecSize::VEC256) {
-		const auto m256iWhere0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
-		const auto m256iWhere1 = _mm256_srli_si256(m256iWhere0, 1);
-		const auto m256iWhere2 = _mm256_srli_si256(m256iWhere0, 2);
-		const auto m256iWhere3 = _mm256_srli_si256(m256iWhere0, 3);
-		const auto m256iWhat = _mm256_set1_epi32(ui32What);
-		const auto m256iResult0 = _mm256_cmpeq_epi32(m256iWhere0, m256iWhat);
-		const auto m256iResult1 = _mm256_cmpeq_epi32(m256iWhere1, m256iWhat);
-		const auto m256iResult2 = _mm256_cmpeq_epi32(m256iWhere2, m256iWhat);
-		const auto m256iResult3 = _mm256_cmpeq_epi32(m256iWhere3, m256iWhat);
-		const auto uiMask0 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult0));
-		const auto uiMask1 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult1)) << 1;
-		const auto uiMask2 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult2)) << 2;
-		const auto uiMask3 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult3)) << 3;
-		const auto iRes0 = std::countr_zero(~uiMask0);
-		const auto iRes1 = std::countr_zero((~uiMask1) & 0b00011111'11111111'11111111'11111110);
-		const auto iRes2 = std::countr_zero((~uiMask2) & 0b00111111'11111111'11111111'11111100);
-		const auto iRes3 = std::countr_zero((~uiMask3) & 0b01111111'11111111'11111111'11111000);
-		return (std::min)(iRes0, (std::min)(iRes1, (std::min)(iRes2, iRes3)));
-	}
-}
-
-template<CHexDlgSearch::SEARCHTYPE stType>
-auto CHexDlgSearch::SearchFuncVecFwdByte1(const SEARCHFUNCDATA& refSearch)->FINDRESULT
-{
-	//Members locality is important for the best performance of the tight search loop below.
-	constexpr auto iVecSize = static_cast<int>(stType.eVecSize); //Vector size 128/256.
-	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
-	const auto ullStep = refSearch.ullStep;
-	const auto pHexCtrl = refSearch.pHexCtrl;
-	const auto pDlgProg = refSearch.pDlgProg;
-	const auto pDataSearch = refSearch.spnFind.data();
-	const auto nSizeSearch = refSearch.spnFind.size();
-	const auto ullEnd = ullOffsetSentinel - nSizeSearch;
-	const auto fBigStep = refSearch.fBigStep;
-	const auto fInverted = refSearch.fInverted;
-	const auto ullChunks = refSearch.ullChunks;
-	auto ullChunkSize = refSearch.ullChunkSize;
-	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
-	auto ullOffsetSearch = refSearch.ullStartFrom;
 
 	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
-		const auto spnData = pHexCtrl->GetData({ ullOffsetSearch, ullChunkSize });
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
 		assert(!spnData.empty());
 		assert(spnData.size() >= ullChunkSize);
 
-		for (auto ullOffsetData = 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += iVecSize) {
-			if ((ullOffsetData + iVecSize) <= ullChunkMaxOffset) {
-				if constexpr (!stType.fInverted) { //SIMD forward not inverted.
-					if (const auto iRes = MemCmpVecEQByte1<stType.eVecSize>(spnData.data() + ullOffsetData, *pDataSearch);
-						iRes < iVecSize) {
-						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
-					}
+		if (fBitap) {
+			//Every offset up to the ullChunkMaxOffset has all its data within the chunk, the states start anew.
+			std::fill(vecState.begin(), vecState.end(), 0ULL);
+			const auto ullOffsetDataEnd = ullChunkMaxOffset + nSizeBitap;
+			for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData < ullOffsetDataEnd; ++ullOffsetData) {
+				const auto u64ByteBits = arrByteBits[static_cast<std::uint8_t>(spnData[ullOffsetData])];
+				auto u64StatePrev = vecState[0];
+				vecState[0] = ((u64StatePrev << 1) | 1) & u64ByteBits;
+				for (auto itState = 1U; itState <= nMismatch; ++itState) { //Either the byte matches, or it's one more mismatch.
+					const auto u64StateCurr = vecState[itState];
+					vecState[itState] = (((u64StateCurr << 1) | 1) & u64ByteBits) | ((u64StatePrev << 1) | 1);
+					u64StatePrev = u64StateCurr;
 				}
-				else if constexpr (stType.fInverted) { //SIMD forward inverted.
-					if (const auto iRes = MemCmpVecNEQByte1<stType.eVecSize>(spnData.data() + ullOffsetData, *pDataSearch);
-						iRes < iVecSize) {
-						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
+
+				if ((vecState[nMismatch] & u64StateFound) != 0) {
+					const auto ullOffsetFound = ullOffsetData + 1 - nSizeBitap;
+					if (nSizeSearch == nSizeBitap || MemCmpMaskDist<stType.eVecSize>(spnData.data() + ullOffsetFound,
+						pDataSearch, pDataMask, nSizeSearch, nMismatch) <= nMismatch) {
+						return { ullOffsetSearch + ullOffsetFound, true, false };
 					}
 				}
-			}
-			else {
-				for (auto i = 0; i <= ullChunkMaxOffset - ullOffsetData; ++i) {
-					if (MemCmp<stType>(spnData.data() + ullOffsetData + i, pDataSearch, 0) == !fInverted) {
-						return { ullOffsetSearch + ullOffsetData + i, true, false };
+
+				if constexpr (stType.fDlgProg) {
+					if ((ullOffsetData & 0xFFFFU) == 0) {
+						if (pDlgProg->IsCanceled()) {
+							return { { }, false, true };
+						}
+						pDlgProg->SetCurrent(ullOffsetSearch + ullOffsetData);
 					}
 				}
 			}
+		}
+		else {
+			for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += ullStep) {
+				if ((MemCmpMaskDist<stType.eVecSize>(spnData.data() + ullOffsetData, pDataSearch, pDataMask, nSizeSearch,
+					nMismatch) <= nMismatch) == !fInverted) {
+					return { ullOffsetSearch + ullOffsetData, true, false };
+				}
 
-			if constexpr (stType.fDlgProg) {
-				if (pDlgProg->IsCanceled()) {
-					return { { }, false, true };
+				if constexpr (stType.fDlgProg) {
+					if (pDlgProg->IsCanceled()) {
+						return { { }, false, true };
+					}
+					pDlgProg->SetCurrent(ullOffsetSearch + ullOffsetData);
 				}
-				pDlgProg->SetCurrent(ullOffsetSearch + ullOffsetData);
 			}
 		}
 
@@ -2260,15 +3466,36 @@ auto CHexDlgSearch::SearchFuncVecFwdByte1(const SEARCHFUNCDATA& refSearch)->FIND
 }
 
 template<CHexDlgSearch::SEARCHTYPE stType>
-auto CHexDlgSearch::SearchFuncVecFwdByte2(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+auto CHexDlgSearch::SearchFuncFwdIndex(const SEARCHFUNCDATA& refSearch)->FINDRESULT
 {
-	//Members locality is important for the best performance of the tight search loop below.
-	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	//Candidates are taken from the search index, instead of going through all the data.
+	const auto pDlgProg = stType.fDlgProg ? refSearch.pDlgProg : nullptr;
+	const auto ullLast = refSearch.ullRngEnd + 1 - refSearch.spnFind.size();
+	if (const auto optOffset = refSearch.pIndex->FindFwd(refSearch.spnFind, refSearch.ullStartFrom + refSearch.ullChunkSkip, ullLast,
+		refSearch.ullStep, pDlgProg); optOffset) {
+		return { *optOffset, true, false };
+	}
+
+	if constexpr (stType.fDlgProg) {
+		if (pDlgProg->IsCanceled()) {
+			return { { }, false, true };
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncFwdMask(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Hex bytes with the wildcards, compared under the mask at every step offset.
 	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
 	const auto ullStep = refSearch.ullStep;
-	const auto pHexCtrl = refSearch.pHexCtrl;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
 	const auto pDlgProg = refSearch.pDlgProg;
 	const auto pDataSearch = refSearch.spnFind.data();
+	const auto pDataMask = refSearch.spnMask.data();
 	const auto nSizeSearch = refSearch.spnFind.size();
 	const auto ullEnd = ullOffsetSentinel - nSizeSearch;
 	const auto fBigStep = refSearch.fBigStep;
@@ -2279,34 +3506,13 @@ auto CHexDlgSearch::SearchFuncVecFwdByte2(const SEARCHFUNCDATA& refSearch)->FIND
 	auto ullOffsetSearch = refSearch.ullStartFrom;
 
 	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
-		const auto spnData = pHexCtrl->GetData({ ullOffsetSearch, ullChunkSize });
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
 		assert(!spnData.empty());
 		assert(spnData.size() >= ullChunkSize);
 
-		//Next cycle offset is "iVecSize - 1", to get the data that crosses the vector.
-		for (auto ullOffsetData = 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += (iVecSize - 1)) {
-			if ((ullOffsetData + iVecSize) <= ullChunkMaxOffset) {
-				if constexpr (!stType.fInverted) { //SIMD forward not inverted.
-					if (const auto iRes = MemCmpVecEQByte2<stType.eVecSize>(spnData.data() + ullOffsetData,
-						*reinterpret_cast<const std::uint16_t*>(pDataSearch));
-						iRes < iVecSize) {
-						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
-					}
-				}
-				else if constexpr (stType.fInverted) { //SIMD forward inverted.
-					if (const auto iRes = MemCmpVecNEQByte2<stType.eVecSize>(spnData.data() + ullOffsetData,
-						*reinterpret_cast<const std::uint16_t*>(pDataSearch));
-						iRes < iVecSize) {
-						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
-					}
-				}
-			}
-			else {
-				for (auto i = 0; i <= ullChunkMaxOffset - ullOffsetData; ++i) {
-					if (MemCmp<stType>(spnData.data() + ullOffsetData + i, pDataSearch, 0) == !fInverted) {
-						return { ullOffsetSearch + ullOffsetData + i, true, false };
-					}
-				}
+		for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += ullStep) {
+			if (MemCmpMask<stType.eVecSize>(spnData.data() + ullOffsetData, pDataSearch, pDataMask, nSizeSearch) == !fInverted) {
+				return { ullOffsetSearch + ullOffsetData, true, false };
 			}
 
 			if constexpr (stType.fDlgProg) {
@@ -2336,18 +3542,20 @@ auto CHexDlgSearch::SearchFuncVecFwdByte2(const SEARCHFUNCDATA& refSearch)->FIND
 	return { };
 }
 
-template<CHexDlgSearch::SEARCHTYPE stType>
-auto CHexDlgSearch::SearchFuncVecFwdByte4(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+template<CHexDlgSearch::SEARCHTYPE stType, typename T>
+auto CHexDlgSearch::SearchFuncFwdNumRange(const SEARCHFUNCDATA& refSearch)->FINDRESULT
 {
-	//Members locality is important for the best performance of the tight search loop below.
-	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	//Numbers of the T type within the tMin-tMax range, at every step offset.
 	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
 	const auto ullStep = refSearch.ullStep;
-	const auto pHexCtrl = refSearch.pHexCtrl;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
 	const auto pDlgProg = refSearch.pDlgProg;
-	const auto pDataSearch = refSearch.spnFind.data();
 	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto tMin = ut::LoadTData<T>(refSearch.arrNumMin.data(), false);
+	const auto tMax = ut::LoadTData<T>(refSearch.arrNumMax.data(), false);
 	const auto ullEnd = ullOffsetSentinel - nSizeSearch;
+	const auto fBigEndian = refSearch.fBigEndian;
 	const auto fBigStep = refSearch.fBigStep;
 	const auto fInverted = refSearch.fInverted;
 	const auto ullChunks = refSearch.ullChunks;
@@ -2356,34 +3564,14 @@ auto CHexDlgSearch::SearchFuncVecFwdByte4(const SEARCHFUNCDATA& refSearch)->FIND
 	auto ullOffsetSearch = refSearch.ullStartFrom;
 
 	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
-		const auto spnData = pHexCtrl->GetData({ ullOffsetSearch, ullChunkSize });
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
 		assert(!spnData.empty());
 		assert(spnData.size() >= ullChunkSize);
 
-		//Next cycle offset is "iVecSize - 3", to get the data that crosses the vector.
-		for (auto ullOffsetData = 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += (iVecSize - 3)) {
-			if ((ullOffsetData + iVecSize) <= ullChunkMaxOffset) {
-				if constexpr (!stType.fInverted) { //SIMD forward not inverted.
-					if (const auto iRes = MemCmpVecEQByte4<stType.eVecSize>(spnData.data() + ullOffsetData,
-						*reinterpret_cast<const std::uint32_t*>(pDataSearch));
-						iRes < iVecSize) {
-						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
-					}
-				}
-				else if constexpr (stType.fInverted) { //SIMD forward inverted.
-					if (const auto iRes = MemCmpVecNEQByte4<stType.eVecSize>(spnData.data() + ullOffsetData,
-						*reinterpret_cast<const std::uint32_t*>(pDataSearch));
-						iRes < iVecSize) {
-						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
-					}
-				}
-			}
-			else {
-				for (auto i = 0; i <= ullChunkMaxOffset - ullOffsetData; ++i) {
-					if (MemCmp<stType>(spnData.data() + ullOffsetData + i, pDataSearch, 0) == !fInverted) {
-						return { ullOffsetSearch + ullOffsetData + i, true, false };
-					}
-				}
+		for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += ullStep) {
+			const auto tData = ut::LoadTData<T>(spnData.data() + ullOffsetData, fBigEndian);
+			if ((tData >= tMin && tData <= tMax) == !fInverted) {
+				return { ullOffsetSearch + ullOffsetData, true, false };
 			}
 
 			if constexpr (stType.fDlgProg) {
@@ -2412,45 +3600,1524 @@ auto CHexDlgSearch::SearchFuncVecFwdByte4(const SEARCHFUNCDATA& refSearch)->FIND
 
 	return { };
 }
-#elif defined(_M_ARM64)  //^^^ _M_IX86 || _M_X64 / vvv _M_ARM64
-template<CHexDlgSearch::SEARCHTYPE stType>
-auto CHexDlgSearch::SearchFuncVecFwdByte1(const SEARCHFUNCDATA& refSearch)->FINDRESULT
-{
-	return CHexDlgSearch::SearchFuncFwd<stType>(refSearch);
-}
 
-template<CHexDlgSearch::SEARCHTYPE stType>
-auto CHexDlgSearch::SearchFuncVecFwdByte2(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+#if defined(_M_IX86) || defined(_M_X64)
+template<CHexDlgSearch::EVecSize eVecSize>
+int CHexDlgSearch::MemCmpVecEQByte1(const std::byte* pWhere, std::byte bWhat)
 {
-	return CHexDlgSearch::SearchFuncFwd<stType>(refSearch);
+	if constexpr (eVecSize == EVecSize::VEC128) {
+		const auto m128iWhere = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
+		const auto m128iWhat = _mm_set1_epi8(static_cast<char>(bWhat));
+		const auto m128iResult = _mm_cmpeq_epi8(m128iWhere, m128iWhat);
+		const auto uiMask = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult));
+		return std::countr_zero(uiMask); //>15 here means not found, all in mask are zeros.
+	}
+	else if constexpr (eVecSize == EVecSize::VEC256) {
+		const auto m256iWhere = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
+		const auto m256iWhat = _mm256_set1_epi8(static_cast<char>(bWhat));
+		const auto m256iResult = _mm256_cmpeq_epi8(m256iWhere, m256iWhat);
+		const auto uiMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult));
+		return std::countr_zero(uiMask); //>31 here means not found, all in mask are zeros.
+	}
 }
 
-template<CHexDlgSearch::SEARCHTYPE stType>
-auto CHexDlgSearch::SearchFuncVecFwdByte4(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+template<CHexDlgSearch::EVecSize eVecSize>
+int CHexDlgSearch::MemCmpVecNEQByte1(const std::byte* pWhere, std::byte bWhat)
 {
-	return CHexDlgSearch::SearchFuncFwd<stType>(refSearch);
-}
+	if constexpr (eVecSize == EVecSize::VEC128) {
+		const auto m128iWhere = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
+		const auto m128iWhat = _mm_set1_epi8(static_cast<char>(bWhat));
+		const auto m128iResult = _mm_cmpeq_epi8(m128iWhere, m128iWhat);
+		const auto iMask = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult));
+		return std::countr_zero(~iMask);
+	}
+	else if constexpr (eVecSize == EVecSize::VEC256) {
+		const auto m256iWhere = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
+		const auto m256iWhat = _mm256_set1_epi8(static_cast<char>(bWhat));
+		const auto m256iResult = _mm256_cmpeq_epi8(m256iWhere, m256iWhat);
+		const auto iMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult));
+		return std::countr_zero(~iMask);
+	}
+}
+
+template<CHexDlgSearch::EVecSize eVecSize>
+int CHexDlgSearch::MemCmpVecEQByte2(const std::byte* pWhere, std::uint16_t ui16What)
+{
+	if constexpr (eVecSize == EVecSize::VEC128) {
+		const auto m128iWhere0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
+		const auto m128iWhere1 = _mm_srli_si128(m128iWhere0, 1); //Shifting-right the whole vector by 1 byte.
+		const auto m128iWhat = _mm_set1_epi16(ui16What);
+		const auto m128iResult0 = _mm_cmpeq_epi16(m128iWhere0, m128iWhat);
+		const auto m128iResult1 = _mm_cmpeq_epi16(m128iWhere1, m128iWhat); //Comparing both loads simultaneously.
+		const auto uiMask0 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult0));
+		//Shifting-left the mask by 1 to compensate previous 1 byte right-shift by _mm_srli_si128.
+		const auto uiMask1 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult1)) << 1;
+		const auto iRes0 = std::countr_zero(uiMask0);
+		//Setting the last bit (of 16) to zero, to avoid false positives when searching for `0000` and last byte is `00`.
+		const auto iRes1 = std::countr_zero(uiMask1 & 0b01111111'11111110);
+		return (std::min)(iRes0, iRes1); //>15 here means not found, all in mask are zeros.
+	}
+	else if constexpr (eVecSize == EVecSize::VEC256) {
+		const auto m256iWhere0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
+		//The _mm256_srli_si256 shifts within the 128-bit lanes, so the data is loaded from the next byte instead.
+		const auto m256iWhere1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + 1));
+		const auto m256iWhat = _mm256_set1_epi16(ui16What);
+		const auto m256iResult0 = _mm256_cmpeq_epi16(m256iWhere0, m256iWhat);
+		const auto m256iResult1 = _mm256_cmpeq_epi16(m256iWhere1, m256iWhat); //Comparing both loads simultaneously.
+		const auto uiMask0 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult0));
+		//Shifting-left the mask by 1 to compensate the 1 byte offset of the second load.
+		const auto uiMask1 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult1)) << 1;
+		const auto iRes0 = std::countr_zero(uiMask0);
+		//Setting the last bit (of 32) to zero, the next cycle starts from this offset.
+		const auto iRes1 = std::countr_zero(uiMask1 & 0b01111111'11111111'11111111'11111110);
+		return (std::min)(iRes0, iRes1); //>31 here means not found, all in mask are zeros.
+	}
+}
+
+template<CHexDlgSearch::EVecSize eVecSize>
+int CHexDlgSearch::MemCmpVecNEQByte2(const std::byte* pWhere, std::uint16_t ui16What)
+{
+	if constexpr (eVecSize == EVecSize::VEC128) {
+		const auto m128iWhere0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
+		const auto m128iWhere1 = _mm_srli_si128(m128iWhere0, 1);
+		const auto m128iWhat = _mm_set1_epi16(ui16What);
+		const auto m128iResult0 = _mm_cmpeq_epi16(m128iWhere0, m128iWhat);
+		const auto m128iResult1 = _mm_cmpeq_epi16(m128iWhere1, m128iWhat);
+		const auto uiMask0 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult0));
+		const auto uiMask1 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult1)) << 1;
+		const auto iRes0 = std::countr_zero(~uiMask0);
+		//Setting the first bit (of 16), after inverting, to zero, because it's always 0 after the left-shifting above.
+		const auto iRes1 = std::countr_zero((~uiMask1) & 0b01111111'11111110);
+		return (std::min)(iRes0, iRes1);
+	}
+	else if constexpr (eVecSize == EVecSize::VEC256) {
+		const auto m256iWhere0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
+		const auto m256iWhere1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + 1)); //Not the in-lane shift.
+		const auto m256iWhat = _mm256_set1_epi16(ui16What);
+		const auto m256iResult0 = _mm256_cmpeq_epi16(m256iWhere0, m256iWhat);
+		const auto m256iResult1 = _mm256_cmpeq_epi16(m256iWhere1, m256iWhat);
+		const auto uiMask0 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult0));
+		const auto uiMask1 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult1)) << 1;
+		const auto iRes0 = std::countr_zero(~uiMask0);
+		//Setting the first bit (of 32), after inverting, to zero, because it's always 0 after the left-shifting above.
+		const auto iRes1 = std::countr_zero((~uiMask1) & 0b01111111'11111111'11111111'11111110);
+		return (std::min)(iRes0, iRes1);
+	}
+}
+
+template<CHexDlgSearch::EVecSize eVecSize>
+int CHexDlgSearch::MemCmpVecEQByte4(const std::byte* pWhere, std::uint32_t ui32What)
+{
+	if constexpr (eVecSize == EVecSize::VEC128) {
+		const auto m128iWhere0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
+		const auto m128iWhere1 = _mm_srli_si128(m128iWhere0, 1);
+		const auto m128iWhere2 = _mm_srli_si128(m128iWhere0, 2);
+		const auto m128iWhere3 = _mm_srli_si128(m128iWhere0, 3);
+		const auto m128iWhat = _mm_set1_epi32(ui32What);
+		const auto m128iResult0 = _mm_cmpeq_epi32(m128iWhere0, m128iWhat);
+		const auto m128iResult1 = _mm_cmpeq_epi32(m128iWhere1, m128iWhat);
+		const auto m128iResult2 = _mm_cmpeq_epi32(m128iWhere2, m128iWhat);
+		const auto m128iResult3 = _mm_cmpeq_epi32(m128iWhere3, m128iWhat);
+		const auto uiMask0 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult0));
+		const auto uiMask1 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult1)) << 1;
+		const auto uiMask2 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult2)) << 2;
+		const auto uiMask3 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult3)) << 3;
+		const auto iRes0 = std::countr_zero(uiMask0);
+		const auto iRes1 = std::countr_zero(uiMask1 & 0b00011111'11111110);
+		const auto iRes2 = std::countr_zero(uiMask2 & 0b00111111'11111100);
+		const auto iRes3 = std::countr_zero(uiMask3 & 0b01111111'11111000);
+		return (std::min)(iRes0, (std::min)(iRes1, (std::min)(iRes2, iRes3)));
+	}
+	else if constexpr (eVecSize == EVecSize::VEC256) {
+		const auto m256iWhere0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
+		const auto m256iWhere1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + 1)); //Not the in-lane shifts.
+		const auto m256iWhere2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + 2));
+		const auto m256iWhere3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + 3));
+		const auto m256iWhat = _mm256_set1_epi32(ui32What);
+		const auto m256iResult0 = _mm256_cmpeq_epi32(m256iWhere0, m256iWhat);
+		const auto m256iResult1 = _mm256_cmpeq_epi32(m256iWhere1, m256iWhat);
+		const auto m256iResult2 = _mm256_cmpeq_epi32(m256iWhere2, m256iWhat);
+		const auto m256iResult3 = _mm256_cmpeq_epi32(m256iWhere3, m256iWhat);
+		const auto uiMask0 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult0));
+		const auto uiMask1 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult1)) << 1;
+		const auto uiMask2 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult2)) << 2;
+		const auto uiMask3 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult3)) << 3;
+		const auto iRes0 = std::countr_zero(uiMask0);
+		const auto iRes1 = std::countr_zero(uiMask1 & 0b00011111'11111111'11111111'11111110);
+		const auto iRes2 = std::countr_zero(uiMask2 & 0b00111111'11111111'11111111'11111100);
+		const auto iRes3 = std::countr_zero(uiMask3 & 0b01111111'11111111'11111111'11111000);
+		return (std::min)(iRes0, (std::min)(iRes1, (std::min)(iRes2, iRes3)));
+	}
+}
+
+template<CHexDlgSearch::EVecSize eVecSize>
+int CHexDlgSearch::MemCmpVecNEQByte4(const std::byte* pWhere, std::uint32_t ui32What)
+{
+	if constexpr (eVecSize == EVecSize::VEC128) {
+		const auto m128iWhere0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
+		const auto m128iWhere1 = _mm_srli_si128(m128iWhere0, 1);
+		const auto m128iWhere2 = _mm_srli_si128(m128iWhere0, 2);
+		const auto m128iWhere3 = _mm_srli_si128(m128iWhere0, 3);
+		const auto m128iWhat = _mm_set1_epi32(ui32What);
+		const auto m128iResult0 = _mm_cmpeq_epi32(m128iWhere0, m128iWhat);
+		const auto m128iResult1 = _mm_cmpeq_epi32(m128iWhere1, m128iWhat);
+		const auto m128iResult2 = _mm_cmpeq_epi32(m128iWhere2, m128iWhat);
+		const auto m128iResult3 = _mm_cmpeq_epi32(m128iWhere3, m128iWhat);
+		const auto uiMask0 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult0));
+		const auto uiMask1 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult1)) << 1;
+		const auto uiMask2 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult2)) << 2;
+		const auto uiMask3 = static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult3)) << 3;
+		const auto iRes0 = std::countr_zero(~uiMask0);
+		const auto iRes1 = std::countr_zero((~uiMask1) & 0b00011111'11111110);
+		const auto iRes2 = std::countr_zero((~uiMask2) & 0b00111111'11111100);
+		const auto iRes3 = std::countr_zero((~uiMask3) & 0b01111111'11111000);
+		return (std::min)(iRes0, (std::min)(iRes1, (std::min)(iRes2, iRes3)));
+	}
+	else if constexpr (eVecSize == EVecSize::VEC256) {
+		const auto m256iWhere0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
+		const auto m256iWhere1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + 1)); //Not the in-lane shifts.
+		const auto m256iWhere2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + 2));
+		const auto m256iWhere3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + 3));
+		const auto m256iWhat = _mm256_set1_epi32(ui32What);
+		const auto m256iResult0 = _mm256_cmpeq_epi32(m256iWhere0, m256iWhat);
+		const auto m256iResult1 = _mm256_cmpeq_epi32(m256iWhere1, m256iWhat);
+		const auto m256iResult2 = _mm256_cmpeq_epi32(m256iWhere2, m256iWhat);
+		const auto m256iResult3 = _mm256_cmpeq_epi32(m256iWhere3, m256iWhat);
+		const auto uiMask0 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult0));
+		const auto uiMask1 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult1)) << 1;
+		const auto uiMask2 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult2)) << 2;
+		const auto uiMask3 = static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult3)) << 3;
+		const auto iRes0 = std::countr_zero(~uiMask0);
+		const auto iRes1 = std::countr_zero((~uiMask1) & 0b00011111'11111111'11111111'11111110);
+		const auto iRes2 = std::countr_zero((~uiMask2) & 0b00111111'11111111'11111111'11111100);
+		const auto iRes3 = std::countr_zero((~uiMask3) & 0b01111111'11111111'11111111'11111000);
+		return (std::min)(iRes0, (std::min)(iRes1, (std::min)(iRes2, iRes3)));
+	}
+}
+
+template<CHexDlgSearch::EVecSize eVecSize, bool fMatchCase>
+auto CHexDlgSearch::MemCmpVecEQFirstLast(const std::byte* pWhere, std::size_t nSize, std::byte bFirst,
+	std::byte bLast)->std::uint32_t
+{
+	if constexpr (eVecSize == EVecSize::VEC128) {
+		auto m128iWhereFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
+		auto m128iWhereLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere + nSize - 1));
+		if constexpr (!fMatchCase) { //Bytes within the 'A'-'Z' range get the 0x20 bit, bytes above 0x7F are negative here.
+			const auto lmbToLower = [](__m128i m128iData) {
+				const auto m128iUpper = _mm_and_si128(_mm_cmpgt_epi8(m128iData, _mm_set1_epi8('A' - 1)),
+					_mm_cmplt_epi8(m128iData, _mm_set1_epi8('Z' + 1)));
+				return _mm_or_si128(m128iData, _mm_and_si128(m128iUpper, _mm_set1_epi8(0x20)));
+				};
+			m128iWhereFirst = lmbToLower(m128iWhereFirst);
+			m128iWhereLast = lmbToLower(m128iWhereLast);
+		}
+		const auto m128iResult = _mm_and_si128(_mm_cmpeq_epi8(m128iWhereFirst, _mm_set1_epi8(static_cast<char>(bFirst))),
+			_mm_cmpeq_epi8(m128iWhereLast, _mm_set1_epi8(static_cast<char>(bLast))));
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult));
+	}
+	else if constexpr (eVecSize == EVecSize::VEC256) {
+		auto m256iWhereFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
+		auto m256iWhereLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + nSize - 1));
+		if constexpr (!fMatchCase) {
+			const auto lmbToLower = [](__m256i m256iData) {
+				const auto m256iUpper = _mm256_and_si256(_mm256_cmpgt_epi8(m256iData, _mm256_set1_epi8('A' - 1)),
+					_mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), m256iData));
+				return _mm256_or_si256(m256iData, _mm256_and_si256(m256iUpper, _mm256_set1_epi8(0x20)));
+				};
+			m256iWhereFirst = lmbToLower(m256iWhereFirst);
+			m256iWhereLast = lmbToLower(m256iWhereLast);
+		}
+		const auto m256iResult = _mm256_and_si256(_mm256_cmpeq_epi8(m256iWhereFirst, _mm256_set1_epi8(static_cast<char>(bFirst))),
+			_mm256_cmpeq_epi8(m256iWhereLast, _mm256_set1_epi8(static_cast<char>(bLast))));
+		return static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult));
+	}
+}
+
+template<CHexDlgSearch::EVecSize eVecSize>
+auto CHexDlgSearch::MemCmpVecEQMask(const std::byte* pWhere, const std::byte* pWhat, const std::byte* pMask,
+	std::size_t nIndex1, std::size_t nIndex2)->std::uint32_t
+{
+	if constexpr (eVecSize == EVecSize::VEC128) {
+		const auto m128iWhere1 = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere + nIndex1)),
+			_mm_set1_epi8(static_cast<char>(pMask[nIndex1])));
+		const auto m128iWhere2 = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere + nIndex2)),
+			_mm_set1_epi8(static_cast<char>(pMask[nIndex2])));
+		const auto m128iResult = _mm_and_si128(_mm_cmpeq_epi8(m128iWhere1, _mm_set1_epi8(static_cast<char>(pWhat[nIndex1]))),
+			_mm_cmpeq_epi8(m128iWhere2, _mm_set1_epi8(static_cast<char>(pWhat[nIndex2]))));
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult));
+	}
+	else if constexpr (eVecSize == EVecSize::VEC256) {
+		const auto m256iWhere1 = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + nIndex1)),
+			_mm256_set1_epi8(static_cast<char>(pMask[nIndex1])));
+		const auto m256iWhere2 = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + nIndex2)),
+			_mm256_set1_epi8(static_cast<char>(pMask[nIndex2])));
+		const auto m256iResult = _mm256_and_si256(_mm256_cmpeq_epi8(m256iWhere1, _mm256_set1_epi8(static_cast<char>(pWhat[nIndex1]))),
+			_mm256_cmpeq_epi8(m256iWhere2, _mm256_set1_epi8(static_cast<char>(pWhat[nIndex2]))));
+		return static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult));
+	}
+}
+
+template<CHexDlgSearch::EVecSize eVecSize>
+auto CHexDlgSearch::MemCmpVecEQShort(const std::byte* pWhere, const std::byte* pWhat, std::size_t nSize)->std::uint32_t
+{
+	//Every byte of the pWhat is compared with the vector loaded at its own offset, the results are ANDed.
+	assert(nSize > 0 && nSize <= 4);
+	if constexpr (eVecSize == EVecSize::VEC128) {
+		auto m128iResult = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere)),
+			_mm_set1_epi8(static_cast<char>(pWhat[0])));
+		for (std::size_t i { 1 }; i < nSize; ++i) {
+			m128iResult = _mm_and_si128(m128iResult, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere + i)),
+				_mm_set1_epi8(static_cast<char>(pWhat[i]))));
+		}
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult));
+	}
+	else if constexpr (eVecSize == EVecSize::VEC256) {
+		auto m256iResult = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere)),
+			_mm256_set1_epi8(static_cast<char>(pWhat[0])));
+		for (std::size_t i { 1 }; i < nSize; ++i) {
+			m256iResult = _mm256_and_si256(m256iResult, _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere + i)),
+				_mm256_set1_epi8(static_cast<char>(pWhat[i]))));
+		}
+		return static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult));
+	}
+}
+
+template<CHexDlgSearch::EVecSize eVecSize>
+auto CHexDlgSearch::MemCmpVecEQLane(const std::byte* pWhere, const std::byte* pWhat, std::size_t nSize)->std::uint32_t
+{
+	//The whole lanes are compared at once, the lane's bytes mask bits are all set or all clear.
+	assert(nSize == 2 || nSize == 4 || nSize == 8);
+	if constexpr (eVecSize == EVecSize::VEC128) {
+		const auto m128iWhere = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
+		__m128i m128iResult;
+		switch (nSize) {
+		case 2:
+			m128iResult = _mm_cmpeq_epi16(m128iWhere, _mm_set1_epi16(*reinterpret_cast<const std::int16_t*>(pWhat)));
+			break;
+		case 4:
+			m128iResult = _mm_cmpeq_epi32(m128iWhere, _mm_set1_epi32(*reinterpret_cast<const std::int32_t*>(pWhat)));
+			break;
+		default:
+			m128iResult = _mm_cmpeq_epi64(m128iWhere, _mm_set1_epi64x(*reinterpret_cast<const std::int64_t*>(pWhat)));
+			break;
+		}
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(m128iResult));
+	}
+	else if constexpr (eVecSize == EVecSize::VEC256) {
+		const auto m256iWhere = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
+		__m256i m256iResult;
+		switch (nSize) {
+		case 2:
+			m256iResult = _mm256_cmpeq_epi16(m256iWhere, _mm256_set1_epi16(*reinterpret_cast<const std::int16_t*>(pWhat)));
+			break;
+		case 4:
+			m256iResult = _mm256_cmpeq_epi32(m256iWhere, _mm256_set1_epi32(*reinterpret_cast<const std::int32_t*>(pWhat)));
+			break;
+		default:
+			m256iResult = _mm256_cmpeq_epi64(m256iWhere, _mm256_set1_epi64x(*reinterpret_cast<const std::int64_t*>(pWhat)));
+			break;
+		}
+		return static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iResult));
+	}
+}
+
+template<CHexDlgSearch::EVecSize eVecSize, typename T>
+auto CHexDlgSearch::MemCmpVecNumRange(const std::byte* pWhere, T tMin, T tMax, bool fBigEndian)->std::uint32_t
+{
+	//Integrals are compared as signed, the unsigned ones with their sign bit flipped. NaNs are never within the range.
+	constexpr auto iTypeBits = static_cast<int>(sizeof(T) * 8);
+	if constexpr (eVecSize == EVecSize::VEC128) {
+		auto m128iData = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWhere));
+		if (fBigEndian) {
+			m128iData = ut::ByteSwapVec<T>(m128iData);
+		}
+
+		if constexpr (std::is_same_v<T, float>) {
+			const auto m128Data = _mm_castsi128_ps(m128iData);
+			const auto m128Result = _mm_and_ps(_mm_cmpge_ps(m128Data, _mm_set1_ps(tMin)), _mm_cmple_ps(m128Data, _mm_set1_ps(tMax)));
+			return static_cast<std::uint32_t>(_mm_movemask_ps(m128Result));
+		}
+		else if constexpr (std::is_same_v<T, double>) {
+			const auto m128dData = _mm_castsi128_pd(m128iData);
+			const auto m128dResult = _mm_and_pd(_mm_cmpge_pd(m128dData, _mm_set1_pd(tMin)), _mm_cmple_pd(m128dData, _mm_set1_pd(tMax)));
+			return static_cast<std::uint32_t>(_mm_movemask_pd(m128dResult));
+		}
+		else {
+			const auto lmbSet1 = [](T tData) {
+				if constexpr (iTypeBits == 8) { return _mm_set1_epi8(static_cast<char>(tData)); }
+				else if constexpr (iTypeBits == 16) { return _mm_set1_epi16(static_cast<short>(tData)); }
+				else if constexpr (iTypeBits == 32) { return _mm_set1_epi32(static_cast<int>(tData)); }
+				else { return _mm_set1_epi64x(static_cast<long long>(tData)); }
+				};
+			const auto lmbCmpGT = [](__m128i m128i1, __m128i m128i2) {
+				if constexpr (iTypeBits == 8) { return _mm_cmpgt_epi8(m128i1, m128i2); }
+				else if constexpr (iTypeBits == 16) { return _mm_cmpgt_epi16(m128i1, m128i2); }
+				else if constexpr (iTypeBits == 32) { return _mm_cmpgt_epi32(m128i1, m128i2); }
+				else { return _mm_cmpgt_epi64(m128i1, m128i2); } //SSE4.2
+				};
+			const auto m128iSign = std::is_signed_v<T> ? _mm_setzero_si128() : lmbSet1(static_cast<T>(1ULL << (iTypeBits - 1)));
+			m128iData = _mm_xor_si128(m128iData, m128iSign);
+			const auto m128iOut = _mm_or_si128(lmbCmpGT(_mm_xor_si128(lmbSet1(tMin), m128iSign), m128iData),
+				lmbCmpGT(m128iData, _mm_xor_si128(lmbSet1(tMax), m128iSign)));
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(m128iOut)) ^ 0xFFFFU;
+		}
+	}
+	else if constexpr (eVecSize == EVecSize::VEC256) {
+		auto m256iData = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWhere));
+		if (fBigEndian) {
+			m256iData = ut::ByteSwapVec<T>(m256iData);
+		}
+
+		if constexpr (std::is_same_v<T, float>) {
+			const auto m256Data = _mm256_castsi256_ps(m256iData);
+			const auto m256Result = _mm256_and_ps(_mm256_cmp_ps(m256Data, _mm256_set1_ps(tMin), _CMP_GE_OQ),
+				_mm256_cmp_ps(m256Data, _mm256_set1_ps(tMax), _CMP_LE_OQ));
+			return static_cast<std::uint32_t>(_mm256_movemask_ps(m256Result));
+		}
+		else if constexpr (std::is_same_v<T, double>) {
+			const auto m256dData = _mm256_castsi256_pd(m256iData);
+			const auto m256dResult = _mm256_and_pd(_mm256_cmp_pd(m256dData, _mm256_set1_pd(tMin), _CMP_GE_OQ),
+				_mm256_cmp_pd(m256dData, _mm256_set1_pd(tMax), _CMP_LE_OQ));
+			return static_cast<std::uint32_t>(_mm256_movemask_pd(m256dResult));
+		}
+		else {
+			const auto lmbSet1 = [](T tData) {
+				if constexpr (iTypeBits == 8) { return _mm256_set1_epi8(static_cast<char>(tData)); }
+				else if constexpr (iTypeBits == 16) { return _mm256_set1_epi16(static_cast<short>(tData)); }
+				else if constexpr (iTypeBits == 32) { return _mm256_set1_epi32(static_cast<int>(tData)); }
+				else { return _mm256_set1_epi64x(static_cast<long long>(tData)); }
+				};
+			const auto lmbCmpGT = [](__m256i m256i1, __m256i m256i2) {
+				if constexpr (iTypeBits == 8) { return _mm256_cmpgt_epi8(m256i1, m256i2); }
+				else if constexpr (iTypeBits == 16) { return _mm256_cmpgt_epi16(m256i1, m256i2); }
+				else if constexpr (iTypeBits == 32) { return _mm256_cmpgt_epi32(m256i1, m256i2); }
+				else { return _mm256_cmpgt_epi64(m256i1, m256i2); }
+				};
+			const auto m256iSign = std::is_signed_v<T> ? _mm256_setzero_si256() : lmbSet1(static_cast<T>(1ULL << (iTypeBits - 1)));
+			m256iData = _mm256_xor_si256(m256iData, m256iSign);
+			const auto m256iOut = _mm256_or_si256(lmbCmpGT(_mm256_xor_si256(lmbSet1(tMin), m256iSign), m256iData),
+				lmbCmpGT(m256iData, _mm256_xor_si256(lmbSet1(tMax), m256iSign)));
+			return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(m256iOut));
+		}
+	}
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::CountFuncVecFwd(const SEARCHFUNCDATA& refSearch)->ULONGLONG
+{
+	//The match bits of all the vector's offsets are counted at once, no offset is returned on the way.
+	//The short match case data is compared whole, any other is filtered by its first and last bytes,
+	//and the full comparison is only done at the offsets where both of them match.
+	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	const auto ullStartFrom = refSearch.ullStartFrom;
+	const auto pHexCtrl = refSearch.pHexCtrl;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	if (ullStartFrom + nSizeSearch > refSearch.ullRngEnd + 1)
+		return 0;
+
+	const auto byteFirst = ToLowerASCII<stType>(pDataSearch[0]);
+	const auto byteLast = ToLowerASCII<stType>(pDataSearch[nSizeSearch - 1]);
+	const auto fShort = stType.fMatchCase && nSizeSearch <= 4;
+	const auto ullLast = refSearch.ullRngEnd + 1 - nSizeSearch; //Last offset to compare at.
+	const auto ullChunkSizeMax = pHexCtrl->IsVirtual() ? static_cast<ULONGLONG>(pHexCtrl->GetCacheSize()) :
+		(std::numeric_limits<ULONGLONG>::max)();
+	ULONGLONG ullCount { 0 };
+
+	//Every chunk's data overlaps the next chunk by the (search data size - 1) bytes.
+	for (auto ullOffsetSearch = ullStartFrom; ullOffsetSearch <= ullLast;) {
+		const auto ullOffsets = (std::min)(ullLast - ullOffsetSearch, ullChunkSizeMax - nSizeSearch) + 1;
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullOffsets + nSizeSearch - 1 });
+		assert(spnData.size() >= ullOffsets + nSizeSearch - 1);
+
+		auto ullOffsetData = 0ULL;
+		for (; ullOffsetData + iVecSize <= ullOffsets; ullOffsetData += iVecSize) {
+			const auto pData = spnData.data() + ullOffsetData;
+			if (fShort) {
+				ullCount += std::popcount(MemCmpVecEQShort<stType.eVecSize>(pData, pDataSearch, nSizeSearch));
+				continue;
+			}
+
+			auto uiMask = MemCmpVecEQFirstLast<stType.eVecSize, stType.fMatchCase>(pData, nSizeSearch, byteFirst, byteLast);
+			while (uiMask != 0) {
+				ullCount += MemCmp<stType>(pData + std::countr_zero(uiMask), pDataSearch, nSizeSearch) ? 1 : 0;
+				uiMask &= uiMask - 1; //Clearing the lowest set bit.
+			}
+		}
+
+		for (; ullOffsetData < ullOffsets; ++ullOffsetData) {
+			ullCount += MemCmp<stType>(spnData.data() + ullOffsetData, pDataSearch, nSizeSearch) ? 1 : 0;
+		}
+
+		if (ullOffsets > ullLast - ullOffsetSearch)
+			break; //Upper bound reached.
+
+		ullOffsetSearch += ullOffsets;
+	}
+
+	return refSearch.fInverted ? (ullLast - ullStartFrom + 1) - ullCount : ullCount;
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdByte1(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Members locality is important for the best performance of the tight search loop below.
+	constexpr auto iVecSize = static_cast<int>(stType.eVecSize); //Vector size 128/256.
+	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
+	const auto ullStep = refSearch.ullStep;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto ullEnd = ullOffsetSentinel - nSizeSearch;
+	const auto fBigStep = refSearch.fBigStep;
+	const auto fInverted = refSearch.fInverted;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom;
+
+	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += iVecSize) {
+			if ((ullOffsetData + iVecSize) <= ullChunkMaxOffset) {
+				if constexpr (!stType.fInverted) { //SIMD forward not inverted.
+					if (const auto iRes = MemCmpVecEQByte1<stType.eVecSize>(spnData.data() + ullOffsetData, *pDataSearch);
+						iRes < iVecSize) {
+						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
+					}
+				}
+				else if constexpr (stType.fInverted) { //SIMD forward inverted.
+					if (const auto iRes = MemCmpVecNEQByte1<stType.eVecSize>(spnData.data() + ullOffsetData, *pDataSearch);
+						iRes < iVecSize) {
+						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
+					}
+				}
+			}
+			else {
+				for (auto i = 0; i <= ullChunkMaxOffset - ullOffsetData; ++i) {
+					if (MemCmp<stType>(spnData.data() + ullOffsetData + i, pDataSearch, 0) == !fInverted) {
+						return { ullOffsetSearch + ullOffsetData + i, true, false };
+					}
+				}
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
+				}
+				pDlgProg->SetCurrent(ullOffsetSearch + ullOffsetData);
+			}
+		}
+
+		if (fBigStep) [[unlikely]] {
+			if ((ullOffsetSearch + ullStep) > ullEnd)
+				break; //Upper bound reached.
+
+			ullOffsetSearch += ullStep;
+		}
+		else {
+			ullOffsetSearch += ullChunkMaxOffset;
+		}
+
+		if (ullOffsetSearch + ullChunkSize > ullOffsetSentinel) {
+			ullChunkSize = ullOffsetSentinel - ullOffsetSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdByte2(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Members locality is important for the best performance of the tight search loop below.
+	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
+	const auto ullStep = refSearch.ullStep;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto ullEnd = ullOffsetSentinel - nSizeSearch;
+	const auto fBigStep = refSearch.fBigStep;
+	const auto fInverted = refSearch.fInverted;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom;
+
+	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		//Next cycle offset is "iVecSize - 1", to get the data that crosses the vector.
+		for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += (iVecSize - 1)) {
+			if ((ullOffsetData + iVecSize) <= ullChunkMaxOffset) {
+				if constexpr (!stType.fInverted) { //SIMD forward not inverted.
+					if (const auto iRes = MemCmpVecEQByte2<stType.eVecSize>(spnData.data() + ullOffsetData,
+						*reinterpret_cast<const std::uint16_t*>(pDataSearch));
+						iRes < iVecSize) {
+						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
+					}
+				}
+				else if constexpr (stType.fInverted) { //SIMD forward inverted.
+					if (const auto iRes = MemCmpVecNEQByte2<stType.eVecSize>(spnData.data() + ullOffsetData,
+						*reinterpret_cast<const std::uint16_t*>(pDataSearch));
+						iRes < iVecSize) {
+						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
+					}
+				}
+			}
+			else {
+				for (auto i = 0; i <= ullChunkMaxOffset - ullOffsetData; ++i) {
+					if (MemCmp<stType>(spnData.data() + ullOffsetData + i, pDataSearch, 0) == !fInverted) {
+						return { ullOffsetSearch + ullOffsetData + i, true, false };
+					}
+				}
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
+				}
+				pDlgProg->SetCurrent(ullOffsetSearch + ullOffsetData);
+			}
+		}
+
+		if (fBigStep) [[unlikely]] {
+			if ((ullOffsetSearch + ullStep) > ullEnd)
+				break; //Upper bound reached.
+
+			ullOffsetSearch += ullStep;
+		}
+		else {
+			ullOffsetSearch += ullChunkMaxOffset;
+		}
+
+		if (ullOffsetSearch + ullChunkSize > ullOffsetSentinel) {
+			ullChunkSize = ullOffsetSentinel - ullOffsetSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdByte4(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Members locality is important for the best performance of the tight search loop below.
+	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
+	const auto ullStep = refSearch.ullStep;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto ullEnd = ullOffsetSentinel - nSizeSearch;
+	const auto fBigStep = refSearch.fBigStep;
+	const auto fInverted = refSearch.fInverted;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom;
+
+	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		//Next cycle offset is "iVecSize - 3", to get the data that crosses the vector.
+		for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += (iVecSize - 3)) {
+			if ((ullOffsetData + iVecSize) <= ullChunkMaxOffset) {
+				if constexpr (!stType.fInverted) { //SIMD forward not inverted.
+					if (const auto iRes = MemCmpVecEQByte4<stType.eVecSize>(spnData.data() + ullOffsetData,
+						*reinterpret_cast<const std::uint32_t*>(pDataSearch));
+						iRes < iVecSize) {
+						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
+					}
+				}
+				else if constexpr (stType.fInverted) { //SIMD forward inverted.
+					if (const auto iRes = MemCmpVecNEQByte4<stType.eVecSize>(spnData.data() + ullOffsetData,
+						*reinterpret_cast<const std::uint32_t*>(pDataSearch));
+						iRes < iVecSize) {
+						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
+					}
+				}
+			}
+			else {
+				for (auto i = 0; i <= ullChunkMaxOffset - ullOffsetData; ++i) {
+					if (MemCmp<stType>(spnData.data() + ullOffsetData + i, pDataSearch, 0) == !fInverted) {
+						return { ullOffsetSearch + ullOffsetData + i, true, false };
+					}
+				}
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
+				}
+				pDlgProg->SetCurrent(ullOffsetSearch + ullOffsetData);
+			}
+		}
+
+		if (fBigStep) [[unlikely]] {
+			if ((ullOffsetSearch + ullStep) > ullEnd)
+				break; //Upper bound reached.
+
+			ullOffsetSearch += ullStep;
+		}
+		else {
+			ullOffsetSearch += ullChunkMaxOffset;
+		}
+
+		if (ullOffsetSearch + ullChunkSize > ullOffsetSentinel) {
+			ullChunkSize = ullOffsetSentinel - ullOffsetSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdFilter(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//The first and the last bytes of the search data are compared at all the vector's offsets at once.
+	//The full comparison is only done at the offsets where both of them match, and that are in line with the step.
+	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
+	const auto ullStep = refSearch.ullStep;
+	const auto u32StepMask = GetStepMask(ullStep);
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto byteFirst = ToLowerASCII<stType>(pDataSearch[0]);
+	const auto byteLast = ToLowerASCII<stType>(pDataSearch[nSizeSearch - 1]);
+	const auto ullEnd = ullOffsetSentinel - nSizeSearch;
+	const auto fBigStep = refSearch.fBigStep;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom;
+
+	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += iVecSize) {
+			const auto pData = spnData.data() + ullOffsetData;
+			if ((ullOffsetData + iVecSize) <= ullChunkMaxOffset) {
+				auto uiMask = MemCmpVecEQFirstLast<stType.eVecSize, stType.fMatchCase>(pData, nSizeSearch, byteFirst, byteLast)
+					& u32StepMask;
+				while (uiMask != 0) {
+					if (const auto iRes = std::countr_zero(uiMask); MemCmp<stType>(pData + iRes, pDataSearch, nSizeSearch)) {
+						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
+					}
+					uiMask &= uiMask - 1; //Clearing the lowest set bit.
+				}
+			}
+			else {
+				for (auto i = 0ULL; i <= ullChunkMaxOffset - ullOffsetData; i += ullStep) {
+					if (MemCmp<stType>(pData + i, pDataSearch, nSizeSearch)) {
+						return { ullOffsetSearch + ullOffsetData + i, true, false };
+					}
+				}
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
+				}
+				pDlgProg->SetCurrent(ullOffsetSearch + ullOffsetData);
+			}
+		}
+
+		if (fBigStep) [[unlikely]] {
+			if ((ullOffsetSearch + ullStep) > ullEnd)
+				break; //Upper bound reached.
+
+			ullOffsetSearch += ullStep;
+		}
+		else {
+			ullOffsetSearch += ullChunkMaxOffset;
+		}
+
+		if (ullOffsetSearch + ullChunkSize > ullOffsetSentinel) {
+			ullChunkSize = ullOffsetSentinel - ullOffsetSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdLane(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//The search data is as long as the step, so every offset in line with the step is the vector's whole lane.
+	//All the lanes are compared at once, and only the first byte of every lane is taken from the mask.
+	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	constexpr auto u32VecMask = iVecSize == 32 ? 0xFFFFFFFFU : (1U << iVecSize) - 1; //Inverted mask has no bits past the vector.
+	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
+	const auto ullStep = refSearch.ullStep;
+	const auto u32StepMask = GetStepMask(ullStep) & u32VecMask;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto ullEnd = ullOffsetSentinel - nSizeSearch;
+	const auto fBigStep = refSearch.fBigStep;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom;
+	assert(nSizeSearch == ullStep);
+
+	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += iVecSize) {
+			const auto pData = spnData.data() + ullOffsetData;
+			if ((ullOffsetData + iVecSize) <= ullChunkMaxOffset) {
+				auto uiMask = MemCmpVecEQLane<stType.eVecSize>(pData, pDataSearch, nSizeSearch);
+				if constexpr (stType.fInverted) {
+					uiMask = ~uiMask;
+				}
+				if (uiMask &= u32StepMask; uiMask != 0) {
+					return { ullOffsetSearch + ullOffsetData + std::countr_zero(uiMask), true, false };
+				}
+			}
+			else {
+				for (auto i = 0ULL; i <= ullChunkMaxOffset - ullOffsetData; i += ullStep) {
+					if (MemCmp<stType>(pData + i, pDataSearch, nSizeSearch) == !stType.fInverted) {
+						return { ullOffsetSearch + ullOffsetData + i, true, false };
+					}
+				}
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
+				}
+				pDlgProg->SetCurrent(ullOffsetSearch + ullOffsetData);
+			}
+		}
+
+		if (fBigStep) [[unlikely]] {
+			if ((ullOffsetSearch + ullStep) > ullEnd)
+				break; //Upper bound reached.
+
+			ullOffsetSearch += ullStep;
+		}
+		else {
+			ullOffsetSearch += ullChunkMaxOffset;
+		}
+
+		if (ullOffsetSearch + ullChunkSize > ullOffsetSentinel) {
+			ullChunkSize = ullOffsetSentinel - ullOffsetSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdMask(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Two anchor bytes of the search data are compared under their masks at all the vector's offsets at once.
+	//The full masked comparison is only done at the offsets where both of them match.
+	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto pDataMask = refSearch.spnMask.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto [nIndex1, nIndex2] = GetMaskAnchors(refSearch.spnMask);
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom;
+
+	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += iVecSize) {
+			const auto pData = spnData.data() + ullOffsetData;
+			if ((ullOffsetData + iVecSize) <= ullChunkMaxOffset) {
+				auto uiMask = MemCmpVecEQMask<stType.eVecSize>(pData, pDataSearch, pDataMask, nIndex1, nIndex2);
+				while (uiMask != 0) {
+					if (const auto iRes = std::countr_zero(uiMask);
+						MemCmpMask<stType.eVecSize>(pData + iRes, pDataSearch, pDataMask, nSizeSearch)) {
+						return { ullOffsetSearch + ullOffsetData + iRes, true, false };
+					}
+					uiMask &= uiMask - 1; //Clearing the lowest set bit.
+				}
+			}
+			else {
+				for (auto i = 0; i <= ullChunkMaxOffset - ullOffsetData; ++i) {
+					if (MemCmpMask<stType.eVecSize>(pData + i, pDataSearch, pDataMask, nSizeSearch)) {
+						return { ullOffsetSearch + ullOffsetData + i, true, false };
+					}
+				}
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
+				}
+				pDlgProg->SetCurrent(ullOffsetSearch + ullOffsetData);
+			}
+		}
+
+		ullOffsetSearch += ullChunkMaxOffset;
+		if (ullOffsetSearch + ullChunkSize > ullOffsetSentinel) {
+			ullChunkSize = ullOffsetSentinel - ullOffsetSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType, typename T>
+auto CHexDlgSearch::SearchFuncVecFwdNumRange(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//A vector of the step offsets is loaded at the sizeof(T) / step phases, to have every offset's number compared.
+	//The offsets are checked one by one only in the vectors that have a number within the range.
+	if (refSearch.fBigStep) { //Only one offset to compare at in a chunk.
+		return SearchFuncFwdNumRange<stType, T>(refSearch);
+	}
+
+	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
+	const auto ullStep = refSearch.ullStep;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto tMin = ut::LoadTData<T>(refSearch.arrNumMin.data(), false);
+	const auto tMax = ut::LoadTData<T>(refSearch.arrNumMax.data(), false);
+	const auto fBigEndian = refSearch.fBigEndian;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom;
+	const auto lmbInRange = [tMin, tMax, fBigEndian](const std::byte* pData) {
+		const auto tData = ut::LoadTData<T>(pData, fBigEndian);
+		return tData >= tMin && tData <= tMax;
+		};
+
+	for (auto itChunk = 0ULL; itChunk < ullChunks; ++itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		for (auto ullOffsetData = itChunk == 0 ? refSearch.ullChunkSkip : 0ULL; ullOffsetData <= ullChunkMaxOffset; ullOffsetData += iVecSize) {
+			const auto pData = spnData.data() + ullOffsetData;
+			if ((ullOffsetData + iVecSize - ullStep) <= ullChunkMaxOffset) {
+				auto uiMask = 0U;
+				for (auto ullPhase = 0ULL; ullPhase < sizeof(T); ullPhase += ullStep) {
+					uiMask |= MemCmpVecNumRange<stType.eVecSize, T>(pData + ullPhase, tMin, tMax, fBigEndian);
+				}
+
+				if (uiMask != 0) {
+					for (auto ullOffset = 0ULL; ullOffset < iVecSize; ullOffset += ullStep) {
+						if (lmbInRange(pData + ullOffset)) {
+							return { ullOffsetSearch + ullOffsetData + ullOffset, true, false };
+						}
+					}
+				}
+			}
+			else {
+				for (auto ullOffset = ullOffsetData; ullOffset <= ullChunkMaxOffset; ullOffset += ullStep) {
+					if (lmbInRange(spnData.data() + ullOffset)) {
+						return { ullOffsetSearch + ullOffset, true, false };
+					}
+				}
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
+				}
+				pDlgProg->SetCurrent(ullOffsetSearch + ullOffsetData);
+			}
+		}
+
+		ullOffsetSearch += ullChunkMaxOffset;
+		if (ullOffsetSearch + ullChunkSize > ullOffsetSentinel) {
+			ullChunkSize = ullOffsetSentinel - ullOffsetSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecBackFilter(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//The first and the last bytes of the search data are compared at all the vector's offsets at once.
+	//Vectors go from the end of a chunk to its beginning, and the found offsets are checked from the highest one.
+	if (refSearch.fBigStep) { //Only one offset to compare at in a chunk.
+		return SearchFuncBack<stType>(refSearch);
+	}
+
+	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	const auto ullStartFrom = refSearch.ullStartFrom;
+	const auto ullEnd = refSearch.ullRngStart;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto byteFirst = ToLowerASCII<stType>(pDataSearch[0]);
+	const auto byteLast = ToLowerASCII<stType>(pDataSearch[nSizeSearch - 1]);
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom - refSearch.ullChunkMaxOffset;
+
+	if (ullOffsetSearch < ullEnd || ullOffsetSearch >((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset)) {
+		ullChunkSize = (ullStartFrom - ullEnd) + nSizeSearch;
+		ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		ullOffsetSearch = ullEnd;
+	}
+
+	for (auto itChunk = ullChunks; itChunk > 0; --itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		//llOffsetData is the highest offset of the current vector.
+		for (auto llOffsetData = static_cast<LONGLONG>(ullChunkMaxOffset); llOffsetData >= 0; llOffsetData -= iVecSize) {
+			if (llOffsetData >= (iVecSize - 1)) {
+				const auto pData = spnData.data() + (llOffsetData - (iVecSize - 1));
+				auto uiMask = MemCmpVecEQFirstLast<stType.eVecSize, stType.fMatchCase>(pData, nSizeSearch, byteFirst, byteLast);
+				while (uiMask != 0) {
+					const auto iRes = 31 - std::countl_zero(uiMask);
+					if (MemCmp<stType>(pData + iRes, pDataSearch, nSizeSearch)) {
+						return { ullOffsetSearch + (llOffsetData - (iVecSize - 1)) + iRes, true, false };
+					}
+					uiMask ^= 1U << iRes;
+				}
+			}
+			else {
+				for (auto llOffset = llOffsetData; llOffset >= 0; --llOffset) {
+					if (MemCmp<stType>(spnData.data() + llOffset, pDataSearch, nSizeSearch)) {
+						return { ullOffsetSearch + llOffset, true, false };
+					}
+				}
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
+				}
+				pDlgProg->SetCurrent(ullStartFrom - (ullOffsetSearch + llOffsetData));
+			}
+		}
+
+		if ((ullOffsetSearch - ullChunkMaxOffset) < ullEnd || ((ullOffsetSearch - ullChunkMaxOffset) >
+			((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset))) {
+			ullChunkSize = (ullOffsetSearch - ullEnd) + nSizeSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+			ullOffsetSearch = ullEnd;
+		}
+		else {
+			ullOffsetSearch -= ullChunkMaxOffset;
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecBackMask(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Two anchor bytes of the search data are compared under their masks at all the vector's offsets at once.
+	//Vectors go from the end of a chunk to its beginning, and the found offsets are checked from the highest one.
+	if (refSearch.fBigStep) { //Only one offset to compare at in a chunk.
+		return SearchFuncBackMask<stType>(refSearch);
+	}
+
+	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	const auto ullStartFrom = refSearch.ullStartFrom;
+	const auto ullEnd = refSearch.ullRngStart;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto pDataMask = refSearch.spnMask.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto [nIndex1, nIndex2] = GetMaskAnchors(refSearch.spnMask);
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom - refSearch.ullChunkMaxOffset;
+
+	if (ullOffsetSearch < ullEnd || ullOffsetSearch >((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset)) {
+		ullChunkSize = (ullStartFrom - ullEnd) + nSizeSearch;
+		ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		ullOffsetSearch = ullEnd;
+	}
+
+	for (auto itChunk = ullChunks; itChunk > 0; --itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		//llOffsetData is the highest offset of the current vector.
+		for (auto llOffsetData = static_cast<LONGLONG>(ullChunkMaxOffset); llOffsetData >= 0; llOffsetData -= iVecSize) {
+			if (llOffsetData >= (iVecSize - 1)) {
+				const auto pData = spnData.data() + (llOffsetData - (iVecSize - 1));
+				auto uiMask = MemCmpVecEQMask<stType.eVecSize>(pData, pDataSearch, pDataMask, nIndex1, nIndex2);
+				while (uiMask != 0) {
+					const auto iRes = 31 - std::countl_zero(uiMask);
+					if (MemCmpMask<stType.eVecSize>(pData + iRes, pDataSearch, pDataMask, nSizeSearch)) {
+						return { ullOffsetSearch + (llOffsetData - (iVecSize - 1)) + iRes, true, false };
+					}
+					uiMask ^= 1U << iRes;
+				}
+			}
+			else {
+				for (auto llOffset = llOffsetData; llOffset >= 0; --llOffset) {
+					if (MemCmpMask<stType.eVecSize>(spnData.data() + llOffset, pDataSearch, pDataMask, nSizeSearch)) {
+						return { ullOffsetSearch + llOffset, true, false };
+					}
+				}
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
+				}
+				pDlgProg->SetCurrent(ullStartFrom - (ullOffsetSearch + llOffsetData));
+			}
+		}
+
+		if ((ullOffsetSearch - ullChunkMaxOffset) < ullEnd || ((ullOffsetSearch - ullChunkMaxOffset) >
+			((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset))) {
+			ullChunkSize = (ullOffsetSearch - ullEnd) + nSizeSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+			ullOffsetSearch = ullEnd;
+		}
+		else {
+			ullOffsetSearch -= ullChunkMaxOffset;
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType, typename T>
+auto CHexDlgSearch::SearchFuncVecBackNumRange(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Vectors go from the end of a chunk to its beginning, and the offsets are checked from the highest one.
+	if (refSearch.fBigStep) { //Only one offset to compare at in a chunk.
+		return SearchFuncBackNumRange<stType, T>(refSearch);
+	}
+
+	constexpr auto iVecSize = static_cast<int>(stType.eVecSize);
+	const auto ullStartFrom = refSearch.ullStartFrom;
+	const auto ullEnd = refSearch.ullRngStart;
+	const auto llStep = static_cast<LONGLONG>(refSearch.ullStep);
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto tMin = ut::LoadTData<T>(refSearch.arrNumMin.data(), false);
+	const auto tMax = ut::LoadTData<T>(refSearch.arrNumMax.data(), false);
+	const auto fBigEndian = refSearch.fBigEndian;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom - refSearch.ullChunkMaxOffset;
+	const auto lmbInRange = [tMin, tMax, fBigEndian](const std::byte* pData) {
+		const auto tData = ut::LoadTData<T>(pData, fBigEndian);
+		return tData >= tMin && tData <= tMax;
+		};
+
+	if (ullOffsetSearch < ullEnd || ullOffsetSearch >((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset)) {
+		ullChunkSize = (ullStartFrom - ullEnd) + nSizeSearch;
+		ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		ullOffsetSearch = ullEnd;
+	}
+
+	for (auto itChunk = ullChunks; itChunk > 0; --itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		//llOffsetData is the highest offset of the current vector.
+		for (auto llOffsetData = static_cast<LONGLONG>(ullChunkMaxOffset); llOffsetData >= 0; llOffsetData -= iVecSize) {
+			if (llOffsetData >= (iVecSize - llStep)) {
+				const auto pData = spnData.data() + (llOffsetData - (iVecSize - llStep));
+				auto uiMask = 0U;
+				for (auto llPhase = 0LL; llPhase < static_cast<LONGLONG>(sizeof(T)); llPhase += llStep) {
+					uiMask |= MemCmpVecNumRange<stType.eVecSize, T>(pData + llPhase, tMin, tMax, fBigEndian);
+				}
+
+				if (uiMask != 0) {
+					for (auto llOffset = llOffsetData; llOffset > llOffsetData - iVecSize; llOffset -= llStep) {
+						if (lmbInRange(spnData.data() + llOffset)) {
+							return { ullOffsetSearch + llOffset, true, false };
+						}
+					}
+				}
+			}
+			else {
+				for (auto llOffset = llOffsetData; llOffset >= 0; llOffset -= llStep) {
+					if (lmbInRange(spnData.data() + llOffset)) {
+						return { ullOffsetSearch + llOffset, true, false };
+					}
+				}
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
+				}
+				pDlgProg->SetCurrent(ullStartFrom - (ullOffsetSearch + llOffsetData));
+			}
+		}
+
+		if ((ullOffsetSearch - ullChunkMaxOffset) < ullEnd || ((ullOffsetSearch - ullChunkMaxOffset) >
+			((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset))) {
+			ullChunkSize = (ullOffsetSearch - ullEnd) + nSizeSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+			ullOffsetSearch = ullEnd;
+		}
+		else {
+			ullOffsetSearch -= ullChunkMaxOffset;
+		}
+	}
+
+	return { };
+}
+#elif defined(_M_ARM64)  //^^^ _M_IX86 || _M_X64 / vvv _M_ARM64
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::CountFuncVecFwd(const SEARCHFUNCDATA& refSearch)->ULONGLONG
+{
+	return CHexDlgSearch::CountFuncFwd<stType>(refSearch);
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdByte1(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	return CHexDlgSearch::SearchFuncFwd<stType>(refSearch);
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdByte2(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	return CHexDlgSearch::SearchFuncFwd<stType>(refSearch);
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdByte4(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	return CHexDlgSearch::SearchFuncFwd<stType>(refSearch);
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdFilter(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	return CHexDlgSearch::SearchFuncFwd<stType>(refSearch);
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdLane(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	return CHexDlgSearch::SearchFuncFwd<stType>(refSearch);
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecFwdMask(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	return CHexDlgSearch::SearchFuncFwdMask<stType>(refSearch);
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecBackFilter(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	return CHexDlgSearch::SearchFuncBack<stType>(refSearch);
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncVecBackMask(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	return CHexDlgSearch::SearchFuncBackMask<stType>(refSearch);
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType, typename T>
+auto CHexDlgSearch::SearchFuncVecFwdNumRange(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	return CHexDlgSearch::SearchFuncFwdNumRange<stType, T>(refSearch);
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType, typename T>
+auto CHexDlgSearch::SearchFuncVecBackNumRange(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	return CHexDlgSearch::SearchFuncBackNumRange<stType, T>(refSearch);
+}
 #endif //^^^ _M_ARM64
 
 template<CHexDlgSearch::SEARCHTYPE stType>
-auto CHexDlgSearch::SearchFuncBack(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+auto CHexDlgSearch::SearchFuncBack(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Members locality is important for the best performance of the tight search loop below.
+	static constexpr auto LOOP_UNROLL_SIZE = 8U; //How many comparisons we do at one loop cycle.
+	const auto ullStartFrom = refSearch.ullStartFrom;
+	const auto ullEnd = refSearch.ullRngStart;
+	//Step is signed here to make the "llOffsetData - llStep" arithmetic also signed.
+	const auto llStep = static_cast<std::int64_t>(refSearch.ullStep);
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto fBigStep = refSearch.fBigStep;
+	const auto fInverted = refSearch.fInverted;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom - refSearch.ullChunkMaxOffset;
+
+	if (ullOffsetSearch < ullEnd || ullOffsetSearch >((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset)) {
+		ullChunkSize = (ullStartFrom - ullEnd) + nSizeSearch;
+		ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		ullOffsetSearch = ullEnd;
+	}
+
+	for (auto itChunk = ullChunks; itChunk > 0; --itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		for (auto llOffsetData = static_cast<LONGLONG>(ullChunkMaxOffset); llOffsetData >= 0;
+			llOffsetData -= llStep * LOOP_UNROLL_SIZE) { //llOffsetData might be negative.
+			//First memory comparison is always unconditional.
+			if (MemCmp<stType>(spnData.data() + llOffsetData, pDataSearch, nSizeSearch) == !fInverted) {
+				return { ullOffsetSearch + llOffsetData, true, false };
+			}
+
+			if ((llOffsetData - llStep * (LOOP_UNROLL_SIZE - 1)) >= 0) {
+				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 1), pDataSearch, nSizeSearch) == !fInverted) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 1), true, false };
+				}
+				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 2), pDataSearch, nSizeSearch) == !fInverted) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 2), true, false };
+				}
+				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 3), pDataSearch, nSizeSearch) == !fInverted) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 3), true, false };
+				}
+				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 4), pDataSearch, nSizeSearch) == !fInverted) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 4), true, false };
+				}
+				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 5), pDataSearch, nSizeSearch) == !fInverted) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 5), true, false };
+				}
+				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 6), pDataSearch, nSizeSearch) == !fInverted) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 6), true, false };
+				}
+				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 7), pDataSearch, nSizeSearch) == !fInverted) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 7), true, false };
+				}
+			}
+			else {
+				if ((llOffsetData - llStep * 1 >= 0)
+					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 1), pDataSearch, nSizeSearch) == !fInverted)) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 1), true, false };
+				}
+				if ((llOffsetData - llStep * 2 >= 0)
+					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 2), pDataSearch, nSizeSearch) == !fInverted)) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 2), true, false };
+				}
+				if ((llOffsetData - llStep * 3 >= 0)
+					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 3), pDataSearch, nSizeSearch) == !fInverted)) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 3), true, false };
+				}
+				if ((llOffsetData - llStep * 4 >= 0)
+					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 4), pDataSearch, nSizeSearch) == !fInverted)) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 4), true, false };
+				}
+				if ((llOffsetData - llStep * 5 >= 0)
+					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 5), pDataSearch, nSizeSearch) == !fInverted)) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 5), true, false };
+				}
+				if ((llOffsetData - llStep * 6 >= 0)
+					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 6), pDataSearch, nSizeSearch) == !fInverted)) {
+					return { ullOffsetSearch + (llOffsetData - llStep * 6), true, false };
+				}
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
+				}
+				pDlgProg->SetCurrent(ullStartFrom - (ullOffsetSearch + llOffsetData));
+			}
+		}
+
+		if (fBigStep) [[unlikely]] {
+			if ((ullOffsetSearch - llStep) < ullEnd || (ullOffsetSearch - llStep) > ((std::numeric_limits<ULONGLONG>::max)() - llStep))
+				break; //Lower bound reached.
+
+			ullOffsetSearch -= ullChunkMaxOffset;
+		}
+		else {
+			if ((ullOffsetSearch - ullChunkMaxOffset) < ullEnd || ((ullOffsetSearch - ullChunkMaxOffset) >
+				((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset))) {
+				ullChunkSize = (ullOffsetSearch - ullEnd) + nSizeSearch;
+				ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+				ullOffsetSearch = ullEnd;
+			}
+			else {
+				ullOffsetSearch -= ullChunkMaxOffset;
+			}
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncBackLong(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Boyer-Moore-Horspool backward search. The data byte under the first byte of the search data
+	//defines how far the next comparison can be shifted. The offset to compare at is kept absolute,
+	//to stay in line with the step across the chunks.
+	if (refSearch.fBigStep) { //Only one offset to compare at in a chunk, nothing to shift.
+		return SearchFuncBack<stType>(refSearch);
+	}
+
+	const auto ullStartFrom = refSearch.ullStartFrom;
+	const auto ullEnd = refSearch.ullRngStart;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto byteFirst = pDataSearch[0];
+	const auto& arrShift = refSearch.arrShift;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom - refSearch.ullChunkMaxOffset;
+	auto ullOffsetCmp = ullStartFrom;
+	auto ullIter = 0ULL;
+
+	if (ullOffsetSearch < ullEnd || ullOffsetSearch >((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset)) {
+		ullChunkSize = (ullStartFrom - ullEnd) + nSizeSearch;
+		ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		ullOffsetSearch = ullEnd;
+	}
+
+	for (auto itChunk = ullChunks; itChunk > 0; --itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		while (ullOffsetCmp >= ullOffsetSearch) {
+			const auto pData = spnData.data() + (ullOffsetCmp - ullOffsetSearch);
+			const auto byteKey = ToLowerASCII<stType>(*pData);
+			if (byteKey == byteFirst && MemCmp<stType>(pData, pDataSearch, nSizeSearch)) {
+				return { ullOffsetCmp, true, false };
+			}
+
+			const auto ullShift = arrShift[static_cast<std::uint8_t>(byteKey)];
+			if (ullOffsetCmp - ullEnd < ullShift)
+				return { }; //Lower bound reached.
+
+			ullOffsetCmp -= ullShift;
+
+			if constexpr (stType.fDlgProg) {
+				if ((++ullIter % 0x1000) == 0) {
+					if (pDlgProg->IsCanceled()) {
+						return { { }, false, true };
+					}
+					pDlgProg->SetCurrent(ullStartFrom - ullOffsetCmp);
+				}
+			}
+		}
+
+		if ((ullOffsetSearch - ullChunkMaxOffset) < ullEnd || ((ullOffsetSearch - ullChunkMaxOffset) >
+			((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset))) {
+			ullChunkSize = (ullOffsetSearch - ullEnd) + nSizeSearch;
+			ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+			ullOffsetSearch = ullEnd;
+		}
+		else {
+			ullOffsetSearch -= ullChunkMaxOffset;
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncBackFuzzy(const SEARCHFUNCDATA& refSearch)->FINDRESULT
 {
-	//Members locality is important for the best performance of the tight search loop below.
-	static constexpr auto LOOP_UNROLL_SIZE = 8U; //How many comparisons we do at one loop cycle.
+	//Backward Hamming distance search. The Bitap goes from the end of a chunk to its beginning,
+	//over the last up to 64 bytes of the search data taken in the reverse order.
+	constexpr auto nSizeBitapMax { sizeof(std::uint64_t) * 8 };
 	const auto ullStartFrom = refSearch.ullStartFrom;
 	const auto ullEnd = refSearch.ullRngStart;
 	//Step is signed here to make the "llOffsetData - llStep" arithmetic also signed.
 	const auto llStep = static_cast<std::int64_t>(refSearch.ullStep);
-	const auto pHexCtrl = refSearch.pHexCtrl;
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
 	const auto pDlgProg = refSearch.pDlgProg;
 	const auto pDataSearch = refSearch.spnFind.data();
+	const auto pDataMask = refSearch.spnMask.data();
 	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto nMismatch = static_cast<std::size_t>(refSearch.dwMismatch);
+	const auto nSizeBitap = (std::min)(nSizeSearch, nSizeBitapMax);
+	const auto nOffsetBitap = nSizeSearch - nSizeBitap; //Offset of the Bitap bytes within the search data.
 	const auto fBigStep = refSearch.fBigStep;
 	const auto fInverted = refSearch.fInverted;
+	const auto fBitap = llStep == 1 && !fInverted && nMismatch < nSizeBitap;
 	const auto ullChunks = refSearch.ullChunks;
 	auto ullChunkSize = refSearch.ullChunkSize;
 	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
 	auto ullOffsetSearch = refSearch.ullStartFrom - refSearch.ullChunkMaxOffset;
+	std::array<std::uint64_t, 256> arrByteBits { }; //Bit N is set if the byte matches the search byte N from the end.
+	std::vector<std::uint64_t> vecState(nMismatch + 1);
+	const auto u64StateFound = 1ULL << (nSizeBitap - 1);
+
+	if (fBitap) {
+		for (auto itByte = 0U; itByte < arrByteBits.size(); ++itByte) {
+			for (auto itBit = 0U; itBit < nSizeBitap; ++itBit) {
+				if ((static_cast<std::byte>(itByte) & pDataMask[nSizeSearch - 1 - itBit]) == pDataSearch[nSizeSearch - 1 - itBit]) {
+					arrByteBits[itByte] |= 1ULL << itBit;
+				}
+			}
+		}
+	}
 
 	if (ullOffsetSearch < ullEnd || ullOffsetSearch >((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset)) {
 		ullChunkSize = (ullStartFrom - ullEnd) + nSizeSearch;
@@ -2459,65 +5126,204 @@ auto CHexDlgSearch::SearchFuncBack(const SEARCHFUNCDATA& refSearch)->FINDRESULT
 	}
 
 	for (auto itChunk = ullChunks; itChunk > 0; --itChunk) {
-		const auto spnData = pHexCtrl->GetData({ ullOffsetSearch, ullChunkSize });
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
 		assert(!spnData.empty());
 		assert(spnData.size() >= ullChunkSize);
 
-		for (auto llOffsetData = static_cast<LONGLONG>(ullChunkMaxOffset); llOffsetData >= 0;
-			llOffsetData -= llStep * LOOP_UNROLL_SIZE) { //llOffsetData might be negative.
-			//First memory comparison is always unconditional.
-			if (MemCmp<stType>(spnData.data() + llOffsetData, pDataSearch, nSizeSearch) == !fInverted) {
-				return { ullOffsetSearch + llOffsetData, true, false };
-			}
-
-			if ((llOffsetData - llStep * (LOOP_UNROLL_SIZE - 1)) >= 0) {
-				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 1), pDataSearch, nSizeSearch) == !fInverted) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 1), true, false };
+		if (fBitap) {
+			//The found Bitap bytes at the llOffsetData make the whole search data start at the nOffsetBitap before.
+			std::fill(vecState.begin(), vecState.end(), 0ULL);
+			const auto llOffsetDataEnd = static_cast<LONGLONG>(nOffsetBitap);
+			for (auto llOffsetData = static_cast<LONGLONG>(ullChunkMaxOffset + nSizeSearch - 1);
+				llOffsetData >= llOffsetDataEnd; --llOffsetData) {
+				const auto u64ByteBits = arrByteBits[static_cast<std::uint8_t>(spnData[llOffsetData])];
+				auto u64StatePrev = vecState[0];
+				vecState[0] = ((u64StatePrev << 1) | 1) & u64ByteBits;
+				for (auto itState = 1U; itState <= nMismatch; ++itState) { //Either the byte matches, or it's one more mismatch.
+					const auto u64StateCurr = vecState[itState];
+					vecState[itState] = (((u64StateCurr << 1) | 1) & u64ByteBits) | ((u64StatePrev << 1) | 1);
+					u64StatePrev = u64StateCurr;
 				}
-				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 2), pDataSearch, nSizeSearch) == !fInverted) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 2), true, false };
-				}
-				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 3), pDataSearch, nSizeSearch) == !fInverted) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 3), true, false };
-				}
-				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 4), pDataSearch, nSizeSearch) == !fInverted) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 4), true, false };
+
+				if ((vecState[nMismatch] & u64StateFound) != 0) {
+					const auto ullOffsetFound = static_cast<ULONGLONG>(llOffsetData) - nOffsetBitap;
+					if (nSizeSearch == nSizeBitap || MemCmpMaskDist<stType.eVecSize>(spnData.data() + ullOffsetFound,
+						pDataSearch, pDataMask, nSizeSearch, nMismatch) <= nMismatch) {
+						return { ullOffsetSearch + ullOffsetFound, true, false };
+					}
 				}
-				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 5), pDataSearch, nSizeSearch) == !fInverted) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 5), true, false };
+
+				if constexpr (stType.fDlgProg) {
+					if ((llOffsetData & 0xFFFFLL) == 0) {
+						if (pDlgProg->IsCanceled()) {
+							return { { }, false, true };
+						}
+						pDlgProg->SetCurrent(ullStartFrom - (ullOffsetSearch + llOffsetData));
+					}
 				}
-				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 6), pDataSearch, nSizeSearch) == !fInverted) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 6), true, false };
+			}
+		}
+		else {
+			for (auto llOffsetData = static_cast<LONGLONG>(ullChunkMaxOffset); llOffsetData >= 0; llOffsetData -= llStep) {
+				if ((MemCmpMaskDist<stType.eVecSize>(spnData.data() + llOffsetData, pDataSearch, pDataMask, nSizeSearch,
+					nMismatch) <= nMismatch) == !fInverted) {
+					return { ullOffsetSearch + llOffsetData, true, false };
 				}
-				if (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 7), pDataSearch, nSizeSearch) == !fInverted) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 7), true, false };
+
+				if constexpr (stType.fDlgProg) {
+					if (pDlgProg->IsCanceled()) {
+						return { { }, false, true };
+					}
+					pDlgProg->SetCurrent(ullStartFrom - (ullOffsetSearch + llOffsetData));
 				}
 			}
+		}
+
+		if (fBigStep) [[unlikely]] {
+			if ((ullOffsetSearch - llStep) < ullEnd || (ullOffsetSearch - llStep) > ((std::numeric_limits<ULONGLONG>::max)() - llStep))
+				break; //Lower bound reached.
+
+			ullOffsetSearch -= ullChunkMaxOffset;
+		}
+		else {
+			if ((ullOffsetSearch - ullChunkMaxOffset) < ullEnd || ((ullOffsetSearch - ullChunkMaxOffset) >
+				((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset))) {
+				ullChunkSize = (ullOffsetSearch - ullEnd) + nSizeSearch;
+				ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+				ullOffsetSearch = ullEnd;
+			}
 			else {
-				if ((llOffsetData - llStep * 1 >= 0)
-					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 1), pDataSearch, nSizeSearch) == !fInverted)) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 1), true, false };
-				}
-				if ((llOffsetData - llStep * 2 >= 0)
-					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 2), pDataSearch, nSizeSearch) == !fInverted)) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 2), true, false };
-				}
-				if ((llOffsetData - llStep * 3 >= 0)
-					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 3), pDataSearch, nSizeSearch) == !fInverted)) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 3), true, false };
-				}
-				if ((llOffsetData - llStep * 4 >= 0)
-					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 4), pDataSearch, nSizeSearch) == !fInverted)) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 4), true, false };
-				}
-				if ((llOffsetData - llStep * 5 >= 0)
-					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 5), pDataSearch, nSizeSearch) == !fInverted)) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 5), true, false };
-				}
-				if ((llOffsetData - llStep * 6 >= 0)
-					&& (MemCmp<stType>(spnData.data() + (llOffsetData - llStep * 6), pDataSearch, nSizeSearch) == !fInverted)) {
-					return { ullOffsetSearch + (llOffsetData - llStep * 6), true, false };
+				ullOffsetSearch -= ullChunkMaxOffset;
+			}
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncBackIndex(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Candidates are taken from the search index, instead of going through all the data.
+	const auto pDlgProg = stType.fDlgProg ? refSearch.pDlgProg : nullptr;
+	if (const auto optOffset = refSearch.pIndex->FindBack(refSearch.spnFind, refSearch.ullRngStart, refSearch.ullStartFrom,
+		refSearch.ullStep, pDlgProg); optOffset) {
+		return { *optOffset, true, false };
+	}
+
+	if constexpr (stType.fDlgProg) {
+		if (pDlgProg->IsCanceled()) {
+			return { { }, false, true };
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType>
+auto CHexDlgSearch::SearchFuncBackMask(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Hex bytes with the wildcards, compared under the mask at every step offset, backward.
+	const auto ullStartFrom = refSearch.ullStartFrom;
+	const auto ullEnd = refSearch.ullRngStart;
+	//Step is signed here to make the "llOffsetData - llStep" arithmetic also signed.
+	const auto llStep = static_cast<std::int64_t>(refSearch.ullStep);
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pDataSearch = refSearch.spnFind.data();
+	const auto pDataMask = refSearch.spnMask.data();
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto fBigStep = refSearch.fBigStep;
+	const auto fInverted = refSearch.fInverted;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom - refSearch.ullChunkMaxOffset;
+
+	if (ullOffsetSearch < ullEnd || ullOffsetSearch >((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset)) {
+		ullChunkSize = (ullStartFrom - ullEnd) + nSizeSearch;
+		ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		ullOffsetSearch = ullEnd;
+	}
+
+	for (auto itChunk = ullChunks; itChunk > 0; --itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		for (auto llOffsetData = static_cast<LONGLONG>(ullChunkMaxOffset); llOffsetData >= 0; llOffsetData -= llStep) {
+			if (MemCmpMask<stType.eVecSize>(spnData.data() + llOffsetData, pDataSearch, pDataMask, nSizeSearch) == !fInverted) {
+				return { ullOffsetSearch + llOffsetData, true, false };
+			}
+
+			if constexpr (stType.fDlgProg) {
+				if (pDlgProg->IsCanceled()) {
+					return { { }, false, true };
 				}
+				pDlgProg->SetCurrent(ullStartFrom - (ullOffsetSearch + llOffsetData));
+			}
+		}
+
+		if (fBigStep) [[unlikely]] {
+			if ((ullOffsetSearch - llStep) < ullEnd || (ullOffsetSearch - llStep) > ((std::numeric_limits<ULONGLONG>::max)() - llStep))
+				break; //Lower bound reached.
+
+			ullOffsetSearch -= ullChunkMaxOffset;
+		}
+		else {
+			if ((ullOffsetSearch - ullChunkMaxOffset) < ullEnd || ((ullOffsetSearch - ullChunkMaxOffset) >
+				((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset))) {
+				ullChunkSize = (ullOffsetSearch - ullEnd) + nSizeSearch;
+				ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+				ullOffsetSearch = ullEnd;
+			}
+			else {
+				ullOffsetSearch -= ullChunkMaxOffset;
+			}
+		}
+	}
+
+	return { };
+}
+
+template<CHexDlgSearch::SEARCHTYPE stType, typename T>
+auto CHexDlgSearch::SearchFuncBackNumRange(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//Numbers of the T type within the tMin-tMax range, at every step offset, backward.
+	const auto ullStartFrom = refSearch.ullStartFrom;
+	const auto ullEnd = refSearch.ullRngStart;
+	//Step is signed here to make the "llOffsetData - llStep" arithmetic also signed.
+	const auto llStep = static_cast<std::int64_t>(refSearch.ullStep);
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto nSizeSearch = refSearch.spnFind.size();
+	const auto tMin = ut::LoadTData<T>(refSearch.arrNumMin.data(), false);
+	const auto tMax = ut::LoadTData<T>(refSearch.arrNumMax.data(), false);
+	const auto fBigEndian = refSearch.fBigEndian;
+	const auto fBigStep = refSearch.fBigStep;
+	const auto fInverted = refSearch.fInverted;
+	const auto ullChunks = refSearch.ullChunks;
+	auto ullChunkSize = refSearch.ullChunkSize;
+	auto ullChunkMaxOffset = refSearch.ullChunkMaxOffset;
+	auto ullOffsetSearch = refSearch.ullStartFrom - refSearch.ullChunkMaxOffset;
+
+	if (ullOffsetSearch < ullEnd || ullOffsetSearch >((std::numeric_limits<ULONGLONG>::max)() - ullChunkMaxOffset)) {
+		ullChunkSize = (ullStartFrom - ullEnd) + nSizeSearch;
+		ullChunkMaxOffset = ullChunkSize - nSizeSearch;
+		ullOffsetSearch = ullEnd;
+	}
+
+	for (auto itChunk = ullChunks; itChunk > 0; --itChunk) {
+		const auto spnData = reader.GetData({ ullOffsetSearch, ullChunkSize });
+		assert(!spnData.empty());
+		assert(spnData.size() >= ullChunkSize);
+
+		for (auto llOffsetData = static_cast<LONGLONG>(ullChunkMaxOffset); llOffsetData >= 0; llOffsetData -= llStep) {
+			const auto tData = ut::LoadTData<T>(spnData.data() + llOffsetData, fBigEndian);
+			if ((tData >= tMin && tData <= tMax) == !fInverted) {
+				return { ullOffsetSearch + llOffsetData, true, false };
 			}
 
 			if constexpr (stType.fDlgProg) {
@@ -2547,5 +5353,183 @@ auto CHexDlgSearch::SearchFuncBack(const SEARCHFUNCDATA& refSearch)->FINDRESULT
 		}
 	}
 
+	return { };
+}
+
+template<bool fDlgProg>
+auto CHexDlgSearch::SearchFuncRegexFwd(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//The forward unanchored DFA finds the first match end, from the lowest offset not searched yet.
+	//Every match that starts up to this end is then known by the reverse unanchored DFA, its match states
+	//are the match starts. It's run back from the end itself first, the lowest offset is often the start.
+	//Otherwise it's run back from where all such matches end: the max match size past the end, or where
+	//the forward anchored DFA of the matches that started up to the end is dead.
+	//The data is read in chunks, the DFA states are carried over between them.
+	const auto ullStartFrom = refSearch.ullStartFrom;
+	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
+	const auto ullStep = refSearch.ullStep;
+	const auto pHexCtrl = refSearch.pHexCtrl;
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pRegex = refSearch.pRegex;
+	const auto optMax = pRegex->GetMaxSize();
+	if (ullStartFrom + pRegex->GetMinSize() > ullOffsetSentinel)
+		return { };
+
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto ullChunkSizeMax = pHexCtrl->IsVirtual() ? static_cast<ULONGLONG>(pHexCtrl->GetCacheSize()) :
+		ullOffsetSentinel - ullStartFrom;
+	CHexRegexDFA dfaFwd(*pRegex, false, true);
+	CHexRegexDFA dfaBack(*pRegex, true, true);
+	std::optional<CHexRegexDFA> optDFAAnch; //For the unbounded expression only.
+	bool fCanceled { false };
+	const auto lmbIsCanceled = [&]() {
+		if constexpr (fDlgProg) {
+			fCanceled = fCanceled || pDlgProg->IsCanceled();
+		}
+		return fCanceled;
+		};
+	//The func(ullOffset) is called with every offset a match ends at, inclusive, it returns false to stop.
+	const auto lmbRunFwd = [&](CHexRegexDFA& refDFA, std::uint32_t& refState, ULONGLONG ullFirst, const auto& func) {
+		for (auto ullOffset = ullFirst; ullOffset < ullOffsetSentinel && !lmbIsCanceled();) {
+			const auto ullSize = (std::min)(ullChunkSizeMax, ullOffsetSentinel - ullOffset);
+			if (!refDFA.Run<false>(reader.GetData({ ullOffset, ullSize }), refState,
+				[&](std::size_t sIndex) { return func(ullOffset + sIndex); }))
+				return;
+
+			ullOffset += ullSize;
+			if constexpr (fDlgProg) {
+				pDlgProg->SetCurrent(ullOffset);
+			}
+		}
+		};
+	//The func(ullOffset) is called with every offset a match starts at, in the descending order.
+	const auto lmbRunBack = [&](ULONGLONG ullFirst, ULONGLONG ullDataEnd, const auto& func) {
+		auto u32State = dfaBack.GetStartState();
+		for (auto ullOffsetEnd = ullDataEnd; ullOffsetEnd > ullFirst && !lmbIsCanceled();) {
+			const auto ullSize = (std::min)(ullChunkSizeMax, ullOffsetEnd - ullFirst);
+			const auto ullOffset = ullOffsetEnd - ullSize;
+			if (!dfaBack.Run<true>(reader.GetData({ ullOffset, ullSize }), u32State,
+				[&](std::size_t sIndex) { return func(ullOffset + sIndex); }))
+				return;
+
+			ullOffsetEnd = ullOffset;
+		}
+		};
+
+	auto ullLow = ullStartFrom; //Lowest offset not searched yet.
+	while (ullLow < ullOffsetSentinel) {
+		auto u32State = dfaFwd.GetStartState();
+		std::optional<ULONGLONG> optEnd;
+		lmbRunFwd(dfaFwd, u32State, ullLow, [&](ULONGLONG ullOffset) { optEnd = ullOffset; return false; });
+		if (!optEnd || lmbIsCanceled())
+			return { { }, false, fCanceled };
+
+		const auto ullEnd = *optEnd;
+		const auto ullLowInStep = ullLow + ((ullStep - ((ullLow - ullStartFrom) % ullStep)) % ullStep);
+		std::optional<ULONGLONG> optStart;
+		const auto lmbStart = [&](ULONGLONG ullOffset) {
+			if (ullOffset <= ullEnd && (ullOffset - ullStartFrom) % ullStep == 0) {
+				optStart = ullOffset; //The last one is the lowest.
+			}
+			return true;
+			};
+
+		lmbRunBack(ullLow, ullEnd + 1, lmbStart); //Matches that end at the ullEnd.
+		if (!optStart || *optStart != ullLowInStep) {
+			auto ullDataEnd = ullEnd + 1; //Where all the matches that start up to the ullEnd end.
+			if (optMax) {
+				ullDataEnd = *optMax >= ullOffsetSentinel - ullEnd ? ullOffsetSentinel : ullEnd + *optMax;
+			}
+			else {
+				if (!optDFAAnch) {
+					optDFAAnch.emplace(*pRegex, false, false);
+				}
+				auto u32StateAnch = optDFAAnch->ImportState(dfaFwd, u32State);
+				lmbRunFwd(*optDFAAnch, u32StateAnch, ullEnd + 1, [&](ULONGLONG ullOffset) { ullDataEnd = ullOffset + 1; return true; });
+			}
+
+			if (ullDataEnd > ullEnd + 1) {
+				lmbRunBack(ullLow, ullDataEnd, lmbStart);
+			}
+		}
+
+		if (lmbIsCanceled())
+			return { { }, false, true };
+
+		if (optStart)
+			return { *optStart, true, false };
+
+		ullLow = ullEnd + 1; //No match starts up to the ullEnd.
+	}
+
+	return { };
+}
+
+template<bool fDlgProg>
+auto CHexDlgSearch::SearchFuncRegexBack(const SEARCHFUNCDATA& refSearch)->FINDRESULT
+{
+	//The reverse unanchored DFA is run back from where all the matches that start up to the ullStartFrom end:
+	//the max match size past it, or the range end for the unbounded expression. Its first match state
+	//that is in line with the step is the match start. The unbounded expression's match at the ullStartFrom
+	//itself is checked first, by the forward anchored DFA within one chunk.
+	//The data is read in chunks backward, the DFA state is carried over between them.
+	const auto ullStartFrom = refSearch.ullStartFrom;
+	const auto ullOffsetSentinel = refSearch.ullRngEnd + 1;
+	const auto ullEnd = refSearch.ullRngStart;
+	const auto ullStep = refSearch.ullStep;
+	const auto pHexCtrl = refSearch.pHexCtrl;
+	const auto pDlgProg = refSearch.pDlgProg;
+	const auto pRegex = refSearch.pRegex;
+	const auto optMax = pRegex->GetMaxSize();
+	if (ullStartFrom + pRegex->GetMinSize() > ullOffsetSentinel)
+		return { };
+
+	std::optional<CHexReader> optReader;
+	auto& reader = GetReader(refSearch, optReader);
+	const auto ullChunkSizeMax = pHexCtrl->IsVirtual() ? static_cast<ULONGLONG>(pHexCtrl->GetCacheSize()) :
+		ullOffsetSentinel - ullEnd;
+	if (!optMax) {
+		const auto spnData = reader.GetData({ ullStartFrom, (std::min)(ullChunkSizeMax, ullOffsetSentinel - ullStartFrom) });
+		if (pRegex->IsFirstByte(spnData[0])) {
+			CHexRegexDFA dfaAnch(*pRegex, false, false);
+			auto u32State = dfaAnch.GetStartState();
+			bool fMatch { false };
+			dfaAnch.Run<false>(spnData, u32State, [&fMatch](std::size_t) { fMatch = true; return false; });
+			if (fMatch)
+				return { ullStartFrom, true, false };
+		}
+	}
+
+	CHexRegexDFA dfaBack(*pRegex, true, true);
+	auto u32State = dfaBack.GetStartState();
+	std::optional<ULONGLONG> optStart;
+	const auto ullDataEnd = optMax && *optMax < ullOffsetSentinel - ullStartFrom ? ullStartFrom + *optMax : ullOffsetSentinel;
+	for (auto ullOffsetEnd = ullDataEnd; ullOffsetEnd > ullEnd;) {
+		const auto ullSize = (std::min)(ullChunkSizeMax, ullOffsetEnd - ullEnd);
+		const auto ullOffset = ullOffsetEnd - ullSize;
+		if (!dfaBack.Run<true>(reader.GetData({ ullOffset, ullSize }), u32State, [&](std::size_t sIndex) {
+			const auto ullOffsetStart = ullOffset + sIndex;
+			if (ullOffsetStart <= ullStartFrom && (ullStartFrom - ullOffsetStart) % ullStep == 0) {
+				optStart = ullOffsetStart;
+				return false;
+			}
+			return true; }))
+			break;
+
+		ullOffsetEnd = ullOffset;
+		if constexpr (fDlgProg) {
+			if (pDlgProg->IsCanceled()) {
+				return { { }, false, true };
+			}
+			if (ullOffsetEnd <= ullStartFrom) {
+				pDlgProg->SetCurrent(ullStartFrom - ullOffsetEnd);
+			}
+		}
+	}
+
+	if (optStart)
+		return { *optStart, true, false };
+
 	return { };
 }
\ No newline at end of file
@@ -8,22 +8,34 @@
 #include "../../HexCtrl.h"
 #include <commctrl.h>
 #include <chrono>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 import HEXCTRL.HexUtility;
 import HEXCTRL.CHexDlgProgress;
+import HEXCTRL.CHexParallel;
+import HEXCTRL.CHexReader;
+import HEXCTRL.CHexRegex;
+import HEXCTRL.CHexSearchCache;
+import HEXCTRL.CHexSearchIndex;
+import HEXCTRL.CHexSearchResult;
 
 namespace HEXCTRL::INTERNAL {
+	class CHexSearchAsync;
 	class CHexDlgSearch final {
 	public:
+		void CancelSearchAsync(); //Cancels the SearchAsync searches and waits for them, before the data changes.
 		void ClearData();
 		void CreateDlg();
 		void DestroyDlg();
 		[[nodiscard]] auto GetDlgItemHandle(EHexDlgItem eItem)const->HWND;
 		[[nodiscard]] auto GetHWND()const->HWND;
-		void Initialize(IHexCtrl* pHexCtrl, HINSTANCE hInstRes);
+		void Initialize(IHexCtrl* pHexCtrl, HINSTANCE hInstRes, const CHexSearchIndex* pSearchIndex, CHexSearchCache* pSearchCache);
 		[[nodiscard]] bool IsSearchAvail()const; //Can we do search next/prev?
 		[[nodiscard]] bool PreTranslateMsg(MSG* pMsg);
 		[[nodiscard]] auto ProcessMsg(const MSG& msg) -> INT_PTR;
+		[[nodiscard]] auto SearchAsync(const HEXSEARCH& hss)const->IHexSearchPtr; //Search without the dialog.
 		void SearchNextPrev(bool fForward);
 		void SetDlgProperties(std::uint64_t u64Flags);
 		void ShowWindow(int iCmdShow);
@@ -35,18 +47,22 @@ namespace HEXCTRL::INTERNAL {
 		struct SEARCHFUNCDATA;
 		struct FINDRESULT;
 		using PtrSearchFunc = auto(*)(const SEARCHFUNCDATA&)->FINDRESULT;
-		using VecSearchResult = std::vector<ULONGLONG>;
+		using PtrCountFunc = auto(*)(const SEARCHFUNCDATA&)->ULONGLONG;
 
 		void AddToList(ULONGLONG ullOffset);
-		void CalcMemChunks(SEARCHFUNCDATA& refData)const;
 		void ClearComboType();
 		void ClearList();
 		void ComboSearchFill(LPCWSTR pwsz);
 		void ComboReplaceFill(LPCWSTR pwsz);
 		[[nodiscard]] auto CreateSearchData(CHexDlgProgress* pDlgProg = nullptr)const->SEARCHFUNCDATA;
-		void FindAll();
+		void FindAll(); //Finds all the occurrences, or only counts them if the m_fCount is set.
 		void FindForward();
 		void FindBackward();
+		[[nodiscard]] auto GetCacheKey()const->std::vector<std::byte>; //Everything the found offsets depend on, but the start.
+		[[nodiscard]] auto GetCountFunc()const->PtrCountFunc; //Counting function, or nullptr if not applicable.
+		template<EVecSize eVecSize>
+		[[nodiscard]] auto GetCountFuncFwd()const->PtrCountFunc;
+		[[nodiscard]] auto GetFoundSize(ULONGLONG ullOffset)const->ULONGLONG; //Size of the found occurrence at the offset.
 		[[nodiscard]] auto GetHexCtrl()const->IHexCtrl*;
 		[[nodiscard]] auto GetLastSearchOffset()const->ULONGLONG;
 		[[nodiscard]] auto GetRngStart()const->ULONGLONG;
@@ -54,13 +70,17 @@ namespace HEXCTRL::INTERNAL {
 		[[nodiscard]] auto GetRngSize()const->ULONGLONG;     //Size of the range to search within.
 		[[nodiscard]] auto GetReplaceDataSize()const->DWORD; //Replace vec data size.
 		[[nodiscard]] auto GetReplaceSpan()const->SpanCByte;
-		[[nodiscard]] auto GetSearchDataSize()const->DWORD;  //Search vec data size.
+		[[nodiscard]] auto GetSearchDataSize()const->DWORD;  //Search vec data size, or the min match size for the regex.
 		[[nodiscard]] auto GetSearchRngSize()const->ULONGLONG;
 		[[nodiscard]] auto GetSearchFunc(bool fFwd, bool fDlgProg)const->PtrSearchFunc;
+		template<EVecSize eVecSize>
+		[[nodiscard]] static auto GetSearchFuncAsync(const HEXSEARCH& hss)->PtrSearchFunc;
 		template<bool fDlgProg, EVecSize eVecSize>
 		[[nodiscard]] auto GetSearchFuncFwd()const->PtrSearchFunc;
 		template<bool fDlgProg, EVecSize eVecSize>
 		[[nodiscard]] auto GetSearchFuncBack()const->PtrSearchFunc;
+		template<bool fDlgProg, EVecSize eVecSize>
+		[[nodiscard]] auto GetSearchFuncNumRange(bool fFwd)const->PtrSearchFunc;
 		[[nodiscard]] auto GetSearchMode()const->ESearchMode; //Getcurrent search mode.
 		[[nodiscard]] auto GetSearchSpan()const->SpanCByte;
 		[[nodiscard]] auto GetSearchType()const->ESearchType; //Get current search type.
@@ -69,11 +89,18 @@ namespace HEXCTRL::INTERNAL {
 		[[nodiscard]] auto GetStep()const->ULONGLONG;
 		void HexCtrlHighlight(const VecSpan& vecSel); //Highlight found occurence in the HexCtrl.
 		[[nodiscard]] bool IsBigEndian()const;
+		[[nodiscard]] bool IsCacheable()const; //Occurrences are of the fixed size, the cached results can be patched.
 		[[nodiscard]] bool IsForward()const;
 		[[nodiscard]] bool IsFreshSearch()const;
+		[[nodiscard]] bool IsFuzzy()const;
+		[[nodiscard]] bool IsHexWildcard()const;
+		[[nodiscard]] bool IsIndexSearch()const; //Exact search data that the search index can be used for.
 		[[nodiscard]] bool IsInverted()const;
+		[[nodiscard]] bool IsLongSearch()const; //Search data is long enough for the shift-table search.
 		[[nodiscard]] bool IsMatchCase()const;
 		[[nodiscard]] bool IsNoEsc()const;
+		[[nodiscard]] bool IsNumRange()const; //Numbers within the min/max range, rather than the exact number.
+		[[nodiscard]] bool IsRegex()const;
 		[[nodiscard]] bool IsReplace()const;
 		[[nodiscard]] bool IsSelection()const;
 		[[nodiscard]] bool IsSmallSearch()const;
@@ -82,6 +109,7 @@ namespace HEXCTRL::INTERNAL {
 		void OnButtonSearchF();
 		void OnButtonSearchB();
 		void OnButtonFindAll();
+		void OnButtonCountAll();
 		void OnButtonReplace();
 		void OnButtonReplaceAll();
 		void OnCancel();
@@ -102,23 +130,38 @@ namespace HEXCTRL::INTERNAL {
 		void OnOK();
 		void OnSelectModeHEXBYTES();
 		void OnSelectModeNUMBERS();
+		void OnSelectModeREGEX();
 		void OnSelectModeSTRUCT();
 		void OnSearchModeTEXT();
+		[[nodiscard]] bool PatchCached(CHexSearchCache::CACHED& refCached)const; //Searches again near the modified data.
 		void Prepare();
 		[[nodiscard]] bool PrepareHexBytes();
+		[[nodiscard]] bool PrepareRegex();
 		[[nodiscard]] bool PrepareTextASCII();
 		[[nodiscard]] bool PrepareTextUTF16();
 		[[nodiscard]] bool PrepareTextUTF8();
 		template<typename T> requires ut::TSize1248<T>
 		[[nodiscard]] bool PrepareNumber();
 		[[nodiscard]] bool PrepareFILETIME();
+		void PutCached(CHexSearchCache::CACHED&& refCached);
+		void RemoveSearchAsync(CHexSearchAsync* pSearch)const; //The search is being deleted.
 		void ReplaceAll();
 		void ResetSearch();
 		void Search();
 		void SetControlsState();
 		void SetEditStartFrom(ULONGLONG ullOffset); //Start search offset edit set.
+		void SetFoundAll(); //Found state, Find Next offset and list count after the Find All.
+		void SetListCount(); //List items count from the search results count.
+		//Cached result of the current search, that has all the occurrences from the ullFrom, or the ones before it if !fFwd.
+		//The result is patched to the current data, it's taken out of the cache and must be put back with the PutCached.
+		[[nodiscard]] auto TakeCached(ULONGLONG ullFrom, bool fFwd)->std::optional<CHexSearchCache::CACHED>;
 	private:
 		//Static functions.
+		static void CalcMemChunks(SEARCHFUNCDATA& refData, bool fFwd);
+		[[nodiscard]] static bool CalcMemChunksNext(SEARCHFUNCDATA& refData, ULONGLONG ullOffsetNext); //Forward only.
+		static void CalcShifts(SEARCHFUNCDATA& refData, bool fFwd); //Shifts for the long search data.
+		//The refSearch's shared reader, or the one emplaced in the refOptReader.
+		[[nodiscard]] static auto GetReader(const SEARCHFUNCDATA& refSearch, std::optional<CHexReader>& refOptReader)->CHexReader&;
 		static void Replace(IHexCtrl* pHexCtrl, ULONGLONG ullIndex, SpanCByte spnReplace);
 		enum class EMemCmp : std::uint8_t { DATA_BYTE1, DATA_BYTE2, DATA_BYTE4, DATA_BYTE8, CHAR_STR, WCHAR_STR };
 		enum class EVecSize : std::uint8_t { VEC128 = 16, VEC256 = 32 /*SSE4.2 = sizeof(__m128), AVX2 = sizeof(__m256).*/ };
@@ -139,6 +182,18 @@ namespace HEXCTRL::INTERNAL {
 		};
 		template<SEARCHTYPE stType>
 		[[nodiscard]] static auto __forceinline MemCmp(const std::byte* pWhere, const std::byte* pWhat, std::size_t nSize)->bool;
+		//Compares only the bits set in the pMask, pWhat must have all the other bits zeroed.
+		template<EVecSize eVecSize>
+		[[nodiscard]] static auto __forceinline MemCmpMask(const std::byte* pWhere, const std::byte* pWhat,
+			const std::byte* pMask, std::size_t nSize)->bool;
+		//Number of the bytes that differ under the pMask, counting stops as soon as it exceeds the nMax.
+		template<EVecSize eVecSize>
+		[[nodiscard]] static auto __forceinline MemCmpMaskDist(const std::byte* pWhere, const std::byte* pWhat,
+			const std::byte* pMask, std::size_t nSize, std::size_t nMax)->std::size_t;
+		//Indexes of the two bytes to filter the masked search data by, the fully defined bytes are preferred.
+		[[nodiscard]] static auto GetMaskAnchors(SpanCByte spnMask) -> std::pair<std::size_t, std::size_t>;
+		//Bit mask of the vector's offsets that are in line with the step: 1, 2, 4, 8 or 16.
+		[[nodiscard]] static auto GetStepMask(ULONGLONG ullStep) -> std::uint32_t;
 		//Vector functions return index within the vector of found element.
 		//Index greater than sizeof(vec)-1 means not found.
 		template<EVecSize eVecSize>
@@ -153,6 +208,32 @@ namespace HEXCTRL::INTERNAL {
 		[[nodiscard]] static auto __forceinline MemCmpVecEQByte4(const std::byte* pWhere, std::uint32_t ui32What)->int;
 		template<EVecSize eVecSize>
 		[[nodiscard]] static auto __forceinline MemCmpVecNEQByte4(const std::byte* pWhere, std::uint32_t ui32What)->int;
+		//Bit mask of the vector's offsets where the first and the last bytes of the nSize data both match.
+		//Not fMatchCase lowers the ASCII letters in the vectors before the comparison.
+		template<EVecSize eVecSize, bool fMatchCase>
+		[[nodiscard]] static auto __forceinline MemCmpVecEQFirstLast(const std::byte* pWhere, std::size_t nSize,
+			std::byte bFirst, std::byte bLast)->std::uint32_t;
+		//Bit mask of the vector's offsets where all the nSize bytes of the pWhat match, nSize is at most 4.
+		template<EVecSize eVecSize>
+		[[nodiscard]] static auto __forceinline MemCmpVecEQShort(const std::byte* pWhere, const std::byte* pWhat,
+			std::size_t nSize)->std::uint32_t;
+		//Bit mask of the vector's lanes of the nSize bytes (2, 4 or 8) that are equal to the pWhat, all lane's bits are set.
+		template<EVecSize eVecSize>
+		[[nodiscard]] static auto __forceinline MemCmpVecEQLane(const std::byte* pWhere, const std::byte* pWhat,
+			std::size_t nSize)->std::uint32_t;
+		//Bit mask of the vector's numbers of the T type that are within the tMin-tMax range.
+		template<EVecSize eVecSize, typename T>
+		[[nodiscard]] static auto __forceinline MemCmpVecNumRange(const std::byte* pWhere, T tMin, T tMax,
+			bool fBigEndian)->std::uint32_t;
+		//Bit mask of the vector's offsets where the masked bytes at the nIndex1 and the nIndex2 both match.
+		template<EVecSize eVecSize>
+		[[nodiscard]] static auto __forceinline MemCmpVecEQMask(const std::byte* pWhere, const std::byte* pWhat,
+			const std::byte* pMask, std::size_t nIndex1, std::size_t nIndex2)->std::uint32_t;
+		//Count functions return the count of the occurrences from the ullStartFrom to the ullRngEnd, with the step 1.
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto CountFuncFwd(const SEARCHFUNCDATA& refSearch) -> ULONGLONG;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto CountFuncVecFwd(const SEARCHFUNCDATA& refSearch) -> ULONGLONG;
 		template<SEARCHTYPE stType>
 		[[nodiscard]] static auto SearchFuncFwd(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
 		template<SEARCHTYPE stType>
@@ -162,7 +243,47 @@ namespace HEXCTRL::INTERNAL {
 		template<SEARCHTYPE stType>
 		[[nodiscard]] static auto SearchFuncVecFwdByte4(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
 		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncVecFwdFilter(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncVecFwdLane(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncFwdFuzzy(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncFwdIndex(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncFwdMask(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType, typename T>
+		[[nodiscard]] static auto SearchFuncFwdNumRange(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType, typename T>
+		[[nodiscard]] static auto SearchFuncVecFwdNumRange(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncVecFwdMask(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncFwdLong(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
 		[[nodiscard]] static auto SearchFuncBack(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncBackLong(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncVecBackFilter(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncBackFuzzy(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncBackIndex(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncBackMask(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType, typename T>
+		[[nodiscard]] static auto SearchFuncBackNumRange(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType, typename T>
+		[[nodiscard]] static auto SearchFuncVecBackNumRange(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType>
+		[[nodiscard]] static auto SearchFuncVecBackMask(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<bool fDlgProg>
+		[[nodiscard]] static auto SearchFuncRegexFwd(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<bool fDlgProg>
+		[[nodiscard]] static auto SearchFuncRegexBack(const SEARCHFUNCDATA& refSearch) -> FINDRESULT;
+		template<SEARCHTYPE stType> //Lowers the byte only for the case insensitive text search.
+		[[nodiscard]] static auto __forceinline ToLowerASCII(std::byte byte)->std::byte;
 	private:
 		static constexpr std::byte m_uWildcard { '?' }; //Wildcard symbol.
 		static constexpr auto m_pwszWrongInput { L"Wrong input data." };
@@ -183,8 +304,12 @@ namespace HEXCTRL::INTERNAL {
 		wnd::CWndEdit m_WndEditRngBegin; //Edit box "Range begin".
 		wnd::CWndEdit m_WndEditRngEnd;   //Edit box "Range end".
 		wnd::CWndEdit m_WndEditLimit;    //Edit box "Limit search hits".
+		wnd::CWndEdit m_WndEditMismatch; //Edit box "Mismatches".
 		wnd::CMenu m_MenuList;           //Menu for the list control.
 		IHexCtrl* m_pHexCtrl { };
+		const CHexSearchIndex* m_pSearchIndex { };
+		CHexSearchCache* m_pSearchCache { };
+		CHexRegex m_Regex;              //Compiled expression for the MODE_REGEX.
 		ESearchMode m_eSearchMode { };
 		std::uint64_t m_u64Flags { };   //Data from SetDlgProperties.
 		LISTEX::CListEx m_ListEx;
@@ -194,20 +319,30 @@ namespace HEXCTRL::INTERNAL {
 		ULONGLONG m_ullStep { 1 };      //Search step (default is 1 byte).
 		DWORD m_dwCount { };            //How many, or what index number.
 		DWORD m_dwReplaced { };         //Replaced amount;
+		ULONGLONG m_ullCounted { };     //Count of the occurrences, for the Count All.
 		DWORD m_dwLimit { 10000 };      //Maximum found search occurences.
+		DWORD m_dwMismatch { };         //Maximum mismatching bytes, for the fuzzy hex bytes search.
 		int m_iWrap { };                //Wrap direction: -1 = Beginning, 1 = End.
-		VecSearchResult m_vecSearchRes; //Search results.
+		CHexSearchResult m_SearchRes;   //Search results, sorted.
 		std::vector<std::byte> m_vecSearchData;  //Data to search for.
+		std::vector<std::byte> m_vecSearchMask;  //Bits of the m_vecSearchData to compare, for the hex bytes.
 		std::vector<std::byte> m_vecReplaceData; //Data to replace with.
+		std::array<std::byte, 8> m_arrNumMin { }; //Min number of the numbers range search.
+		std::array<std::byte, 8> m_arrNumMax { }; //Max number of the numbers range search.
 		std::wstring m_wstrSearch;      //Text from "Search" box.
 		std::wstring m_wstrReplace;     //Text from "Replace with..." box.
+		mutable std::vector<CHexSearchAsync*> m_vecSearchAsync; //Searches of the SearchAsync, until they're deleted.
+		mutable std::mutex m_mtxSearchAsync;
 		bool m_fForward { };            //Search direction, Forward/Backward.
 		bool m_fSecondMatch { false };  //First or subsequent match. 
 		bool m_fFound { false };        //Found or not.
 		bool m_fDoCount { true };       //Do we count matches or just print "Found".
 		bool m_fReplace { false };      //Find or Find and Replace with...?
 		bool m_fAll { false };          //Find/Replace one by one, or all?
+		bool m_fCount { false };        //Only count all the occurrences, without keeping them.
 		bool m_fSearchNext { false };   //Search through Next/Prev menu.
+		bool m_fNumRange { false };     //Numbers range or tolerance search.
 		bool m_fFreshSearch { true };
+		friend class CHexSearchAsync;
 	};
 }
\ No newline at end of file
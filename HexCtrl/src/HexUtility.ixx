@@ -11,6 +11,7 @@ module;
 #include <bit>
 #include <cassert>
 #include <commctrl.h>
+#include <cstring>
 #include <cwctype>
 #include <format>
 #include <intrin.h>
@@ -18,6 +19,7 @@ module;
 #include <optional>
 #include <source_location>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 export module HEXCTRL.HexUtility;
 
@@ -34,6 +36,7 @@ export namespace HEXCTRL::INTERNAL::ut { //Utility methods and stuff.
 	constexpr auto g_ulFileTime1970_LOW = 0xd53e8000U;  //1st Jan 1970 as FILETIME.
 	constexpr auto g_ulFileTime1970_HIGH = 0x019db1deU; //Used for Unix and Java times.
 	constexpr auto g_ullUnixEpochDiff = 11644473600ULL; //Number of ticks from FILETIME epoch of 1st Jan 1601 to Unix epoch of 1st Jan 1970.
+	constexpr auto g_ullUndoSizeMax = 1024ULL * 1024ULL * 10ULL; //Bigger modifications have no Undo snapshot.
 
 	//Get data from IHexCtrl's given offset converted to a necessary type.
 	template<typename T>
@@ -99,6 +102,55 @@ export namespace HEXCTRL::INTERNAL::ut { //Utility methods and stuff.
 		}
 	}
 
+	//Reads an unaligned element of the T type, that is stored in the big or little endian byte order.
+	template<TSize1248 T> [[nodiscard]] T LoadTData(const std::byte* pData, bool fBigEndian)noexcept
+	{
+		T tData;
+		std::memcpy(&tData, pData, sizeof(T));
+		return fBigEndian ? ByteSwap(tData) : tData;
+	}
+
+	//Calls the lmb with the std::type_identity of the type that corresponds to the eDataType.
+	template<typename TLmb>
+	void VisitDataType(EHexDataType eDataType, TLmb&& lmb)
+	{
+		using enum EHexDataType;
+		switch (eDataType) {
+		case DATA_INT8:
+			lmb(std::type_identity<std::int8_t> { });
+			break;
+		case DATA_UINT8:
+			lmb(std::type_identity<std::uint8_t> { });
+			break;
+		case DATA_INT16:
+			lmb(std::type_identity<std::int16_t> { });
+			break;
+		case DATA_UINT16:
+			lmb(std::type_identity<std::uint16_t> { });
+			break;
+		case DATA_INT32:
+			lmb(std::type_identity<std::int32_t> { });
+			break;
+		case DATA_UINT32:
+			lmb(std::type_identity<std::uint32_t> { });
+			break;
+		case DATA_INT64:
+			lmb(std::type_identity<std::int64_t> { });
+			break;
+		case DATA_UINT64:
+			lmb(std::type_identity<std::uint64_t> { });
+			break;
+		case DATA_FLOAT:
+			lmb(std::type_identity<float> { });
+			break;
+		case DATA_DOUBLE:
+			lmb(std::type_identity<double> { });
+			break;
+		default:
+			break;
+		}
+	}
+
 #if defined(_M_IX86) || defined(_M_X64)
 	template<typename T> concept TVec128 = (std::is_same_v<T, __m128> || std::is_same_v<T, __m128i> || std::is_same_v<T, __m128d>);
 	template<typename T> concept TVec256 = (std::is_same_v<T, __m256> || std::is_same_v<T, __m256i> || std::is_same_v<T, __m256d>);
@@ -200,6 +252,48 @@ export namespace HEXCTRL::INTERNAL::ut { //Utility methods and stuff.
 			}();
 		return fHasAVX2;
 	}
+
+	[[nodiscard]] bool HasSSE42() {
+		const static bool fHasSSE42 = []() {
+			int arrInfo[4] { };
+			__cpuid(arrInfo, 1);
+			return (arrInfo[2] & (1 << 20)) != 0;
+			}();
+		return fHasSSE42;
+	}
+
+	[[nodiscard]] bool HasSSSE3() {
+		const static bool fHasSSSE3 = []() {
+			int arrInfo[4] { };
+			__cpuid(arrInfo, 1);
+			return (arrInfo[2] & (1 << 9)) != 0;
+			}();
+		return fHasSSSE3;
+	}
+
+	[[nodiscard]] bool HasPCLMUL() { //Carry-less multiplication, along with the SSE4.1 for the _mm_extract_epi32.
+		const static bool fHasPCLMUL = []() {
+			int arrInfo[4] { };
+			__cpuid(arrInfo, 1);
+			return (arrInfo[2] & (1 << 1)) != 0 && (arrInfo[2] & (1 << 19)) != 0;
+			}();
+		return fHasPCLMUL;
+	}
+
+	[[nodiscard]] bool HasSHA() { //SHA extensions, along with the SSE4.1 for the _mm_blend_epi16.
+		const static bool fHasSHA = []() {
+			int arrInfo[4] { };
+			__cpuid(arrInfo, 1);
+			const auto fHasSSE41 = (arrInfo[2] & (1 << 19)) != 0;
+			__cpuid(arrInfo, 0);
+			if (fHasSSE41 && arrInfo[0] >= 7) {
+				__cpuidex(arrInfo, 7, 0);
+				return (arrInfo[1] & (1 << 29)) != 0;
+			}
+			return false;
+			}();
+		return fHasSHA;
+	}
 #endif // ^^^ _M_IX86 || _M_X64
 
 	template<TSize1248 T> [[nodiscard]] constexpr T BitReverse(T tData) {
@@ -211,6 +305,44 @@ export namespace HEXCTRL::INTERNAL::ut { //Utility methods and stuff.
 		return tReversed;
 	}
 
+	//XOR sSize bytes of the pData with the bytes of the pKey in place: pData[i] ^= pKey[i].
+	void XorBytes(std::byte* pData, const std::byte* pKey, std::size_t sSize)
+	{
+		assert(pData != nullptr); assert(pKey != nullptr);
+		std::size_t sOffset { 0 };
+	#if defined(_M_IX86) || defined(_M_X64)
+		if (HasAVX2()) {
+			for (; sOffset + (sizeof(__m256i) * 2) <= sSize; sOffset += sizeof(__m256i) * 2) { //Unrolled by two vectors.
+				const auto pVecData = reinterpret_cast<__m256i*>(pData + sOffset);
+				const auto pVecKey = reinterpret_cast<const __m256i*>(pKey + sOffset);
+				const auto m256iData0 = _mm256_xor_si256(_mm256_loadu_si256(pVecData), _mm256_loadu_si256(pVecKey));
+				const auto m256iData1 = _mm256_xor_si256(_mm256_loadu_si256(pVecData + 1), _mm256_loadu_si256(pVecKey + 1));
+				_mm256_storeu_si256(pVecData, m256iData0);
+				_mm256_storeu_si256(pVecData + 1, m256iData1);
+			}
+		}
+
+		for (; sOffset + sizeof(__m128i) <= sSize; sOffset += sizeof(__m128i)) {
+			const auto pVecData = reinterpret_cast<__m128i*>(pData + sOffset);
+			const auto pVecKey = reinterpret_cast<const __m128i*>(pKey + sOffset);
+			_mm_storeu_si128(pVecData, _mm_xor_si128(_mm_loadu_si128(pVecData), _mm_loadu_si128(pVecKey)));
+		}
+	#endif //^^^ _M_IX86 || _M_X64
+
+		for (; sOffset + sizeof(std::uint64_t) <= sSize; sOffset += sizeof(std::uint64_t)) { //Bytes may be unaligned.
+			std::uint64_t u64Data;
+			std::uint64_t u64Key;
+			std::memcpy(&u64Data, pData + sOffset, sizeof(u64Data));
+			std::memcpy(&u64Key, pKey + sOffset, sizeof(u64Key));
+			u64Data ^= u64Key;
+			std::memcpy(pData + sOffset, &u64Data, sizeof(u64Data));
+		}
+
+		for (; sOffset < sSize; ++sOffset) { //Remainder.
+			pData[sOffset] ^= pKey[sOffset];
+		}
+	}
+
 	//Converts every two numeric wchars to one respective hex character: "56"->V(0x56), "7A"->z(0x7A), etc...
 	//chWc - a wildcard if any.
 	[[nodiscard]] auto NumStrToHex(std::wstring_view wsv, char chWc = 0) -> std::optional<std::string>
@@ -247,6 +379,91 @@ export namespace HEXCTRL::INTERNAL::ut { //Utility methods and stuff.
 		return { std::move(strHexTmp) };
 	}
 
+	//Converts the hex string to the bytes and the bits mask of them, spaces separate the bytes tokens: "48 65 6C".
+	//A standalone wildcard or a wildcard in a longer token is a whole byte: "48 ? 89" and "48?89" are 48, any, 89.
+	//Only in the two chars token it's a half-byte (nibble): "4?" and "?8" match any low and high nibble.
+	//The hex digits are paired within a token, an odd digits run is an error, unless it ends a single token input.
+	[[nodiscard]] auto HexStrToBytes(std::wstring_view wsv, wchar_t wchWc = 0) -> std::optional<HEXBYTES>
+	{
+		const auto lmbNibble = [](wchar_t wch)->std::optional<std::uint8_t> {
+			if (wch >= L'0' && wch <= L'9')
+				return static_cast<std::uint8_t>(wch - L'0');
+			if (wch >= L'A' && wch <= L'F')
+				return static_cast<std::uint8_t>(wch - L'A' + 10);
+			if (wch >= L'a' && wch <= L'f')
+				return static_cast<std::uint8_t>(wch - L'a' + 10);
+			return std::nullopt;
+			};
+		const auto fWc = wchWc != 0;
+		const auto fSingleToken = wsv.find(L' ') == std::wstring_view::npos; //"ABC" is AB 0C, as always.
+		HEXBYTES stBytes;
+		const auto lmbAdd = [&stBytes](std::uint8_t u8Data, std::uint8_t u8Mask) {
+			stBytes.vecData.emplace_back(static_cast<std::byte>(u8Data));
+			stBytes.vecMask.emplace_back(static_cast<std::byte>(u8Mask));
+			};
+
+		for (std::size_t sPos { 0 }; sPos < wsv.size();) {
+			if (wsv[sPos] == L' ') {
+				++sPos;
+				continue;
+			}
+
+			const auto sEnd = (std::min)(wsv.find(L' ', sPos), wsv.size());
+			const auto wsvToken = wsv.substr(sPos, sEnd - sPos);
+			sPos = sEnd;
+
+			if (fWc && wsvToken.size() == 2 && wsvToken.find(wchWc) != std::wstring_view::npos) { //Nibbles.
+				std::uint8_t u8Data { };
+				std::uint8_t u8Mask { };
+				for (const auto wch : wsvToken) {
+					u8Data <<= 4; u8Mask <<= 4;
+					if (wch == wchWc)
+						continue;
+
+					const auto optNibble = lmbNibble(wch);
+					if (!optNibble)
+						return std::nullopt;
+
+					u8Data |= *optNibble; u8Mask |= 0xFU;
+				}
+				lmbAdd(u8Data, u8Mask);
+				continue;
+			}
+
+			for (std::size_t i { 0 }; i < wsvToken.size();) {
+				if (fWc && wsvToken[i] == wchWc) { //Whole byte wildcard.
+					lmbAdd(0, 0);
+					++i;
+					continue;
+				}
+
+				const auto optHi = lmbNibble(wsvToken[i]);
+				if (!optHi)
+					return std::nullopt;
+
+				if (i + 1 == wsvToken.size() || (fWc && wsvToken[i + 1] == wchWc)) { //Odd digits run.
+					if (!fSingleToken || i + 1 != wsvToken.size())
+						return std::nullopt;
+
+					lmbAdd(*optHi, 0xFFU);
+					break;
+				}
+
+				const auto optLo = lmbNibble(wsvToken[i + 1]);
+				if (!optLo)
+					return std::nullopt;
+
+				lmbAdd(static_cast<std::uint8_t>((*optHi << 4) | *optLo), 0xFFU);
+				i += 2;
+			}
+		}
+
+		if (stBytes.vecData.empty())
+			return std::nullopt;
+
+		return { std::move(stBytes) };
+	}
+
 	[[nodiscard]] auto WstrToStr(std::wstring_view wsv, UINT uCodePage = CP_UTF8) -> std::string
 	{
 		const auto iSize = WideCharToMultiByte(uCodePage, 0, wsv.data(), static_cast<int>(wsv.size()), nullptr, 0, nullptr, nullptr);
@@ -0,0 +1,85 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <vector>
+
+namespace TestHexCtrl {
+	//Compare the CompareData ranges with the ones found here byte by byte.
+	void VerifyCompare(IHexCtrl* pHex, const std::vector<std::byte>& vecOther, DWORD dwMergeGap) {
+		const auto ullDataSize = pHex->GetDataSize();
+		const auto spnData = pHex->GetData({ .ullOffset { 0 }, .ullSize { ullDataSize } });
+		VecSpan vecRef;
+		for (ULONGLONG ullOffset { 0 }; ullOffset < ullDataSize; ++ullOffset) {
+			if (ullOffset < vecOther.size() && spnData[static_cast<std::size_t>(ullOffset)] == vecOther[static_cast<std::size_t>(ullOffset)])
+				continue;
+
+			if (!vecRef.empty() && ullOffset - (vecRef.back().ullOffset + vecRef.back().ullSize) <= dwMergeGap) {
+				vecRef.back().ullSize = ullOffset + 1 - vecRef.back().ullOffset;
+			}
+			else {
+				vecRef.emplace_back(ullOffset, 1);
+			}
+		}
+
+		const auto vecDiff = pHex->CompareData({ .spnData { vecOther }, .dwMergeGap { dwMergeGap } });
+		pHex->CompareData({ }); //Clear the differences.
+		Assert::AreEqual(vecRef.size(), vecDiff.size());
+		for (std::size_t i { 0 }; i < vecRef.size(); ++i) {
+			Assert::AreEqual(vecRef[i].ullOffset, vecDiff[i].ullOffset);
+			Assert::AreEqual(vecRef[i].ullSize, vecDiff[i].ullSize);
+		}
+	}
+
+	TEST_CLASS(CCompareData) {
+public:
+	TEST_METHOD(RandomDiffs) {
+		CreateDataForType<std::uint8_t>();
+		const auto spnData = GetHexCtrl()->GetData({ .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+		std::vector<std::byte> vecOther(spnData.begin(), spnData.end());
+		VerifyCompare(GetHexCtrl(), vecOther, 0); //Equal data.
+
+		std::uniform_int_distribution<std::size_t> distr(0, GetTestDataSize() - 1);
+		for (auto i { 0 }; i < 40; ++i) {
+			vecOther[distr(GetMT19937())] ^= std::byte { 0x5A };
+		}
+		VerifyCompare(GetHexCtrl(), vecOther, 0);
+		VerifyCompare(GetHexCtrl(), vecOther, 4);
+
+		vecOther.resize(GetTestDataSize() - 50); //The HexCtrl's data tail is a difference.
+		VerifyCompare(GetHexCtrl(), vecOther, 0);
+	}
+	TEST_METHOD(PartitionBoundary) {
+		//The data is compared by the 4MB parts in parallel, the differences across the parts' boundaries
+		//must be merged into one range.
+		constexpr auto sSizePart { 1024U * 1024U * 4U };
+		std::vector<std::byte> vecData((sSizePart * 2) + 100);
+		std::uniform_int_distribution<int> distr(0, 255);
+		for (auto& refByte : vecData) {
+			refByte = static_cast<std::byte>(distr(GetMT19937()));
+		}
+
+		const auto pHex { CreateHexCtrl() };
+		pHex->Create({ .hInstRes { ::GetModuleHandleW(HEXCTRL_DLL(L"HexCtrl")) },
+			.dwStyle { WS_POPUP | WS_OVERLAPPEDWINDOW }, .dwExStyle { WS_EX_APPWINDOW } });
+		pHex->SetData({ .spnData { vecData } });
+
+		auto vecOther = vecData;
+		for (auto sOffset { sSizePart - 3 }; sOffset < sSizePart + 3; ++sOffset) { //Run across the first boundary.
+			vecOther[sOffset] = ~vecOther[sOffset];
+		}
+		vecOther[(sSizePart * 2) - 2] = ~vecOther[(sSizePart * 2) - 2]; //Two bytes apart across the second boundary.
+		vecOther[(sSizePart * 2) + 1] = ~vecOther[(sSizePart * 2) + 1];
+
+		const auto vecDiff = pHex->CompareData({ .spnData { vecOther }, .dwMergeGap { 2 } });
+		pHex->CompareData({ });
+		Assert::AreEqual(std::size_t { 2 }, vecDiff.size());
+		Assert::AreEqual(static_cast<ULONGLONG>(sSizePart - 3), vecDiff[0].ullOffset);
+		Assert::AreEqual(6ULL, vecDiff[0].ullSize);
+		Assert::AreEqual(static_cast<ULONGLONG>((sSizePart * 2) - 2), vecDiff[1].ullOffset);
+		Assert::AreEqual(4ULL, vecDiff[1].ullSize);
+		VerifyCompare(pHex.get(), vecOther, 0);
+
+		pHex->ClearData();
+	}
+	};
+}
\ No newline at end of file
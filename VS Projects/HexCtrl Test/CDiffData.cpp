@@ -0,0 +1,84 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace TestHexCtrl {
+	//The operations must cover the HexCtrl's data in order, and every DIFF_COPY must be equal to the other data.
+	//Returns the count of the copied bytes.
+	auto VerifyDiffOps(const std::vector<HEXDIFFOP>& vecOps, const std::vector<std::byte>& vecOther)->ULONGLONG {
+		const auto spnData = GetHexCtrl()->GetData({ .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+		ULONGLONG ullPos { 0 };
+		ULONGLONG ullCopied { 0 };
+		for (const auto& refOp : vecOps) {
+			Assert::AreEqual(ullPos, refOp.ullOffset);
+			Assert::IsTrue(refOp.ullSize > 0);
+			if (refOp.eOp == EHexDiffOp::DIFF_COPY) {
+				Assert::IsTrue(refOp.ullOffsetOther + refOp.ullSize <= vecOther.size());
+				Assert::AreEqual(0, std::memcmp(spnData.data() + refOp.ullOffset, vecOther.data() + refOp.ullOffsetOther,
+					static_cast<std::size_t>(refOp.ullSize)));
+				ullCopied += refOp.ullSize;
+			}
+			ullPos += refOp.ullSize;
+		}
+		Assert::AreEqual(static_cast<ULONGLONG>(GetTestDataSize()), ullPos);
+
+		return ullCopied;
+	}
+
+	//The data's byte at the ullOffset is copied from the other data's byte at the ullOffsetOther.
+	[[nodiscard]] bool IsDiffCopied(const std::vector<HEXDIFFOP>& vecOps, ULONGLONG ullOffset, ULONGLONG ullOffsetOther) {
+		return std::any_of(vecOps.begin(), vecOps.end(), [=](const HEXDIFFOP& refOp) {
+			return refOp.eOp == EHexDiffOp::DIFF_COPY && ullOffset >= refOp.ullOffset && ullOffset < refOp.ullOffset + refOp.ullSize
+				&& refOp.ullOffsetOther + (ullOffset - refOp.ullOffset) == ullOffsetOther; });
+	}
+
+	[[nodiscard]] auto GetDiffOps(const std::vector<std::byte>& vecOther)->std::vector<HEXDIFFOP> {
+		auto vecOps = GetHexCtrl()->DiffData({ .spnData { vecOther }, .dwBlockSize { 16 } });
+		GetHexCtrl()->DiffData({ }); //Clear the differences.
+		return vecOps;
+	}
+
+	TEST_CLASS(CDiffData) {
+public:
+	TEST_METHOD(Equal) {
+		CreateDataForType<std::uint8_t>();
+		const std::vector<std::byte> vecOther(std::begin(*GetReferenceData()), std::end(*GetReferenceData()));
+		const auto vecOps = GetDiffOps(vecOther);
+		Assert::AreEqual(std::size_t { 1 }, vecOps.size());
+		Assert::IsTrue(vecOps[0].eOp == EHexDiffOp::DIFF_COPY);
+		Assert::AreEqual(0ULL, vecOps[0].ullOffsetOther);
+		Assert::AreEqual(static_cast<ULONGLONG>(GetTestDataSize()), VerifyDiffOps(vecOps, vecOther));
+	}
+	TEST_METHOD(Insertion) {
+		//The HexCtrl's data is the other data with 40 bytes inserted at the offset 100.
+		CreateDataForType<std::uint8_t>();
+		const auto pRef = std::begin(*GetReferenceData());
+		std::vector<std::byte> vecOther(pRef, pRef + 100);
+		vecOther.insert(vecOther.end(), pRef + 140, std::end(*GetReferenceData()));
+		const auto vecOps = GetDiffOps(vecOther);
+		Assert::IsTrue(VerifyDiffOps(vecOps, vecOther) >= GetTestDataSize() - 40); //Bytes around may be equal by chance.
+		Assert::IsTrue(IsDiffCopied(vecOps, 0, 0));
+		Assert::IsTrue(IsDiffCopied(vecOps, 99, 99));
+		Assert::IsTrue(IsDiffCopied(vecOps, 140, 100));
+		Assert::IsTrue(IsDiffCopied(vecOps, GetTestDataSize() - 1, GetTestDataSize() - 41));
+	}
+	TEST_METHOD(Deletion) {
+		//The HexCtrl's data is the other data with 50 bytes removed at the offset 200.
+		CreateDataForType<std::uint8_t>();
+		const auto pRef = std::begin(*GetReferenceData());
+		std::vector<std::byte> vecOther(pRef, pRef + 200);
+		for (auto i { 0 }; i < 50; ++i) {
+			vecOther.emplace_back(static_cast<std::byte>(GetMT19937()()));
+		}
+		vecOther.insert(vecOther.end(), pRef + 200, std::end(*GetReferenceData()));
+		const auto vecOps = GetDiffOps(vecOther);
+		Assert::AreEqual(static_cast<ULONGLONG>(GetTestDataSize()), VerifyDiffOps(vecOps, vecOther));
+		Assert::IsTrue(IsDiffCopied(vecOps, 199, 199));
+		Assert::IsTrue(IsDiffCopied(vecOps, 201, 251));
+		Assert::IsTrue(IsDiffCopied(vecOps, GetTestDataSize() - 1, GetTestDataSize() + 49));
+	}
+	};
+}
\ No newline at end of file
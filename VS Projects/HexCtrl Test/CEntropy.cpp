@@ -0,0 +1,78 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <array>
+#include <numeric>
+#include <vector>
+
+namespace TestHexCtrl {
+	[[nodiscard]] auto EntropyForHist(const std::array<ULONGLONG, 256>& arrHist, ULONGLONG ullTotal)->double {
+		double dEntropy { };
+		for (const auto ullCount : arrHist) {
+			if (ullCount > 0) {
+				const auto dProb = static_cast<double>(ullCount) / ullTotal;
+				dEntropy -= dProb * std::log2(dProb);
+			}
+		}
+		return dEntropy;
+	}
+
+	//Compare the HexCtrl's entropy with the one computed here from the HexCtrl's data.
+	void VerifyEntropy(DWORD dwBlockSize) {
+		const auto hxe = GetHexCtrl()->GetEntropy(dwBlockSize);
+		const auto spnData = GetHexCtrl()->GetData({ .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+		std::array<ULONGLONG, 256> arrHist { };
+		for (const auto byte : spnData) {
+			++arrHist[static_cast<std::uint8_t>(byte)];
+		}
+
+		Assert::AreEqual(dwBlockSize, hxe.dwBlockSize);
+		Assert::IsTrue(arrHist == hxe.arrHist);
+		Assert::AreEqual(EntropyForHist(arrHist, GetTestDataSize()), hxe.dEntropy, 1e-9);
+		Assert::AreEqual(static_cast<std::size_t>((GetTestDataSize() + dwBlockSize - 1) / dwBlockSize), hxe.vecBlockEntropy.size());
+		for (auto i { 0UL }; i < hxe.vecBlockEntropy.size(); ++i) {
+			std::array<ULONGLONG, 256> arrHistBlock { };
+			const auto ulSize = (std::min)(dwBlockSize, GetTestDataSize() - (i * dwBlockSize));
+			for (auto j { 0UL }; j < ulSize; ++j) {
+				++arrHistBlock[static_cast<std::uint8_t>(spnData[(i * dwBlockSize) + j])];
+			}
+			Assert::AreEqual(EntropyForHist(arrHistBlock, ulSize), static_cast<double>(hxe.vecBlockEntropy[i]), 1e-5);
+		}
+	}
+
+	TEST_CLASS(CEntropy) {
+public:
+	TEST_METHOD(SingleValue) {
+		constexpr std::byte byteFill { 0xAB };
+		GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_REPEAT }, .spnData { &byteFill, 1 },
+			.vecSpan { { 0, GetTestDataSize() } } });
+		const auto hxe = GetHexCtrl()->GetEntropy(64);
+		Assert::AreEqual(static_cast<ULONGLONG>(GetTestDataSize()), hxe.arrHist[0xAB]);
+		Assert::AreEqual(0., hxe.dEntropy);
+		VerifyEntropy(64);
+	}
+	TEST_METHOD(AllValues) {
+		std::vector<std::uint8_t> vecData(256);
+		std::iota(vecData.begin(), vecData.end(), static_cast<std::uint8_t>(0));
+		GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_REPEAT },
+			.spnData { reinterpret_cast<const std::byte*>(vecData.data()), vecData.size() }, .vecSpan { { 0, 256 } } });
+		const auto hxe = GetHexCtrl()->GetEntropy(256);
+		Assert::AreEqual(8., static_cast<double>(hxe.vecBlockEntropy[0]), 1e-6);
+		VerifyEntropy(256);
+	}
+	TEST_METHOD(Incremental) {
+		CreateDataForType<std::uint8_t>();
+		VerifyEntropy(32);
+
+		//Only the touched blocks are recomputed after every modification.
+		constexpr std::byte arrData[] { std::byte { 0x00 }, std::byte { 0xFF }, std::byte { 0x7F } };
+		GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_REPEAT }, .spnData { arrData, sizeof(arrData) },
+			.vecSpan { { 30, 9 }, { 100, 3 } } });
+		VerifyEntropy(32);
+		GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_OPERATION }, .eOperMode { OPER_XOR }, .eDataType { DATA_UINT8 },
+			.spnData { arrData + 1, 1 }, .vecSpan { { 470, 7 } } });
+		VerifyEntropy(32);
+		VerifyEntropy(100); //Different block size.
+	}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace TestHexCtrl {
+	void PutStringASCII(std::vector<std::byte>& vecData, std::size_t sOffset, std::string_view sv) {
+		std::transform(sv.begin(), sv.end(), vecData.begin() + sOffset, [](char ch) { return static_cast<std::byte>(ch); });
+	}
+
+	void PutStringUTF16LE(std::vector<std::byte>& vecData, std::size_t sOffset, std::string_view sv) {
+		for (std::size_t i { 0 }; i < sv.size(); ++i) {
+			vecData[sOffset + (i * 2)] = static_cast<std::byte>(sv[i]);
+			vecData[sOffset + (i * 2) + 1] = std::byte { 0 };
+		}
+	}
+
+	void VerifyString(const HEXSTRING& hsRef, const HEXSTRING& hs) {
+		Assert::AreEqual(hsRef.ullOffset, hs.ullOffset);
+		Assert::AreEqual(hsRef.ullSize, hs.ullSize);
+		Assert::AreEqual(hsRef.ullLength, hs.ullLength);
+		Assert::IsTrue(hsRef.eType == hs.eType);
+	}
+
+	TEST_CLASS(CExtractStrings) {
+public:
+	TEST_METHOD(PartitionBoundary) {
+		//The data is split into the 16MB partitions, the strings that cross their boundaries must be found whole,
+		//and only once, by the partition they start in.
+		constexpr auto sSizePart { 1024U * 1024U * 16U };
+		std::vector<std::byte> vecData((sSizePart * 3) + 4096);
+		PutStringASCII(vecData, sSizePart - 8, "PartitionBoundary");
+		PutStringUTF16LE(vecData, (sSizePart * 2) - 11, "WideAcross");
+		PutStringASCII(vecData, sSizePart * 3, "StartsAtBoundary");
+		PutStringASCII(vecData, vecData.size() - 4, "Tail");
+
+		const auto pHex { CreateHexCtrl() };
+		pHex->Create({ .hInstRes { ::GetModuleHandleW(HEXCTRL_DLL(L"HexCtrl")) },
+			.dwStyle { WS_POPUP | WS_OVERLAPPEDWINDOW }, .dwExStyle { WS_EX_APPWINDOW } });
+		pHex->SetData({ .spnData { vecData } });
+
+		std::vector<HEXSTRING> vecStr;
+		const auto pStrings = pHex->ExtractStrings({ .FuncString { [&](const HEXSTRING& hs) {
+			vecStr.emplace_back(hs); return true; } } });
+		Assert::IsTrue(pStrings != nullptr);
+		pStrings->Wait();
+		Assert::IsFalse(pStrings->IsCanceled());
+
+		using enum EHexStringType;
+		const HEXSTRING arrRef[] {
+			{ .ullOffset { sSizePart - 8 }, .ullSize { 17 }, .ullLength { 17 }, .eType { STRING_ASCII } },
+			{ .ullOffset { (sSizePart * 2) - 11 }, .ullSize { 20 }, .ullLength { 10 }, .eType { STRING_UTF16LE } },
+			{ .ullOffset { sSizePart * 3 }, .ullSize { 16 }, .ullLength { 16 }, .eType { STRING_ASCII } },
+			{ .ullOffset { vecData.size() - 4 }, .ullSize { 4 }, .ullLength { 4 }, .eType { STRING_ASCII } } };
+		Assert::AreEqual(std::size(arrRef), vecStr.size());
+		for (std::size_t i { 0 }; i < vecStr.size(); ++i) {
+			VerifyString(arrRef[i], vecStr[i]);
+		}
+		Assert::AreEqual(static_cast<ULONGLONG>(std::size(arrRef)), pStrings->GetCount());
+
+		pHex->ClearData();
+	}
+	};
+}
\ No newline at end of file
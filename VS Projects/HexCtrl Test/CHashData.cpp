@@ -0,0 +1,67 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TestHexCtrl {
+	using enum EHexHash;
+
+	//Put the string into the HexCtrl's data at the given offset.
+	void SetHashData(std::string_view sv, ULONGLONG ullOffset) {
+		GetHexCtrl()->ModifyData({ .eModifyMode { EHexModifyMode::MODIFY_ONCE },
+			.spnData { reinterpret_cast<const std::byte*>(sv.data()), sv.size() }, .vecSpan { { ullOffset, sv.size() } } });
+	}
+
+	[[nodiscard]] auto DigestToStr(const HEXDIGEST& hd)->std::string {
+		constexpr char arrHex[] { "0123456789abcdef" };
+		std::string str;
+		for (const auto byte : hd.vecDigest) {
+			str += arrHex[static_cast<std::uint8_t>(byte) >> 4];
+			str += arrHex[static_cast<std::uint8_t>(byte) & 0x0F];
+		}
+		return str;
+	}
+
+	constexpr std::string_view g_svFox { "The quick brown fox jumps over the lazy dog" };
+
+	TEST_CLASS(CHashData) {
+public:
+	TEST_METHOD(KnownAnswers) {
+		SetHashData(g_svFox, 0);
+		const auto vecDigest = GetHexCtrl()->HashData({ .vecSpan { { 0, g_svFox.size() } },
+			.vecHash { HASH_CRC32, HASH_CRC32C, HASH_ADLER32, HASH_XXH64, HASH_MD5, HASH_SHA1, HASH_SHA256 } });
+		Assert::AreEqual(std::size_t { 7 }, vecDigest.size());
+		Assert::AreEqual(std::string { "414fa339" }, DigestToStr(vecDigest[0]));
+		Assert::AreEqual(std::string { "22620404" }, DigestToStr(vecDigest[1]));
+		Assert::AreEqual(std::string { "5bdc0fda" }, DigestToStr(vecDigest[2]));
+		Assert::AreEqual(std::string { "0b242d361fda71bc" }, DigestToStr(vecDigest[3]));
+		Assert::AreEqual(std::string { "9e107d9d372bb6826bd81d3542a419d6" }, DigestToStr(vecDigest[4]));
+		Assert::AreEqual(std::string { "2fd4e1c67a2d28fced849ee1bb76e7391b93eb12" }, DigestToStr(vecDigest[5]));
+		Assert::AreEqual(std::string { "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592" },
+			DigestToStr(vecDigest[6]));
+	}
+	TEST_METHOD(SpansAsOneStream) {
+		SetHashData(g_svFox, 0);
+		SetHashData(g_svFox, 100);
+		const auto vecDigest = GetHexCtrl()->HashData({ .vecSpan { { 0, 20 }, { 120, g_svFox.size() - 20 } },
+			.vecHash { HASH_CRC32, HASH_SHA256 } });
+		Assert::AreEqual(std::size_t { 2 }, vecDigest.size());
+		Assert::AreEqual(std::string { "414fa339" }, DigestToStr(vecDigest[0]));
+		Assert::AreEqual(std::string { "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592" },
+			DigestToStr(vecDigest[1]));
+	}
+	TEST_METHOD(PerSpan) {
+		SetHashData("abc", 0);
+		SetHashData(g_svFox, 200);
+		const auto vecDigest = GetHexCtrl()->HashData({ .vecSpan { { 0, 3 }, { 200, g_svFox.size() } },
+			.vecHash { HASH_MD5 }, .fPerSpan { true } });
+		Assert::AreEqual(std::size_t { 2 }, vecDigest.size());
+		Assert::AreEqual(std::size_t { 0 }, vecDigest[0].sSpanIndex);
+		Assert::AreEqual(std::string { "900150983cd24fb0d6963f7d28e17f72" }, DigestToStr(vecDigest[0]));
+		Assert::AreEqual(std::size_t { 1 }, vecDigest[1].sSpanIndex);
+		Assert::AreEqual(std::string { "9e107d9d372bb6826bd81d3542a419d6" }, DigestToStr(vecDigest[1]));
+	}
+	};
+}
\ No newline at end of file
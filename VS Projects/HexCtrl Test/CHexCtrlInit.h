@@ -1,10 +1,17 @@
 #include "../../HexCtrl/HexCtrl.h"
+#include "../../HexCtrl/res/HexCtrlRes.h"
 #include "CppUnitTest.h"
+#include <CommCtrl.h>
 #include <bit>
 #include <cassert>
 #include <cmath>
+#include <cwchar>
+#include <cwctype>
 #include <limits>
+#include <optional>
 #include <random>
+#include <string>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace HEXCTRL;
@@ -49,6 +56,34 @@ namespace TestHexCtrl {
 		return pHexCtrl;
 	}
 
+	//Virtual data handler over a buffer.
+	class CVirtDataBuffer final : public IHexVirtData {
+	public:
+		explicit CVirtDataBuffer(SpanByte spnData) : m_spnData(spnData) { }
+		void OnHexGetData(HEXDATAINFO& hdi)override {
+			hdi.spnData = m_spnData.subspan(static_cast<std::size_t>(hdi.stHexSpan.ullOffset),
+				static_cast<std::size_t>(hdi.stHexSpan.ullSize));
+		}
+		void OnHexGetOffset(HEXDATAINFO& /*hdi*/, bool /*fGetVirt*/)override { }
+		void OnHexSetData(const HEXDATAINFO& /*hdi*/)override { }
+	private:
+		SpanByte m_spnData;
+	};
+
+	[[nodiscard]] consteval auto GetTestCacheSize() {
+		return 1024UL * 64UL; //Minimum cache size, the VirtualData is read by the chunks of this size.
+	}
+
+	//HexCtrl of its own over the data, or over the VirtualData if it's set.
+	[[nodiscard]] inline auto CreateHexCtrlData(SpanByte spnData, IHexVirtData* pVirtData = nullptr, bool fMutable = false)->IHexCtrlPtr {
+		auto pHex { CreateHexCtrl() };
+		pHex->Create({ .hInstRes { ::GetModuleHandleW(HEXCTRL_DLL(L"HexCtrl")) },
+			.dwStyle { WS_POPUP | WS_OVERLAPPEDWINDOW }, .dwExStyle { WS_EX_APPWINDOW } });
+		pHex->SetData({ .spnData { spnData }, .pHexVirtData { pVirtData }, .dwCacheSize { GetTestCacheSize() },
+			.fMutable { fMutable } });
+		return pHex;
+	}
+
 	static std::byte byteReferenceData[GetTestDataSize()]; //Reference data array.
 	[[nodiscard]] consteval auto GetReferenceData() {
 		return &byteReferenceData;
@@ -266,4 +301,125 @@ namespace TestHexCtrl {
 			}
 		}
 	}
+
+	inline void VerifyOffsets(const std::vector<ULONGLONG>& vecRef, const std::vector<ULONGLONG>& vecRes) {
+		Assert::AreEqual(vecRef.size(), vecRes.size());
+		for (std::size_t i { 0 }; i < vecRef.size(); ++i) {
+			Assert::AreEqual(vecRef[i], vecRes[i]);
+		}
+	}
+
+	//Search dialog's "Mode" combo-box items, in the order they are added.
+	enum class ESearchDlgMode : std::uint8_t {
+		MODE_HEXBYTES, MODE_TEXT, MODE_NUMBERS, MODE_STRUCT, MODE_REGEX
+	};
+
+	//Search dialog driven by its controls, the same way the user does it.
+	//The "Type" combo-box index is: ASCII, UTF-8, UTF-16 for the text, and
+	//Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float, Double for the numbers.
+	class CSearchDlgDriver final {
+	public:
+		explicit CSearchDlgDriver(IHexCtrl* pHex) : m_hWnd(pHex->GetWndHandle(EHexWnd::DLG_SEARCH)) { }
+		void Click(int iIDButton)const {
+			::SendMessageW(m_hWnd, WM_COMMAND, MAKEWPARAM(iIDButton, BN_CLICKED), reinterpret_cast<LPARAM>(GetItem(iIDButton)));
+		}
+
+		//"Count All" occurrences, from the result text.
+		[[nodiscard]] auto CountAll()const->ULONGLONG {
+			SetText(IDC_HEXCTRL_SEARCH_EDIT_START, L"");
+			Click(IDC_HEXCTRL_SEARCH_BTN_COUNTALL);
+			auto wstrRes = GetText(IDC_HEXCTRL_SEARCH_STAT_RESULT);
+			if (!wstrRes.starts_with(L"Counted"))
+				return 0;
+
+			std::erase_if(wstrRes, [](wchar_t wch) { return !std::iswdigit(wch); }); //Locale's thousands separators.
+			return std::wcstoull(wstrRes.data(), nullptr, 10);
+		}
+
+		//"Find All" occurrences, from the results list.
+		[[nodiscard]] auto FindAll()const->std::vector<ULONGLONG> {
+			SetText(IDC_HEXCTRL_SEARCH_EDIT_START, L"");
+			Click(IDC_HEXCTRL_SEARCH_BTN_FINDALL);
+			return GetList();
+		}
+
+		//All occurrences found one by one with the "Search Forward" or the "Search Backward", until the search wraps.
+		[[nodiscard]] auto FindEach(bool fForward)const->std::vector<ULONGLONG> {
+			Reset();
+			std::vector<ULONGLONG> vecRes;
+			for (auto optOffset = FindNext(fForward); optOffset; optOffset = FindNext(fForward)) {
+				if (!vecRes.empty() && (fForward ? *optOffset <= vecRes.back() : *optOffset >= vecRes.back()))
+					break;
+
+				vecRes.emplace_back(*optOffset);
+			}
+
+			return vecRes;
+		}
+
+		//One "Search Forward" or "Search Backward" occurrence, from the "Start from" that is set to it.
+		[[nodiscard]] auto FindNext(bool fForward)const->std::optional<ULONGLONG> {
+			Click(fForward ? IDC_HEXCTRL_SEARCH_BTN_SEARCHF : IDC_HEXCTRL_SEARCH_BTN_SEARCHB);
+			if (GetText(IDC_HEXCTRL_SEARCH_STAT_RESULT).starts_with(L"Didn't"))
+				return std::nullopt;
+
+			return std::wcstoull(GetText(IDC_HEXCTRL_SEARCH_EDIT_START).data(), nullptr, 16);
+		}
+
+		[[nodiscard]] auto GetItem(int iID)const->HWND {
+			return ::GetDlgItem(m_hWnd, iID);
+		}
+
+		[[nodiscard]] auto GetList()const->std::vector<ULONGLONG> {
+			const auto hWndList = GetItem(IDC_HEXCTRL_SEARCH_LIST);
+			std::vector<ULONGLONG> vecRes;
+			wchar_t buff[32];
+			for (auto iItem { 0 }; iItem < ListView_GetItemCount(hWndList); ++iItem) {
+				ListView_GetItemText(hWndList, iItem, 1, buff, static_cast<int>(std::size(buff))); //"0x" prefixed offset.
+				vecRes.emplace_back(std::wcstoull(buff, nullptr, 16));
+			}
+
+			return vecRes;
+		}
+
+		[[nodiscard]] auto GetText(int iID)const->std::wstring {
+			const auto hWndItem = GetItem(iID);
+			std::wstring wstr(static_cast<std::size_t>(::GetWindowTextLengthW(hWndItem)), L'\0');
+			::GetWindowTextW(hWndItem, wstr.data(), static_cast<int>(wstr.size() + 1));
+			return wstr;
+		}
+
+		//The search is started anew, as when the mode is changed.
+		void Reset()const {
+			const auto hWndMode = GetItem(IDC_HEXCTRL_SEARCH_COMBO_MODE);
+			const auto hWndType = GetItem(IDC_HEXCTRL_SEARCH_COMBO_TYPE);
+			const auto iMode = static_cast<int>(::SendMessageW(hWndMode, CB_GETCURSEL, 0, 0));
+			const auto iType = static_cast<int>(::SendMessageW(hWndType, CB_GETCURSEL, 0, 0));
+			SetMode(iMode == 0 ? ESearchDlgMode::MODE_TEXT : ESearchDlgMode::MODE_HEXBYTES);
+			SetMode(static_cast<ESearchDlgMode>(iMode), (std::max)(iType, 0));
+			SetText(IDC_HEXCTRL_SEARCH_EDIT_START, L"");
+		}
+
+		void SetCheck(int iID, bool fCheck)const {
+			::SendMessageW(GetItem(iID), BM_SETCHECK, fCheck ? BST_CHECKED : BST_UNCHECKED, 0);
+		}
+
+		void SetMode(ESearchDlgMode eMode, int iType = 0)const {
+			const auto lmbSelect = [this](int iIDCombo, int iIndex) {
+				const auto hWndCombo = GetItem(iIDCombo);
+				::SendMessageW(hWndCombo, CB_SETCURSEL, static_cast<WPARAM>(iIndex), 0);
+				::SendMessageW(m_hWnd, WM_COMMAND, MAKEWPARAM(iIDCombo, CBN_SELCHANGE), reinterpret_cast<LPARAM>(hWndCombo));
+				};
+			lmbSelect(IDC_HEXCTRL_SEARCH_COMBO_MODE, static_cast<int>(eMode));
+			if (::IsWindowEnabled(GetItem(IDC_HEXCTRL_SEARCH_COMBO_TYPE))) {
+				lmbSelect(IDC_HEXCTRL_SEARCH_COMBO_TYPE, iType);
+			}
+		}
+
+		void SetText(int iID, std::wstring_view wsv)const {
+			::SetWindowTextW(GetItem(iID), std::wstring { wsv }.data());
+		}
+	private:
+		HWND m_hWnd { };
+	};
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <optional>
+#include <vector>
+
+namespace TestHexCtrl {
+	[[nodiscard]] auto MakeBytes(std::initializer_list<std::uint8_t> il)->std::vector<std::byte> {
+		std::vector<std::byte> vec;
+		for (const auto u8 : il) {
+			vec.emplace_back(static_cast<std::byte>(u8));
+		}
+		return vec;
+	}
+
+	void VerifyHexStr(std::wstring_view wsvHex, std::initializer_list<std::uint8_t> ilData, std::initializer_list<std::uint8_t> ilMask) {
+		const auto optBytes = HexStrToBytes(wsvHex, L'?');
+		Assert::IsTrue(optBytes.has_value());
+		Assert::IsTrue(optBytes->vecData == MakeBytes(ilData));
+		Assert::IsTrue(optBytes->vecMask == MakeBytes(ilMask));
+	}
+
+	TEST_CLASS(CHexStrToBytes) {
+public:
+	TEST_METHOD(WholeByteWildcard) {
+		VerifyHexStr(L"48 ? 89", { 0x48, 0x00, 0x89 }, { 0xFF, 0x00, 0xFF });
+		VerifyHexStr(L"48?89", { 0x48, 0x00, 0x89 }, { 0xFF, 0x00, 0xFF });
+		VerifyHexStr(L"48??89", { 0x48, 0x00, 0x00, 0x89 }, { 0xFF, 0x00, 0x00, 0xFF });
+		VerifyHexStr(L"?", { 0x00 }, { 0x00 });
+		VerifyHexStr(L"?? 48", { 0x00, 0x48 }, { 0x00, 0xFF });
+	}
+	TEST_METHOD(HalfByteWildcard) {
+		VerifyHexStr(L"4?", { 0x40 }, { 0xF0 });
+		VerifyHexStr(L"?8", { 0x08 }, { 0x0F });
+		VerifyHexStr(L"48 4? ?8 89", { 0x48, 0x40, 0x08, 0x89 }, { 0xFF, 0xF0, 0x0F, 0xFF });
+	}
+	TEST_METHOD(NoWildcard) {
+		VerifyHexStr(L"48 65 6C", { 0x48, 0x65, 0x6C }, { 0xFF, 0xFF, 0xFF });
+		VerifyHexStr(L"48656C", { 0x48, 0x65, 0x6C }, { 0xFF, 0xFF, 0xFF });
+		VerifyHexStr(L"ABC", { 0xAB, 0x0C }, { 0xFF, 0xFF }); //The lone last digit of a single token.
+		const auto optBytes = HexStrToBytes(L"48 ? 89"); //No wildcard is set.
+		Assert::IsFalse(optBytes.has_value());
+	}
+	TEST_METHOD(WrongInput) {
+		for (const auto wsv : { L"", L" ", L"4 89", L"48 9", L"4?89 1", L"4?8", L"48?9 ?", L"4G", L"48 x?" }) {
+			Assert::IsFalse(HexStrToBytes(wsv, L'?').has_value());
+		}
+	}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <numeric>
+#include <vector>
+
+namespace TestHexCtrl {
+	using enum EHexKeyStream;
+
+	//Apply keystream to the HexCtrl's data and to the Reference data.
+	void KeyStreamData(EHexKeyStream eKeyStream, const std::vector<std::uint8_t>& vecKey, HEXSPAN hsp) {
+		const HEXMODIFY hms { .eModifyMode { MODIFY_KEYSTREAM }, .eKeyStream { eKeyStream },
+			.spnData { reinterpret_cast<const std::byte*>(vecKey.data()), vecKey.size() }, .vecSpan { hsp } };
+		GetHexCtrl()->ModifyData(hms);
+
+		const auto pRefData = reinterpret_cast<std::uint8_t*>(GetReferenceData()) + hsp.ullOffset;
+		const auto sSizeKey = vecKey.size();
+		std::uint8_t arrRC4S[256];
+		std::uint8_t u8I { 0 };
+		std::uint8_t u8J { 0 };
+		if (eKeyStream == KEYSTREAM_RC4) {
+			std::iota(std::begin(arrRC4S), std::end(arrRC4S), static_cast<std::uint8_t>(0));
+			for (auto i { 0U }; i < 256U; ++i) {
+				u8J += arrRC4S[i] + vecKey[i % sSizeKey];
+				std::swap(arrRC4S[i], arrRC4S[u8J]);
+			}
+			u8J = 0;
+		}
+
+		std::uint8_t u8Prev { 0 };
+		for (auto i { 0ULL }; i < hsp.ullSize; ++i) {
+			std::uint8_t u8Stream { };
+			switch (eKeyStream) {
+			case KEYSTREAM_XOR:
+				u8Stream = vecKey[i % sSizeKey];
+				break;
+			case KEYSTREAM_ROLLXOR:
+				u8Stream = vecKey[i % sSizeKey] ^ u8Prev;
+				u8Prev = pRefData[i];
+				break;
+			case KEYSTREAM_COUNTER:
+				u8Stream = static_cast<std::uint8_t>(vecKey[i % sSizeKey] + (i / sSizeKey));
+				break;
+			case KEYSTREAM_RC4:
+				++u8I;
+				u8J += arrRC4S[u8I];
+				std::swap(arrRC4S[u8I], arrRC4S[u8J]);
+				u8Stream = arrRC4S[static_cast<std::uint8_t>(arrRC4S[u8I] + arrRC4S[u8J])];
+				break;
+			default:
+				break;
+			}
+			pRefData[i] ^= u8Stream;
+		}
+	}
+
+	TEST_CLASS(CModifyKEYSTREAM) {
+public:
+	TEST_METHOD(KeyXor1) {
+		CreateDataForType<std::uint8_t>();
+		KeyStreamData(KEYSTREAM_XOR, { 0xA5 }, { .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+		VerifyDataForType<std::uint8_t>();
+	}
+	TEST_METHOD(KeyXor3) {
+		CreateDataForType<std::uint8_t>();
+		KeyStreamData(KEYSTREAM_XOR, { 0x01, 0x7F, 0xFE }, { .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+		VerifyDataForType<std::uint8_t>();
+	}
+	TEST_METHOD(KeyXor33Unaligned) {
+		CreateDataForType<std::uint8_t>();
+		std::vector<std::uint8_t> vecKey(33);
+		std::iota(vecKey.begin(), vecKey.end(), static_cast<std::uint8_t>(0x40));
+		KeyStreamData(KEYSTREAM_XOR, vecKey, { .ullOffset { 7 }, .ullSize { GetTestDataSize() - 11 } });
+		VerifyDataForType<std::uint8_t>();
+	}
+	TEST_METHOD(KeyXorLongerThanData) {
+		CreateDataForType<std::uint8_t>();
+		std::vector<std::uint8_t> vecKey(GetTestDataSize() + 5);
+		std::iota(vecKey.begin(), vecKey.end(), static_cast<std::uint8_t>(0x11));
+		KeyStreamData(KEYSTREAM_XOR, vecKey, { .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+		VerifyDataForType<std::uint8_t>();
+	}
+	TEST_METHOD(RollXor) {
+		CreateDataForType<std::uint8_t>();
+		KeyStreamData(KEYSTREAM_ROLLXOR, { 0x3C, 0x5A }, { .ullOffset { 3 }, .ullSize { GetTestDataSize() - 3 } });
+		VerifyDataForType<std::uint8_t>();
+	}
+	TEST_METHOD(Counter) {
+		CreateDataForType<std::uint8_t>();
+		KeyStreamData(KEYSTREAM_COUNTER, { 0xF0, 0x0F, 0x80 }, { .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+		VerifyDataForType<std::uint8_t>();
+	}
+	TEST_METHOD(RC4) {
+		CreateDataForType<std::uint8_t>();
+		KeyStreamData(KEYSTREAM_RC4, { 'S', 'e', 'c', 'r', 'e', 't' }, { .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+		VerifyDataForType<std::uint8_t>();
+	}
+	TEST_METHOD(RC4KnownAnswer) {
+		constexpr std::uint8_t arrPlain[] { 'P', 'l', 'a', 'i', 'n', 't', 'e', 'x', 't' };
+		constexpr std::uint8_t arrCipher[] { 0xBB, 0xF3, 0x16, 0xE8, 0xD9, 0x40, 0xAF, 0x0A, 0xD3 };
+		GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { reinterpret_cast<const std::byte*>(arrPlain),
+			sizeof(arrPlain) }, .vecSpan { { 0, sizeof(arrPlain) } } });
+		const std::vector<std::uint8_t> vecKey { 'K', 'e', 'y' };
+		GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_KEYSTREAM }, .eKeyStream { KEYSTREAM_RC4 },
+			.spnData { reinterpret_cast<const std::byte*>(vecKey.data()), vecKey.size() }, .vecSpan { { 0, sizeof(arrPlain) } } });
+		const auto spnHexData = GetHexCtrl()->GetData({ .ullOffset { 0 }, .ullSize { sizeof(arrCipher) } });
+		for (auto i { 0U }; i < sizeof(arrCipher); ++i) {
+			Assert::AreEqual(arrCipher[i], static_cast<std::uint8_t>(spnHexData[i]));
+		}
+	}
+	};
+}
\ No newline at end of file
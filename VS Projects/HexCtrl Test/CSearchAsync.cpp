@@ -0,0 +1,304 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace TestHexCtrl {
+	[[nodiscard]] auto SearchAsyncHits(IHexCtrl* pHex, HEXSEARCH hss)->std::vector<ULONGLONG> {
+		std::vector<ULONGLONG> vecHit;
+		hss.FuncHit = [&](ULONGLONG ullOffset) { vecHit.emplace_back(ullOffset); return true; };
+		const auto pSearch = pHex->SearchAsync(hss);
+		Assert::IsTrue(pSearch != nullptr);
+		pSearch->Wait();
+		return vecHit;
+	}
+
+	//Compare the SearchAsync occurrences with the ones found here byte by byte, step 1.
+	void VerifySearchAsync(IHexCtrl* pHex, const std::vector<std::byte>& vecFind, bool fInverted) {
+		const auto ullDataSize = pHex->GetDataSize();
+		const auto spnData = pHex->GetData({ .ullOffset { 0 }, .ullSize { ullDataSize } });
+		std::vector<ULONGLONG> vecRef;
+		for (ULONGLONG ullOffset { 0 }; ullOffset + vecFind.size() <= ullDataSize; ++ullOffset) {
+			if ((std::memcmp(spnData.data() + ullOffset, vecFind.data(), vecFind.size()) != 0) == fInverted) {
+				vecRef.emplace_back(ullOffset);
+			}
+		}
+
+		const auto vecHit = SearchAsyncHits(pHex, { .vecData { vecFind }, .fInverted { fInverted } });
+		Assert::AreEqual(vecRef.size(), vecHit.size());
+		for (std::size_t i { 0 }; i < vecRef.size(); ++i) {
+			Assert::AreEqual(vecRef[i], vecHit[i]);
+		}
+	}
+
+	//Case insensitive search byte by byte, only the ASCII capital letters are folded, in the one or two bytes chars.
+	[[nodiscard]] auto FindCaseFold(SpanCByte spnData, SpanCByte spnFind, std::size_t sSizeChar, bool fInverted)->std::vector<ULONGLONG> {
+		const auto lmbFold = [sSizeChar](const std::byte* pChar) {
+			std::uint16_t u16Char { };
+			std::memcpy(&u16Char, pChar, sSizeChar);
+			return u16Char >= 'A' && u16Char <= 'Z' ? static_cast<std::uint16_t>(u16Char + 32) : u16Char;
+			};
+
+		std::vector<ULONGLONG> vecRef;
+		for (std::size_t sOffset { 0 }; sOffset + spnFind.size() <= spnData.size(); ++sOffset) {
+			auto fMatch { true };
+			for (std::size_t i { 0 }; i < spnFind.size() && fMatch; i += sSizeChar) {
+				fMatch = lmbFold(spnData.data() + sOffset + i) == lmbFold(spnFind.data() + i);
+			}
+
+			if (fMatch != fInverted) {
+				vecRef.emplace_back(sOffset);
+			}
+		}
+
+		return vecRef;
+	}
+
+	//Offsets of the search data byte by byte, in line with the step from the sFirst.
+	[[nodiscard]] auto FindStepped(SpanCByte spnData, SpanCByte spnFind, std::size_t sStep, std::size_t sFirst)->std::vector<ULONGLONG> {
+		std::vector<ULONGLONG> vecRef;
+		for (auto sOffset = sFirst; sOffset + spnFind.size() <= spnData.size(); sOffset += sStep) {
+			if (std::memcmp(spnData.data() + sOffset, spnFind.data(), spnFind.size()) == 0) {
+				vecRef.emplace_back(sOffset);
+			}
+		}
+
+		return vecRef;
+	}
+
+	//The data and the search data are of the same four bytes, the partial matches are frequent.
+	//The search data is placed at the data's both ends, and across every VirtualData chunks' boundary:
+	//starting at it, ending at it, crossing it in the middle, and crossing it by its last byte.
+	//The SearchAsync and the Search dialog results, forward and backward one by one, until the search wraps,
+	//are compared with the reference, in the default and in the virtual data modes.
+	void VerifyChunkEdges(std::size_t sSizeFind, std::size_t sStep, bool fForward, bool fBackward) {
+		constexpr auto uSizeCache { GetTestCacheSize() };
+		constexpr auto uSizeData { uSizeCache * 4U + 123U };
+		static std::byte byteData[uSizeData];
+		std::uniform_int_distribution<int> distr(0x11, 0x14);
+		for (auto& refByte : byteData) {
+			refByte = static_cast<std::byte>(distr(GetMT19937()));
+		}
+
+		std::vector<std::byte> vecFind(sSizeFind);
+		for (auto& refByte : vecFind) {
+			refByte = static_cast<std::byte>(distr(GetMT19937()));
+		}
+
+		std::vector<std::size_t> vecPlace { 0, uSizeData - sSizeFind };
+		for (std::size_t sEdge { uSizeCache }, sVariant { 0 }; sEdge + sSizeFind <= uSizeData; sEdge += uSizeCache, ++sVariant) {
+			const std::size_t arrOffset[] { sEdge, sEdge - sSizeFind, sEdge - (sSizeFind / 2), sEdge - 1 };
+			vecPlace.emplace_back(arrOffset[sVariant % std::size(arrOffset)]);
+		}
+		for (const auto sOffset : vecPlace) {
+			std::ranges::copy(vecFind, byteData + sOffset);
+		}
+
+		std::wstring wstrFind;
+		for (const auto byte : vecFind) {
+			wstrFind += std::format(L"{:02X}", static_cast<unsigned>(byte));
+		}
+
+		const auto vecRefFwd = FindStepped(byteData, vecFind, sStep, 0);
+		const auto vecRefBack = FindStepped(byteData, vecFind, sStep, (uSizeData - sSizeFind) % sStep); //From the last offset.
+		CVirtDataBuffer virtData({ byteData, sizeof(byteData) });
+		for (const auto pVirtData : { static_cast<IHexVirtData*>(nullptr), static_cast<IHexVirtData*>(&virtData) }) {
+			const auto pHex = CreateHexCtrlData({ byteData, sizeof(byteData) }, pVirtData);
+			const CSearchDlgDriver dlg(pHex.get());
+			dlg.SetMode(ESearchDlgMode::MODE_HEXBYTES);
+			dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_INV, false);
+			dlg.SetText(IDC_HEXCTRL_SEARCH_EDIT_STEP, std::format(L"{}", sStep));
+			dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, wstrFind);
+			if (fForward) { //One by one, before the Find All results are cached.
+				VerifyOffsets(vecRefFwd, SearchAsyncHits(pHex.get(), { .vecData { vecFind }, .ullStep { sStep } }));
+				VerifyOffsets(vecRefFwd, dlg.FindEach(true));
+				if (vecRefFwd.size() > 1) { //The search has wrapped to the first occurrence.
+					Assert::AreEqual(vecRefFwd[1], *dlg.FindNext(true));
+				}
+			}
+
+			if (fBackward) {
+				auto vecBack = dlg.FindEach(false);
+				std::ranges::reverse(vecBack);
+				VerifyOffsets(vecRefBack, vecBack);
+				if (vecRefBack.size() > 1) { //The search has wrapped to the last occurrence.
+					Assert::AreEqual(vecRefBack[vecRefBack.size() - 2], *dlg.FindNext(false));
+				}
+			}
+
+			if (fForward) {
+				VerifyOffsets(vecRefFwd, dlg.FindAll());
+			}
+			pHex->ClearData();
+		}
+	}
+
+	TEST_CLASS(CSearchAsync) {
+public:
+	TEST_METHOD(Byte2Byte4LaneCrossing) {
+		//The AVX2 two and four bytes kernels compare the data at the every byte offset of a 32 bytes vector,
+		//the occurrences that start in the vector's low 128-bit lane and end in the high one must be found too.
+		constexpr std::byte arrFind[] { std::byte { 0x5A }, std::byte { 0xA5 }, std::byte { 0x3C }, std::byte { 0xC3 } };
+		const std::byte byteFill { 0x77 };
+		for (const auto sSizeFind : { std::size_t { 2 }, std::size_t { 4 } }) {
+			const std::vector<std::byte> vecFind(arrFind, arrFind + sSizeFind);
+			for (auto ullOffset { 0ULL }; ullOffset < 80ULL; ++ullOffset) {
+				GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_REPEAT }, .spnData { &byteFill, 1 },
+					.vecSpan { { 0, GetTestDataSize() } } });
+				GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { vecFind },
+					.vecSpan { { ullOffset, sSizeFind } } });
+				VerifySearchAsync(GetHexCtrl(), vecFind, false);
+
+				//All the data but one byte is the search data's repeat, the inverted search finds only around it.
+				const std::vector<std::byte> vecFindRep(sSizeFind, byteFill);
+				GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { arrFind, 1 },
+					.vecSpan { { ullOffset + sSizeFind, 1 } } });
+				GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { vecFindRep },
+					.vecSpan { { ullOffset, sSizeFind } } });
+				VerifySearchAsync(GetHexCtrl(), vecFindRep, true);
+			}
+		}
+	}
+	TEST_METHOD(CaseFoldingText) {
+		//The case insensitive text of one, two and four bytes, and the inverted one, is folded,
+		//it's not compared as the exact bytes.
+		constexpr auto uSizeData { 4096U + 77U };
+		static std::byte byteData[uSizeData];
+		constexpr char arrChars[] { 'a', 'A', 'b', 'B', '\0' };
+		std::uniform_int_distribution<std::size_t> distr(0, std::size(arrChars) - 1);
+		for (auto& refByte : byteData) {
+			refByte = static_cast<std::byte>(arrChars[distr(GetMT19937())]);
+		}
+
+		const auto pHex { CreateHexCtrl() };
+		pHex->Create({ .hInstRes { ::GetModuleHandleW(HEXCTRL_DLL(L"HexCtrl")) },
+			.dwStyle { WS_POPUP | WS_OVERLAPPEDWINDOW }, .dwExStyle { WS_EX_APPWINDOW } });
+		pHex->SetData({ .spnData { byteData, sizeof(byteData) } });
+		const CSearchDlgDriver dlg(pHex.get());
+		dlg.SetText(IDC_HEXCTRL_SEARCH_EDIT_LIMIT, L"100000");
+
+		struct FIND { std::wstring_view wsvFind; bool fUTF16 { }; };
+		for (const auto& [wsvFind, fUTF16] : { FIND { L"a" }, FIND { L"aB" }, FIND { L"AbBa" },
+			FIND { L"B", true }, FIND { L"bA", true } }) {
+			std::vector<std::byte> vecFind;
+			for (const auto wch : wsvFind) {
+				vecFind.emplace_back(static_cast<std::byte>(wch));
+				if (fUTF16) {
+					vecFind.emplace_back(static_cast<std::byte>(wch >> 8));
+				}
+			}
+
+			dlg.SetMode(ESearchDlgMode::MODE_TEXT, fUTF16 ? 2 : 0);
+			dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_MC, false);
+			dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, wsvFind);
+			for (const auto fInverted : { false, true }) {
+				dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_INV, fInverted);
+				auto vecRef = FindCaseFold({ byteData, sizeof(byteData) }, vecFind, fUTF16 ? 2 : 1, fInverted);
+				if (!fInverted) { //One by one, before the Find All results are cached.
+					VerifyOffsets(vecRef, dlg.FindEach(true));
+					auto vecBack = dlg.FindEach(false);
+					std::ranges::reverse(vecBack);
+					VerifyOffsets(vecRef, vecBack);
+				}
+				VerifyOffsets(vecRef, dlg.FindAll());
+			}
+		}
+
+		pHex->ClearData();
+	}
+	TEST_METHOD(VirtualChunkBoundary) {
+		//The virtual data is read by the cache size chunks, the occurrences across their boundaries must be found.
+		//The chunks overlap by the (search data size - 1) bytes, every placement around the boundaries is checked.
+		constexpr auto uSizeCache { 1024U * 64U }; //Minimum cache size.
+		constexpr auto uSizeData { uSizeCache * 4U + 123U };
+		static std::byte byteData[uSizeData];
+		const std::byte byteFill { 0x77 };
+		std::ranges::fill(byteData, byteFill);
+		const std::vector<std::byte> vecFind { std::byte { 0x5A }, std::byte { 0xA5 }, std::byte { 0x3C },
+			std::byte { 0xC3 }, std::byte { 0x11 }, std::byte { 0x22 }, std::byte { 0x33 } };
+		const auto uSizeFind = static_cast<unsigned>(vecFind.size());
+
+		CVirtDataBuffer virtData({ byteData, sizeof(byteData) });
+		const auto pHex { CreateHexCtrl() };
+		pHex->Create({ .hInstRes { ::GetModuleHandleW(HEXCTRL_DLL(L"HexCtrl")) },
+			.dwStyle { WS_POPUP | WS_OVERLAPPEDWINDOW }, .dwExStyle { WS_EX_APPWINDOW } });
+		pHex->SetData({ .spnData { byteData, sizeof(byteData) }, .pHexVirtData { &virtData }, .dwCacheSize { uSizeCache } });
+
+		for (auto uChunk { 1U }; uChunk < 4U; ++uChunk) {
+			const auto uFirst = uChunk * (uSizeCache - (uSizeFind - 1)) - (uSizeFind + 1);
+			for (auto uOffset = uFirst; uOffset <= uChunk * uSizeCache + 1; ++uOffset) {
+				std::copy(vecFind.begin(), vecFind.end(), byteData + uOffset);
+				std::vector<ULONGLONG> vecHit;
+				const auto pSearch = pHex->SearchAsync({ .vecData { vecFind },
+					.FuncHit { [&](ULONGLONG ullOffset) { vecHit.emplace_back(ullOffset); return true; } } });
+				Assert::IsTrue(pSearch != nullptr);
+				Assert::IsTrue(pSearch->IsDone()); //The virtual data is searched in the calling thread.
+				Assert::AreEqual(std::size_t { 1 }, vecHit.size());
+				Assert::AreEqual(static_cast<ULONGLONG>(uOffset), vecHit[0]);
+				std::fill_n(byteData + uOffset, uSizeFind, byteFill);
+			}
+		}
+
+		pHex->ClearData();
+	}
+
+	TEST_METHOD(ModifyCancelsSearch) {
+		//Every byte is a hit, and every hit takes a while, the search is running when the data is modified.
+		//The ModifyData cancels the search and returns only after its thread has finished.
+		std::vector<std::byte> vecData(1024 * 1024);
+		const auto pHex = CreateHexCtrlData(vecData, nullptr, true);
+		std::atomic<ULONGLONG> atomHits { 0 };
+		const auto pSearch = pHex->SearchAsync({ .vecData { std::byte { 0 } },
+			.FuncHit { [&](ULONGLONG /*ullOffset*/) {
+				++atomHits;
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+				return true; } } });
+		Assert::IsTrue(pSearch != nullptr);
+		while (atomHits == 0) {
+			std::this_thread::yield();
+		}
+
+		const std::byte byteFill { 0xFF };
+		pHex->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { &byteFill, 1 }, .vecSpan { { 0, 1 } } });
+		Assert::IsTrue(pSearch->IsDone());
+		Assert::IsTrue(pSearch->IsCanceled());
+		const ULONGLONG ullHits = atomHits;
+		Assert::IsTrue(ullHits < vecData.size());
+		Assert::AreEqual(ullHits, pSearch->GetCount());
+	}
+
+	TEST_METHOD(BackwardFilter) {
+		//The backward search takes the vector's candidates from the highest one, and goes from the chunk's end
+		//to its beginning, the nearest occurrence before the start must be found, also when the search wraps.
+		for (const auto sSizeFind : { 5U, 6U, 7U, 8U, 15U, 16U, 17U, 31U, 32U, 33U, 63U, 64U, 65U, 255U, 256U }) {
+			VerifyChunkEdges(sSizeFind, 1, false, true);
+		}
+	}
+
+	TEST_METHOD(FirstLastByteFilter) {
+		//The search data of any size but 1, 2 and 4 bytes is found forward by its first and last bytes first,
+		//the vectors' candidates at the chunks' ends must be fully compared too.
+		for (const auto sSizeFind : { 5U, 6U, 7U, 8U, 15U, 16U, 17U, 31U, 32U, 33U, 63U, 64U, 65U, 255U, 256U }) {
+			VerifyChunkEdges(sSizeFind, 1, true, false);
+		}
+	}
+
+	TEST_METHOD(LongDataShifts) {
+		//The search data of 16 bytes and more with the steps other than 1, 2, 4, 8 and 16, is searched
+		//by the bad-character shifts forward and backward, the shifts are in line with the step.
+		for (const auto sStep : { std::size_t { 3 }, std::size_t { 5 } }) {
+			for (const auto sSizeFind : { 16U, 17U, 31U, 32U, 33U, 64U, 100U, 255U, 256U }) {
+				VerifyChunkEdges(sSizeFind, sStep, true, true);
+			}
+		}
+	}
+	};
+}
\ No newline at end of file
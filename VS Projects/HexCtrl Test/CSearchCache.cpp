@@ -0,0 +1,68 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace TestHexCtrl {
+	TEST_CLASS(CSearchCache) {
+public:
+	TEST_METHOD(PatchedMatchesFresh) {
+		//The "Find All" results are cached, and only the data around the modified spans is searched again.
+		//The modifications break an occurrence, make a new one that goes past the modified span, and touch
+		//the byte right before an occurrence. The patched results must be the same as a fresh search finds.
+		constexpr auto uSizeData { 1024U * 256U };
+		static std::byte byteData[uSizeData];
+		static constexpr std::byte arrFind[] { std::byte { 0x5A }, std::byte { 0xA5 }, std::byte { 0x3C }, std::byte { 0xC3 } };
+		std::ranges::fill(byteData, std::byte { 0x77 });
+		for (const auto sOffset : { std::size_t { 100 }, std::size_t { 5000 }, std::size_t { 5004 }, std::size_t { 20000 },
+			std::size_t { 40000 }, std::size_t { uSizeData - 4U } }) {
+			std::ranges::copy(arrFind, byteData + sOffset);
+		}
+		std::ranges::copy(std::span(arrFind).last(2), byteData + 30000); //Half of the search data.
+
+		const auto lmbFindRef = []() {
+			std::vector<ULONGLONG> vecRef;
+			for (std::size_t sOffset { 0 }; sOffset + std::size(arrFind) <= uSizeData; ++sOffset) {
+				if (std::memcmp(byteData + sOffset, arrFind, std::size(arrFind)) == 0) {
+					vecRef.emplace_back(sOffset);
+				}
+			}
+			return vecRef;
+			};
+
+		const auto pHex = CreateHexCtrlData({ byteData, sizeof(byteData) }, nullptr, true);
+		const CSearchDlgDriver dlg(pHex.get());
+		dlg.SetMode(ESearchDlgMode::MODE_HEXBYTES);
+		dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_INV, false);
+		dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, L"5AA53CC3");
+		const auto vecRef = lmbFindRef();
+		VerifyOffsets(vecRef, dlg.FindAll());
+
+		//The data changed outside the HexCtrl is not seen, the results are taken from the cache.
+		byteData[100] = std::byte { 0x00 };
+		VerifyOffsets(vecRef, dlg.FindAll());
+		byteData[100] = arrFind[0];
+
+		const std::byte byteZero { 0x00 };
+		pHex->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { &byteZero, 1 }, .vecSpan { { 5002, 1 } } });
+		pHex->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { arrFind, 2 }, .vecSpan { { 29998, 2 } } });
+		pHex->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { &byteZero, 1 }, .vecSpan { { 19999, 1 } } });
+		const auto vecRefMod = lmbFindRef();
+		Assert::AreEqual(vecRef.size(), vecRefMod.size()); //One occurrence is broken, one is made.
+		VerifyOffsets(vecRefMod, dlg.FindAll());
+		VerifyOffsets(vecRefMod, dlg.FindEach(true));
+
+		const auto pHexFresh = CreateHexCtrlData({ byteData, sizeof(byteData) });
+		const CSearchDlgDriver dlgFresh(pHexFresh.get());
+		dlgFresh.SetMode(ESearchDlgMode::MODE_HEXBYTES);
+		dlgFresh.SetCheck(IDC_HEXCTRL_SEARCH_CHK_INV, false);
+		dlgFresh.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, L"5AA53CC3");
+		VerifyOffsets(dlgFresh.FindAll(), dlg.FindAll());
+		pHexFresh->ClearData();
+		pHex->ClearData();
+	}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <cstring>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace TestHexCtrl {
+	TEST_CLASS(CSearchCount) {
+public:
+	TEST_METHOD(CountEqualsFindAll) {
+		//The "Count All" counts the matches within the search kernels, the count must be the same as
+		//the count of the "Find All" results, for the search data of every kernel's size, inverted too.
+		constexpr auto uSizeCache { GetTestCacheSize() };
+		constexpr auto uSizeData { uSizeCache * 2U + 77U };
+		static std::byte byteData[uSizeData];
+		const std::byte arrBytes[] { std::byte { 0x11 }, std::byte { 0x22 }, std::byte { 0x33 } };
+		std::uniform_int_distribution<std::size_t> distr(0, std::size(arrBytes) - 1);
+		for (auto& refByte : byteData) {
+			refByte = arrBytes[distr(GetMT19937())];
+		}
+
+		CVirtDataBuffer virtData({ byteData, sizeof(byteData) });
+		for (const auto pVirtData : { static_cast<IHexVirtData*>(nullptr), static_cast<IHexVirtData*>(&virtData) }) {
+			const auto pHex = CreateHexCtrlData({ byteData, sizeof(byteData) }, pVirtData);
+			const CSearchDlgDriver dlg(pHex.get());
+			dlg.SetMode(ESearchDlgMode::MODE_HEXBYTES);
+			dlg.SetText(IDC_HEXCTRL_SEARCH_EDIT_LIMIT, L"1000000");
+			for (const auto sSizeFind : { 1U, 2U, 3U, 4U, 8U, 16U }) {
+				const std::vector<std::byte> vecFind(byteData + 1000, byteData + 1000 + sSizeFind);
+				std::wstring wstrFind;
+				for (const auto byte : vecFind) {
+					wstrFind += std::format(L"{:02X}", static_cast<unsigned>(byte));
+				}
+
+				dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, wstrFind);
+				for (const auto fInverted : { false, true }) {
+					auto ullRef { 0ULL };
+					for (std::size_t sOffset { 0 }; sOffset + vecFind.size() <= uSizeData; ++sOffset) {
+						ullRef += (std::memcmp(byteData + sOffset, vecFind.data(), vecFind.size()) != 0) == fInverted ? 1 : 0;
+					}
+
+					dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_INV, fInverted);
+					Assert::AreEqual(ullRef, dlg.CountAll());
+					Assert::AreEqual(ullRef, static_cast<ULONGLONG>(dlg.FindAll().size()));
+					Assert::AreEqual(ullRef, dlg.CountAll()); //After the Find All results are cached.
+				}
+			}
+			pHex->ClearData();
+		}
+	}
+	};
+}
\ No newline at end of file
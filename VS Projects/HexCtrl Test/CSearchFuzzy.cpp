@@ -0,0 +1,73 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace TestHexCtrl {
+	//Offsets where the data differs from the search data in no more than dwMismatch bytes.
+	[[nodiscard]] auto FindHamming(SpanCByte spnData, SpanCByte spnFind, DWORD dwMismatch)->std::vector<ULONGLONG> {
+		std::vector<ULONGLONG> vecRef;
+		for (std::size_t sOffset { 0 }; sOffset + spnFind.size() <= spnData.size(); ++sOffset) {
+			DWORD dwDist { 0 };
+			for (std::size_t i { 0 }; i < spnFind.size() && dwDist <= dwMismatch; ++i) {
+				dwDist += spnData[sOffset + i] != spnFind[i] ? 1 : 0;
+			}
+
+			if (dwDist <= dwMismatch) {
+				vecRef.emplace_back(sOffset);
+			}
+		}
+
+		return vecRef;
+	}
+
+	TEST_CLASS(CSearchFuzzy) {
+public:
+	TEST_METHOD(HammingDistance) {
+		//The search data is placed with none, one, two and four mismatching bytes, the mismatch at its
+		//last byte too, and also across the VirtualData chunks' boundaries.
+		constexpr auto uSizeCache { GetTestCacheSize() };
+		constexpr auto uSizeData { uSizeCache * 3U + 123U };
+		static std::byte byteData[uSizeData];
+		const std::vector<std::byte> vecFind { std::byte { 0x5A }, std::byte { 0xA5 }, std::byte { 0x3C },
+			std::byte { 0xC3 }, std::byte { 0x11 }, std::byte { 0x22 }, std::byte { 0x33 }, std::byte { 0x44 } };
+		struct PLACE { ULONGLONG ullOffset; std::vector<std::size_t> vecMismatch; };
+		const PLACE arrPlace[] { { 100, { } }, { 1000, { 7 } }, { 5000, { 0, 4 } }, { 9000, { 1, 2, 5, 6 } },
+			{ uSizeCache - 3, { } }, { uSizeCache * 2 - 5, { 7 } }, { uSizeCache * 3 - 2, { 0, 3, 7 } } };
+		std::ranges::fill(byteData, std::byte { 0x77 });
+		for (const auto& [ullOffset, vecMismatch] : arrPlace) {
+			std::ranges::copy(vecFind, byteData + ullOffset);
+			for (const auto sIndex : vecMismatch) {
+				byteData[ullOffset + sIndex] = ~byteData[ullOffset + sIndex];
+			}
+		}
+
+		std::wstring wstrFind;
+		for (const auto byte : vecFind) {
+			wstrFind += std::format(L"{:02X}", static_cast<unsigned>(byte));
+		}
+
+		CVirtDataBuffer virtData({ byteData, sizeof(byteData) });
+		for (const auto pVirtData : { static_cast<IHexVirtData*>(nullptr), static_cast<IHexVirtData*>(&virtData) }) {
+			const auto pHex = CreateHexCtrlData({ byteData, sizeof(byteData) }, pVirtData);
+			const CSearchDlgDriver dlg(pHex.get());
+			dlg.SetMode(ESearchDlgMode::MODE_HEXBYTES);
+			dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_INV, false);
+			dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, wstrFind);
+			for (const auto dwMismatch : { 0UL, 1UL, 2UL, 4UL }) {
+				dlg.SetText(IDC_HEXCTRL_SEARCH_EDIT_MISMATCH, std::format(L"{}", dwMismatch));
+				const auto vecRef = FindHamming({ byteData, sizeof(byteData) }, vecFind, dwMismatch);
+				VerifyOffsets(vecRef, dlg.FindEach(true)); //One by one, before the Find All results are cached.
+				auto vecBack = dlg.FindEach(false);
+				std::ranges::reverse(vecBack);
+				VerifyOffsets(vecRef, vecBack);
+				VerifyOffsets(vecRef, dlg.FindAll());
+			}
+			pHex->ClearData();
+		}
+	}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace TestHexCtrl {
+	[[nodiscard]] auto ReadIndexFile(const std::filesystem::path& path)->std::vector<char> {
+		std::ifstream ifs(path, std::ios::binary);
+		return { std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>() };
+	}
+
+	//Offsets of all the occurrences, by the plain memory compare.
+	[[nodiscard]] auto FindPlain(SpanCByte spnData, SpanCByte spnFind)->std::vector<ULONGLONG> {
+		std::vector<ULONGLONG> vecRef;
+		for (std::size_t sOffset { 0 }; sOffset + spnFind.size() <= spnData.size(); ++sOffset) {
+			if (std::memcmp(spnData.data() + sOffset, spnFind.data(), spnFind.size()) == 0) {
+				vecRef.emplace_back(sOffset);
+			}
+		}
+
+		return vecRef;
+	}
+
+	[[nodiscard]] auto CreateIndexHexCtrl(SpanByte spnData)->IHexCtrlPtr {
+		auto pHex { CreateHexCtrl() };
+		pHex->Create({ .hInstRes { ::GetModuleHandleW(HEXCTRL_DLL(L"HexCtrl")) },
+			.dwStyle { WS_POPUP | WS_OVERLAPPEDWINDOW }, .dwExStyle { WS_EX_APPWINDOW } });
+		pHex->SetData({ .spnData { spnData }, .fMutable { true } });
+		return pHex;
+	}
+
+	TEST_CLASS(CSearchIndex) {
+public:
+	TEST_METHOD(IndexMatchesPlainSearch) {
+		//The search data is placed at the data's both ends, and in-between. The results found with
+		//the index are the same as the ones found without it, before and after the data is modified.
+		constexpr auto uSizeData { 1024U * 1024U };
+		static std::byte byteData[uSizeData];
+		std::uniform_int_distribution<int> distr(0, 255);
+		for (auto& refByte : byteData) {
+			refByte = static_cast<std::byte>(distr(GetMT19937()));
+		}
+
+		std::vector<std::byte> vecFind(16);
+		for (auto& refByte : vecFind) {
+			refByte = static_cast<std::byte>(distr(GetMT19937()));
+		}
+		for (const auto sOffset : { std::size_t { 0 }, std::size_t { 12345 }, std::size_t { 500001 },
+			std::size_t { uSizeData - 16 } }) {
+			std::ranges::copy(vecFind, byteData + sOffset);
+		}
+		byteData[300000] = vecFind[0]; //Almost the search data, the last byte differs.
+		std::copy(vecFind.begin() + 1, vecFind.end() - 1, byteData + 300001);
+		byteData[300015] = ~vecFind[15];
+
+		std::wstring wstrFind;
+		for (const auto byte : vecFind) {
+			wstrFind += std::format(L"{:02X}", static_cast<unsigned>(byte));
+		}
+
+		const auto pHex = CreateIndexHexCtrl({ byteData, sizeof(byteData) });
+		const CSearchDlgDriver dlg(pHex.get());
+		dlg.SetMode(ESearchDlgMode::MODE_HEXBYTES);
+		dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_INV, false);
+		dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, wstrFind);
+		const auto lmbFindEach = [&dlg](bool fForward) {
+			auto vecRes = dlg.FindEach(fForward);
+			if (!fForward) {
+				std::ranges::reverse(vecRes);
+			}
+			return vecRes;
+			};
+
+		//One by one without the index, before the Find All results are cached.
+		const auto vecRef = FindPlain({ byteData, sizeof(byteData) }, vecFind);
+		Assert::AreEqual(std::size_t { 4 }, vecRef.size());
+		VerifyOffsets(vecRef, lmbFindEach(true));
+		VerifyOffsets(vecRef, lmbFindEach(false));
+
+		const auto pathIndex = std::filesystem::temp_directory_path() / L"HexCtrlTestIndexPlain.hxix";
+		std::filesystem::remove(pathIndex);
+		Assert::IsTrue(pHex->SetSearchIndex(pathIndex.wstring()));
+		pHex->WaitSearchIndex();
+		const auto vecIndex = ReadIndexFile(pathIndex);
+		Assert::IsTrue(vecIndex.size() > 4 && std::memcmp(vecIndex.data(), "HXIX", 4) == 0);
+		VerifyOffsets(vecRef, lmbFindEach(true));
+		VerifyOffsets(vecRef, lmbFindEach(false));
+
+		//The modified data is searched directly, and the side file is kept as is.
+		pHex->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { vecFind }, .vecSpan { { 700000, vecFind.size() } } });
+		const std::byte byteFill { 0x00 };
+		pHex->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { &byteFill, 1 }, .vecSpan { { 500001 + 7, 1 } } });
+		const auto vecRefMod = FindPlain({ byteData, sizeof(byteData) }, vecFind);
+		Assert::AreEqual(std::size_t { 4 }, vecRefMod.size());
+		VerifyOffsets(vecRefMod, lmbFindEach(true));
+		VerifyOffsets(vecRefMod, lmbFindEach(false));
+		VerifyOffsets(vecRefMod, dlg.FindAll());
+		Assert::IsTrue(vecIndex == ReadIndexFile(pathIndex));
+
+		pHex->ClearData();
+		std::filesystem::remove(pathIndex);
+	}
+
+	TEST_METHOD(OtherFileNotOverwritten) {
+		//The side file path points to a file that is not an index side file, it's left intact.
+		constexpr auto uSizeData { 64U * 1024U };
+		static std::byte byteData[uSizeData];
+		std::uniform_int_distribution<int> distr(0, 255);
+		for (auto& refByte : byteData) {
+			refByte = static_cast<std::byte>(distr(GetMT19937()));
+		}
+
+		const auto pathOther = std::filesystem::temp_directory_path() / L"HexCtrlTestIndexOther.txt";
+		{
+			std::ofstream ofs(pathOther, std::ios::binary | std::ios::trunc);
+			ofs << "Not an index side file.";
+		}
+		const auto vecOther = ReadIndexFile(pathOther);
+
+		const auto pHex = CreateIndexHexCtrl({ byteData, sizeof(byteData) });
+		Assert::IsTrue(pHex->SetSearchIndex(pathOther.wstring()));
+		pHex->WaitSearchIndex();
+		Assert::IsTrue(vecOther == ReadIndexFile(pathOther));
+
+		pHex->ClearData();
+		std::filesystem::remove(pathOther);
+	}
+
+	TEST_METHOD(StaleIndexRejected) {
+		constexpr auto uSizeData { 1024U * 1024U };
+		static std::byte byteData[uSizeData];
+		std::uniform_int_distribution<int> distr(0, 255);
+		for (auto& refByte : byteData) {
+			refByte = static_cast<std::byte>(distr(GetMT19937()));
+		}
+
+		const auto pHex = CreateIndexHexCtrl({ byteData, sizeof(byteData) });
+		const auto pathIndex = std::filesystem::temp_directory_path() / L"HexCtrlTestIndex.hxix";
+		std::filesystem::remove(pathIndex);
+		Assert::IsTrue(pHex->SetSearchIndex(pathIndex.wstring()));
+		pHex->WaitSearchIndex();
+		const auto vecIndex = ReadIndexFile(pathIndex);
+		Assert::IsFalse(vecIndex.empty());
+		Assert::IsTrue(pHex->SetSearchIndex(L""));
+
+		//The data is changed outside the HexCtrl, keeping its size, the side file must not be loaded then.
+		byteData[uSizeData / 2 + 123] ^= std::byte { 0xFF };
+		Assert::IsTrue(pHex->SetSearchIndex(pathIndex.wstring()));
+		pHex->WaitSearchIndex();
+		const auto vecIndexNew = ReadIndexFile(pathIndex);
+		Assert::IsFalse(vecIndexNew.empty());
+		Assert::IsTrue(vecIndexNew != vecIndex); //The index was rebuilt and saved again.
+
+		pHex->ClearData();
+		std::filesystem::remove(pathIndex);
+	}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace TestHexCtrl {
+	//Numbers search for the tMin..tMax range in the random data, with the range's ends and the numbers
+	//just outside them planted in, and the NaN for the floating point numbers. Every byte offset is checked.
+	template<typename T>
+	void VerifyNumRange(int iType, std::wstring_view wsvFind, T tMin, T tMax) {
+		constexpr auto uSizeData { 1024U + 5U };
+		static std::byte byteData[uSizeData];
+		std::vector<T> vecPlant { tMin, tMax, static_cast<T>(tMin / 2 + tMax / 2) };
+		if constexpr (std::is_floating_point_v<T>) {
+			vecPlant.emplace_back(std::nextafter(tMin, std::numeric_limits<T>::lowest()));
+			vecPlant.emplace_back(std::nextafter(tMax, (std::numeric_limits<T>::max)()));
+			vecPlant.emplace_back(std::numeric_limits<T>::quiet_NaN());
+		}
+		else {
+			if (tMin > std::numeric_limits<T>::lowest()) {
+				vecPlant.emplace_back(static_cast<T>(tMin - 1));
+			}
+			if (tMax < (std::numeric_limits<T>::max)()) {
+				vecPlant.emplace_back(static_cast<T>(tMax + 1));
+			}
+		}
+
+		std::uniform_int_distribution<int> distrByte(0, 255);
+		for (auto& refByte : byteData) {
+			refByte = static_cast<std::byte>(distrByte(GetMT19937()));
+		}
+		std::uniform_int_distribution<std::size_t> distrPlant(0, vecPlant.size() * 2 - 1); //Half of the numbers are random.
+		for (std::size_t sOffset { 0 }; sOffset + sizeof(T) <= uSizeData; sOffset += sizeof(T)) {
+			if (const auto sPlant = distrPlant(GetMT19937()); sPlant < vecPlant.size()) {
+				std::memcpy(byteData + sOffset, &vecPlant[sPlant], sizeof(T));
+			}
+		}
+
+		std::vector<ULONGLONG> vecRef;
+		for (std::size_t sOffset { 0 }; sOffset + sizeof(T) <= uSizeData; ++sOffset) {
+			T tData;
+			std::memcpy(&tData, byteData + sOffset, sizeof(T));
+			if (tData >= tMin && tData <= tMax) { //NaN is never in range.
+				vecRef.emplace_back(sOffset);
+			}
+		}
+		Assert::IsFalse(vecRef.empty());
+
+		const auto pHex = CreateHexCtrlData({ byteData, sizeof(byteData) });
+		const CSearchDlgDriver dlg(pHex.get());
+		dlg.SetMode(ESearchDlgMode::MODE_NUMBERS, iType);
+		dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_BE, false);
+		dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_INV, false);
+		dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, wsvFind);
+		VerifyOffsets(vecRef, dlg.FindEach(true)); //One by one, before the Find All results are cached.
+		auto vecBack = dlg.FindEach(false);
+		std::ranges::reverse(vecBack);
+		VerifyOffsets(vecRef, vecBack);
+		VerifyOffsets(vecRef, dlg.FindAll());
+		pHex->ClearData();
+	}
+
+	TEST_CLASS(CSearchNumRange) {
+public:
+	TEST_METHOD(Integers) {
+		VerifyNumRange<std::int8_t>(0, L"-10..10", -10, 10);
+		VerifyNumRange<std::uint8_t>(1, L"200..250", 200, 250);
+		VerifyNumRange<std::int16_t>(2, L"-1000 ~500", -1500, -500);
+		VerifyNumRange<std::uint16_t>(3, L"40000..50000", 40000, 50000);
+		VerifyNumRange<std::int32_t>(4, L"-5..-1", -5, -1);
+		VerifyNumRange<std::uint32_t>(5, L"4294967290 ~10", 4294967280U, 4294967295U); //Saturated at the max.
+		VerifyNumRange<std::int64_t>(6, L"-9223372036854775800 ~100", (std::numeric_limits<std::int64_t>::min)(),
+			-9223372036854775700LL); //Saturated at the min.
+		VerifyNumRange<std::uint64_t>(7, L"10..20", 10, 20);
+	}
+	TEST_METHOD(FloatingPoint) {
+		VerifyNumRange<float>(8, L"-2.5..2.5", -2.5F, 2.5F);
+		VerifyNumRange<float>(8, L"100 ~1%", 99.F, 101.F);
+		VerifyNumRange<double>(9, L"-1e10..-1e9", -1e10, -1e9);
+		VerifyNumRange<double>(9, L"3.14 ~0.01", 3.14 - 0.01, 3.14 + 0.01);
+	}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <cstring>
+#include <vector>
+
+namespace TestHexCtrl {
+	[[nodiscard]] auto MakePattern(std::initializer_list<std::uint8_t> il)->std::vector<std::byte> {
+		std::vector<std::byte> vec;
+		for (const auto u8 : il) {
+			vec.emplace_back(static_cast<std::byte>(u8));
+		}
+		return vec;
+	}
+
+	//Compare the HexCtrl's occurrences with the ones found here byte by byte.
+	void VerifyPatterns(const HEXPATTERNS& hps) {
+		const auto vecHit = GetHexCtrl()->SearchPatterns(hps);
+		const auto spnData = GetHexCtrl()->GetData({ .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+		std::vector<HEXPATTERNHIT> vecRef;
+		for (const auto& hss : hps.vecSpan) {
+			for (auto ullOffset = hss.ullOffset; ullOffset < hss.ullOffset + hss.ullSize; ++ullOffset) {
+				for (std::size_t sPatt { 0 }; sPatt < hps.vecPattern.size(); ++sPatt) {
+					const auto& vecPatt = hps.vecPattern[sPatt];
+					if (!vecPatt.empty() && ullOffset + vecPatt.size() <= hss.ullOffset + hss.ullSize
+						&& std::memcmp(spnData.data() + ullOffset, vecPatt.data(), vecPatt.size()) == 0) {
+						vecRef.emplace_back(ullOffset, sPatt);
+					}
+				}
+			}
+		}
+		if (vecRef.size() > hps.dwLimit) {
+			vecRef.resize(hps.dwLimit);
+		}
+
+		Assert::AreEqual(vecRef.size(), vecHit.size());
+		for (std::size_t i { 0 }; i < vecRef.size(); ++i) {
+			Assert::AreEqual(vecRef[i].ullOffset, vecHit[i].ullOffset);
+			Assert::AreEqual(vecRef[i].sPatternIndex, vecHit[i].sPatternIndex);
+		}
+	}
+
+	TEST_CLASS(CSearchPatterns) {
+public:
+	TEST_METHOD(Overlapping) {
+		constexpr std::uint8_t arrData[] { 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x03 };
+		GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { reinterpret_cast<const std::byte*>(arrData),
+			sizeof(arrData) }, .vecSpan { { 10, sizeof(arrData) } } });
+		const auto vecHit = GetHexCtrl()->SearchPatterns({ .vecSpan { { 10, sizeof(arrData) } },
+			.vecPattern { MakePattern({ 0x01, 0x02, 0x01 }), MakePattern({ 0x02 }), MakePattern({ 0x02, 0x03 }) } });
+		Assert::AreEqual(std::size_t { 6 }, vecHit.size());
+		Assert::AreEqual(10ULL, vecHit[0].ullOffset);
+		Assert::AreEqual(std::size_t { 0 }, vecHit[0].sPatternIndex);
+		Assert::AreEqual(12ULL, vecHit[2].ullOffset);
+		Assert::AreEqual(std::size_t { 0 }, vecHit[2].sPatternIndex);
+		Assert::AreEqual(15ULL, vecHit[4].ullOffset);
+		Assert::AreEqual(std::size_t { 1 }, vecHit[4].sPatternIndex);
+		Assert::AreEqual(15ULL, vecHit[5].ullOffset);
+		Assert::AreEqual(std::size_t { 2 }, vecHit[5].sPatternIndex);
+	}
+	TEST_METHOD(ManyPatterns) {
+		CreateDataForType<std::uint8_t>();
+		const auto spnData = GetHexCtrl()->GetData({ .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+		HEXPATTERNS hps { .vecSpan { { 0, GetTestDataSize() } } };
+		for (auto i { 0U }; i < 100U; ++i) { //Patterns of the different sizes, taken from the data itself.
+			const auto pData = spnData.data() + ((i * 37U) % (GetTestDataSize() - 16));
+			hps.vecPattern.emplace_back(pData, pData + 1 + (i % 16));
+		}
+		hps.vecPattern.emplace_back(); //Empty pattern never matches.
+		VerifyPatterns(hps);
+	}
+	TEST_METHOD(SpansAndLimit) {
+		CreateDataForType<std::uint8_t>();
+		VerifyPatterns({ .vecSpan { { 0, 100 }, { 200, 150 } },
+			.vecPattern { MakePattern({ 0x00 }), MakePattern({ 0xFF }), MakePattern({ 0x7F, 0x80 }) }, .dwLimit { 5 } });
+	}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace TestHexCtrl {
+	//Offsets the fMatchAt(sOffset) holds at, the reference for the regex search.
+	template<typename TFuncMatch>
+	[[nodiscard]] auto FindRegexRef(std::size_t sSize, const TFuncMatch& fMatchAt)->std::vector<ULONGLONG> {
+		std::vector<ULONGLONG> vecRef;
+		for (std::size_t sOffset { 0 }; sOffset < sSize; ++sOffset) {
+			if (fMatchAt(sOffset)) {
+				vecRef.emplace_back(sOffset);
+			}
+		}
+
+		return vecRef;
+	}
+
+	TEST_CLASS(CSearchRegex) {
+public:
+	TEST_METHOD(MatchesAcrossChunks) {
+		//Bounded and unbounded expressions, with the matches that cross the VirtualData chunks' boundaries,
+		//the overlapping ones, and the ones that start and end in the different chunks.
+		constexpr auto uSizeCache { GetTestCacheSize() };
+		constexpr auto uSizeData { uSizeCache * 3U + 123U };
+		static std::byte byteData[uSizeData];
+		std::ranges::fill(byteData, std::byte { 0x77 });
+		const auto lmbPut = [](std::size_t sOffset, std::initializer_list<std::uint8_t> ilBytes) {
+			for (const auto u8 : ilBytes) {
+				byteData[sOffset++] = static_cast<std::byte>(u8);
+			}
+			};
+
+		//"\x5A\xA5.{0,40}\x3C\xC3", the gap of 41 bytes doesn't match.
+		for (const auto [sOffset, sGap] : { std::pair { 100U, 0U }, { 1000U, 40U }, { 3000U, 41U },
+			{ uSizeCache - 10U, 30U }, { uSizeCache * 3U - 1U, 5U }, { uSizeCache * 3U + 60U, 39U } }) {
+			lmbPut(sOffset, { 0x5A, 0xA5 });
+			lmbPut(sOffset + 2U + sGap, { 0x3C, 0xC3 });
+		}
+		lmbPut(20000, { 0x5A, 0xA5, 0x5A, 0xA5 });
+		lmbPut(20010, { 0x3C, 0xC3 });
+
+		//"\x11[\x00-\xFE]*\x22", the 0xFF breaks the match.
+		lmbPut(uSizeCache + 2000U, { 0x11 });
+		lmbPut(uSizeCache * 2U + 5U, { 0x22 });
+		lmbPut(uSizeCache * 2U + 100U, { 0xFF });
+		lmbPut(uSizeCache * 2U + 200U, { 0x11 });
+		lmbPut(uSizeCache * 2U + 300U, { 0xFF });
+		lmbPut(uSizeCache * 2U + 400U, { 0x22 });
+		lmbPut(uSizeCache * 2U + 1000U, { 0x11 });
+		lmbPut(uSizeCache * 2U + 1010U, { 0x11 });
+		lmbPut(uSizeCache * 3U + 30U, { 0x22 });
+
+		const auto lmbByte = [](std::size_t sOffset) { return static_cast<std::uint8_t>(byteData[sOffset]); };
+		const auto vecRefBounded = FindRegexRef(uSizeData, [&](std::size_t sOffset) {
+			if (sOffset + 4U > uSizeData || lmbByte(sOffset) != 0x5A || lmbByte(sOffset + 1U) != 0xA5)
+				return false;
+
+			for (std::size_t sGap { 0 }; sGap <= 40U && sOffset + sGap + 4U <= uSizeData; ++sGap) {
+				if (lmbByte(sOffset + sGap + 2U) == 0x3C && lmbByte(sOffset + sGap + 3U) == 0xC3)
+					return true;
+			}
+			return false; });
+		const auto vecRefUnbounded = FindRegexRef(uSizeData, [&](std::size_t sOffset) {
+			if (lmbByte(sOffset) != 0x11)
+				return false;
+
+			for (auto sIndex = sOffset + 1U; sIndex < uSizeData && lmbByte(sIndex) != 0xFF; ++sIndex) {
+				if (lmbByte(sIndex) == 0x22)
+					return true;
+			}
+			return false; });
+		Assert::AreEqual(std::size_t { 7 }, vecRefBounded.size());
+		Assert::AreEqual(std::size_t { 3 }, vecRefUnbounded.size());
+
+		CVirtDataBuffer virtData({ byteData, sizeof(byteData) });
+		for (const auto pVirtData : { static_cast<IHexVirtData*>(nullptr), static_cast<IHexVirtData*>(&virtData) }) {
+			const auto pHex = CreateHexCtrlData({ byteData, sizeof(byteData) }, pVirtData);
+			const CSearchDlgDriver dlg(pHex.get());
+			dlg.SetMode(ESearchDlgMode::MODE_REGEX);
+			dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_MC, true);
+			for (const auto& [wsvFind, pRef] : { std::pair { std::wstring_view { LR"(\x5A\xA5.{0,40}\x3C\xC3)" }, &vecRefBounded },
+				{ std::wstring_view { LR"(\x11[\x00-\xFE]*\x22)" }, &vecRefUnbounded } }) {
+				dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, wsvFind);
+				VerifyOffsets(*pRef, dlg.FindEach(true));
+				auto vecBack = dlg.FindEach(false);
+				std::ranges::reverse(vecBack);
+				VerifyOffsets(*pRef, vecBack);
+				VerifyOffsets(*pRef, dlg.FindAll());
+			}
+			pHex->ClearData();
+		}
+	}
+
+	TEST_METHOD(PathologicalRuns) {
+		//Long runs of the bytes that every match consists of, the matches are found in the linear time.
+		//"[\x00-\x1f]{4,}" matches at almost every offset of the zero-filled data, the "[\x00-\x1f]{4,}\x01"
+		//matches only before the single 0x01, but every offset of the runs starts a partial match.
+		constexpr auto uSizeCache { GetTestCacheSize() };
+		constexpr auto uSizeData { uSizeCache * 3U + 123U };
+		static std::byte byteData[uSizeData];
+		std::ranges::fill(byteData, std::byte { 0x00 });
+		byteData[uSizeCache + 7U] = std::byte { 0xFF };
+		byteData[uSizeCache * 2U + 2U] = std::byte { 0xFF };
+		byteData[uSizeCache * 2U + 990U] = std::byte { 0xFF };
+		byteData[uSizeCache * 2U + 1000U] = std::byte { 0x01 };
+
+		//Offsets of the next byte that is not in the [\x00-\x1f], and of the next 0x01, from every offset.
+		std::vector<std::size_t> vecNextBreak(uSizeData + 1U, uSizeData);
+		std::vector<std::size_t> vecNext01(uSizeData + 1U, uSizeData);
+		for (auto sOffset = uSizeData; sOffset-- > 0;) {
+			const auto u8 = static_cast<std::uint8_t>(byteData[sOffset]);
+			vecNextBreak[sOffset] = u8 > 0x1F ? sOffset : vecNextBreak[sOffset + 1U];
+			vecNext01[sOffset] = u8 == 0x01 ? sOffset : vecNext01[sOffset + 1U];
+		}
+
+		const auto vecRefRun = FindRegexRef(uSizeData, [&](std::size_t sOffset) {
+			return vecNextBreak[sOffset] >= sOffset + 4U; });
+		const auto vecRefRun01 = FindRegexRef(uSizeData, [&](std::size_t sOffset) {
+			return sOffset + 4U < uSizeData && vecNext01[sOffset + 4U] < vecNextBreak[sOffset]; });
+		Assert::AreEqual(std::size_t { 6 }, vecRefRun01.size());
+
+		CVirtDataBuffer virtData({ byteData, sizeof(byteData) });
+		for (const auto pVirtData : { static_cast<IHexVirtData*>(nullptr), static_cast<IHexVirtData*>(&virtData) }) {
+			const auto pHex = CreateHexCtrlData({ byteData, sizeof(byteData) }, pVirtData);
+			const CSearchDlgDriver dlg(pHex.get());
+			dlg.SetMode(ESearchDlgMode::MODE_REGEX);
+			dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_MC, true);
+
+			dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, LR"([\x00-\x1f]{4,})");
+			Assert::AreEqual(static_cast<ULONGLONG>(vecRefRun.size()), dlg.CountAll());
+			for (const auto ullStart : { 0ULL, uSizeCache + 4ULL, uSizeCache * 2ULL - 1ULL, 5000ULL, uSizeData - 4ULL }) {
+				dlg.Reset();
+				dlg.SetText(IDC_HEXCTRL_SEARCH_EDIT_START, std::format(L"0x{:X}", ullStart));
+				const auto optOffset = dlg.FindNext(true);
+				Assert::IsTrue(optOffset.has_value());
+				Assert::AreEqual(*std::ranges::lower_bound(vecRefRun, ullStart), *optOffset);
+			}
+
+			dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, LR"([\x00-\x1f]{4,}\x01)");
+			VerifyOffsets(vecRefRun01, dlg.FindEach(true));
+			auto vecBack = dlg.FindEach(false);
+			std::ranges::reverse(vecBack);
+			VerifyOffsets(vecRefRun01, vecBack);
+			VerifyOffsets(vecRefRun01, dlg.FindAll());
+			pHex->ClearData();
+		}
+	}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace TestHexCtrl {
+	TEST_CLASS(CSearchReplace) {
+public:
+	TEST_METHOD(ReplaceAllOneUndo) {
+		//The "Replace All" is one modification with one Undo snapshot, the single Undo restores all the data.
+		//The replace data is longer than the search data, the next occurrence is searched after the replaced one.
+		constexpr auto uSizeCache { GetTestCacheSize() };
+		constexpr auto uSizeData { uSizeCache * 2U + 77U };
+		static std::byte byteData[uSizeData];
+		const std::byte arrBytes[] { std::byte { 0x5A }, std::byte { 0xA5 }, std::byte { 0x77 } };
+		const std::byte arrFind[] { std::byte { 0x5A }, std::byte { 0xA5 } };
+		const std::byte arrRepl[] { std::byte { 0xC3 }, std::byte { 0xC3 }, std::byte { 0xC3 } };
+		std::uniform_int_distribution<std::size_t> distr(0, std::size(arrBytes) - 1);
+
+		CVirtDataBuffer virtData({ byteData, sizeof(byteData) });
+		for (const auto pVirtData : { static_cast<IHexVirtData*>(nullptr), static_cast<IHexVirtData*>(&virtData) }) {
+			for (auto& refByte : byteData) {
+				refByte = arrBytes[distr(GetMT19937())];
+			}
+			const std::vector<std::byte> vecOrig(byteData, byteData + uSizeData);
+
+			auto vecRepl = vecOrig;
+			for (std::size_t sOffset { 0 }; sOffset + std::size(arrRepl) <= uSizeData;) {
+				if (std::memcmp(vecOrig.data() + sOffset, arrFind, std::size(arrFind)) == 0) {
+					std::ranges::copy(arrRepl, vecRepl.begin() + sOffset);
+					sOffset += std::size(arrRepl);
+				}
+				else {
+					++sOffset;
+				}
+			}
+
+			const auto pHex = CreateHexCtrlData({ byteData, sizeof(byteData) }, pVirtData, true);
+			const CSearchDlgDriver dlg(pHex.get());
+			dlg.SetMode(ESearchDlgMode::MODE_HEXBYTES);
+			dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_INV, false);
+			dlg.SetText(IDC_HEXCTRL_SEARCH_EDIT_LIMIT, L"1000000");
+			dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, L"5AA5");
+			dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_REPL, L"C3C3C3");
+			dlg.SetText(IDC_HEXCTRL_SEARCH_EDIT_START, L"");
+			dlg.Click(IDC_HEXCTRL_SEARCH_BTN_REPLALL);
+			Assert::IsTrue(std::ranges::equal(vecRepl, byteData));
+
+			pHex->ExecuteCmd(EHexCmd::CMD_MODIFY_UNDO);
+			Assert::IsTrue(std::ranges::equal(vecOrig, byteData));
+			Assert::IsFalse(pHex->IsCmdAvail(EHexCmd::CMD_MODIFY_UNDO)); //The only snapshot.
+
+			pHex->ExecuteCmd(EHexCmd::CMD_MODIFY_REDO);
+			Assert::IsTrue(std::ranges::equal(vecRepl, byteData));
+			pHex->ClearData();
+		}
+	}
+	};
+}
\ No newline at end of file
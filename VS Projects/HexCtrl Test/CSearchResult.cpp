@@ -0,0 +1,45 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <vector>
+
+namespace TestHexCtrl {
+	TEST_CLASS(CSearchResult) {
+public:
+	TEST_METHOD(BlocksRoundTrip) {
+		//The found offsets span many result blocks, the deltas between them take one to four LEB128 bytes.
+		//The Find All appends the offsets block by block, the one by one search inserts them,
+		//at the list's end going forward, and at the list's beginning going backward, splitting the blocks.
+		constexpr auto uSizeData { 1024U * 1024U * 4U };
+		static std::byte byteData[uSizeData];
+		std::ranges::fill(byteData, std::byte { 0x00 });
+		const ULONGLONG arrDelta[] { 2, 3, 127, 128, 300, 16383, 16384 };
+		std::vector<ULONGLONG> vecRef;
+		for (ULONGLONG ullOffset { 1 }, i { 0 }; ullOffset + 2 <= uSizeData; ++i) {
+			vecRef.emplace_back(ullOffset);
+			ullOffset += i == 100 ? 1024ULL * 1024ULL * 2ULL : arrDelta[i % std::size(arrDelta)];
+		}
+
+		for (const auto ullOffset : vecRef) {
+			byteData[ullOffset] = std::byte { 0x5A };
+			byteData[ullOffset + 1] = std::byte { 0xA5 };
+		}
+		Assert::IsTrue(vecRef.size() > 256);
+
+		const auto pHex = CreateHexCtrlData({ byteData, sizeof(byteData) });
+		const CSearchDlgDriver dlg(pHex.get());
+		dlg.SetMode(ESearchDlgMode::MODE_HEXBYTES);
+		dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_INV, false);
+		dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, L"5AA5");
+		VerifyOffsets(vecRef, dlg.FindAll());
+		auto vecBack = dlg.FindEach(false);
+		std::ranges::reverse(vecBack);
+		VerifyOffsets(vecRef, vecBack);
+		VerifyOffsets(vecRef, dlg.GetList());
+		VerifyOffsets(vecRef, dlg.FindEach(true));
+		VerifyOffsets(vecRef, dlg.GetList());
+		pHex->ClearData();
+	}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace TestHexCtrl {
+	TEST_CLASS(CSearchStep) {
+public:
+	TEST_METHOD(StridedMatchesScalar) {
+		//The search with the step of 2, 4, 8 and 16 compares only the offsets in line with the step.
+		//The search data is placed every 97 bytes, at the offsets with every remainder of the step,
+		//and across the VirtualData chunks' boundaries. The search data of the step's size fills the whole lanes.
+		constexpr auto uSizeCache { GetTestCacheSize() };
+		constexpr auto uSizeData { uSizeCache * 2U + 77U };
+		static std::byte byteData[uSizeData];
+		std::vector<std::byte> vecPlace;
+		for (auto i { 1U }; i <= 17U; ++i) {
+			vecPlace.emplace_back(static_cast<std::byte>(i));
+		}
+
+		std::ranges::fill(byteData, std::byte { 0x77 });
+		for (std::size_t sOffset { 0 }; sOffset + vecPlace.size() <= uSizeData; sOffset += 97) {
+			std::ranges::copy(vecPlace, byteData + sOffset);
+		}
+		for (const auto sOffset : { std::size_t { uSizeCache - 3U }, std::size_t { uSizeCache * 2U - 6U },
+			std::size_t { uSizeData - vecPlace.size() } }) {
+			std::ranges::copy(vecPlace, byteData + sOffset);
+		}
+
+		CVirtDataBuffer virtData({ byteData, sizeof(byteData) });
+		for (const auto pVirtData : { static_cast<IHexVirtData*>(nullptr), static_cast<IHexVirtData*>(&virtData) }) {
+			const auto pHex = CreateHexCtrlData({ byteData, sizeof(byteData) }, pVirtData);
+			const CSearchDlgDriver dlg(pHex.get());
+			dlg.SetMode(ESearchDlgMode::MODE_HEXBYTES);
+			dlg.SetText(IDC_HEXCTRL_SEARCH_EDIT_LIMIT, L"1000000");
+			for (const auto sStep : { std::size_t { 2 }, std::size_t { 4 }, std::size_t { 8 }, std::size_t { 16 } }) {
+				dlg.SetText(IDC_HEXCTRL_SEARCH_EDIT_STEP, std::format(L"{}", sStep));
+				for (const auto sSizeFind : { std::size_t { 1 }, std::size_t { 3 }, sStep, sStep + 1 }) {
+					const std::vector<std::byte> vecFind(vecPlace.begin(), vecPlace.begin() + sSizeFind);
+					std::wstring wstrFind;
+					for (const auto byte : vecFind) {
+						wstrFind += std::format(L"{:02X}", static_cast<unsigned>(byte));
+					}
+
+					dlg.SetText(IDC_HEXCTRL_SEARCH_COMBO_FIND, wstrFind);
+					for (const auto fInverted : { false, true }) {
+						if (fInverted && sSizeFind != sStep) //The inverted strided search is for the whole lanes only.
+							continue;
+
+						std::vector<ULONGLONG> vecRef;
+						for (std::size_t sOffset { 0 }; sOffset + sSizeFind <= uSizeData; sOffset += sStep) {
+							if ((std::memcmp(byteData + sOffset, vecFind.data(), sSizeFind) != 0) == fInverted) {
+								vecRef.emplace_back(sOffset);
+							}
+						}
+
+						dlg.SetCheck(IDC_HEXCTRL_SEARCH_CHK_INV, fInverted);
+						if (!fInverted) { //One by one, before the Find All results are cached.
+							VerifyOffsets(vecRef, dlg.FindEach(true));
+						}
+						VerifyOffsets(vecRef, dlg.FindAll());
+					}
+				}
+			}
+			pHex->ClearData();
+		}
+	}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "stdafx.h"
+#include "CHexCtrlInit.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <vector>
+
+namespace TestHexCtrl {
+	template<typename T>
+	void VerifyStatsForType(bool fBigEndian, HEXSPAN hsp) {
+		CreateDataForType<T>();
+		const auto hxs = GetHexCtrl()->GetStatistics({ hsp }, TypeToEHexDataType<T>(), fBigEndian);
+
+		std::vector<double> vecData;
+		const auto pRefData = reinterpret_cast<const std::byte*>(GetReferenceData()) + hsp.ullOffset;
+		for (auto i { 0ULL }; i < hsp.ullSize / sizeof(T); ++i) {
+			std::byte arrElem[sizeof(T)];
+			std::copy_n(pRefData + (i * sizeof(T)), sizeof(T), arrElem);
+			if (fBigEndian) {
+				std::reverse(std::begin(arrElem), std::end(arrElem));
+			}
+			vecData.emplace_back(static_cast<double>(std::bit_cast<T>(arrElem)));
+		}
+
+		double dSum { };
+		for (const auto dData : vecData) {
+			dSum += dData;
+		}
+		const auto dMean = dSum / vecData.size();
+		double dM2 { };
+		for (const auto dData : vecData) {
+			dM2 += (dData - dMean) * (dData - dMean);
+		}
+		const auto dTolerance = 1e-9 * (std::max)(1., std::abs(dSum));
+
+		Assert::AreEqual(static_cast<ULONGLONG>(vecData.size()), hxs.ullCount);
+		Assert::AreEqual(static_cast<ULONGLONG>(std::count(vecData.begin(), vecData.end(), 0.)), hxs.ullCountZero);
+		Assert::AreEqual(*std::min_element(vecData.begin(), vecData.end()), hxs.dMin);
+		Assert::AreEqual(*std::max_element(vecData.begin(), vecData.end()), hxs.dMax);
+		Assert::AreEqual(dSum, hxs.dSum, dTolerance);
+		Assert::AreEqual(dMean, hxs.dMean, dTolerance);
+		Assert::AreEqual(std::sqrt(dM2 / vecData.size()), hxs.dStdDev, 1e-9 * (std::max)(1., std::sqrt(dM2 / vecData.size())));
+	}
+
+	TEST_CLASS(CStatistics) {
+public:
+	TEST_METHOD(Int8) {
+		VerifyStatsForType<std::int8_t>(false, { .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+	}
+	TEST_METHOD(UInt16BigEndian) {
+		VerifyStatsForType<std::uint16_t>(true, { .ullOffset { 1 }, .ullSize { GetTestDataSize() - 1 } });
+	}
+	TEST_METHOD(Int32) {
+		VerifyStatsForType<std::int32_t>(false, { .ullOffset { 3 }, .ullSize { GetTestDataSize() - 10 } });
+	}
+	TEST_METHOD(UInt64BigEndian) {
+		VerifyStatsForType<std::uint64_t>(true, { .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+	}
+	TEST_METHOD(Float) {
+		VerifyStatsForType<float>(false, { .ullOffset { 0 }, .ullSize { GetTestDataSize() } });
+	}
+	TEST_METHOD(DoubleNaN) {
+		const double arrDouble[] { 1., std::numeric_limits<double>::quiet_NaN(), 0., -3., 6. };
+		GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { reinterpret_cast<const std::byte*>(arrDouble),
+			sizeof(arrDouble) }, .vecSpan { { 0, sizeof(arrDouble) } } });
+		const auto hxs = GetHexCtrl()->GetStatistics({ { 0, sizeof(arrDouble) } }, DATA_DOUBLE);
+		Assert::AreEqual(5ULL, hxs.ullCount);
+		Assert::AreEqual(1ULL, hxs.ullCountNaN);
+		Assert::AreEqual(1ULL, hxs.ullCountZero);
+		Assert::AreEqual(-3., hxs.dMin);
+		Assert::AreEqual(6., hxs.dMax);
+		Assert::AreEqual(4., hxs.dSum);
+		Assert::AreEqual(1., hxs.dMean);
+		Assert::AreEqual(std::sqrt(10.5), hxs.dStdDev, 1e-12);
+	}
+	TEST_METHOD(SeveralSpans) {
+		const std::int16_t arrInt16[] { 10, -20, 30, 40 };
+		GetHexCtrl()->ModifyData({ .eModifyMode { MODIFY_ONCE }, .spnData { reinterpret_cast<const std::byte*>(arrInt16),
+			sizeof(arrInt16) }, .vecSpan { { 100, sizeof(arrInt16) } } });
+		const auto hxs = GetHexCtrl()->GetStatistics({ { 100, 5 }, { 104, 4 } }, DATA_INT16); //Trailing byte of the first span is ignored.
+		Assert::AreEqual(4ULL, hxs.ullCount);
+		Assert::AreEqual(-20., hxs.dMin);
+		Assert::AreEqual(40., hxs.dMax);
+		Assert::AreEqual(60., hxs.dSum);
+	}
+	};
+}
\ No newline at end of file